@@ -39,4 +39,29 @@ t_std_error sdi_bmc_device_driver_init (sdi_device_hdl_t dev_hdl);
  */
 t_std_error sdi_bmc_oem_cmd_execute(sdi_bmc_oem_cmd_info_t *oem_cmd, uint8_t *data);
 
+/**
+ * sdi_bmc_oem_cmd_submit is to queue OEM specific IPMI command. An identical
+ * command which is queued and not sent yet is shared. The completion callback
+ * is called on the IPMI event thread.
+ * oem_cmd[in] - command, its resp_data is also updated on completion
+ * data[in] - data to write, NULL to read data_size bytes
+ * cb[in] - completion callback, may be NULL
+ * cb_data[in] - data passed to the completion callback
+ * return STD_ERR_OK if the command is queued
+ */
+t_std_error sdi_bmc_oem_cmd_submit(sdi_bmc_oem_cmd_info_t *oem_cmd, uint8_t *data,
+                                   sdi_bmc_oem_cmd_cb_t cb, void *cb_data);
+
+/**
+ * sdi_bmc_oem_cmd_execute_sync is to execute OEM specific IPMI command and
+ * wait for its response. Must not be called on the IPMI event thread.
+ * oem_cmd[in] - command
+ * data[in] - data to write, NULL to read data_size bytes
+ * resp[out] - response data of a read, may be NULL
+ * timeout[in] - time to wait in milliseconds
+ * return STD_ERR_OK if the BMC answered with success
+ */
+t_std_error sdi_bmc_oem_cmd_execute_sync(sdi_bmc_oem_cmd_info_t *oem_cmd, uint8_t *data,
+                                         uint8_t *resp, uint32_t timeout);
+
 #endif /* __SDI_BMC_H__ */
@@ -88,9 +88,17 @@ sdi_bmc_sensor_t *sdi_bmc_db_sensor_get (uint32_t id, uint32_t instance, char *n
 
 /*
  * Delete sensor record from a sensor database using entity id, instance and sensor Id.
+ * The record stays allocated, OpenIPMI callbacks may still hold it.
  */
 bool sdi_bmc_db_sensor_remove (uint32_t id, uint32_t instance, char *name);
 
+/*
+ * Remove the sensors restored from the SDR cache which were not discovered,
+ * returns the number of sensors removed. The records stay allocated, callers
+ * may still hold them.
+ */
+uint32_t sdi_bmc_db_sensor_prune_cached (void);
+
 /*
  * sdi_bmc_db_for_each_sensor is to call a specified method for each sensor
  * present in the sensor map.
@@ -104,7 +112,8 @@ void sdi_bmc_db_for_each_sensor (uint32_t entity_id, uint32_t instance,
 sdi_bmc_sensor_t *sdi_bmc_db_sensor_get_by_name (char *name);
 
 /*
- * Sensor map cleanup function.
+ * Sensor map cleanup function. The records stay allocated, OpenIPMI
+ * callbacks may still hold them.
  */
 void sdi_bmc_db_sensor_cleanup(void);
 
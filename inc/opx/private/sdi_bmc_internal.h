@@ -30,11 +30,13 @@
 
 #define MAX_THRESHOLDS         (6)   /* Max thresholds for a sensor */
 #define BMC_DEFAULT_POLLING    (5)   /* BMC default polling interval 5 seconds */
+#define BMC_DEFAULT_DISCRETE_POLLING (30) /* BMC default discrete sensor polling interval 30 seconds */
 
 /*
  * BMC configuration attributes
  */
 #define SDI_BMC_DEV_ATR_POLLING_INT     "polling_interval"
+#define SDI_BMC_DEV_ATR_DISCRETE_POLLING_INT "discrete_polling_interval"
 #define SDI_BMC_DEV_ATTR_FAN            "bmc_fan"
 #define SDI_BMC_DEV_ATTR_TEMP           "bmc_temp"
 #define SDI_BMC_DEV_ATTR_EEPROM         "bmc_eeprom"
@@ -116,6 +118,8 @@ typedef struct sdi_bmc_reading_s {
     double    data;  /** threshold sensor reading. */
     uint32_t  raw_data; /** threshold sensor raw reading */
     uint32_t  discrete_state; /** Discrete sensor states */
+    uint32_t  sample_seq; /** Number of samples published, 0 if never sampled */
+    uint64_t  timestamp; /** Monotonic time of the last sample in milliseconds */
 } sdi_bmc_reading_t;
 
 typedef struct sdi_bmc_entity_info_s {
@@ -164,15 +168,37 @@ typedef struct sdi_bmc_sensor_s {
     uint32_t            type; /** BMC sensor type */
     sdi_sdr_rd_type_t   reading_type; /** Sensor reading type */
     sdi_bmc_res_data_t  res;   /** Sensor data */
+    uint32_t            reading_lock; /** Sequence lock of res.reading, odd while it is written */
     ipmi_event_state_t  *ev_state; /** Sensor event status */
     ipmi_thresholds_t   *thresholds; /** Sensor threshold states */
     int32_t             state_sup; /* Event support status */
     int32_t             thresh_sup; /* Threshold support status */
     double              threshold[MAX_THRESHOLDS]; /** BMC configured threshold values */
+    ipmi_sensor_id_t    ipmi_id; /** OpenIPMI id of the sensor, valid once scheduled for polling */
+    bool                cached; /** Restored from the SDR cache and not discovered yet */
+    bool                poll_scheduled; /** Sensor is in the poll schedule */
+    bool                poll_discrete; /** Polled at the discrete sensor polling interval */
+    uint64_t            poll_time; /** Monotonic time of the last poll request in milliseconds */
+    struct sdi_bmc_sensor_s *poll_next; /** Next sensor in the poll schedule */
 } sdi_bmc_sensor_t;
 
 
 
+/*
+ * Identity of the BMC firmware the SDR cache was built from.
+ */
+#define SDI_BMC_SDR_CACHE_DIR   "/var/cache/opx/sdi"
+#define SDI_BMC_SDR_CACHE_FILE  SDI_BMC_SDR_CACHE_DIR "/bmc_sdr.cache"
+
+typedef struct sdi_bmc_sdr_cache_key_s {
+    uint32_t manufacturer_id; /** BMC manufacturer id */
+    uint32_t product_id; /** BMC product id */
+    uint32_t device_revision; /** BMC device revision */
+    uint32_t major_fw_revision; /** BMC major firmware revision */
+    uint32_t minor_fw_revision; /** BMC minor firmware revision */
+    uint8_t  aux_fw_revision[4]; /** BMC auxiliary firmware revision */
+} sdi_bmc_sdr_cache_key_t;
+
 /*
  * BMC OEM speicific IPMI command details
  *
@@ -189,6 +215,27 @@ typedef struct sdi_bmc_oem_cmd_info_s {
     uint8_t              *resp_data;
 } sdi_bmc_oem_cmd_info_t;
 
+/*
+ * Maximum number of OEM commands sent to the BMC and not answered yet.
+ */
+#define SDI_BMC_OEM_MAX_INFLIGHT     (4)
+
+/*
+ * Default time in milliseconds to wait for the response of an OEM command.
+ */
+#define SDI_BMC_OEM_DEFAULT_TIMEOUT  (2000)
+
+/**
+ * Completion callback of an OEM command.
+ * oem_cmd[in] - command which completed
+ * status[in] - STD_ERR_OK if the BMC answered with success
+ * resp[in] - response data of a read, data_size bytes, NULL otherwise
+ * timestamp[in] - monotonic time of the completion in milliseconds
+ * cb_data[in] - data given when the command was submitted
+ */
+typedef void (*sdi_bmc_oem_cmd_cb_t) (sdi_bmc_oem_cmd_info_t *oem_cmd, t_std_error status,
+                                      const uint8_t *resp, uint64_t timestamp, void *cb_data);
+
 /*
  * BMC OEM specific IPMI Poller
  */
@@ -245,6 +292,7 @@ typedef struct sdi_bmc_dev_list_s {
 typedef struct sdi_bmc_dev_s {
     uint32_t            instance;  /** Instance number */
     uint32_t            polling_interval; /** Polling interval */
+    uint32_t            discrete_polling_interval; /** Polling interval of discrete sensors */
     char                alias[SDI_MAX_NAME_LEN]; /** BMC device alias */
     sdi_bmc_dev_list_t  *dev_list; /** Device list */
     std_dll_head        *oem_poller_head; /** OEM command list */
@@ -261,6 +309,40 @@ void  sdi_bmc_populate_oem_cmd_info (std_config_node_t node, sdi_bmc_oem_cmd_inf
 
 sdi_bmc_dev_resource_info_t * sdi_bmc_dev_get_by_data_sdr (sdi_device_hdl_t dev_hdl, char *sdr_id);
 
+/**
+ * Start an update of the reading of a sensor. Readers retry instead of
+ * blocking the writer, which is the OpenIPMI event thread.
+ */
+void sdi_bmc_sensor_reading_write_begin (sdi_bmc_sensor_t *sensor);
+
+/**
+ * Publish the reading updated since sdi_bmc_sensor_reading_write_begin,
+ * stamping it with the current time and the next sample sequence number.
+ */
+void sdi_bmc_sensor_reading_write_end (sdi_bmc_sensor_t *sensor);
+
+/**
+ * Get a consistent copy of the reading of a sensor, along with the time and
+ * sequence number of its sample.
+ */
+void sdi_bmc_sensor_reading_get (sdi_bmc_sensor_t *sensor, sdi_bmc_reading_t *reading);
+
+/**
+ * Pre-populate the sensor database from the SDR cache file. Restored sensors
+ * are marked cached until OpenIPMI discovers them.
+ * key[out] - BMC firmware identity the cache was built from
+ * Return true if the cache was valid and loaded.
+ */
+bool sdi_bmc_sdr_cache_load (sdi_bmc_sdr_cache_key_t *key);
+
+/**
+ * Write the SDR cache file from a list of discovered sensors, linked by
+ * poll_next.
+ * key[in] - BMC firmware identity the sensors were discovered from
+ * sensors[in] - first sensor of the list
+ */
+void sdi_bmc_sdr_cache_save (const sdi_bmc_sdr_cache_key_t *key, sdi_bmc_sensor_t *sensors);
+
 /**
  * BMC FAN device registration function.
  */
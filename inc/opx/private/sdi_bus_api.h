@@ -73,6 +73,22 @@ t_std_error sdi_bus_read_byte(sdi_bus_hdl_t bus_hdl, sdi_device_addr_t addr,
 t_std_error sdi_bus_write_byte(sdi_bus_hdl_t bus_hdl, sdi_device_addr_t addr,
                                uint_t offset, uint8_t buffer);
 
+/**
+ * @brief sdi_bus_read_block
+ * Read consecutive bytes starting at a specified offset of a device using bus
+ * api. I2C devices are read with a single block transfer when the adapter
+ * supports it, other buses byte by byte.
+ * @param[in] bus_hdl - Bus handle on which device data to be read is attached.
+ * @param[in] addr - Device address
+ * @param[in] offset - Offset of the first byte within device
+ * @param[out] buffer - Data read from device, must hold len bytes.
+ * @param[in] len - Number of bytes to read
+ * @return STD_ERR_OK on success, SDI_ERRCODE(ENOTSUP) if unsupported or
+ * STD failure code on error.
+ */
+t_std_error sdi_bus_read_block(sdi_bus_hdl_t bus_hdl, sdi_device_addr_t addr,
+                               uint_t offset, uint8_t *buffer, uint_t len);
+
 
 /**
  * @}
@@ -48,6 +48,11 @@
  * @def Attribute used for representing 16Bit device addressing mode
  */
 #define SDI_DEV_ATTR_16BIT_ADDR_MODE  "dev_addr_mode_16bit"
+/**
+ * @def Attribute used for representing the delay in usec to be observed after
+ * every transaction to an i2c device or on an i2c bus
+ */
+#define SDI_DEV_ATTR_SETTLE_DELAY     "settle_delay"
 /**
  * @def Attribute value used to denote when the attribute is enabled
  */
@@ -38,6 +38,8 @@
 
 #include "sdi_pin.h"
 #include "sdi_pin_group.h"
+#include "sdi_driver_internal.h"
+#include "std_mutex_lock.h"
 
 /**
  * sdi_cpld_device_t
@@ -47,6 +49,14 @@ typedef struct sdi_cpld_device_ {
     uint_t width; /* Width of every cpld register in bytes */
     uint_t start_addr; /* CPLD Register start offset address for the pin group */
     uint_t end_addr; /* CPLD Register end offset address for the pin group */
+    uint_t shadow_ttl; /* Freshness window of the register shadow in msec,
+                          0 when registers are always read from the cpld */
+    std_mutex_type_t shadow_lock; /* Serializes register read-modify-write and
+                                     protects the shadow */
+    uint8_t *shadow; /* Shadow of registers start_addr to end_addr */
+    uint64_t shadow_time; /* Time the shadow was read in msec, 0 if invalid */
+    const void **reg_owner; /* Pin or pin group which last wrote each register
+                               from start_addr to end_addr, NULL when unknown */
 } sdi_cpld_device_t;
 
 /**
@@ -81,6 +91,69 @@ typedef struct sdi_cpld_pin_group_ {
                             group counted from 1 starting LSB */
     uint_t length; /* number of cpld registers in the pin group */
     sdi_device_hdl_t cpld_hdl; /* CPLD Device Handle */
+    char event_pin[SDI_MAX_NAME_LEN]; /* Name of the pin (cpld interrupt line)
+                            signalling changes of the pin group, empty if none */
+    sdi_pin_bus_hdl_t event_pin_hdl; /* Handle of event_pin, looked up on
+                            first use */
+    bool event_clear; /* event_clear_addr is configured */
+    uint_t event_clear_addr; /* CPLD register acknowledging the interrupt */
+    uint8_t event_clear_value; /* Value written to event_clear_addr */
 } sdi_cpld_pin_group_t;
 
+/**
+ * sdi_cpld_refresh
+ * Read every register of the cpld into its shadow with one block transfer
+ * param[in] dev_hdl cpld device handle
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRCODE(ENOTSUP) when the shadow
+ * is disabled, SDI_DEVICE_ERRNO on failure
+ */
+t_std_error sdi_cpld_refresh(sdi_device_hdl_t dev_hdl);
+
+/**
+ * sdi_cpld_reg_read
+ * Read a cpld register, from the shadow when it is fresh
+ * param[in] dev_hdl cpld device handle
+ * param[in] offset register address
+ * param[out] buffer register value
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+t_std_error sdi_cpld_reg_read(sdi_device_hdl_t dev_hdl, uint_t offset,
+                              uint8_t *buffer);
+
+/**
+ * sdi_cpld_reg_write
+ * Write a cpld register as a whole, e.g. to acknowledge an interrupt
+ * param[in] dev_hdl cpld device handle
+ * param[in] offset register address
+ * param[in] value value to be written
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+t_std_error sdi_cpld_reg_write(sdi_device_hdl_t dev_hdl, uint_t offset, uint8_t value);
+
+/**
+ * sdi_cpld_reg_update
+ * Read-modify-write a cpld register: register = (register & keep_mask) | bits.
+ * The current value is taken from the shadow when it is fresh.
+ * param[in] dev_hdl cpld device handle
+ * param[in] offset register address
+ * param[in] keep_mask bits of the register which are preserved
+ * param[in] bits bits to be set in the register
+ * param[in] owner pin or pin group writing the register
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+t_std_error sdi_cpld_reg_update(sdi_device_hdl_t dev_hdl, uint_t offset,
+                                uint8_t keep_mask, uint8_t bits, const void *owner);
+
+/**
+ * sdi_cpld_reg_owned
+ * Check whether a range of cpld registers was last written by the same owner
+ * param[in] dev_hdl cpld device handle
+ * param[in] start_addr first register of the range
+ * param[in] end_addr last register of the range, may be below start_addr
+ * param[in] owner pin or pin group
+ * return true when owner was the last to write every register of the range
+ */
+bool sdi_cpld_reg_owned(sdi_device_hdl_t dev_hdl, uint_t start_addr, uint_t end_addr,
+                        const void *owner);
+
 #endif /* __SDI_CPLD_H__ */
@@ -72,4 +72,23 @@
  */
 #define SDI_CPLD_DEFAULT_REGISTER_WIDTH        1
 
+/*
+ * Attribute used for representing the freshness window, in milliseconds, of
+ * the cpld register shadow. Register reads within the window are served from
+ * the shadow; 0 or absent disables the shadow.
+ */
+#define SDI_DEV_ATTR_CPLD_SHADOW_TTL    "shadow_ttl"
+
+/*
+ * Attribute used for representing the cpld register acknowledging the
+ * interrupt signalled on the event pin of a cpld pin group
+ */
+#define SDI_DEV_ATTR_CPLD_EVENT_CLEAR_ADDR    "event_clear_addr"
+
+/*
+ * Attribute used for representing the value written to the event clear
+ * register, all ones when absent
+ */
+#define SDI_DEV_ATTR_CPLD_EVENT_CLEAR_VALUE   "event_clear_value"
+
 #endif /* __SDI_CPLD_ATTR_H__ */
@@ -46,6 +46,9 @@
 #include "std_config_node.h"
 #include "std_error_codes.h"
 #include "sdi_bus.h"
+#include "sdi_name_hash.h"
+
+#include <pthread.h>
 
 typedef std_config_node_t sdi_driver_cfg;
 
@@ -58,6 +61,8 @@ typedef uint16_t i2c_addr_t;
 typedef struct sdi_i2c_addr {
     i2c_addr_t i2c_addr;
     bool addr_mode_16bit;
+    uint16_t settle_delay; /* delay in usec needed by the device after every
+        transaction, 0 to use the bus settle delay */
 }sdi_i2c_addr_t;
 
 typedef union sdi_device_addr {
@@ -80,6 +85,19 @@ typedef struct sdi_bus_list {
      * @brief Lock for SDI Bus dynamic linked list
       */
     std_mutex_type_t lock;
+    /**
+     * @brief Buses of the list indexed by bus name
+     */
+    sdi_name_hash_t name_index;
+    /**
+     * @brief Buses of the list indexed by bus id
+     */
+    sdi_name_hash_t id_index;
+    /**
+     * @brief Lock for name_index and id_index, held for writing only while
+     * a bus is registered or unregistered, so lookups run in parallel
+     */
+    pthread_rwlock_t index_lock;
 } sdi_bus_list_t;
 
 typedef struct sdi_device_entry {
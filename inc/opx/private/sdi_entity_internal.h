@@ -41,6 +41,7 @@
 #include "sdi_pin.h"
 #include "sdi_pin_group.h"
 #include "sdi_entity_info.h"
+#include "sdi_name_hash.h"
 #include "std_llist.h"
 
 /**
@@ -84,6 +85,12 @@ struct sdi_entity {
     sdi_resource_hdl_t entity_info_hdl; /**entity_info handler of an entity */
     sdi_entity_info_t entity_info; /**<entity_info of an entity */
     std_dll_head *resource_list;/**<list of resources that are part of this entity*/
+    sdi_name_hash_t resource_index; /**<resources of resource_list indexed by alias */
+    sdi_resource_hdl_t *resources[SDI_RESOURCE_MAX]; /**<resources of resource_list
+                                                      * per type, in list order */
+    uint_t resource_count[SDI_RESOURCE_MAX]; /**<number of entries of resources per type */
+    char *init_after; /**<comma separated names of entities to be initialised
+                       * before this one at startup, NULL if none */
     bool present;
     bool entity_info_valid;
 }sdi_entity_t;
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2019 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_gpiod.h
+ */
+
+
+/******************************************************************************
+ * @file sdi_gpiod.h
+ * @brief Defines data structure for sdi gpiod pin and gpiod pin group.
+ * Gpiod pin and gpiod pin group access gpio lines through the gpio character
+ * device (/dev/gpiochipN) of the kernel gpio driver.
+ *****************************************************************************/
+
+#ifndef __SDI_GPIOD_H___
+#define __SDI_GPIOD_H___
+
+#include "sdi_pin.h"
+#include "sdi_pin_group.h"
+
+#include <stdint.h>
+
+/**
+ * Every gpio chip is exposed by the kernel as a character device
+ * /dev/gpiochip<num>. A set of lines of a chip is requested with
+ * GPIO_V2_GET_LINE_IOCTL, which returns a file descriptor owning those lines.
+ * Direction, polarity and output levels of all lines of the request are
+ * changed with a single GPIO_V2_LINE_SET_CONFIG_IOCTL, and levels of all
+ * lines are read or driven with a single GPIO_V2_LINE_GET_VALUES_IOCTL or
+ * GPIO_V2_LINE_SET_VALUES_IOCTL.
+ * Once edge detection is enabled on input lines, the same file descriptor
+ * becomes readable whenever a line changes level.
+ * For more details refer to
+ * https://www.kernel.org/doc/html/latest/userspace-api/gpio/chardev.html
+ */
+
+/**
+ * @def Path of gpio chip character device
+ */
+#define SDI_GPIOD_CHIP_PATH        "/dev/gpiochip%u"
+
+/**
+ * @struct sdi_gpiod_lines_t
+ * Lines of a gpio chip requested together, with the configuration they are
+ * currently requested with
+ */
+typedef struct sdi_gpiod_lines {
+    uint_t chip_num; /**< gpio chip number */
+    uint_t line_count; /**< number of lines in the request */
+    uint_t *line; /**< line offsets within the chip */
+    int line_fd; /**< file descriptor of the line request */
+    sdi_pin_bus_direction_t direction; /**< direction of all lines */
+    sdi_pin_bus_polarity_t polarity; /**< polarity of all lines */
+    uint64_t values; /**< last levels driven, bit n is line[n] */
+    bool edge_events; /**< edge detection enabled, line_fd delivers events */
+} sdi_gpiod_lines_t;
+
+/**
+ * @struct sdi_gpiod_pin_t
+ * SDI PIN Bus Structure Registered by every gpiod pin
+ */
+typedef struct sdi_gpiod_pin {
+    sdi_pin_bus_t bus; /**< SDI Pin Bus Object */
+    sdi_gpiod_lines_t lines; /**< Line request of the pin */
+} sdi_gpiod_pin_t;
+
+/**
+ * @struct sdi_gpiod_group_t
+ * SDI PIN Group Bus Structure Registered by every gpiod pin group
+ */
+typedef struct sdi_gpiod_pingroup {
+    sdi_pin_group_bus_t bus; /**< SDI Pin Bus Group Object */
+    sdi_gpiod_lines_t lines; /**< Line request of all pins of the group */
+} sdi_gpiod_group_t;
+
+#endif /* __SDI_GPIOD_H___ */
@@ -91,6 +91,16 @@
  * Code to detect i2c bus supports SMBUS WRITE WORD DATA transaction
  */
 #define SDI_I2C_FUNC_SMBUS_WRITE_WORD_DATA  0x00400000
+/**
+ * @def SDI_I2C_FUNC_SMBUS_READ_I2C_BLOCK
+ * Code to detect i2c bus supports SMBUS I2C BLOCK READ transaction
+ */
+#define SDI_I2C_FUNC_SMBUS_READ_I2C_BLOCK   0x04000000
+/**
+ * @def SDI_I2C_FUNC_SMBUS_WRITE_I2C_BLOCK
+ * Code to detect i2c bus supports SMBUS I2C BLOCK WRITE transaction
+ */
+#define SDI_I2C_FUNC_SMBUS_WRITE_I2C_BLOCK  0x08000000
 /**
  * @def SDI_I2C_FUNC_SMBUS_BYTE
  * Code to detect i2c bus supports I2C BYTE transactions
@@ -230,6 +240,68 @@ typedef sdi_i2c_bus_t *sdi_i2c_bus_hdl_t;
  */
 typedef unsigned long sdi_i2c_bus_capability_t;
 
+/**
+ * @def SDI_I2C_BATCH_MAX_OPS
+ * Maximum number of transactions in an I2C batch
+ */
+#define SDI_I2C_BATCH_MAX_OPS             16
+
+/**
+ * @def SDI_I2C_BATCH_MAX_WRITE_LEN
+ * Maximum number of bytes written by a single transaction of an I2C batch
+ */
+#define SDI_I2C_BATCH_MAX_WRITE_LEN       32
+
+/**
+ * @struct sdi_i2c_batch_op
+ * One register transaction of an I2C batch, @sa sdi_i2c_batch_execute
+ */
+typedef struct sdi_i2c_batch_op {
+    /**
+     * Read or write
+     */
+    sdi_i2c_operation_t operation;
+    /**
+     * Register offset, 16bit for slaves using 16bit addressing
+     */
+    uint_t offset;
+    /**
+     * Data read from/written to the slave
+     */
+    uint8_t *buffer;
+    /**
+     * Number of bytes to read/write
+     */
+    uint_t len;
+} sdi_i2c_batch_op_t;
+
+/**
+ * @struct sdi_i2c_bus_stats
+ * Transaction and timing counters maintained by an I2C Bus
+ */
+typedef struct sdi_i2c_bus_stats {
+    /**
+     * Number of transactions executed on the bus
+     */
+    uint64_t transactions;
+    /**
+     * Number of transactions retried after a failure
+     */
+    uint64_t retries;
+    /**
+     * Time spent executing transactions on the bus, in micro seconds
+     */
+    uint64_t io_time_us;
+    /**
+     * Time spent sleeping in settle and retry delays, in micro seconds
+     */
+    uint64_t sleep_time_us;
+    /**
+     * Number of bus recovery attempts made on the bus
+     */
+    uint64_t resets;
+} sdi_i2c_bus_stats_t;
+
 /**
  * @struct sdi_i2c_bus_ops
  * SDI I2C Bus Operations defined by every I2C Bus Registered
@@ -295,6 +367,32 @@ typedef struct sdi_i2c_bus_ops {
      */
      void (*sdi_i2c_get_capability) (sdi_i2c_bus_hdl_t bus,
         sdi_i2c_bus_capability_t *capability);
+    /**
+     * @brief sdi_i2c_get_stats
+     * Get the transaction and timing counters of the bus.
+     * Doesn't acquire the bus, so it can be called with the bus acquired.
+     * Optional, NULL when the bus doesn't maintain counters.
+     */
+     void (*sdi_i2c_get_stats) (sdi_i2c_bus_hdl_t bus,
+        sdi_i2c_bus_stats_t *stats);
+    /**
+     * @brief sdi_i2c_batch_execute
+     * Execute a batch of register transactions on a slave, in order, with
+     * fewer bus operations than executing them one by one. Bus is acquired
+     * by the caller.
+     * Optional, NULL when the bus can't do better than one by one. Returns
+     * SDI_ERRCODE(EOPNOTSUPP) without executing any transaction when the
+     * batch can't be done this way.
+     */
+    t_std_error (*sdi_i2c_batch_execute) (sdi_i2c_bus_hdl_t bus,
+        sdi_i2c_addr_t address, const sdi_i2c_batch_op_t *ops, uint_t count,
+        uint_t flags);
+    /**
+     * @brief sdi_i2c_get_parent
+     * Get the i2c bus this bus is multiplexed from.
+     * Optional, NULL for a bus driven directly by an i2c adapter.
+     */
+    sdi_i2c_bus_hdl_t (*sdi_i2c_get_parent) (sdi_i2c_bus_hdl_t bus);
 } sdi_i2c_bus_ops_t;
 
 /**
@@ -305,4 +305,50 @@ t_std_error sdi_smbus_write_i2c_block_data(sdi_i2c_bus_hdl_t bus_handle,
                                 sdi_i2c_addr_t i2c_addr, uint16_t cmd,
                                 uint8_t length, const uint8_t *values, uint_t flags);
 
+/**
+ * @brief sdi_i2c_batch_execute
+ * Execute a batch of register reads and writes on a slave, in order, under
+ * a single bus acquisition. When the bus supports it, the whole batch is a
+ * single combined I2C transfer; otherwise transactions are executed one by
+ * one with SMBUS byte transactions. Execution stops at the first failure.
+ * @param[in] bus_handle : i2c bus handle
+ * @param[in] i2c_addr : i2c slave address
+ * @param[in,out] ops : transactions to execute, read data is filled in the
+ * buffer of read transactions
+ * @param[in] count : number of transactions, at most SDI_I2C_BATCH_MAX_OPS
+ * @param[in] flags : options if any to be sent @sa sdi_i2c_flags for
+ * supported flags
+ * @return returns
+ * - STD_ERR_OK on success,
+ * - SDI_ERRNO on failure.
+ */
+t_std_error sdi_i2c_batch_execute(sdi_i2c_bus_hdl_t bus_handle,
+                                  sdi_i2c_addr_t i2c_addr,
+                                  const sdi_i2c_batch_op_t *ops, uint_t count,
+                                  uint_t flags);
+
+/**
+ * @brief sdi_i2c_bus_root_get
+ * Get the i2c bus driven by the i2c adapter that carries all transactions of
+ * this bus, following i2c mux channels up to their parent bus.
+ * @param[in] bus_handle : i2c bus handle
+ * @return handle of the root i2c bus, bus_handle itself if it is not a mux
+ * channel.
+ */
+sdi_i2c_bus_hdl_t sdi_i2c_bus_root_get(sdi_i2c_bus_hdl_t bus_handle);
+
+/**
+ * @brief sdi_i2c_bus_stats_get
+ * Get the transaction and timing counters of the bus. For a mux channel bus,
+ * counters of the multiplexed bus are returned.
+ * @param[in] bus_handle : i2c bus handle
+ * @param[out] stats : transaction count, retries, time spent on the bus
+ * and time spent sleeping in settle and retry delays
+ * @return returns
+ * - STD_ERR_OK on success,
+ * - SDI_ERRCODE(ENOTSUP) when the bus doesn't maintain counters.
+ */
+t_std_error sdi_i2c_bus_stats_get(sdi_i2c_bus_hdl_t bus_handle,
+                                  sdi_i2c_bus_stats_t *stats);
+
 #endif /* __SDI_I2C_BUS_API_H__ */
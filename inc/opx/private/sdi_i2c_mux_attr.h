@@ -54,6 +54,15 @@
  * @def Attribute used to select channel for PCA mux
  */
 #define SDI_DEV_ATTR_SDI_I2CMUX_SELECT            "mux_sel_value"
+/**
+ * @def Attribute used for channel deselect policy of PCA mux
+ * (always, idle or never)
+ */
+#define SDI_DEV_ATTR_SDI_I2CMUX_DESELECT          "deselect"
+/**
+ * @def Attribute used for idle time in msec after which PCA mux is deselected
+ */
+#define SDI_DEV_ATTR_SDI_I2CMUX_IDLE_TIMEOUT      "idle_timeout"
 /**
  * @}
  */
@@ -55,6 +55,18 @@
  */
 #define SDI_DEV_ATTR_SYSFS_NAME        "sysfs_name"
 
+/**
+ * Attribute used for representing the initial delay in usec before retrying
+ * a failed transaction. Delay is doubled on every retry.
+ */
+#define SDI_DEV_ATTR_RETRY_DELAY       "retry_delay"
+
+/**
+ * Slave address of i2cdev_fd when no address is programmed or the
+ * programmed address is unknown
+ */
+#define SDI_I2CDEV_SLAVE_ADDR_NONE     (-1)
+
 /**
  * SDI I2C BUS Object for Kernel driver I2C Bus
  */
@@ -68,6 +80,17 @@ typedef struct sdi_sys_i2c_bus_ {
         Bus */
     sdi_i2c_bus_capability_t capability; /* Funcionality supported by the i2c
         bus. Data type is unsigned long as expected by ioctl call */
+    uint_t settle_delay; /* Delay in usec after every transaction, unless the
+        slave device asks for a longer one */
+    uint_t retry_delay; /* Initial delay in usec before retrying a failed
+        transaction, doubled on every retry */
+    sdi_i2c_bus_stats_t stats; /* Transaction and timing counters, updated
+        with bus lock held and read atomically without it */
+    int slave_addr; /* Slave address programmed on i2cdev_fd with I2C_SLAVE,
+        SDI_I2CDEV_SLAVE_ADDR_NONE when unknown */
+    bool pec_enabled; /* PEC state programmed on i2cdev_fd with I2C_PEC */
+    bool rdwr_split; /* Adapter rejects I2C_RDWR of several transactions, so
+        every transaction of a batch is a separate ioctl */
 } sdi_sys_i2c_bus_t;
 
 #endif /* __SDI_I2CDEV_H___ */
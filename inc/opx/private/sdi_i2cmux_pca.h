@@ -48,6 +48,20 @@
 #define __SDI_I2CMUX_PCA_H__
 
 #include "sdi_i2c.h"
+#include "std_thread_tools.h"
+
+/**
+ * @enum sdi_i2cmux_pca_deselect_t
+ * @brief when a selected channel of PCA mux is deselected
+ */
+typedef enum {
+    SDI_I2CMUX_PCA_DESELECT_ALWAYS, /**< deselect on every channel bus release */
+    SDI_I2CMUX_PCA_DESELECT_IDLE, /**< deselect once mux is idle for idle timeout */
+    SDI_I2CMUX_PCA_DESELECT_NEVER, /**< keep last channel selected till another
+                                        channel is selected */
+} sdi_i2cmux_pca_deselect_t;
+
+struct sdi_i2cmuxchan_bus_;
 
 /**
  * @struct sdi_i2cmux_pca_t
@@ -55,12 +69,23 @@
  * contains
  * - bus id of i2c bus being multiplexed
  * - i2c address of PCA mux
+ * - channel last selected on the mux, used to skip redundant select writes
  */
 typedef struct sdi_i2cmux_pca {
     sdi_i2c_bus_hdl_t i2c_bus; /**< parent i2c bus handle */
     char i2c_bus_name[SDI_MAX_NAME_LEN]; /**< parent i2c bus name */
     std_mutex_type_t mux_lock; /**< lock to synchronize accessing i2c mux */
     sdi_bus_list_t channel_list; /**< list to maintain i2c mux channel */
+    sdi_i2cmux_pca_deselect_t deselect; /**< channel deselect policy */
+    uint_t idle_timeout; /**< idle time in msec before deselect, for
+                              SDI_I2CMUX_PCA_DESELECT_IDLE */
+    struct sdi_i2cmuxchan_bus_ *selected_chan; /**< channel last selected, NULL
+                                                    when mux is deselected */
+    bool selected_valid; /**< false when state of selected_chan is unknown,
+                              e.g., after an i2c bus error */
+    uint64_t parent_resets; /**< resets of parent bus when channel was selected */
+    uint64_t last_access; /**< time in msec of last channel bus release */
+    std_thread_create_param_t deselect_thread; /**< idle deselect thread */
 } sdi_i2cmux_pca_t;
 
 /**
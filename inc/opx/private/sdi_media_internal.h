@@ -33,6 +33,61 @@
 #include "std_error_codes.h"
 #include "std_type_defs.h"
 #include "sdi_media.h"
+#include "sdi_pin_group.h"
+#include "std_mutex_lock.h"
+
+#include <string.h>
+
+/**
+ * @def SDI_MEDIA_STATE_PRESENT
+ * state_get flag and state bit for module presence
+ */
+#define SDI_MEDIA_STATE_PRESENT  (1 << 0)
+
+/**
+ * @def SDI_MEDIA_STATE_RESET
+ * state_get flag and state bit for module held in reset
+ */
+#define SDI_MEDIA_STATE_RESET    (1 << 1)
+
+/**
+ * @def SDI_MEDIA_STATE_LPMODE
+ * state_get flag and state bit for module in low power mode
+ */
+#define SDI_MEDIA_STATE_LPMODE   (1 << 2)
+
+/**
+ * @struct sdi_media_pin_level_t
+ * Level of a pin group read once for a batch of media
+ */
+typedef struct {
+    sdi_pin_group_bus_hdl_t hdl;
+    const void *device; /* Device refreshed for the pin group, NULL if none */
+    uint_t level;
+    t_std_error rc;
+} sdi_media_pin_level_t;
+
+/**
+ * @struct sdi_media_pin_levels_t
+ * Pin group levels already read for a batch of media. Media of a batch
+ * usually share a handful of pin groups, one per control signal and port
+ * range, so each is read only once per batch.
+ */
+typedef struct {
+    sdi_media_pin_level_t *levels;
+    uint_t count;
+    uint_t size;
+} sdi_media_pin_levels_t;
+
+/**
+ * @brief Get the level of a pin group, reading it only on first use in a batch
+ * @param[in] levels - pin group levels of the batch
+ * @param[in] hdl - pin group handle
+ * @param[out] value - level of the pin group
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_media_pin_group_level_get(sdi_media_pin_levels_t *levels,
+                                          sdi_pin_group_bus_hdl_t hdl, uint_t *value);
 
 /**
  * Each media resource provides the following callbacks.
@@ -190,6 +245,179 @@ typedef struct {
     t_std_error (*media_module_info_get)(sdi_resource_hdl_t resource_hdl,
             sdi_media_module_info_t* module_info);
 
+    /* For reading all module and channel monitors at once. Optional, media
+     * layer composes the snapshot from module_monitor_get and
+     * channel_monitor_get when not provided */
+    t_std_error (*dom_snapshot_get)(sdi_resource_hdl_t resource_hdl, uint_t channel_count,
+            sdi_media_dom_snapshot_t *snapshot);
+
+    /* For getting a file descriptor which becomes readable when presence of
+     * the media may have changed. Optional, presence is polled when not
+     * provided or when it returns an error */
+    t_std_error (*presence_event_fd_get)(sdi_resource_hdl_t resource_hdl, int *fd);
+
+    /* For consuming pending presence events, so the file descriptor of
+     * presence_event_fd_get is no longer readable */
+    t_std_error (*presence_event_clear)(sdi_resource_hdl_t resource_hdl);
+
+    /* For getting SDI_MEDIA_STATE_* bits selected by flags, reading pin
+     * groups through sdi_media_pin_group_level_get. Optional, media layer uses
+     * presence_get and module_control_status_get when not provided */
+    t_std_error (*state_get)(sdi_resource_hdl_t resource_hdl, sdi_media_pin_levels_t *levels,
+                             uint_t flags, uint_t *state);
+
+    /* For dropping eeprom data cached for the inserted module, when a
+     * presence event shows the module may have been swapped. Optional */
+    void (*module_cache_invalidate)(sdi_resource_hdl_t resource_hdl);
+
 } media_ctrl_t;
 
+/**
+ * @def SDI_MEDIA_SHADOW_CC_BASE_INDEX
+ * Index of CC_BASE in an eeprom shadow. CC_BASE is the low order 8 bits of
+ * the sum of all bytes before it. Same for SFP page A0 and QSFP upper page 0.
+ */
+#define SDI_MEDIA_SHADOW_CC_BASE_INDEX   63
+
+/**
+ * @def SDI_MEDIA_SHADOW_CC_EXT_INDEX
+ * Index of CC_EXT in an eeprom shadow. CC_EXT is the low order 8 bits of the
+ * sum of all bytes from CC_BASE + 1 till CC_EXT.
+ */
+#define SDI_MEDIA_SHADOW_CC_EXT_INDEX    95
+
+/**
+ * @enum sdi_media_shadow_state_t
+ * State of the eeprom shadow of a module
+ */
+typedef enum {
+    /** not read since the module was inserted */
+    SDI_MEDIA_SHADOW_EMPTY = 0,
+    /** read and checksums match, static fields are served from it */
+    SDI_MEDIA_SHADOW_VALID,
+    /** checksums don't match or layout is not known, static fields are read
+     * from the module */
+    SDI_MEDIA_SHADOW_INVALID,
+} sdi_media_shadow_state_t;
+
+/**
+ * @struct sdi_media_shadow_t
+ * In memory copy of the static eeprom page of a module(SFP page A0, QSFP upper
+ * page 0). It holds the base and extended ID fields, validated with CC_BASE
+ * and CC_EXT, followed by the vendor specific area. The page is read without
+ * the lock and published only if the shadow was not invalidated meanwhile.
+ */
+typedef struct {
+    std_mutex_type_t lock; /* protects state, generation and data */
+    uint_t generation; /* incremented on every invalidation */
+    sdi_media_shadow_state_t state;
+    uint8_t data[SDI_MEDIA_PAGE_SIZE];
+} sdi_media_shadow_t;
+
+/**
+ * @brief Initialize the eeprom shadow of a module
+ * @param[out] shadow - eeprom shadow
+ * @return - none
+ */
+static inline void sdi_media_shadow_init(sdi_media_shadow_t *shadow)
+{
+    std_mutex_lock_init_non_recursive(&(shadow->lock));
+    shadow->generation = 0;
+    shadow->state = SDI_MEDIA_SHADOW_EMPTY;
+}
+
+/**
+ * @brief Drop the eeprom shadow, the module may have been removed or swapped
+ * @param[in] shadow - eeprom shadow
+ * @return - none
+ */
+static inline void sdi_media_shadow_invalidate(sdi_media_shadow_t *shadow)
+{
+    std_mutex_lock(&(shadow->lock));
+    shadow->state = SDI_MEDIA_SHADOW_EMPTY;
+    shadow->generation++;
+    std_mutex_unlock(&(shadow->lock));
+}
+
+/**
+ * @brief Check whether the eeprom shadow has to be read from the module
+ * @param[in] shadow - eeprom shadow
+ * @param[out] generation - generation to publish the page with
+ * @return - true if the shadow is empty
+ */
+static inline bool sdi_media_shadow_load_begin(sdi_media_shadow_t *shadow, uint_t *generation)
+{
+    bool empty = false;
+
+    std_mutex_lock(&(shadow->lock));
+    empty = (shadow->state == SDI_MEDIA_SHADOW_EMPTY);
+    *generation = shadow->generation;
+    std_mutex_unlock(&(shadow->lock));
+    return empty;
+}
+
+/**
+ * @brief Publish a page read from the module into the eeprom shadow, unless
+ * the shadow was invalidated since sdi_media_shadow_load_begin
+ * @param[in] shadow - eeprom shadow
+ * @param[in] generation - generation from sdi_media_shadow_load_begin
+ * @param[in] data - page read from the module
+ * @param[in] state - state of the page
+ * @return - none
+ */
+static inline void sdi_media_shadow_publish(sdi_media_shadow_t *shadow, uint_t generation,
+                                            const uint8_t *data, sdi_media_shadow_state_t state)
+{
+    std_mutex_lock(&(shadow->lock));
+    if ((shadow->generation == generation) && (shadow->state == SDI_MEDIA_SHADOW_EMPTY)) {
+        memcpy(shadow->data, data, sizeof(shadow->data));
+        shadow->state = state;
+    }
+    std_mutex_unlock(&(shadow->lock));
+}
+
+/**
+ * @brief Copy bytes of a valid eeprom shadow
+ * @param[in] shadow - eeprom shadow
+ * @param[in] index - index of the first byte in the shadow
+ * @param[out] buf - buffer for the bytes
+ * @param[in] len - number of bytes
+ * @return - true if the shadow is valid and the bytes are copied
+ */
+static inline bool sdi_media_shadow_read(sdi_media_shadow_t *shadow, uint_t index,
+                                         uint8_t *buf, size_t len)
+{
+    bool valid = false;
+
+    std_mutex_lock(&(shadow->lock));
+    valid = (shadow->state == SDI_MEDIA_SHADOW_VALID);
+    if (valid) {
+        memcpy(buf, &(shadow->data[index]), len);
+    }
+    std_mutex_unlock(&(shadow->lock));
+    return valid;
+}
+
+/**
+ * @brief Check CC_BASE and CC_EXT of an eeprom page
+ * @param[in] data - page of SDI_MEDIA_PAGE_SIZE bytes
+ * @return - true if both checksums match
+ */
+static inline bool sdi_media_shadow_checksum_valid(const uint8_t *data)
+{
+    uint8_t cc_base = 0;
+    uint8_t cc_ext = 0;
+    uint_t index = 0;
+
+    for (index = 0; index < SDI_MEDIA_SHADOW_CC_BASE_INDEX; index++) {
+        cc_base += data[index];
+    }
+    for (index = SDI_MEDIA_SHADOW_CC_BASE_INDEX + 1;
+         index < SDI_MEDIA_SHADOW_CC_EXT_INDEX; index++) {
+        cc_ext += data[index];
+    }
+    return ((cc_base == data[SDI_MEDIA_SHADOW_CC_BASE_INDEX])
+            && (cc_ext == data[SDI_MEDIA_SHADOW_CC_EXT_INDEX]));
+}
+
 #endif
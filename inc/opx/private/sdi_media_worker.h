@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_media_worker.h
+ */
+
+
+/*******************************************************************
+* @file   sdi_media_worker.h
+* @brief  Per i2c adapter worker threads used to access media in parallel.
+* Media on different root i2c buses don't share any bus lock, so each root
+* i2c bus gets a worker thread which executes the work queued for media
+* attached to it, in order.
+*******************************************************************/
+
+#ifndef _SDI_MEDIA_WORKER_H_
+#define _SDI_MEDIA_WORKER_H_
+
+#include "std_error_codes.h"
+#include "std_llist.h"
+#include "sdi_entity.h"
+
+/**
+ * @typedef sdi_media_work_fn_t
+ * Function executed by a media worker
+ */
+typedef void (*sdi_media_work_fn_t)(void *arg);
+
+/**
+ * @struct sdi_media_work_t
+ * Work queued to a media worker. Memory is owned by the caller and must stay
+ * valid till fn is called.
+ */
+typedef struct sdi_media_work {
+    std_dll node; /**< node in the queue of the worker, must be first */
+    sdi_media_work_fn_t fn; /**< function to execute */
+    void *arg; /**< argument passed to fn */
+} sdi_media_work_t;
+
+/**
+ * @brief Queue work on the worker of the root i2c bus of a media. Worker is
+ * created on first use.
+ * @param[in] resource_hdl - handle of the media resource
+ * @param[in] work - work to execute
+ * @return STD_ERR_OK when work is queued, error when media isn't attached to
+ * an i2c bus or no worker could be created; caller should then execute the
+ * work itself.
+ */
+t_std_error sdi_media_work_queue(sdi_resource_hdl_t resource_hdl,
+                                 sdi_media_work_t *work);
+
+/**
+ * @brief Check whether the caller runs on a media worker thread. Work which
+ * waits for other queued work must not run there, the worker would wait
+ * for itself.
+ * @return true on a media worker thread
+ */
+bool sdi_media_work_on_worker(void);
+
+#endif /* _SDI_MEDIA_WORKER_H_ */
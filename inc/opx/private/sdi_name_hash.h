@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2019 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_name_hash.h
+ */
+
+
+/******************************************************************************
+ * @file sdi_name_hash.h
+ * @brief Hash table used by the SDI frameworks to look up resources, entities
+ * and buses by name or by numeric identifier
+ *****************************************************************************/
+
+#ifndef __SDI_NAME_HASH_H___
+#define __SDI_NAME_HASH_H___
+
+#include "std_type_defs.h"
+
+/**
+ * @defgroup sdi_internal_name_hash SDI Internal Name Hash
+ * @brief Hash table of objects keyed either by a null terminated name of at
+ * most SDI_MAX_NAME_LEN characters or by a numeric identifier; a table holds
+ * one kind of key only. Names are not copied, they must live as long as the
+ * table. Several objects may share a key, they are found in the order they
+ * were added, as a scan of a list in registration order would find them.
+ *
+ * @ingroup sdi_internal
+ *
+ * @{
+ */
+
+/**
+ * @struct sdi_name_hash_entry_t
+ * Object added to a name hash
+ */
+typedef struct sdi_name_hash_entry {
+    /** next entry of the same bucket, in the order of addition */
+    struct sdi_name_hash_entry *next;
+    /** name of the object, NULL in a table keyed by identifier */
+    const char *name;
+    /** identifier of the object, in a table keyed by identifier */
+    uint_t id;
+    /** the object */
+    void *value;
+} sdi_name_hash_entry_t;
+
+/**
+ * @struct sdi_name_hash_t
+ * Name hash table, zero initialised memory is an empty table
+ */
+typedef struct {
+    sdi_name_hash_entry_t **buckets;
+    uint_t bucket_count;
+    uint_t count;
+} sdi_name_hash_t;
+
+/**
+ * @brief Add an object to a name hash
+ * @param[in] hash - name hash
+ * @param[in] name - name of the object, referenced by the hash
+ * @param[in] value - the object
+ */
+void sdi_name_hash_add(sdi_name_hash_t *hash, const char *name, void *value);
+
+/**
+ * @brief Add an object to a hash keyed by identifier
+ * @param[in] hash - identifier hash
+ * @param[in] id - identifier of the object
+ * @param[in] value - the object
+ */
+void sdi_name_hash_add_id(sdi_name_hash_t *hash, uint_t id, void *value);
+
+/**
+ * @brief Remove an object from a hash
+ * @param[in] hash - name or identifier hash
+ * @param[in] value - the object, removed from every key it was added with
+ */
+void sdi_name_hash_remove(sdi_name_hash_t *hash, void *value);
+
+/**
+ * @brief Get the first entry added with a name
+ * @param[in] hash - name hash
+ * @param[in] name - name to look up
+ * @return entry, NULL if no object has that name
+ */
+sdi_name_hash_entry_t *sdi_name_hash_first(const sdi_name_hash_t *hash, const char *name);
+
+/**
+ * @brief Get the entry added with the same name after a given entry
+ * @param[in] entry - entry returned by @ref sdi_name_hash_first or by this API
+ * @return entry, NULL if no other object has that name
+ */
+sdi_name_hash_entry_t *sdi_name_hash_next(const sdi_name_hash_entry_t *entry);
+
+/**
+ * @brief Get the first object added with a name
+ * @param[in] hash - name hash
+ * @param[in] name - name to look up
+ * @return the object, NULL if no object has that name
+ */
+void *sdi_name_hash_find(const sdi_name_hash_t *hash, const char *name);
+
+/**
+ * @brief Get the first object added with an identifier
+ * @param[in] hash - identifier hash
+ * @param[in] id - identifier to look up
+ * @return the object, NULL if no object has that identifier
+ */
+void *sdi_name_hash_find_id(const sdi_name_hash_t *hash, uint_t id);
+
+/**
+ * @}
+ */
+
+#endif /* __SDI_NAME_HASH_H___ */
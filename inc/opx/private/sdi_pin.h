@@ -66,9 +66,8 @@
  *         default configuration of pin
  *         lock to syncrhonize access to pin
  *
- * @todo
- * Add interrupt related functionality when a pin can receive interrupt/generate
- * interrupt
+ * Pins which can signal level changes (edges) expose a pollable event file
+ * descriptor, so consumers wait for changes instead of polling the level.
  *
  * @ingroup sdi_internal_bus
  *
@@ -173,6 +172,19 @@ typedef struct sdi_pin_bus_ops {
      */
     t_std_error (*sdi_pin_bus_get_polarity) (sdi_pin_bus_hdl_t bus_handle,
             sdi_pin_bus_polarity_t *polarity);
+    /**
+     * @brief sdi_pin_bus_event_fd_get
+     * Get a file descriptor which becomes readable when the pin level changes.
+     * Optional, NULL when the pin can not signal level changes
+     */
+    t_std_error (*sdi_pin_bus_event_fd_get) (sdi_pin_bus_hdl_t bus_handle,
+            int *fd);
+    /**
+     * @brief sdi_pin_bus_event_clear
+     * Consume pending level change events, so the event file descriptor is no
+     * longer readable. Mandatory when sdi_pin_bus_event_fd_get is provided
+     */
+    t_std_error (*sdi_pin_bus_event_clear) (sdi_pin_bus_hdl_t bus_handle);
 } sdi_pin_bus_ops_t;
 
 /**
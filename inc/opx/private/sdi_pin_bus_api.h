@@ -100,6 +100,25 @@ t_std_error sdi_pin_set_polarity(sdi_pin_bus_hdl_t bus,
 t_std_error sdi_pin_get_polarity(sdi_pin_bus_hdl_t bus,
                                  sdi_pin_bus_polarity_t *polarity);
 
+/**
+ * @brief sdi_pin_event_fd_get
+ * Get a file descriptor which becomes readable when the pin level changes
+ * @param[in] bus sdi pin bus object
+ * @param[out] fd pollable event file descriptor of the pin
+ * @return STD_ERR_OK on SUCCESS, SDI_ERRCODE(ENOTSUP) when the pin can not
+ * signal level changes, SDI_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_event_fd_get(sdi_pin_bus_hdl_t bus, int *fd);
+
+/**
+ * @brief sdi_pin_event_clear
+ * Consume pending level change events of the pin
+ * @param[in] bus sdi pin bus object
+ * @return STD_ERR_OK on SUCCESS, SDI_ERRCODE(ENOTSUP) when the pin can not
+ * signal level changes, SDI_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_event_clear(sdi_pin_bus_hdl_t bus);
+
 /**
  * @}
  */
@@ -39,6 +39,10 @@
  * @def Attribute used for representing the pin number
  */
 #define SDI_DEV_ATTR_PIN_NUMBER            "pin"
+/**
+ * @def Attribute used for representing the gpio chip number of a pin
+ */
+#define SDI_DEV_ATTR_GPIO_CHIP             "chip"
 /**
  * @def Attribute used for representing the pin group
  */
@@ -55,6 +59,11 @@
  * @def Attribute used for representing the pin level
  */
 #define SDI_DEV_ATTR_PIN_LEVEL             "level"
+/**
+ * @def Attribute used for representing the pin signalling level changes of a
+ * pin group
+ */
+#define SDI_DEV_ATTR_EVENT_PIN             "event_pin"
 /**
  * @def Attribute used for representing the input pin
  */
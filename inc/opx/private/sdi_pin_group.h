@@ -120,6 +120,43 @@ typedef struct sdi_pin_group_bus_ops {
      */
     t_std_error (*sdi_pin_group_bus_get_polarity) (sdi_pin_group_bus_hdl_t bus_hdl,
             sdi_pin_bus_polarity_t *polarity);
+    /**
+     * @brief sdi_pin_group_bus_event_fd_get
+     * Get a file descriptor which becomes readable when the level of any pin
+     * of the group changes. Optional, NULL when the pin group can not signal
+     * level changes
+     */
+    t_std_error (*sdi_pin_group_bus_event_fd_get) (sdi_pin_group_bus_hdl_t bus_hdl,
+            int *fd);
+    /**
+     * @brief sdi_pin_group_bus_event_clear
+     * Consume pending level change events, so the event file descriptor is no
+     * longer readable. Mandatory when sdi_pin_group_bus_event_fd_get is
+     * provided
+     */
+    t_std_error (*sdi_pin_group_bus_event_clear) (sdi_pin_group_bus_hdl_t bus_hdl);
+    /**
+     * @brief sdi_pin_group_bus_refresh
+     * Re-read the device backing the pin group, so following reads of this
+     * and other pin groups of the same device reflect the current levels
+     * without further device access. Optional, NULL when every read accesses
+     * the device anyway
+     */
+    t_std_error (*sdi_pin_group_bus_refresh) (sdi_pin_group_bus_hdl_t bus_hdl);
+    /**
+     * @brief sdi_pin_group_bus_refresh_device
+     * Identify the device re-read by sdi_pin_group_bus_refresh, so pin groups
+     * sharing it are refreshed once. Mandatory when sdi_pin_group_bus_refresh
+     * is provided
+     */
+    const void *(*sdi_pin_group_bus_refresh_device) (sdi_pin_group_bus_hdl_t bus_hdl);
+    /**
+     * @brief sdi_pin_group_bus_level_owned
+     * Check that nothing else wrote the device bits backing the pin group
+     * since its last write, e.g. another pin or pin group on the same cpld
+     * register. Optional, NULL when the pins are driven by this pin group only
+     */
+    bool (*sdi_pin_group_bus_level_owned) (sdi_pin_group_bus_hdl_t bus_hdl);
 } sdi_pin_group_bus_ops_t;
 
 /**
@@ -155,6 +192,21 @@ typedef struct sdi_pin_group_bus {
      * Set to SDI_PIN_POLARITY_NORMAL for pins with no default configuration
      */
     sdi_pin_bus_polarity_t default_polarity;
+    /**
+     * @brief written_level
+     * Level last written through @ref sdi_pin_group_write_level, valid when
+     * written_level_valid is set. Lets select pin groups skip rewriting the
+     * level already driven. It is kept per pin group object, writes through
+     * other objects backed by the same device bits are caught by
+     * sdi_pin_group_bus_level_owned.
+     */
+    uint_t written_level;
+    /**
+     * @brief written_level_valid
+     * Cleared when the level driven by the pin group is not known, i.e. before
+     * the first write, after a failed write or a direction or polarity change
+     */
+    bool written_level_valid;
     /**
      * @brief lock
      * To serialize access to pin
@@ -76,6 +76,27 @@ t_std_error sdi_pin_group_read_level(sdi_pin_group_bus_hdl_t bus_hdl,
 t_std_error sdi_pin_group_write_level(sdi_pin_group_bus_hdl_t bus_hdl,
                                       uint_t value);
 
+/**
+ * @brief sdi_pin_group_write_level_cached
+ * Write value of the Pin Group unless the same value was the last one written
+ * to it. Meant for select pin groups(i2c mux, module select), which are
+ * rewritten before every access but seldom change. Owners which change the
+ * pins by other means must call @ref sdi_pin_group_level_invalidate.
+ * @param[in] bus_hdl sdi pin group bus object
+ * @param[in] value pin group level to be set
+ * @return STD_ERR_OK on SUCCESS, SDI_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_group_write_level_cached(sdi_pin_group_bus_hdl_t bus_hdl,
+                                             uint_t value);
+
+/**
+ * @brief sdi_pin_group_level_invalidate
+ * Forget the level last written to the Pin Group, so the next
+ * @ref sdi_pin_group_write_level_cached writes the pins again
+ * @param[in] bus_hdl sdi pin group bus object
+ */
+void sdi_pin_group_level_invalidate(sdi_pin_group_bus_hdl_t bus_hdl);
+
 
 /**
  * @brief sdi_pin_group_set_direction
@@ -120,6 +141,48 @@ t_std_error sdi_pin_group_set_polarity(sdi_pin_group_bus_hdl_t bus_hdl,
 t_std_error sdi_pin_group_get_polarity(sdi_pin_group_bus_hdl_t bus_hdl,
                                        sdi_pin_bus_polarity_t *polarity);
 
+
+/**
+ * @brief sdi_pin_group_event_fd_get
+ * Get a file descriptor which becomes readable when the level of any pin of
+ * the pin group changes
+ * @param[in] bus_hdl sdi pin group bus object
+ * @param[out] fd pollable event file descriptor of the pin group
+ * @return STD_ERR_OK on SUCCESS, SDI_ERRCODE(ENOTSUP) when the pin group can
+ * not signal level changes, SDI_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_group_event_fd_get(sdi_pin_group_bus_hdl_t bus_hdl, int *fd);
+
+
+/**
+ * @brief sdi_pin_group_event_clear
+ * Consume pending level change events of the pin group
+ * @param[in] bus_hdl sdi pin group bus object
+ * @return STD_ERR_OK on SUCCESS, SDI_ERRCODE(ENOTSUP) when the pin group can
+ * not signal level changes, SDI_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_group_event_clear(sdi_pin_group_bus_hdl_t bus_hdl);
+
+/**
+ * @brief sdi_pin_group_refresh
+ * Re-read the device backing the pin group in one access, so reads of pin
+ * groups sharing the device are served without further device access
+ * @param[in] bus_hdl sdi pin group bus object
+ * @return STD_ERR_OK on SUCCESS, SDI_ERRCODE(ENOTSUP) when reads of the pin
+ * group always access the device, SDI_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_group_refresh(sdi_pin_group_bus_hdl_t bus_hdl);
+
+/**
+ * @brief sdi_pin_group_refresh_device
+ * Identify the device re-read by @ref sdi_pin_group_refresh. Pin groups with
+ * the same device are served by a single refresh
+ * @param[in] bus_hdl sdi pin group bus object
+ * @return device backing the pin group, NULL when the pin group can not be
+ * refreshed
+ */
+const void *sdi_pin_group_refresh_device(sdi_pin_group_bus_hdl_t bus_hdl);
+
 /**
  * @}
  */
@@ -28,6 +28,7 @@
 #define __SDI_QSFP_H_
 #include "sdi_resource_internal.h"
 #include "sdi_media.h"
+#include "sdi_media_internal.h"
 
 /* For some QSFP28-DD version 2.7 and up, length calculation is needed*/
 #define LEN_CODE_MANTISSA_SHIFT      (0)
@@ -87,6 +88,9 @@ typedef struct qsfp_device {
     sdi_media_port_info_t port_info;
 
     uint_t eeprom_version; /* Used for QSFP28-DD EEPROM version */
+
+    sdi_media_shadow_t eeprom; /**<upper page 0 of the inserted module */
+    bool paging_support; /**<paging support of the module, valid with eeprom */
 } qsfp_device_t;
 
 /* This function overrides the LP_MODE hardware pin. Use carefully */
@@ -258,6 +262,28 @@ t_std_error sdi_qsfp_module_monitor_get (sdi_resource_hdl_t resource_hdl,
 t_std_error sdi_qsfp_channel_monitor_get (sdi_resource_hdl_t resource_hdl, uint_t channel,
                                           sdi_media_channel_monitor_t monitor, float *value);
 
+/**
+ * @brief Read module and channel monitors of a range of channels of the
+ * specified qsfp in one go
+ * @param[in] resource_hdl - handle to qsfp
+ * @param[in] first_channel - first channel of the range
+ * @param[in] channel_count - number of channels of interest
+ * @param[out] snapshot - monitors of the media
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_qsfp_dom_snapshot_read (sdi_resource_hdl_t resource_hdl, uint_t first_channel,
+                                        uint_t channel_count, sdi_media_dom_snapshot_t *snapshot);
+
+/**
+ * @brief Read all module and channel monitors of the specified qsfp in one go
+ * @param[in] resource_hdl - handle to qsfp
+ * @param[in] channel_count - number of channels of interest
+ * @param[out] snapshot - monitors of the media
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_qsfp_dom_snapshot_get (sdi_resource_hdl_t resource_hdl, uint_t channel_count,
+                                       sdi_media_dom_snapshot_t *snapshot);
+
 /**
  * @brief Get the optional feature support status for optics
  * @param resource_hdl[in] - handle to qsfp
@@ -353,6 +379,13 @@ t_std_error sdi_qsfp_phy_speed_set(sdi_resource_hdl_t resource_hdl, uint_t chann
  */
 t_std_error sdi_qsfp_module_init (sdi_resource_hdl_t resource_hdl, bool pres);
 
+/*
+ * @brief Drop the eeprom data cached for the inserted module
+ * @param[in] resource_hdl - handle to the qsfp
+ * @return - none
+ */
+void sdi_qsfp_module_cache_invalidate(sdi_resource_hdl_t resource_hdl);
+
 /*
  * @brief Set wavelength for tunable media
  * @param[in]  - resource_hdl - handle to the front panel port
@@ -450,6 +483,21 @@ t_std_error sdi_qsfp_module_info_get (sdi_resource_hdl_t resource_hdl,
  */
 t_std_error sdi_qsfp_presence_get (sdi_resource_hdl_t resource_hdl, bool *pres);
 
+/**
+ * Gets the file descriptor signalling presence changes of qsfp module
+ * resource_hdl[in] - Handle of the qsfp resource
+ * fd[out]        - pollable file descriptor of the presence pin group
+ * return t_std_error
+ */
+t_std_error sdi_qsfp_presence_event_fd_get (sdi_resource_hdl_t resource_hdl, int *fd);
+
+/**
+ * Consumes pending presence events of qsfp module
+ * resource_hdl[in] - Handle of the qsfp resource
+ * return t_std_error
+ */
+t_std_error sdi_qsfp_presence_event_clear (sdi_resource_hdl_t resource_hdl);
+
 /**
  * Enable/Disable the module control parameters like low power mode and reset
  * control
@@ -205,6 +205,16 @@ t_std_error sdi_qsfp28_dd_module_monitor_get (sdi_resource_hdl_t resource_hdl,
 t_std_error sdi_qsfp28_dd_channel_monitor_get (sdi_resource_hdl_t resource_hdl, uint_t channel,
                                           sdi_media_channel_monitor_t monitor, float *value);
 
+/**
+ * @brief Read all module and channel monitors of the specified media in one go
+ * @param[in] resource_hdl - handle to qsfp28_dd
+ * @param[in] channel_count - number of channels of interest
+ * @param[out] snapshot - monitors of the media
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_qsfp28_dd_dom_snapshot_get (sdi_resource_hdl_t resource_hdl, uint_t channel_count,
+                                            sdi_media_dom_snapshot_t *snapshot);
+
 /**
  * @brief Get the optional feature support status for optics
  * @param resource_hdl[in] - handle to qsfp28_dd
@@ -50,6 +50,7 @@
 #include "sdi_entity.h"
 #include "sdi_entity_internal.h"
 #include "sdi_sys_common.h"
+#include "std_mutex_lock.h"
 
 /**
  * Every reource is identified by
@@ -94,8 +95,26 @@ struct sdi_resource {
     struct sdi_entity *parent; /* Parent entity, to which this resource belongs */
     bool entity_ppid_regexp_valid; /* Entity ppid pattern valid */
     regex_t entity_ppid_regexp[1]; /* Resource available only if ppid of parent entity matches this pattern */
+    bool init_deferred; /* Init is deferred till the resource is first accessed */
+    uint_t init_data; /* Data passed to the deferred init */
+    std_mutex_type_t init_lock; /* Serializes the deferred init with accesses */
+    struct sdi_resource *prewarm_next; /* Next resource in the pre-warm queue */
 };
 
+/**
+ * @enum sdi_resource_init_mode_t
+ * When resources of an entity are initialised by sdi_entity_init
+ */
+typedef enum {
+    /** Initialise every resource during sdi_entity_init */
+    SDI_RESOURCE_INIT_EAGER,
+    /** Initialise each resource on its first access */
+    SDI_RESOURCE_INIT_LAZY,
+    /** Initialise each resource on its first access, or earlier by a
+     * background thread of idle priority */
+    SDI_RESOURCE_INIT_LAZY_PREWARM,
+} sdi_resource_init_mode_t;
+
 
 /**
  * @brief Initialize the resource manager.
@@ -184,6 +203,40 @@ sdi_resource_hdl_t sdi_find_resource_by_alias(const char *alias);
  */
 t_std_error sdi_resource_init(sdi_resource_hdl_t hdl, void *data);
 
+/**
+ * @brief Select when @ref sdi_resource_init_schedule initialises resources.
+ * @param[in] mode - resource init mode, SDI_RESOURCE_INIT_EAGER by default
+ */
+void sdi_resource_init_mode_set(sdi_resource_init_mode_t mode);
+
+/**
+ * @brief Initialise the resource now or, in lazy init modes, on its first
+ * access through the SDI APIs.
+ * @param[in] hdl - handle to the resource whose information has to be initialised.
+ * @param[in] data - data to initialise, copied when init is deferred
+ * @return STD_ERR_OK on success and standard error on failure. A deferred
+ * init always succeeds here, its failure is logged when it runs.
+ */
+t_std_error sdi_resource_init_schedule(sdi_resource_hdl_t hdl, void *data);
+
+/**
+ * @brief Run the deferred init of a resource, if it is still pending.
+ * @param[in] hdl - handle to the resource
+ */
+void sdi_resource_deferred_init(sdi_resource_hdl_t hdl);
+
+/**
+ * @brief Make sure the resource is initialised before it is accessed. Every
+ * SDI API of a resource type with an init callback calls this first.
+ * @param[in] hdl - handle to the resource
+ */
+static inline void sdi_resource_init_ensure(sdi_resource_hdl_t hdl)
+{
+    if (__atomic_load_n(&(((sdi_resource_priv_hdl_t)hdl)->init_deferred), __ATOMIC_ACQUIRE)) {
+        sdi_resource_deferred_init(hdl);
+    }
+}
+
 /**
  * @}
  */
@@ -28,6 +28,7 @@
 #define _SDI_SFP_H_
 
 #include "sdi_media.h"
+#include "sdi_media_internal.h"
 #include "sdi_resource_internal.h"
 #include "sdi_pin_group.h"
 
@@ -112,45 +113,6 @@ typedef struct sdi_sfp_tunable_capabilities {
     uint_t channel_count; /* channel starts from 1 to N */
 } sdi_sfp_tunable_capabilities_t;
 
-/**
- * @struct sfp_device_t
- * SFP device private data
- */
-typedef struct sfp_device {
-    sdi_pin_group_bus_hdl_t mux_sel_hdl; /**<sfp device mux selection pin
-                                           group bus handler*/
-    uint_t mux_sel_value; /**<value which needs to be written on pin group bus for
-                            selecting mux */
-    /** sfp device module selection pin group bus handler */
-    sdi_pin_group_bus_hdl_t mod_sel_hdl;
-    /** value needs to be written on pin group bus for selecting module */
-    uint_t mod_sel_value;
-    /** sfp device module presence pin group bus handler */
-    sdi_pin_group_bus_hdl_t mod_pres_hdl;
-    /** sfp devie presence bit mask */
-    uint_t mod_pres_bitmask;
-    /** sfp device module transmitter control pin bus handler */
-    sdi_pin_group_bus_hdl_t mod_tx_control_hdl;
-    /** sfp devie tx control bit mask */
-    uint_t mod_tx_control_bitmask;
-    /** sfp device module rx los pin bus handler */
-    sdi_pin_group_bus_hdl_t mod_sfp_rx_los_hdl;
-    /** sfp devie rx los bit mask */
-    uint_t mod_sfp_rx_los_bitmask;
-    /** sfp device module tx fault pin bus handler */
-    sdi_pin_group_bus_hdl_t mod_sfp_tx_fault_hdl;
-    /** sfp devie tx fault bit mask */
-    uint_t  mod_sfp_tx_fault_bitmask;
-    /** flag for checking whether LED can be controlled by CPU */
-    bool port_led_control_flag;
-    /** port led related data */
-    sdi_media_led_t port_led;
-    /** Front panel port or media capability */
-    sdi_media_speed_t  capability;
-
-    sdi_media_port_info_t port_info;
-} sfp_device_t;
-
 /**
  * @enum sfp_calib_info_type_t
  * sfp calibration types which is used to interpret the data
@@ -207,6 +169,75 @@ typedef struct {
     uint8_t rx_power_const_0[EXT_CAL_RX_POWER_DATA_LEN];
 } sfp_rx_power_calib_info_t;
 
+/**
+ * @struct sfp_calib_cache_t
+ * Diag monitoring support and calibration constants of the inserted module.
+ * They don't change while the module is inserted, so they are read on the
+ * first monitor or threshold read and dropped with the eeprom shadow.
+ */
+typedef struct {
+    /** true if rest of the cache is loaded */
+    bool valid;
+    /** eeprom shadow generation the cache was read in */
+    uint_t generation;
+    /** true if module supports digital diagnostic monitoring */
+    bool ddm_supported;
+    /** Calibration of temperature */
+    sfp_calib_info_t temp;
+    /** Calibration of supply voltage */
+    sfp_calib_info_t volt;
+    /** Calibration of tx bias current */
+    sfp_calib_info_t tx_bias;
+    /** Calibration of tx output power */
+    sfp_calib_info_t tx_power;
+    /** Calibration of rx optical power */
+    sfp_rx_power_calib_info_t rx_power;
+} sfp_calib_cache_t;
+
+/**
+ * @struct sfp_device_t
+ * SFP device private data
+ */
+typedef struct sfp_device {
+    sdi_pin_group_bus_hdl_t mux_sel_hdl; /**<sfp device mux selection pin
+                                           group bus handler*/
+    uint_t mux_sel_value; /**<value which needs to be written on pin group bus for
+                            selecting mux */
+    /** sfp device module selection pin group bus handler */
+    sdi_pin_group_bus_hdl_t mod_sel_hdl;
+    /** value needs to be written on pin group bus for selecting module */
+    uint_t mod_sel_value;
+    /** sfp device module presence pin group bus handler */
+    sdi_pin_group_bus_hdl_t mod_pres_hdl;
+    /** sfp devie presence bit mask */
+    uint_t mod_pres_bitmask;
+    /** sfp device module transmitter control pin bus handler */
+    sdi_pin_group_bus_hdl_t mod_tx_control_hdl;
+    /** sfp devie tx control bit mask */
+    uint_t mod_tx_control_bitmask;
+    /** sfp device module rx los pin bus handler */
+    sdi_pin_group_bus_hdl_t mod_sfp_rx_los_hdl;
+    /** sfp devie rx los bit mask */
+    uint_t mod_sfp_rx_los_bitmask;
+    /** sfp device module tx fault pin bus handler */
+    sdi_pin_group_bus_hdl_t mod_sfp_tx_fault_hdl;
+    /** sfp devie tx fault bit mask */
+    uint_t  mod_sfp_tx_fault_bitmask;
+    /** flag for checking whether LED can be controlled by CPU */
+    bool port_led_control_flag;
+    /** port led related data */
+    sdi_media_led_t port_led;
+    /** Front panel port or media capability */
+    sdi_media_speed_t  capability;
+
+    sdi_media_port_info_t port_info;
+    /** Calibration constants of the inserted module */
+    sfp_calib_cache_t calib;
+    /** Page A0 of the inserted module */
+    sdi_media_shadow_t eeprom;
+} sfp_device_t;
+
+
 /**
  * @brief Converts a number from milliwatts to dbm
  * @param[in] power_mw - The power value to be converted.
@@ -361,6 +392,16 @@ t_std_error sdi_sfp_module_monitor_get (sdi_resource_hdl_t resource_hdl,
 t_std_error sdi_sfp_channel_monitor_get (sdi_resource_hdl_t resource_hdl, uint_t channel,
                                          sdi_media_channel_monitor_t monitor, float *value);
 
+/**
+ * @brief Read all module and channel monitors of the specified sfp in one go
+ * @param[in] resource_hdl - handle to sfp
+ * @param[in] channel_count - number of channels of interest
+ * @param[out] snapshot - monitors of the media
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_sfp_dom_snapshot_get (sdi_resource_hdl_t resource_hdl, uint_t channel_count,
+                                      sdi_media_dom_snapshot_t *snapshot);
+
 /**
  * @brief Get the optional feature support status for optics
  * @param resource_hdl[in] - handle to sfp
@@ -466,6 +507,13 @@ t_std_error sdi_sfp_phy_speed_set(sdi_resource_hdl_t resource_hdl, uint_t channe
  */
 t_std_error sdi_sfp_module_init (sdi_resource_hdl_t resource_hdl, bool pres);
 
+/*
+ * @brief Drop the eeprom data cached for the inserted module
+ * @param[in] resource_hdl - handle to the sfp
+ * @return - none
+ */
+void sdi_sfp_module_cache_invalidate(sdi_resource_hdl_t resource_hdl);
+
 /*
  * @brief Set wavelength for tunable media
  * @param[in]  - resource_hdl - handle to the front panel port
@@ -41,6 +41,9 @@
 #define SDI_ERRMSG_LOG(format, ...) \
     EV_LOGGING(BOARD, ERR, __func__, format, ## __VA_ARGS__)
 
+#define SDI_INFOMSG_LOG(format, ...) \
+    EV_LOGGING(BOARD, INFO, "", format, ## __VA_ARGS__)
+
 #define SDI_TRACEMSG_LOG(format, ...) \
     EV_LOGGING(BOARD, DEBUG, "", format, ## __VA_ARGS__)
 
@@ -1637,6 +1637,310 @@ t_std_error sdi_media_wavelength_set (sdi_resource_hdl_t resource_hdl, float val
 t_std_error sdi_media_qsa_adapter_type_get (sdi_resource_hdl_t resource_hdl,
                                    sdi_qsa_adapter_type_t* qsa_adapter);
 
+/**
+ * @def SDI_MEDIA_DOM_MAX_CHANNELS
+ * Maximum number of channels in a @ref sdi_media_dom_snapshot_t
+ */
+#define SDI_MEDIA_DOM_MAX_CHANNELS              8
+
+/**
+ * @struct sdi_media_dom_snapshot_t
+ * Module and channel monitors of a media, read at once by
+ * @ref sdi_media_dom_snapshot_get
+ */
+typedef struct {
+    /** number of channels whose monitors are filled */
+    uint_t channel_count;
+    /** "true" if temperature and voltage are supported by the media */
+    bool module_monitor_valid;
+    /** "true" if rx power is supported by the media */
+    bool rx_power_valid;
+    /** "true" if tx bias current is supported by the media */
+    bool tx_bias_valid;
+    /** "true" if tx output power is supported by the media */
+    bool tx_power_valid;
+    /** module temperature */
+    float temperature;
+    /** module supply voltage */
+    float voltage;
+    /** rx power of every channel */
+    float rx_power[SDI_MEDIA_DOM_MAX_CHANNELS];
+    /** tx bias current of every channel */
+    float tx_bias[SDI_MEDIA_DOM_MAX_CHANNELS];
+    /** tx output power of every channel */
+    float tx_power[SDI_MEDIA_DOM_MAX_CHANNELS];
+} sdi_media_dom_snapshot_t;
+
+/**
+ * @brief Read all module and channel monitors of a media in one go. Media
+ * drivers fetch the whole monitor register window in a single block
+ * transfer, so this is much cheaper than the equivalent series of
+ * @ref sdi_media_module_monitor_get and @ref sdi_media_channel_monitor_get.
+ * @param[in] resource_hdl - handle to media
+ * @param[in] channel_count - number of channels of interest, at most
+ * SDI_MEDIA_DOM_MAX_CHANNELS
+ * @param[out] snapshot - monitors of the media. Monitors not supported by the
+ * media are 0 and flagged invalid
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_media_dom_snapshot_get (sdi_resource_hdl_t resource_hdl, uint_t channel_count,
+                                        sdi_media_dom_snapshot_t *snapshot);
+
+/**
+ * @def SDI_MEDIA_POLL_MAX_CHANNELS
+ * Maximum number of channels whose monitors are collected by
+ * @ref sdi_media_poll
+ */
+#define SDI_MEDIA_POLL_MAX_CHANNELS             SDI_MEDIA_DOM_MAX_CHANNELS
+
+/**
+ * @struct sdi_media_poll_t
+ * Presence and DOM data of a media, collected by @ref sdi_media_poll
+ */
+typedef struct {
+    /** [in] handle of the media resource to poll */
+    sdi_resource_hdl_t resource_hdl;
+    /** [in] number of channels whose monitors are read, at most
+     * SDI_MEDIA_POLL_MAX_CHANNELS */
+    uint_t channel_count;
+    /** [out] STD_ERR_OK if all data of a present media could be read. DOM
+     * values not supported by the media are reported as 0 */
+    t_std_error rc;
+    /** [out] "true" if media is present, DOM data is valid only then */
+    bool present;
+    /** [out] module temperature */
+    float temperature;
+    /** [out] module supply voltage */
+    float voltage;
+    /** [out] rx power of every channel */
+    float rx_power[SDI_MEDIA_POLL_MAX_CHANNELS];
+    /** [out] tx bias current of every channel */
+    float tx_bias[SDI_MEDIA_POLL_MAX_CHANNELS];
+    /** [out] tx output power of every channel */
+    float tx_power[SDI_MEDIA_POLL_MAX_CHANNELS];
+} sdi_media_poll_t;
+
+/**
+ * @brief Collect presence and DOM data of a set of media in one sweep.
+ * Media are grouped by the i2c adapter they are attached to and every
+ * adapter is polled by its own worker, so the sweep takes as long as the
+ * busiest adapter rather than the sum of all media.
+ * @param[in,out] media - media to poll, results are filled in every entry
+ * @param[in] count - number of entries in media
+ * @return - STD_ERR_OK when the sweep is complete; result of every media is
+ * in its rc
+ */
+t_std_error sdi_media_poll (sdi_media_poll_t *media, uint_t count);
+
+/**
+ * @typedef sdi_media_async_hdl_t
+ * Handle of an asynchronous media request
+ */
+typedef struct sdi_media_async_req *sdi_media_async_hdl_t;
+
+/**
+ * @typedef sdi_media_async_cb_t
+ * Completion callback of an asynchronous media request. It is called on the
+ * worker thread of the i2c adapter of the media and must not block. The
+ * request is released once the callback returns. Synchronous media APIs
+ * executed by the workers, such as @ref sdi_media_poll, must not be called
+ * from the callback; sdi_media_poll fails with EDEADLK there.
+ * @param[in] req - handle of the completed request
+ * @param[in] rc - result of the request
+ * @param[in] cookie - cookie passed when the request was submitted
+ */
+typedef void (*sdi_media_async_cb_t)(sdi_media_async_hdl_t req, t_std_error rc,
+                                     void *cookie);
+
+/**
+ * @brief Asynchronous media requests run on a worker thread per i2c adapter,
+ * so a slow or hung bus only delays requests for media on that bus.
+ * A request submitted with a callback completes through the callback.
+ * A request submitted without a callback completes by incrementing the
+ * eventfd returned by this API; caller then collects the result with
+ * @ref sdi_media_async_complete. Output buffers of a request must stay valid
+ * until it completes.
+ * @param[out] fd - eventfd signalled whenever a request without callback
+ * completes. It is non blocking and shared by all such requests.
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_media_async_fd_get (int *fd);
+
+/**
+ * @brief Collect the result of a request submitted without a callback and
+ * release the request.
+ * @param[in] req - handle of the request
+ * @param[out] rc - result of the request
+ * @return - STD_ERR_OK if request completed, EAGAIN error code if it is
+ * still pending
+ */
+t_std_error sdi_media_async_complete (sdi_media_async_hdl_t req, t_std_error *rc);
+
+/**
+ * @brief Asynchronous version of @ref sdi_media_presence_get
+ * @param[in] resource_hdl - handle of the media resource
+ * @param[out] presence - filled with presence when request completes
+ * @param[in] cb - completion callback, NULL to complete through the eventfd
+ * @param[in] cookie - cookie passed to cb
+ * @param[out] req - handle of the request, mandatory when cb is NULL; set to
+ *                  NULL when cb is given
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_media_presence_get_async (sdi_resource_hdl_t resource_hdl,
+                                          bool *presence, sdi_media_async_cb_t cb,
+                                          void *cookie, sdi_media_async_hdl_t *req);
+
+/**
+ * @brief Asynchronous version of @ref sdi_media_module_monitor_get
+ * @param[in] resource_hdl - handle of the media resource
+ * @param[in] monitor - the monitor which needs to be retrieved
+ * @param[out] value - filled with value of the monitor when request completes
+ * @param[in] cb - completion callback, NULL to complete through the eventfd
+ * @param[in] cookie - cookie passed to cb
+ * @param[out] req - handle of the request, mandatory when cb is NULL; set to
+ *                  NULL when cb is given
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_media_module_monitor_get_async (sdi_resource_hdl_t resource_hdl,
+                                                sdi_media_module_monitor_t monitor,
+                                                float *value, sdi_media_async_cb_t cb,
+                                                void *cookie, sdi_media_async_hdl_t *req);
+
+/**
+ * @brief Asynchronous version of @ref sdi_media_channel_monitor_get
+ * @param[in] resource_hdl - handle of the media resource
+ * @param[in] channel - channel number that is of interest
+ * @param[in] monitor - the monitor which needs to be retrieved
+ * @param[out] value - filled with value of the monitor when request completes
+ * @param[in] cb - completion callback, NULL to complete through the eventfd
+ * @param[in] cookie - cookie passed to cb
+ * @param[out] req - handle of the request, mandatory when cb is NULL; set to
+ *                  NULL when cb is given
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_media_channel_monitor_get_async (sdi_resource_hdl_t resource_hdl,
+                                                 uint_t channel,
+                                                 sdi_media_channel_monitor_t monitor,
+                                                 float *value, sdi_media_async_cb_t cb,
+                                                 void *cookie, sdi_media_async_hdl_t *req);
+
+/**
+ * @brief Asynchronous version of @ref sdi_media_vendor_info_get
+ * @param[in] resource_hdl - handle of the media resource
+ * @param[in] vendor_info_type - vendor information that is of interest
+ * @param[out] vendor_info - filled with vendor information when request completes
+ * @param[in] buf_size - size of vendor_info
+ * @param[in] cb - completion callback, NULL to complete through the eventfd
+ * @param[in] cookie - cookie passed to cb
+ * @param[out] req - handle of the request, mandatory when cb is NULL; set to
+ *                  NULL when cb is given
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_media_vendor_info_get_async (sdi_resource_hdl_t resource_hdl,
+                                             sdi_media_vendor_info_type_t vendor_info_type,
+                                             char *vendor_info, size_t buf_size,
+                                             sdi_media_async_cb_t cb, void *cookie,
+                                             sdi_media_async_hdl_t *req);
+
+/**
+ * @brief Asynchronous version of @ref sdi_media_read_generic
+ * @param[in] resource_hdl - handle of the media resource
+ * @param[in] addr - address, page and offset to read from, copied on submit
+ * @param[out] data - filled with data_len bytes when request completes
+ * @param[in] data_len - length of the data to read
+ * @param[in] cb - completion callback, NULL to complete through the eventfd
+ * @param[in] cookie - cookie passed to cb
+ * @param[out] req - handle of the request, mandatory when cb is NULL; set to
+ *                  NULL when cb is given
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_media_read_generic_async (sdi_resource_hdl_t resource_hdl,
+                                          sdi_media_eeprom_addr_t *addr,
+                                          uint8_t *data, size_t data_len,
+                                          sdi_media_async_cb_t cb, void *cookie,
+                                          sdi_media_async_hdl_t *req);
+
+/**
+ * @def SDI_MEDIA_PRESENCE_EVENT_POLL_INTERVAL_MS
+ * Interval at which presence is read for media whose presence pins can not
+ * signal level changes
+ */
+#define SDI_MEDIA_PRESENCE_EVENT_POLL_INTERVAL_MS     1000
+
+/**
+ * @struct sdi_media_presence_event_t
+ * Presence change of a media, collected by @ref sdi_media_presence_event_get
+ */
+typedef struct {
+    /** handle of the media resource whose presence changed */
+    sdi_resource_hdl_t resource_hdl;
+    /** presence of the media when the change was detected */
+    bool presence;
+} sdi_media_presence_event_t;
+
+/**
+ * @brief Register a media for presence change notification. Presence changes
+ * of every registered media signal the eventfd returned by this API; caller
+ * then collects them with @ref sdi_media_presence_event_get. Media whose
+ * presence pins signal level changes are reported as soon as the pin changes,
+ * others are read every SDI_MEDIA_PRESENCE_EVENT_POLL_INTERVAL_MS by a
+ * single monitor thread.
+ * @param[in] resource_hdl - handle of the media resource
+ * @param[out] fd - eventfd signalled when presence changes are pending, same
+ * for every registered media
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_media_presence_event_register (sdi_resource_hdl_t resource_hdl, int *fd);
+
+/**
+ * @brief Collect pending presence changes. Several changes of a media between
+ * two calls are reported once, with the latest presence.
+ * @param[out] events - filled with pending presence changes
+ * @param[in] max_count - number of entries in events
+ * @param[out] count - number of entries filled in events. Changes which did
+ * not fit stay pending and keep the eventfd signalled
+ * @return - standard @ref t_std_error
+ */
+t_std_error sdi_media_presence_event_get (sdi_media_presence_event_t *events,
+                                          uint_t max_count, uint_t *count);
+
+/**
+ * @def SDI_MEDIA_BITMAP_BYTES
+ * Size in bytes of a bitmap holding one bit for each of count media
+ */
+#define SDI_MEDIA_BITMAP_BYTES(count)     (((count) + 7) / 8)
+
+/**
+ * @struct sdi_media_state_bitmap_t
+ * Bitmaps filled by @ref sdi_media_presence_bitmap_get. Bit n, counted from
+ * the least significant bit of byte 0, refers to the nth media passed to it.
+ * Each bitmap holds SDI_MEDIA_BITMAP_BYTES(count) bytes. Bitmaps other than
+ * presence are optional, NULL when not required.
+ */
+typedef struct {
+    /** set when the media is present */
+    uint8_t *presence;
+    /** set when the media is held in reset */
+    uint8_t *reset;
+    /** set when the media is in low power mode */
+    uint8_t *lpmode;
+    /** set when the state of the media could not be read */
+    uint8_t *failed;
+} sdi_media_state_bitmap_t;
+
+/**
+ * @brief Get presence, and optionally reset and low power mode state, of a
+ * set of media. Each pin group carrying these signals is read once for the
+ * whole set, instead of once per media and signal.
+ * @param[in] resource_hdl - handles of the media resources
+ * @param[in] count - number of entries in resource_hdl
+ * @param[out] bitmap - bitmaps to fill
+ * @return - standard @ref t_std_error, error of the last media which failed.
+ * Bits of failed media are set in bitmap->failed and cleared elsewhere.
+ */
+t_std_error sdi_media_presence_bitmap_get (sdi_resource_hdl_t *resource_hdl, uint_t count,
+                                           sdi_media_state_bitmap_t *bitmap);
+
 
 /**
  * @}
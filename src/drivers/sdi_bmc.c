@@ -39,11 +39,14 @@
 #include <OpenIPMI/ipmi_fru.h>
 #include <OpenIPMI/ipmi_mc.h>
 #include <OpenIPMI/internal/ipmi_domain.h>
+#include <OpenIPMI/internal/ipmi_mc.h>
 
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/time.h>
+#include <time.h>
 #include <signal.h>
+#include <pthread.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -54,9 +57,46 @@ static int32_t sdi_bmc_entity_presence_handler (ipmi_entity_t *entity, int32_t p
                                                 void *cb_data, ipmi_event_t  *event);
 static sdi_bmc_sensor_t *sdi_bmc_sensor_create (ipmi_entity_t *entity, ipmi_sensor_t *sensor);
 sdi_bmc_sensor_t *sdi_bmc_add_entity_fru_info (ipmi_entity_t *entity);
+static void sdi_bmc_oem_dispatch (void);
 
 std_dll_head *oem_poller_head;
 
+/* Sensors polled by the poller thread, added at the head only */
+static sdi_bmc_sensor_t *poll_schedule = NULL;
+static std_mutex_lock_create_static_init_fast(poll_schedule_lock);
+
+/* SDR cache state: firmware identity of the cached, then of the live BMC,
+ * and whether the cache file has to be rewritten */
+static sdi_bmc_sdr_cache_key_t sdr_cache_key;
+static bool sdr_cache_loaded = false;
+static bool sdr_cache_key_valid = false;
+static bool sdr_cache_dirty = false;
+
+/**
+ * sdi_bmc_sensor_from_cb gets the sensor record of an OpenIPMI sensor
+ * callback. Requests and event handlers for a sensor record get it as
+ * cb_data; records are retired, never freed, when the sensor database is
+ * cleaned up, so they outlive the callbacks. Callbacks without a record look
+ * it up by entity and sensor id.
+ */
+
+static sdi_bmc_sensor_t *sdi_bmc_sensor_from_cb (ipmi_sensor_t *sensor, void *cb_data)
+{
+    ipmi_entity_t      *ent = NULL;
+    uint32_t           id, instance;
+    char               name[SDI_MAX_NAME_LEN] = "";
+
+    if (cb_data != NULL) {
+        return (sdi_bmc_sensor_t *) cb_data;
+    }
+    ent = ipmi_sensor_get_entity(sensor);
+    id = ipmi_entity_get_entity_id(ent);
+    instance = ipmi_entity_get_entity_instance(ent);
+    ipmi_sensor_get_id(sensor, name, sizeof(name));
+
+    return sdi_bmc_db_sensor_get(id, instance, name);
+}
+
 /**
  * sdi_bmc_sensor_threshold_event_handler is a callback function which is used to 
  * register for threshold events with openipmi library. It will update current sensor
@@ -71,16 +111,9 @@ int sdi_bmc_sensor_threshold_event_handler(ipmi_sensor_t *sensor,
                                     uint32_t raw_value, double value, void *cb_data,
                                     ipmi_event_t *event)
 {
-    ipmi_entity_t      *ent = ipmi_sensor_get_entity(sensor);
-    uint32_t           id, instance;
-    char               name[SDI_MAX_NAME_LEN];
     sdi_bmc_sensor_t   *sen = NULL;
 
-    id = ipmi_entity_get_entity_id(ent);
-    instance = ipmi_entity_get_entity_instance(ent);
-    ipmi_sensor_get_id(sensor, name, sizeof(name) );
-
-    sen = sdi_bmc_db_sensor_get(id, instance, name);
+    sen = sdi_bmc_sensor_from_cb(sensor, cb_data);
     if (sen != NULL) {
         switch (value_present)
         {
@@ -88,11 +121,15 @@ int sdi_bmc_sensor_threshold_event_handler(ipmi_sensor_t *sensor,
                 SDI_DEVICE_TRACEMSG_LOG("Threshold event handling No value present.");
                 break;
             case IPMI_BOTH_VALUES_PRESENT:
+                sdi_bmc_sensor_reading_write_begin(sen);
                 sen->res.reading.data = value;
                 sen->res.reading.raw_data = raw_value;
+                sdi_bmc_sensor_reading_write_end(sen);
                 break;
             case IPMI_RAW_VALUE_PRESENT:
+                sdi_bmc_sensor_reading_write_begin(sen);
                 sen->res.reading.raw_data = raw_value;
+                sdi_bmc_sensor_reading_write_end(sen);
                 break;
             default:
                 SDI_DEVICE_TRACEMSG_LOG("Invalid value_present data.");
@@ -114,10 +151,17 @@ sdi_bmc_sensor_discrete_event_handler (ipmi_sensor_t *sensor, enum ipmi_event_di
                                        int offset, int severity, int prev_severity,
                                        void *cb_data, ipmi_event_t *event)
 {
-    ipmi_entity_t   *ent = ipmi_sensor_get_entity(sensor);
+    sdi_bmc_sensor_t *sen = (sdi_bmc_sensor_t *) cb_data;
+    ipmi_entity_t   *ent = NULL;
     int             id, instance;
     char            name[SDI_MAX_NAME_LEN] = "";
 
+    if (sen != NULL) {
+        SDI_DEVICE_TRACEMSG_LOG("Event for Discrete sensor (%u.%u.%s)",
+                                sen->entity_id, sen->entity_instance, sen->name);
+        return IPMI_EVENT_HANDLED;
+    }
+    ent = ipmi_sensor_get_entity(sensor);
     id = ipmi_entity_get_entity_id(ent);
     instance = ipmi_entity_get_entity_instance(ent);
     ipmi_sensor_get_id(sensor, name, sizeof(name));
@@ -138,33 +182,33 @@ static void
 sdi_bmc_sensor_discrete_states (ipmi_sensor_t *sensor, int err,
                                        ipmi_states_t *states, void *cb_data)
 {
-    ipmi_entity_t     *ent = ipmi_sensor_get_entity(sensor);
-    uint32_t          id, instance;
-    char              name[SDI_MAX_NAME_LEN] = "";
     sdi_bmc_sensor_t  *sen = NULL;
 
-    id = ipmi_entity_get_entity_id(ent);
-    instance = ipmi_entity_get_entity_instance(ent);
-    ipmi_sensor_get_id(sensor, name, sizeof(name));
-
-    sen = sdi_bmc_db_sensor_get(id, instance, name);
+    sen = sdi_bmc_sensor_from_cb(sensor, cb_data);
     if (sen == NULL) {
-         SDI_DEVICE_TRACEMSG_LOG("Sensor discrete event handling failed (%d - %d : %s)",
-                 id, instance, name);
+        ipmi_entity_t *ent = ipmi_sensor_get_entity(sensor);
+        char          name[SDI_MAX_NAME_LEN] = "";
+
+        ipmi_sensor_get_id(sensor, name, sizeof(name));
+        SDI_DEVICE_TRACEMSG_LOG("Sensor discrete event handling failed (%d - %d : %s)",
+                 ipmi_entity_get_entity_id(ent), ipmi_entity_get_entity_instance(ent), name);
         return;
     }
 
     uint32_t bit;
-    sen->res.reading.discrete_state = 0;
-    for (bit = 0; bit < sizeof(sen->res.reading.discrete_state) * BITS_PER_BYTE ; bit++) {
+    uint32_t discrete_state = 0;
+    for (bit = 0; bit < sizeof(discrete_state) * BITS_PER_BYTE ; bit++) {
         int val, rv;
         rv = ipmi_sensor_discrete_event_readable(sensor, bit, &val);
         if ((rv != 0) || (val == 0))
             continue;
         if (ipmi_is_state_set(states, bit)) {
-            STD_BIT_SET(sen->res.reading.discrete_state, bit);
+            STD_BIT_SET(discrete_state, bit);
         }
     }
+    sdi_bmc_sensor_reading_write_begin(sen);
+    sen->res.reading.discrete_state = discrete_state;
+    sdi_bmc_sensor_reading_write_end(sen);
     return;
 }
 
@@ -228,54 +272,135 @@ static void sdi_bmc_sensor_update_handler (enum ipmi_update_e op, ipmi_entity_t
 
 }
 
-static void oem_resp_handler (ipmi_mc_t  *src, ipmi_msg_t *rsp, void *rsp_data)
+/*
+ * OEM commands are queued and sent with a bounded number in flight. A queued
+ * command which is not sent yet is shared by identical submissions, every
+ * submitter gets its own completion callback.
+ */
+#define SDI_BMC_OEM_MAX_WAITERS  (4)
+
+typedef struct sdi_bmc_oem_waiter_s {
+    sdi_bmc_oem_cmd_cb_t cb;
+    void                 *cb_data;
+} sdi_bmc_oem_waiter_t;
+
+typedef struct sdi_bmc_oem_req_s {
+    std_dll                node;
+    sdi_bmc_oem_cmd_info_t *oem_cmd; /** Command this request was built from */
+    uint8_t                req_data[SDI_BMC_OEM_DATA_LEN + 4]; /** Request bytes */
+    uint32_t               req_len; /** Number of request bytes */
+    bool                   read; /** Response data is expected */
+    uint8_t                resp_data[SDI_BMC_OEM_DATA_LEN]; /** Response bytes */
+    uint32_t               waiter_count;
+    sdi_bmc_oem_waiter_t   waiter[SDI_BMC_OEM_MAX_WAITERS];
+} sdi_bmc_oem_req_t;
+
+static std_dll_head oem_pending;
+static std_dll_head oem_inflight;
+static bool oem_queue_ready = false;
+static uint32_t oem_inflight_count = 0;
+static std_mutex_lock_create_static_init_fast(oem_queue_lock);
+
+/*
+ * Build the request bytes of an OEM command.
+ */
+static void sdi_bmc_oem_req_build (sdi_bmc_oem_cmd_info_t *oem_cmd, uint8_t *data,
+                                   sdi_bmc_oem_req_t *req)
 {
-    if (src == NULL) {
-        SDI_DEVICE_ERRMSG_LOG(" oem_call_back src is NULL");
+    req->oem_cmd = oem_cmd;
+    req->read = (data == NULL);
+    if (oem_cmd->data != 0) {
+        req->req_data[0] = oem_cmd->data;
+        req->req_len = 1;
         return;
     }
-    sdi_bmc_oem_cmd_info_t *oem_cmd = (sdi_bmc_oem_cmd_info_t *)rsp_data;
-    if (rsp->data[0] != 0) {
-        SDI_DEVICE_ERRMSG_LOG("BMC OEM Failed (%d) for netfn %d:%d - %d:%d:%d", rsp->data[0],
-            oem_cmd->netfn, oem_cmd->cmd, oem_cmd->bus_id, oem_cmd->slave_addr, oem_cmd->offset);
-        return;
-    }
-    for (uint32_t i = 0; i < oem_cmd->data_size; i++) {
-        oem_cmd->resp_data[i]  = rsp->data[i+1];
+    req->req_data[0] = oem_cmd->bus_id;
+    req->req_data[1] = oem_cmd->slave_addr;
+    req->req_data[2] = oem_cmd->data_size;
+    req->req_data[3] = oem_cmd->offset;
+    req->req_len = 4;
+    if (data != NULL) {
+        memcpy(&req->req_data[4], data, oem_cmd->data_size);
+        req->req_len += oem_cmd->data_size;
     }
-    SDI_DEVICE_TRACEMSG_LOG("OEM Resp (%d %d) netfn %d:%d - %d:%d:%d", rsp->data[0], rsp->data[1],
-            oem_cmd->netfn, oem_cmd->cmd, oem_cmd->bus_id, oem_cmd->slave_addr, oem_cmd->offset);
 }
 
 /*
- * Execute OEM specific IPMI command 
+ * Complete a request which is in flight: publish the response and call the
+ * completion callbacks. The request is freed.
  */
-t_std_error sdi_bmc_oem_cmd_execute(sdi_bmc_oem_cmd_info_t *oem_cmd, uint8_t *data)
+static void sdi_bmc_oem_req_complete (sdi_bmc_oem_req_t *req, t_std_error status)
 {
-    ipmi_msg_t msg;
+    sdi_bmc_oem_cmd_info_t *oem_cmd = req->oem_cmd;
+    sdi_bmc_oem_waiter_t   waiter[SDI_BMC_OEM_MAX_WAITERS];
+    uint32_t               waiter_count, i;
+    struct timespec        ts;
+    uint64_t               timestamp;
 
-    if (oem_cmd->data_size > SDI_BMC_OEM_DATA_LEN) {
-        return SDI_ERRCODE(EMSGSIZE);
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    timestamp = ((uint64_t)ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
+
+    if ((status == STD_ERR_OK) && (req->read) && (oem_cmd->resp_data != NULL)) {
+        memcpy(oem_cmd->resp_data, req->resp_data, oem_cmd->data_size);
     }
-    msg.netfn = oem_cmd->netfn;
-    msg.cmd = oem_cmd->cmd;
-    msg.data_len = (oem_cmd->data)? 1 : 4 + (data != NULL)? oem_cmd->data_size : 0;
-    msg.data = oem_cmd->req_data;
-    if (oem_cmd->data == 0) {
-        msg.data[0] = oem_cmd->bus_id;
-        msg.data[1] = oem_cmd->slave_addr;
-        msg.data[2] = oem_cmd->data_size;
-        msg.data[3] = oem_cmd->offset;
-    } else {
-        msg.data[0] = oem_cmd->data;
+
+    /* Waiters taken off the request can not be cancelled any more */
+    std_mutex_lock(&oem_queue_lock);
+    std_dll_remove(&oem_inflight, &req->node);
+    oem_inflight_count--;
+    waiter_count = req->waiter_count;
+    memcpy(waiter, req->waiter, sizeof(waiter));
+    req->waiter_count = 0;
+    std_mutex_unlock(&oem_queue_lock);
+
+    for (i = 0; i < waiter_count; i++) {
+        waiter[i].cb(oem_cmd, status, ((req->read) && (status == STD_ERR_OK)) ? req->resp_data : NULL,
+                     timestamp, waiter[i].cb_data);
     }
-    if (data != NULL) {
-        for(size_t i = 0; i < oem_cmd->data_size; i++) {
-            msg.data[4+i] = data[i];
+    free(req);
+}
+
+/*
+ * Response handler of an OEM command, called once per request, also when
+ * the command failed or timed out.
+ */
+static void oem_resp_handler (ipmi_mc_t  *src, ipmi_msg_t *rsp, void *rsp_data)
+{
+    sdi_bmc_oem_req_t      *req = (sdi_bmc_oem_req_t *)rsp_data;
+    sdi_bmc_oem_cmd_info_t *oem_cmd = req->oem_cmd;
+    t_std_error            status = STD_ERR_OK;
+
+    if ((src == NULL) || (rsp == NULL) || (rsp->data_len < 1)) {
+        SDI_DEVICE_ERRMSG_LOG(" oem_call_back src is NULL");
+        status = SDI_ERRCODE(EIO);
+    } else if (rsp->data[0] != 0) {
+        SDI_DEVICE_ERRMSG_LOG("BMC OEM Failed (%d) for netfn %d:%d - %d:%d:%d", rsp->data[0],
+            oem_cmd->netfn, oem_cmd->cmd, oem_cmd->bus_id, oem_cmd->slave_addr, oem_cmd->offset);
+        status = SDI_ERRCODE(EIO);
+    } else if (req->read) {
+        if ((rsp->data_len - 1) < oem_cmd->data_size) {
+            SDI_DEVICE_ERRMSG_LOG("BMC OEM short response (%d) for netfn %d:%d - %d:%d:%d",
+                rsp->data_len, oem_cmd->netfn, oem_cmd->cmd, oem_cmd->bus_id,
+                oem_cmd->slave_addr, oem_cmd->offset);
+            status = SDI_ERRCODE(EIO);
+        } else {
+            memcpy(req->resp_data, &rsp->data[1], oem_cmd->data_size);
+            SDI_DEVICE_TRACEMSG_LOG("OEM Resp (%d %d) netfn %d:%d - %d:%d:%d", rsp->data[0],
+                rsp->data[1], oem_cmd->netfn, oem_cmd->cmd, oem_cmd->bus_id,
+                oem_cmd->slave_addr, oem_cmd->offset);
         }
     }
+    sdi_bmc_oem_req_complete(req, status);
+    sdi_bmc_oem_dispatch();
+}
 
-    int        rv;
+/*
+ * Send a request to the BMC.
+ */
+static t_std_error sdi_bmc_oem_req_send (sdi_bmc_oem_req_t *req)
+{
+    int                          rv;
+    ipmi_msg_t                   msg;
     ipmi_system_interface_addr_t si;
     ipmi_mc_t                    *si_mc;
 
@@ -289,12 +414,215 @@ t_std_error sdi_bmc_oem_cmd_execute(sdi_bmc_oem_cmd_info_t *oem_cmd, uint8_t *da
         return SDI_ERRCODE(EINVAL);
     }
 
-    rv = ipmi_mc_send_command(si_mc, 0, &msg, (!data)? oem_resp_handler : NULL, (void *)oem_cmd);
+    msg.netfn = req->oem_cmd->netfn;
+    msg.cmd = req->oem_cmd->cmd;
+    msg.data_len = req->req_len;
+    msg.data = req->req_data;
+    rv = ipmi_mc_send_command(si_mc, 0, &msg, oem_resp_handler, req);
+    _ipmi_mc_put(si_mc);
 
     SDI_DEVICE_TRACEMSG_LOG("ipmi_mc_send_command Return val: %d", rv);
     return  (rv != 0)? SDI_ERRCODE(EIO) : STD_ERR_OK;
 }
 
+/*
+ * Send queued requests while there is room in flight. The queue lock is not
+ * held while sending, responses are handled on the IPMI event thread.
+ */
+static void sdi_bmc_oem_dispatch (void)
+{
+    sdi_bmc_oem_req_t *req = NULL;
+    t_std_error       rc;
+
+    while (true) {
+        std_mutex_lock(&oem_queue_lock);
+        req = (sdi_bmc_oem_req_t *)std_dll_getfirst(&oem_pending);
+        if ((req == NULL) || (oem_inflight_count >= SDI_BMC_OEM_MAX_INFLIGHT)) {
+            std_mutex_unlock(&oem_queue_lock);
+            break;
+        }
+        std_dll_remove(&oem_pending, &req->node);
+        std_dll_insertatback(&oem_inflight, &req->node);
+        oem_inflight_count++;
+        std_mutex_unlock(&oem_queue_lock);
+
+        rc = sdi_bmc_oem_req_send(req);
+        if (rc != STD_ERR_OK) {
+            sdi_bmc_oem_req_complete(req, rc);
+        }
+    }
+}
+
+/*
+ * Queue an OEM specific IPMI command.
+ */
+t_std_error sdi_bmc_oem_cmd_submit (sdi_bmc_oem_cmd_info_t *oem_cmd, uint8_t *data,
+                                    sdi_bmc_oem_cmd_cb_t cb, void *cb_data)
+{
+    sdi_bmc_oem_req_t build;
+    sdi_bmc_oem_req_t *req = NULL;
+
+    STD_ASSERT(oem_cmd != NULL);
+    if (oem_cmd->data_size > SDI_BMC_OEM_DATA_LEN) {
+        return SDI_ERRCODE(EMSGSIZE);
+    }
+    memset(&build, 0, sizeof(build));
+    sdi_bmc_oem_req_build(oem_cmd, data, &build);
+
+    std_mutex_lock(&oem_queue_lock);
+    if (!oem_queue_ready) {
+        std_dll_init(&oem_pending);
+        std_dll_init(&oem_inflight);
+        oem_queue_ready = true;
+    }
+    for (req = (sdi_bmc_oem_req_t *)std_dll_getfirst(&oem_pending); req != NULL;
+            req = (sdi_bmc_oem_req_t *)std_dll_getnext(&oem_pending, &req->node)) {
+        if ((req->oem_cmd == oem_cmd) && (req->read == build.read)
+                && (req->req_len == build.req_len)
+                && (memcmp(req->req_data, build.req_data, build.req_len) == 0)
+                && ((cb == NULL) || (req->waiter_count < SDI_BMC_OEM_MAX_WAITERS))) {
+            break;
+        }
+    }
+    if (req == NULL) {
+        req = (sdi_bmc_oem_req_t *)calloc(1, sizeof(*req));
+        if (req == NULL) {
+            std_mutex_unlock(&oem_queue_lock);
+            return SDI_ERRCODE(ENOMEM);
+        }
+        memcpy(req, &build, sizeof(*req));
+        std_dll_insertatback(&oem_pending, &req->node);
+    }
+    if (cb != NULL) {
+        req->waiter[req->waiter_count].cb = cb;
+        req->waiter[req->waiter_count].cb_data = cb_data;
+        req->waiter_count++;
+    }
+    std_mutex_unlock(&oem_queue_lock);
+
+    sdi_bmc_oem_dispatch();
+    return STD_ERR_OK;
+}
+
+/*
+ * Remove the completion callback of cb_data from the request it is waiting
+ * on. Returns false if the request completes already.
+ */
+static bool sdi_bmc_oem_cmd_cancel (void *cb_data)
+{
+    std_dll_head      *list[] = {&oem_pending, &oem_inflight};
+    sdi_bmc_oem_req_t *req = NULL;
+    uint32_t          l, i;
+    bool              found = false;
+
+    std_mutex_lock(&oem_queue_lock);
+    for (l = 0; (l < (sizeof(list) / sizeof(list[0]))) && !found; l++) {
+        for (req = (sdi_bmc_oem_req_t *)std_dll_getfirst(list[l]); (req != NULL) && !found;
+                req = (sdi_bmc_oem_req_t *)std_dll_getnext(list[l], &req->node)) {
+            for (i = 0; i < req->waiter_count; i++) {
+                if (req->waiter[i].cb_data == cb_data) {
+                    req->waiter_count--;
+                    memmove(&req->waiter[i], &req->waiter[i + 1],
+                            (req->waiter_count - i) * sizeof(req->waiter[0]));
+                    found = true;
+                    break;
+                }
+            }
+        }
+    }
+    std_mutex_unlock(&oem_queue_lock);
+    return found;
+}
+
+/*
+ * Execute OEM specific IPMI command 
+ */
+t_std_error sdi_bmc_oem_cmd_execute(sdi_bmc_oem_cmd_info_t *oem_cmd, uint8_t *data)
+{
+    return sdi_bmc_oem_cmd_submit(oem_cmd, data, NULL, NULL);
+}
+
+typedef struct sdi_bmc_oem_sync_s {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    bool            done;
+    t_std_error     status;
+    uint8_t         *resp;
+} sdi_bmc_oem_sync_t;
+
+/*
+ * Completion callback of sdi_bmc_oem_cmd_execute_sync.
+ */
+static void sdi_bmc_oem_sync_cb (sdi_bmc_oem_cmd_info_t *oem_cmd, t_std_error status,
+                                 const uint8_t *resp, uint64_t timestamp, void *cb_data)
+{
+    sdi_bmc_oem_sync_t *sync = (sdi_bmc_oem_sync_t *)cb_data;
+
+    pthread_mutex_lock(&sync->lock);
+    sync->status = status;
+    if ((resp != NULL) && (sync->resp != NULL)) {
+        memcpy(sync->resp, resp, oem_cmd->data_size);
+    }
+    sync->done = true;
+    pthread_cond_signal(&sync->cond);
+    pthread_mutex_unlock(&sync->lock);
+}
+
+/*
+ * Execute OEM specific IPMI command and wait for its response.
+ */
+t_std_error sdi_bmc_oem_cmd_execute_sync (sdi_bmc_oem_cmd_info_t *oem_cmd, uint8_t *data,
+                                          uint8_t *resp, uint32_t timeout)
+{
+    sdi_bmc_oem_sync_t sync;
+    pthread_condattr_t attr;
+    struct timespec    deadline;
+    t_std_error        rc = STD_ERR_OK;
+    int                rv = 0;
+    bool               done = false;
+
+    memset(&sync, 0, sizeof(sync));
+    sync.resp = resp;
+    pthread_mutex_init(&sync.lock, NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&sync.cond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout / 1000;
+    deadline.tv_nsec += (long)(timeout % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    rc = sdi_bmc_oem_cmd_submit(oem_cmd, data, sdi_bmc_oem_sync_cb, &sync);
+    if (rc == STD_ERR_OK) {
+        pthread_mutex_lock(&sync.lock);
+        while (!sync.done && (rv != ETIMEDOUT)) {
+            rv = pthread_cond_timedwait(&sync.cond, &sync.lock, &deadline);
+        }
+        done = sync.done;
+        pthread_mutex_unlock(&sync.lock);
+
+        if (!done && sdi_bmc_oem_cmd_cancel(&sync)) {
+            rc = SDI_ERRCODE(ETIMEDOUT);
+        } else {
+            /* Completing already, the callback is about to signal */
+            pthread_mutex_lock(&sync.lock);
+            while (!sync.done) {
+                pthread_cond_wait(&sync.cond, &sync.lock);
+            }
+            pthread_mutex_unlock(&sync.lock);
+            rc = sync.status;
+        }
+    }
+    pthread_cond_destroy(&sync.cond);
+    pthread_mutex_destroy(&sync.lock);
+    return rc;
+}
+
 static int sdi_bmc_ipmi_traverse_fru_node_tree (ipmi_fru_node_t *node,
                                                 sdi_bmc_sensor_t *srp, void *cb_data)
 {
@@ -459,7 +787,8 @@ static void  sdi_bmc_populate_sensor_for_poller()
     for(node = (sdi_bmc_oem_poller_t *)std_dll_getfirst(oem_poller_head); node != NULL;
         node = (sdi_bmc_oem_poller_t *)std_dll_getnext(oem_poller_head, (std_dll *)node)) {
         sdi_bmc_sensor_t *sensor = sdi_bmc_db_sensor_get_by_name(node->sensor);
-        if (sensor == NULL) return;
+        /* Restored from the SDR cache, may be pruned if not discovered */
+        if ((sensor == NULL) || (sensor->cached)) return;
         node->sensor_loc = &sensor->res.reading.discrete_state;
     }
     return;
@@ -523,16 +852,9 @@ static void sdi_bmc_sensor_reading_handler (ipmi_sensor_t *sensor,
                                 unsigned int raw_value, double val, ipmi_states_t *states,
                                 void *cb_data)
 {
-    ipmi_entity_t    *ent = ipmi_sensor_get_entity(sensor);
     sdi_bmc_sensor_t *sen = NULL;
-    uint32_t         id, instance;
-    char             name[SDI_MAX_NAME_LEN] = "";
-
-    id = ipmi_entity_get_entity_id(ent);
-    instance = ipmi_entity_get_entity_instance(ent);
-    ipmi_sensor_get_id(sensor, name, sizeof(name));
 
-    sen = sdi_bmc_db_sensor_get(id, instance, name);
+    sen = sdi_bmc_sensor_from_cb(sensor, cb_data);
     if (sen != NULL) {
         switch (value_present)
         {
@@ -540,11 +862,15 @@ static void sdi_bmc_sensor_reading_handler (ipmi_sensor_t *sensor,
                 SDI_DEVICE_TRACEMSG_LOG("No value present.\n");
                 break;
             case IPMI_BOTH_VALUES_PRESENT:
+                sdi_bmc_sensor_reading_write_begin(sen);
                 sen->res.reading.data = val;
                 sen->res.reading.raw_data  = raw_value;
+                sdi_bmc_sensor_reading_write_end(sen);
                 break;
             case IPMI_RAW_VALUE_PRESENT:
+                sdi_bmc_sensor_reading_write_begin(sen);
                 sen->res.reading.raw_data  = raw_value;
+                sdi_bmc_sensor_reading_write_end(sen);
                 break;
             default:
                 SDI_DEVICE_TRACEMSG_LOG("Invalid value_present data.");
@@ -590,6 +916,50 @@ static void sdi_bmc_got_thresholds (ipmi_sensor_t *sensor, int err, ipmi_thresho
     return;
 }
 
+/**
+ * sdi_bmc_sensor_schedule adds a sensor to the poll schedule, once.
+ * Threshold sensors are polled at the polling interval and discrete sensors
+ * at the discrete polling interval.
+ */
+static void sdi_bmc_sensor_schedule (ipmi_sensor_t *sensor, sdi_bmc_sensor_t *srp)
+{
+    ipmi_sensor_id_t ipmi_id = ipmi_sensor_convert_to_id(sensor);
+    bool discrete = (ipmi_sensor_get_event_reading_type(sensor)
+                        != IPMI_EVENT_READING_TYPE_THRESHOLD);
+
+    std_mutex_lock(&poll_schedule_lock);
+    if (!srp->poll_scheduled) {
+        srp->ipmi_id = ipmi_id;
+        srp->poll_discrete = discrete;
+        srp->poll_scheduled = true;
+        srp->poll_next = poll_schedule;
+        __atomic_store_n(&poll_schedule, srp, __ATOMIC_RELEASE);
+    }
+    std_mutex_unlock(&poll_schedule_lock);
+}
+
+/**
+ * sdi_bmc_sensor_read requests the reading or discrete states of a sensor,
+ * the handlers update the sensor record.
+ */
+static void sdi_bmc_sensor_read (ipmi_sensor_t *sensor, sdi_bmc_sensor_t *srp)
+{
+    int32_t rv = 0;
+
+    if (ipmi_sensor_get_event_reading_type(sensor)
+            == IPMI_EVENT_READING_TYPE_THRESHOLD) {
+        rv = ipmi_sensor_get_reading(sensor, sdi_bmc_sensor_reading_handler, srp);
+        if (rv != 0) {
+            SDI_DEVICE_ERRMSG_LOG("Error in adding sensor reading handler : 0x%x", rv);
+        }
+    } else {
+        rv = ipmi_sensor_get_states(sensor, sdi_bmc_sensor_discrete_states, srp);
+        if (rv != 0) {
+            SDI_DEVICE_ERRMSG_LOG("Error in adding discrete event handler : 0x%x\n", rv);
+        }
+    }
+}
+
 /**
  * sdi_bmc_sensor_create is to create and add the sensor in sensor database and
  * register callbacks for data reading / discrete states and threshold events
@@ -600,6 +970,7 @@ static sdi_bmc_sensor_t *sdi_bmc_sensor_create (ipmi_entity_t *entity, ipmi_sens
     sdi_bmc_sensor_t *srp = NULL;
     uint32_t         rv, id, instance;
     char             name[SDI_MAX_NAME_LEN] = "";
+    bool             discovered = false;
 
     id = ipmi_entity_get_entity_id(entity);
     instance = ipmi_entity_get_entity_instance(entity);
@@ -610,73 +981,86 @@ static sdi_bmc_sensor_t *sdi_bmc_sensor_create (ipmi_entity_t *entity, ipmi_sens
             SDI_DEVICE_TRACEMSG_LOG("Adding sensor info in DB failed (%u, %u, %s)",
                                      id, instance, name);
         } else {
-            srp->type = ipmi_sensor_get_sensor_type(sensor);
-            if (ipmi_sensor_get_event_reading_type(sensor)
-                    == IPMI_EVENT_READING_TYPE_THRESHOLD) {
-                srp->reading_type = SDI_SDR_READING_THRESHOLD;
-                rv = ipmi_sensor_get_reading(sensor, sdi_bmc_sensor_reading_handler, NULL);
-                 if (rv != 0) {
-                     SDI_DEVICE_ERRMSG_LOG("Error in adding sensor reading handler : 0x%x", rv);
-                 }
-                 rv = ipmi_sensor_add_threshold_event_handler (sensor,
-                                  sdi_bmc_sensor_threshold_event_handler, NULL);
-                 if (rv != 0) {
-                     SDI_DEVICE_ERRMSG_LOG("Error in adding sensor threshold handler : 0x%x\n", rv);
-                 }
-            } else {
-                srp->reading_type = SDI_SDR_READING_DISCRETE;
-                srp->res.reading.discrete_state = 0xff;
-                rv = ipmi_sensor_get_states(sensor, sdi_bmc_sensor_discrete_states, NULL);
-                if (rv != 0) {
-                    SDI_DEVICE_ERRMSG_LOG("Error in adding discrete event handler : 0x%x\n", rv);
-                }
-                rv = ipmi_sensor_add_discrete_event_handler(sensor, 
-                        sdi_bmc_sensor_discrete_event_handler, NULL);
-                if (rv != 0) {
-                    SDI_DEVICE_ERRMSG_LOG("Error in adding discrete event handler : 0x%x\n", rv);
-                }
+            discovered = true;
+            /* Not in the SDR cache, rewrite it */
+            __atomic_store_n(&sdr_cache_dirty, true, __ATOMIC_RELEASE);
+        }
+    } else if (srp->cached) {
+        /* Restored from the SDR cache, not set up with OpenIPMI yet */
+        discovered = true;
+    }
+    if (discovered) {
+        srp->type = ipmi_sensor_get_sensor_type(sensor);
+        if (ipmi_sensor_get_event_reading_type(sensor)
+                == IPMI_EVENT_READING_TYPE_THRESHOLD) {
+            srp->reading_type = SDI_SDR_READING_THRESHOLD;
+            rv = ipmi_sensor_get_reading(sensor, sdi_bmc_sensor_reading_handler, srp);
+             if (rv != 0) {
+                 SDI_DEVICE_ERRMSG_LOG("Error in adding sensor reading handler : 0x%x", rv);
+             }
+             rv = ipmi_sensor_add_threshold_event_handler (sensor,
+                              sdi_bmc_sensor_threshold_event_handler, srp);
+             if (rv != 0) {
+                 SDI_DEVICE_ERRMSG_LOG("Error in adding sensor threshold handler : 0x%x\n", rv);
+             }
+        } else {
+            srp->reading_type = SDI_SDR_READING_DISCRETE;
+            srp->res.reading.discrete_state = 0xff;
+            rv = ipmi_sensor_get_states(sensor, sdi_bmc_sensor_discrete_states, srp);
+            if (rv != 0) {
+                SDI_DEVICE_ERRMSG_LOG("Error in adding discrete event handler : 0x%x\n", rv);
             }
-            if (srp->ev_state == NULL) {
-                srp->ev_state = malloc(ipmi_event_state_size());
-                if (srp->ev_state == NULL) {
-                    SDI_DEVICE_ERRMSG_LOG("Memory alloc failed for handling sensor events (%s)", srp->name);
-                }
+            rv = ipmi_sensor_add_discrete_event_handler(sensor, 
+                    sdi_bmc_sensor_discrete_event_handler, srp);
+            if (rv != 0) {
+                SDI_DEVICE_ERRMSG_LOG("Error in adding discrete event handler : 0x%x\n", rv);
             }
-            if (srp->ev_state != NULL) {
-                    ipmi_event_state_init(srp->ev_state);
+        }
+        if (srp->ev_state == NULL) {
+            srp->ev_state = malloc(ipmi_event_state_size());
+            if (srp->ev_state == NULL) {
+                SDI_DEVICE_ERRMSG_LOG("Memory alloc failed for handling sensor events (%s)", srp->name);
             }
+        }
+        if (srp->ev_state != NULL) {
+                ipmi_event_state_init(srp->ev_state);
+        }
 
-            srp->state_sup = ipmi_sensor_get_event_support(sensor);
-            if ((srp->state_sup != IPMI_EVENT_SUPPORT_NONE)
-                    && (srp->state_sup != IPMI_EVENT_SUPPORT_GLOBAL_ENABLE)) {
-                rv = ipmi_sensor_get_event_enables(sensor, sdi_bmc_sensor_enable_events, srp);
-                if (rv != 0) {
-                    SDI_DEVICE_ERRMSG_LOG("Error in adding sensor get event enables : 0x%x", rv);
-                }
+        srp->state_sup = ipmi_sensor_get_event_support(sensor);
+        if ((srp->state_sup != IPMI_EVENT_SUPPORT_NONE)
+                && (srp->state_sup != IPMI_EVENT_SUPPORT_GLOBAL_ENABLE)) {
+            rv = ipmi_sensor_get_event_enables(sensor, sdi_bmc_sensor_enable_events, srp);
+            if (rv != 0) {
+                SDI_DEVICE_ERRMSG_LOG("Error in adding sensor get event enables : 0x%x", rv);
             }
+        }
+        if (srp->thresholds == NULL) {
+            srp->thresholds = malloc(ipmi_thresholds_size());
             if (srp->thresholds == NULL) {
-                srp->thresholds = malloc(ipmi_thresholds_size());
-                if (srp->thresholds == NULL) {
-                     SDI_DEVICE_ERRMSG_LOG("Memory alloc failed for handling sensor \
-                             threshold events(%s)", srp->name);
-                }
-            }
-            if (srp->thresholds != NULL) {
-                ipmi_thresholds_init(srp->thresholds);
+                 SDI_DEVICE_ERRMSG_LOG("Memory alloc failed for handling sensor \
+                         threshold events(%s)", srp->name);
             }
-            if (ipmi_sensor_get_event_reading_type(sensor)
-                    == IPMI_EVENT_READING_TYPE_THRESHOLD) {
-                srp->thresh_sup = ipmi_sensor_get_threshold_access(sensor);
-                if ((srp->thresh_sup != IPMI_THRESHOLD_ACCESS_SUPPORT_NONE)
-                        && (srp->thresh_sup != IPMI_THRESHOLD_ACCESS_SUPPORT_FIXED)) {
-                    rv = ipmi_sensor_get_thresholds(sensor, sdi_bmc_got_thresholds, srp);
-                    if (rv != 0) {
-                        SDI_DEVICE_ERRMSG_LOG("ipmi_thresholds_get returned error 0x%x"
-                                " for sensor %s\n", rv, srp->name);
-                    }
+        }
+        if (srp->thresholds != NULL) {
+            ipmi_thresholds_init(srp->thresholds);
+        }
+        if (ipmi_sensor_get_event_reading_type(sensor)
+                == IPMI_EVENT_READING_TYPE_THRESHOLD) {
+            srp->thresh_sup = ipmi_sensor_get_threshold_access(sensor);
+            if ((srp->thresh_sup != IPMI_THRESHOLD_ACCESS_SUPPORT_NONE)
+                    && (srp->thresh_sup != IPMI_THRESHOLD_ACCESS_SUPPORT_FIXED)) {
+                rv = ipmi_sensor_get_thresholds(sensor, sdi_bmc_got_thresholds, srp);
+                if (rv != 0) {
+                    SDI_DEVICE_ERRMSG_LOG("ipmi_thresholds_get returned error 0x%x"
+                            " for sensor %s\n", rv, srp->name);
                 }
             }
         }
+        /* Readers serve the record as discovered from here on */
+        __atomic_store_n(&(srp->cached), false, __ATOMIC_RELEASE);
+    }
+    if (srp != NULL) {
+        sdi_bmc_sensor_schedule(sensor, srp);
     }
     return srp;
 }
@@ -690,7 +1074,6 @@ void sdi_bmc_iterate_sensors_cb (ipmi_entity_t *entity, ipmi_sensor_t *sensor,
                                  void *cb_data)
 {
     uint32_t         id, instance;
-    int32_t          rv = 0;
     char             name[SDI_MAX_NAME_LEN] = "";
     sdi_bmc_sensor_t *srp = NULL;
 
@@ -703,18 +1086,7 @@ void sdi_bmc_iterate_sensors_cb (ipmi_entity_t *entity, ipmi_sensor_t *sensor,
         SDI_DEVICE_ERRMSG_LOG("Creating and adding sensor failed: %d - %d - %s",
                                id, instance, name);
     } else {
-        if (ipmi_sensor_get_event_reading_type(sensor)
-                == IPMI_EVENT_READING_TYPE_THRESHOLD) {
-            rv = ipmi_sensor_get_reading(sensor, sdi_bmc_sensor_reading_handler, NULL);
-            if (rv != 0) {
-                SDI_DEVICE_ERRMSG_LOG("Error in adding sensor reading handler : 0x%x", rv);
-            }
-        } else {
-            rv = ipmi_sensor_get_states(sensor, sdi_bmc_sensor_discrete_states, NULL);
-            if (rv != 0) {
-                SDI_DEVICE_ERRMSG_LOG("Error in adding discrete event handler : 0x%x\n", rv);
-            }
-        }
+        sdi_bmc_sensor_read(sensor, srp);
     }
 }
 
@@ -842,8 +1214,46 @@ static void sdi_bmc_open_domain_handler (ipmi_domain_t *domain, int32_t error,
  */
 void sdi_bmc_conection_established (ipmi_domain_t *domain, void *cb_data)
 {
+    ipmi_system_interface_addr_t si;
+    ipmi_mc_t                    *si_mc = NULL;
+    sdi_bmc_sdr_cache_key_t      key;
+    uint32_t                     pruned;
+
     SDI_DEVICE_TRACEMSG_LOG("Connection established, fully up.");
     ipmi_domain_pointer_cb(domain_id, sdi_bmc_iterate_entities, cb_data);
+
+    /* Discovery is done, sensors restored from the SDR cache which this BMC
+     * does not report are stale */
+    pruned = sdi_bmc_db_sensor_prune_cached();
+    if (pruned != 0) {
+        SDI_DEVICE_TRACEMSG_LOG("Removed %u stale sensors of the BMC SDR cache", pruned);
+        __atomic_store_n(&sdr_cache_dirty, true, __ATOMIC_RELEASE);
+    }
+
+    /* All SDRs are read now, check the SDR cache was built from this BMC
+     * firmware */
+    si.addr_type = IPMI_SYSTEM_INTERFACE_ADDR_TYPE;
+    si.channel = 0xf;
+    si.lun = 0;
+    si_mc = _ipmi_find_mc_by_addr(domain, (ipmi_addr_t *) &si, sizeof(si));
+    if (si_mc == NULL) {
+        SDI_DEVICE_ERRMSG_LOG("BMC not found, SDR cache not updated.");
+        return;
+    }
+    memset(&key, 0, sizeof(key));
+    key.manufacturer_id = ipmi_mc_manufacturer_id(si_mc);
+    key.product_id = ipmi_mc_product_id(si_mc);
+    key.device_revision = ipmi_mc_device_revision(si_mc);
+    key.major_fw_revision = ipmi_mc_major_fw_revision(si_mc);
+    key.minor_fw_revision = ipmi_mc_minor_fw_revision(si_mc);
+    ipmi_mc_aux_fw_revision(si_mc, key.aux_fw_revision);
+    _ipmi_mc_put(si_mc);
+
+    if (!sdr_cache_loaded || (memcmp(&key, &sdr_cache_key, sizeof(key)) != 0)) {
+        __atomic_store_n(&sdr_cache_dirty, true, __ATOMIC_RELEASE);
+    }
+    memcpy(&sdr_cache_key, &key, sizeof(key));
+    __atomic_store_n(&sdr_cache_key_valid, true, __ATOMIC_RELEASE);
 }
 
 typedef struct sdi_bmc_thread_param_s {
@@ -875,6 +1285,8 @@ t_std_error sdi_bmc_device_driver_thread (void *param)
     do {
         tparam.os_hnd = os_hnd;
         tparam.dev_hdl = param;
+        /* Sensors are known before the SDR repository is scanned again */
+        sdr_cache_loaded = sdi_bmc_sdr_cache_load(&sdr_cache_key);
         rv = ipmi_init(os_hnd);
         if (rv != 0) {
             SDI_DEVICE_ERRMSG_LOG("IPMI initialization failed : %s.", strerror(rv));
@@ -938,6 +1350,12 @@ void sdi_bmc_thread_cleanup (void)
         std_thread_destroy_struct(bmc_thread_entry);
     }
 
+    std_mutex_lock(&poll_schedule_lock);
+    __atomic_store_n(&poll_schedule, NULL, __ATOMIC_RELEASE);
+    std_mutex_unlock(&poll_schedule_lock);
+    __atomic_store_n(&sdr_cache_key_valid, false, __ATOMIC_RELEASE);
+    __atomic_store_n(&sdr_cache_dirty, false, __ATOMIC_RELEASE);
+
     sdi_bmc_db_entity_cleanup();
     sdi_bmc_db_sensor_cleanup();
 }
@@ -958,7 +1376,8 @@ static void sdi_bmc_oem_poller(void)
     sdi_bmc_oem_poller_t *node = NULL;
     for(node = (sdi_bmc_oem_poller_t *)std_dll_getfirst(oem_poller_head); node != NULL;
         node = (sdi_bmc_oem_poller_t *)std_dll_getnext(oem_poller_head, (std_dll *)node)) {
-        if (((*(node->sensor_loc)) & node->sensor_bit)  == node->sensor_bit) {
+        if ((node->sensor_loc != NULL)
+                && (((*(node->sensor_loc)) & node->sensor_bit)  == node->sensor_bit)) {
             for (size_t i = 0; i < node->oem_cmd_count; i++) {
                 sdi_bmc_oem_cmd_execute(&(node->oem_cmd[i]), NULL);
             }
@@ -967,19 +1386,81 @@ static void sdi_bmc_oem_poller(void)
 }
 
 /**
- * BMC poller thread init function. iterate, read and update sensor data
- * based on configured polling interval.
+ * Poll callback of a scheduled sensor.
+ */
+static void sdi_bmc_sensor_poll_cb (ipmi_sensor_t *sensor, void *cb_data)
+{
+    sdi_bmc_sensor_read(sensor, (sdi_bmc_sensor_t *) cb_data);
+}
+
+/**
+ * sdi_bmc_poll_sensors requests readings of the scheduled sensors which are
+ * due. A sensor is due when neither a poll nor an event refreshed it within
+ * its polling interval, so sensors updated by events are not read again.
+ */
+static void sdi_bmc_poll_sensors (sdi_bmc_dev_t *bmc_dev)
+{
+    struct timespec   ts;
+    uint64_t          now, last, interval;
+    uint64_t          tick = ((uint64_t) bmc_dev->polling_interval) * 1000;
+    sdi_bmc_reading_t reading;
+    sdi_bmc_sensor_t  *srp = NULL;
+    int32_t           rv = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    now = ((uint64_t)ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
+
+    /* Sensors are only added at the head, the rest of the list is stable */
+    for (srp = __atomic_load_n(&poll_schedule, __ATOMIC_ACQUIRE); srp != NULL;
+            srp = srp->poll_next) {
+        interval = ((uint64_t) (srp->poll_discrete ? bmc_dev->discrete_polling_interval
+                                                   : bmc_dev->polling_interval)) * 1000;
+        sdi_bmc_sensor_reading_get(srp, &reading);
+        last = ((reading.timestamp > srp->poll_time) ? reading.timestamp : srp->poll_time);
+        /* Half a tick of slack so that a sensor read in the previous tick is
+         * due again in this one */
+        if ((last != 0) && ((now - last) + (tick / 2) < interval)) {
+            continue;
+        }
+        srp->poll_time = now;
+        rv = ipmi_sensor_pointer_cb(srp->ipmi_id, sdi_bmc_sensor_poll_cb, srp);
+        if (rv != 0) {
+            SDI_DEVICE_TRACEMSG_LOG("Polling sensor %s failed : 0x%x", srp->name, rv);
+        }
+    }
+}
+
+/**
+ * sdi_bmc_sdr_cache_update rewrites the SDR cache when sensors were discovered
+ * which it did not have, once the connection is fully up.
+ */
+static void sdi_bmc_sdr_cache_update (void)
+{
+    if (!__atomic_load_n(&sdr_cache_key_valid, __ATOMIC_ACQUIRE)
+            || !__atomic_exchange_n(&sdr_cache_dirty, false, __ATOMIC_ACQ_REL)) {
+        return;
+    }
+    sdi_bmc_sdr_cache_save(&sdr_cache_key,
+                           __atomic_load_n(&poll_schedule, __ATOMIC_ACQUIRE));
+}
+
+/**
+ * BMC poller thread init function. Reads and updates the sensor data which
+ * is due, based on configured polling intervals. Sensors are discovered when
+ * the connection is up and by the entity and sensor update handlers, the
+ * domain is not walked again. Only sensors discovered so far are polled, so
+ * polling starts right away instead of waiting for discovery to finish.
  */
 static void sdi_bmc_poller_thread (void *param)
 {
     sdi_device_hdl_t dev_hdl = ((sdi_bmc_thread_param_t *)param)->dev_hdl;
     sdi_bmc_dev_t     *bmc_dev = (sdi_bmc_dev_t *) dev_hdl->private_data;
 
-    sleep(100);
     while (true) {
         std_usleep(MILLI_TO_MICRO((bmc_dev->polling_interval * 1000)));
-        ipmi_domain_pointer_cb(domain_id, sdi_bmc_iterate_entities, dev_hdl);
+        sdi_bmc_poll_sensors(bmc_dev);
         sdi_bmc_oem_poller();
+        sdi_bmc_sdr_cache_update();
     }
     return;
 }
@@ -381,6 +381,11 @@ static t_std_error sdi_bmc_dev_register(std_config_node_t node, void *bus_handle
     if (attr != NULL) {
         bmc_dev->polling_interval = (uint_t) strtoul(attr, NULL, 0);
     }
+    bmc_dev->discrete_polling_interval = BMC_DEFAULT_DISCRETE_POLLING;
+    attr = std_config_attr_get(node, SDI_BMC_DEV_ATR_DISCRETE_POLLING_INT);
+    if (attr != NULL) {
+        bmc_dev->discrete_polling_interval = (uint_t) strtoul(attr, NULL, 0);
+    }
 
     sdi_resource_add(SDI_RESOURCE_BMC_DEV, "bmc_dev", (void *)dev_hdl, NULL);
     bmc_dev->dev_list = sdi_bmc_populate_dev_list(node);
@@ -59,6 +59,7 @@ static t_std_error sdi_bmc_fan_speed_get(sdi_resource_hdl_t real_resource_hdl, v
     t_std_error rc = STD_ERR_OK;
     sdi_bmc_dev_resource_info_t *tmp_res = NULL;
     sdi_bmc_sensor_t *sensor = NULL;
+    sdi_bmc_reading_t reading;
 
     STD_ASSERT(resource_hdl != NULL);
     STD_ASSERT(speed != NULL);
@@ -73,7 +74,12 @@ static t_std_error sdi_bmc_fan_speed_get(sdi_resource_hdl_t real_resource_hdl, v
         }
     }
     sensor = tmp_res->data_sdr;
-    *speed = sensor->res.reading.data;
+    if (__atomic_load_n(&(sensor->cached), __ATOMIC_ACQUIRE)) {
+        /* Restored from the SDR cache and not discovered yet */
+        return SDI_DEVICE_ERRCODE(EAGAIN);
+    }
+    sdi_bmc_sensor_reading_get(sensor, &reading);
+    *speed = reading.data;
     return rc;
 }
 
@@ -92,6 +98,7 @@ static t_std_error sdi_bmc_fan_status_get(void *resource_hdl, bool *status)
     t_std_error rc = STD_ERR_OK;
     sdi_bmc_dev_resource_info_t *tmp_res = NULL;
     sdi_bmc_sensor_t *sensor = NULL;
+    sdi_bmc_reading_t reading;
 
     STD_ASSERT(resource_hdl != NULL);
     STD_ASSERT(status != NULL);
@@ -116,11 +123,15 @@ static t_std_error sdi_bmc_fan_status_get(void *resource_hdl, bool *status)
         }
     }
     sensor = tmp_res->status_sdr;
+    if (__atomic_load_n(&(sensor->cached), __ATOMIC_ACQUIRE)) {
+        /* Restored from the SDR cache and not discovered yet */
+        return SDI_DEVICE_ERRCODE(EAGAIN);
+    }
+    sdi_bmc_sensor_reading_get(sensor, &reading);
     if (tmp_res->status_bit == SDI_BMC_INVALID_BIT) {
-        *status = ( (sensor->res.reading.discrete_state == 0) ? false : true );
+        *status = ( (reading.discrete_state == 0) ? false : true );
     } else {
-        uint32_t reading = sensor->res.reading.discrete_state;
-        if (STD_BIT_TEST(reading, tmp_res->status_bit)) {
+        if (STD_BIT_TEST(reading.discrete_state, tmp_res->status_bit)) {
             *status = true;
         } else {
             *status = false;
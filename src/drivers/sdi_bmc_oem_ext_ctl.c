@@ -48,7 +48,8 @@ static t_std_error bmc_oem_ext_ctrl_set(void *resource_hdl, int *ext_ctrl, int s
     ext_ctrl_data = (sdi_bmc_oem_cmd_info_t *)chip->private_data;
     STD_ASSERT(ext_ctrl_data != NULL);
 
-    rc = sdi_bmc_oem_cmd_execute(ext_ctrl_data, (uint8_t *)ext_ctrl);
+    rc = sdi_bmc_oem_cmd_execute_sync(ext_ctrl_data, (uint8_t *)ext_ctrl, NULL,
+                                      SDI_BMC_OEM_DEFAULT_TIMEOUT);
     if(rc != STD_ERR_OK) {
         SDI_DEVICE_ERRMSG_LOG("bmc_oem_ext_ctrl : set value failed with rc=0x%x\n", rc);
         return rc;
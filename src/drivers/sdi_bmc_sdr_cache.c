@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2018 Dell EMC.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_bmc_sdr_cache.c
+ */
+
+/*
+ * Persisted copy of the sensor table discovered from the BMC SDR repository,
+ * so that the sensor database is populated at startup instead of after the
+ * SDR scan.
+ */
+
+#include "sdi_bmc_internal.h"
+#include "sdi_bmc_db.h"
+#include "sdi_device_common.h"
+#include "std_utils.h"
+#include "std_assert.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#define SDI_BMC_SDR_CACHE_MAGIC     (0x53445243) /* "SDRC" */
+#define SDI_BMC_SDR_CACHE_VERSION   (1)
+#define SDI_BMC_SDR_CACHE_MAX_COUNT (4096)
+
+/*
+ * Cache file header, followed by count records.
+ */
+typedef struct sdi_bmc_sdr_cache_hdr_s {
+    uint32_t                 magic;
+    uint32_t                 version;
+    uint32_t                 record_size; /** Size of a record, to detect layout changes */
+    uint32_t                 count; /** Number of records */
+    uint32_t                 checksum; /** Checksum of the records */
+    sdi_bmc_sdr_cache_key_t  key; /** BMC firmware the records were discovered from */
+} sdi_bmc_sdr_cache_hdr_t;
+
+/*
+ * Cache file record of a sensor.
+ */
+typedef struct sdi_bmc_sdr_cache_rec_s {
+    uint32_t  entity_id;
+    uint32_t  entity_instance;
+    uint32_t  type;
+    uint32_t  reading_type;
+    int32_t   thresh_sup;
+    char      name[IPMI_MAX_NAME_LEN];
+    double    threshold[MAX_THRESHOLDS];
+} sdi_bmc_sdr_cache_rec_t;
+
+/*
+ * FNV-1a checksum of the records.
+ */
+static uint32_t sdi_bmc_sdr_cache_checksum (const sdi_bmc_sdr_cache_rec_t *recs, uint32_t count)
+{
+    const uint8_t *byte = (const uint8_t *) recs;
+    size_t        len = count * sizeof(*recs);
+    uint32_t      sum = 2166136261u;
+
+    while (len-- > 0) {
+        sum = (sum ^ *byte++) * 16777619u;
+    }
+    return sum;
+}
+
+/*
+ * Read and validate the cache file. Returns the records, to be freed by the
+ * caller, NULL if the file is missing or not valid.
+ */
+static sdi_bmc_sdr_cache_rec_t *sdi_bmc_sdr_cache_read (sdi_bmc_sdr_cache_hdr_t *hdr)
+{
+    FILE                    *fp = NULL;
+    sdi_bmc_sdr_cache_rec_t *recs = NULL;
+
+    fp = fopen(SDI_BMC_SDR_CACHE_FILE, "rb");
+    if (fp == NULL) {
+        return NULL;
+    }
+    if ((fread(hdr, sizeof(*hdr), 1, fp) != 1)
+            || (hdr->magic != SDI_BMC_SDR_CACHE_MAGIC)
+            || (hdr->version != SDI_BMC_SDR_CACHE_VERSION)
+            || (hdr->record_size != sizeof(*recs))
+            || (hdr->count == 0) || (hdr->count > SDI_BMC_SDR_CACHE_MAX_COUNT)) {
+        fclose(fp);
+        return NULL;
+    }
+    recs = (sdi_bmc_sdr_cache_rec_t *) calloc(hdr->count, sizeof(*recs));
+    STD_ASSERT(recs != NULL);
+    if ((fread(recs, sizeof(*recs), hdr->count, fp) != hdr->count)
+            || (sdi_bmc_sdr_cache_checksum(recs, hdr->count) != hdr->checksum)) {
+        free(recs);
+        recs = NULL;
+    }
+    fclose(fp);
+    return recs;
+}
+
+/*
+ * Pre-populate the sensor database from the SDR cache file.
+ */
+bool sdi_bmc_sdr_cache_load (sdi_bmc_sdr_cache_key_t *key)
+{
+    sdi_bmc_sdr_cache_hdr_t hdr;
+    sdi_bmc_sdr_cache_rec_t *recs = NULL;
+    sdi_bmc_sensor_t        *srp = NULL;
+    uint32_t                index, restored = 0;
+
+    STD_ASSERT(key != NULL);
+    recs = sdi_bmc_sdr_cache_read(&hdr);
+    if (recs == NULL) {
+        SDI_DEVICE_TRACEMSG_LOG("No valid BMC SDR cache %s", SDI_BMC_SDR_CACHE_FILE);
+        return false;
+    }
+
+    for (index = 0; index < hdr.count; index++) {
+        sdi_bmc_sdr_cache_rec_t *rec = &recs[index];
+
+        rec->name[IPMI_MAX_NAME_LEN - 1] = '\0';
+        if ((rec->reading_type != SDI_SDR_READING_THRESHOLD)
+                && (rec->reading_type != SDI_SDR_READING_DISCRETE)) {
+            continue;
+        }
+        if (sdi_bmc_db_sensor_get(rec->entity_id, rec->entity_instance, rec->name) != NULL) {
+            continue;
+        }
+        srp = sdi_bmc_db_sensor_add(rec->entity_id, rec->entity_instance, rec->name);
+        if (srp == NULL) {
+            continue;
+        }
+        srp->type = rec->type;
+        srp->reading_type = (sdi_sdr_rd_type_t) rec->reading_type;
+        srp->thresh_sup = rec->thresh_sup;
+        memcpy(srp->threshold, rec->threshold, sizeof(srp->threshold));
+        if (srp->reading_type == SDI_SDR_READING_DISCRETE) {
+            srp->res.reading.discrete_state = 0xff;
+        }
+        srp->cached = true;
+        restored++;
+    }
+    memcpy(key, &hdr.key, sizeof(*key));
+    free(recs);
+
+    SDI_DEVICE_TRACEMSG_LOG("Restored %u sensors from BMC SDR cache", restored);
+    return true;
+}
+
+/*
+ * Write the SDR cache file, through a temporary file renamed over the
+ * previous one so that readers never see a partial file.
+ */
+void sdi_bmc_sdr_cache_save (const sdi_bmc_sdr_cache_key_t *key, sdi_bmc_sensor_t *sensors)
+{
+    sdi_bmc_sdr_cache_hdr_t hdr;
+    sdi_bmc_sdr_cache_rec_t *recs = NULL;
+    sdi_bmc_sensor_t        *srp = NULL;
+    FILE                    *fp = NULL;
+    uint32_t                count = 0;
+    const char              *tmp_file = SDI_BMC_SDR_CACHE_FILE ".tmp";
+    bool                    written = false;
+
+    STD_ASSERT(key != NULL);
+    for (srp = sensors; srp != NULL; srp = srp->poll_next) {
+        count++;
+    }
+    if ((count == 0) || (count > SDI_BMC_SDR_CACHE_MAX_COUNT)) {
+        return;
+    }
+
+    recs = (sdi_bmc_sdr_cache_rec_t *) calloc(count, sizeof(*recs));
+    STD_ASSERT(recs != NULL);
+    count = 0;
+    for (srp = sensors; srp != NULL; srp = srp->poll_next) {
+        if ((srp->cached)
+                || ((srp->reading_type != SDI_SDR_READING_THRESHOLD)
+                    && (srp->reading_type != SDI_SDR_READING_DISCRETE))) {
+            continue;
+        }
+        recs[count].entity_id = srp->entity_id;
+        recs[count].entity_instance = srp->entity_instance;
+        recs[count].type = srp->type;
+        recs[count].reading_type = srp->reading_type;
+        recs[count].thresh_sup = srp->thresh_sup;
+        safestrncpy(recs[count].name, srp->name, sizeof(recs[count].name));
+        memcpy(recs[count].threshold, srp->threshold, sizeof(recs[count].threshold));
+        count++;
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = SDI_BMC_SDR_CACHE_MAGIC;
+    hdr.version = SDI_BMC_SDR_CACHE_VERSION;
+    hdr.record_size = sizeof(*recs);
+    hdr.count = count;
+    hdr.checksum = sdi_bmc_sdr_cache_checksum(recs, count);
+    memcpy(&hdr.key, key, sizeof(hdr.key));
+
+    /* Parent directories may not exist on first boot */
+    mkdir("/var/cache/opx", 0755);
+    mkdir(SDI_BMC_SDR_CACHE_DIR, 0755);
+
+    fp = fopen(tmp_file, "wb");
+    if (fp != NULL) {
+        written = ((count > 0)
+                   && (fwrite(&hdr, sizeof(hdr), 1, fp) == 1)
+                   && (fwrite(recs, sizeof(*recs), count, fp) == count));
+        if (fclose(fp) != 0) {
+            written = false;
+        }
+        if (written && (rename(tmp_file, SDI_BMC_SDR_CACHE_FILE) != 0)) {
+            written = false;
+        }
+        if (!written) {
+            remove(tmp_file);
+        }
+    }
+    if (!written) {
+        SDI_DEVICE_ERRMSG_LOG("Writing BMC SDR cache %s failed", SDI_BMC_SDR_CACHE_FILE);
+    }
+    free(recs);
+}
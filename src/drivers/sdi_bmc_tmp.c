@@ -57,6 +57,7 @@ static t_std_error sdi_bmc_tmp_temperature_get(void *resource_hdl, int *temperat
     t_std_error rc = STD_ERR_OK;
     sdi_bmc_dev_resource_info_t *tmp_res = NULL;
     sdi_bmc_sensor_t *sensor = NULL;
+    sdi_bmc_reading_t reading;
 
     STD_ASSERT(resource_hdl != NULL);
     STD_ASSERT(temperature != NULL);
@@ -71,7 +72,12 @@ static t_std_error sdi_bmc_tmp_temperature_get(void *resource_hdl, int *temperat
         }
     }
     sensor = tmp_res->data_sdr;
-    *temperature = sensor->res.reading.data;
+    if (__atomic_load_n(&(sensor->cached), __ATOMIC_ACQUIRE)) {
+        /* Restored from the SDR cache and not discovered yet */
+        return SDI_DEVICE_ERRCODE(EAGAIN);
+    }
+    sdi_bmc_sensor_reading_get(sensor, &reading);
+    *temperature = reading.data;
     return rc;
 }
 
@@ -55,8 +55,15 @@
  *
  * Refer to below xml format for exact configuration format:
  *
+ * - When shadow_ttl is configured, the cpld driver keeps a shadow of all
+ * registers from start_addr to end_addr. Pin and pin group reads within the
+ * window are served from the shadow, so pins of neighbouring ports sharing a
+ * register cost one bus transfer. Writes go through to the cpld and update
+ * the shadow. Registers with self clearing or clear on read bits must not be
+ * behind a cpld with shadow_ttl.
+ *
  * xml file format:
- * <cpld instance=0 alias=master addr="0x64">
+ * <cpld instance=0 alias=master addr="0x64" shadow_ttl="20">
  *        <sdi_cpld_pin instance="2" addr="0x7" offset="0x1" bus_name="master_led"
  *            direction="out" level="1" polarity="normal">
  *      </sdi_cpld_pin>
@@ -73,6 +80,9 @@
  *        <!- end_offset is cpld pin group's bit offset within end_addr --!>
  *
  *      <!-- width of cpld register is optional if its 1byte --!>
+ *      <!-- shadow_ttl is optional, when set (in msec) registers read within
+ *           that window are served from a shadow of all cpld registers,
+ *           refreshed with one block read --!>
  *        <!-- level is optional for input pin --!>
  * </cpld>
  *****************************************************************************/
@@ -90,10 +100,13 @@
 #include "std_mutex_lock.h"
 #include "std_utils.h"
 #include "sdi_cpld_attr.h"
+#include "sdi_bus_api.h"
+#include "sdi_io_port_api.h"
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
 
 /* cpld device driver registration function */
 static t_std_error sdi_cpld_register(std_config_node_t node, void *bus_handle,
@@ -168,6 +181,20 @@ static t_std_error sdi_cpld_register(std_config_node_t node, void *bus_handle,
         STD_ASSERT(cpld_dev_hdl->width == SDI_CPLD_DEFAULT_REGISTER_WIDTH);
     }
 
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_CPLD_SHADOW_TTL);
+    if (node_attr != NULL) {
+        cpld_dev_hdl->shadow_ttl = (uint_t)strtoul(node_attr, NULL, 0);
+    }
+    std_mutex_lock_init_non_recursive(&(cpld_dev_hdl->shadow_lock));
+    cpld_dev_hdl->reg_owner = (const void **)calloc(
+        (cpld_dev_hdl->end_addr - cpld_dev_hdl->start_addr) + 1, sizeof(void *));
+    STD_ASSERT(cpld_dev_hdl->reg_owner != NULL);
+    if (cpld_dev_hdl->shadow_ttl != 0) {
+        cpld_dev_hdl->shadow = (uint8_t *)calloc(
+            (cpld_dev_hdl->end_addr - cpld_dev_hdl->start_addr) + 1, 1);
+        STD_ASSERT(cpld_dev_hdl->shadow != NULL);
+    }
+
     dev_hdl->callbacks = &sdi_cpld_entry;
 
     dev_hdl->private_data = cpld_dev_hdl;
@@ -230,7 +257,245 @@ static t_std_error sdi_cpld_register(std_config_node_t node, void *bus_handle,
  * param[in] STD_ERR_OK on success
  */
 static t_std_error sdi_cpld_init(sdi_device_hdl_t device_hdl) {
+    sdi_cpld_dev_hdl_t cpld_dev_hdl = (sdi_cpld_dev_hdl_t) device_hdl->private_data;
+    sdi_bus_hdl_t io_bus_hdl = (sdi_bus_hdl_t) device_hdl->bus_hdl;
+    t_std_error error = STD_ERR_OK;
+
+    /* Shadow refresh reads every register, not only those of pins */
+    if ((cpld_dev_hdl->shadow != NULL) && (io_bus_hdl->bus_type == SDI_IO_BUS)) {
+        error = ioperm(cpld_dev_hdl->start_addr,
+                       (cpld_dev_hdl->end_addr - cpld_dev_hdl->start_addr) + 1,
+                       IO_PORT_PERM_ENABLE);
+        if (error != STD_ERR_OK) {
+            SDI_ERRMSG_LOG("%s:%d IO Permission %s failed for %x with error %d, "
+                           "disabling register shadow\n", __FUNCTION__, __LINE__,
+                           io_bus_hdl->bus_name, cpld_dev_hdl->start_addr, error);
+            free(cpld_dev_hdl->shadow);
+            cpld_dev_hdl->shadow = NULL;
+        }
+    }
+
     sdi_init_bus_for_each_bus_in_list(&device_hdl->bus_list,
                                       sdi_bus_init, NULL);
     return STD_ERR_OK;
 }
+
+/*
+ * Monotonic time in msec, used to age the register shadow
+ */
+static uint64_t sdi_cpld_time_msec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
+}
+
+/*
+ * Read all cpld registers into the shadow. Called with shadow_lock held.
+ * param[in] dev_hdl - cpld device handle
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_cpld_shadow_fill(sdi_device_hdl_t dev_hdl)
+{
+    sdi_cpld_dev_hdl_t cpld_dev_hdl = (sdi_cpld_dev_hdl_t) dev_hdl->private_data;
+    t_std_error error = STD_ERR_OK;
+
+    error = sdi_bus_read_block((sdi_bus_hdl_t) dev_hdl->bus_hdl, dev_hdl->addr,
+                               cpld_dev_hdl->start_addr, cpld_dev_hdl->shadow,
+                               (cpld_dev_hdl->end_addr - cpld_dev_hdl->start_addr) + 1);
+    if (error != STD_ERR_OK) {
+        cpld_dev_hdl->shadow_time = 0;
+        return error;
+    }
+    cpld_dev_hdl->shadow_time = sdi_cpld_time_msec();
+    return error;
+}
+
+/*
+ * Check whether the shadow can serve reads. Called with shadow_lock held.
+ * param[in] cpld_dev_hdl - cpld device
+ * return true when the shadow was read within shadow_ttl
+ */
+static bool sdi_cpld_shadow_fresh(sdi_cpld_dev_hdl_t cpld_dev_hdl)
+{
+    return ((cpld_dev_hdl->shadow != NULL) && (cpld_dev_hdl->shadow_time != 0)
+            && ((sdi_cpld_time_msec() - cpld_dev_hdl->shadow_time)
+                < cpld_dev_hdl->shadow_ttl));
+}
+
+/*
+ * Read a cpld register. Called with shadow_lock held.
+ * param[in] dev_hdl - cpld device handle
+ * param[in] offset - register address
+ * param[out] buffer - register value
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_cpld_reg_get(sdi_device_hdl_t dev_hdl, uint_t offset,
+                                    uint8_t *buffer)
+{
+    sdi_cpld_dev_hdl_t cpld_dev_hdl = (sdi_cpld_dev_hdl_t) dev_hdl->private_data;
+    t_std_error error = STD_ERR_OK;
+
+    if (cpld_dev_hdl->shadow == NULL) {
+        return sdi_bus_read_byte((sdi_bus_hdl_t) dev_hdl->bus_hdl, dev_hdl->addr,
+                                 offset, buffer);
+    }
+
+    if (!sdi_cpld_shadow_fresh(cpld_dev_hdl)) {
+        error = sdi_cpld_shadow_fill(dev_hdl);
+        if (error != STD_ERR_OK) {
+            return error;
+        }
+    }
+    *buffer = cpld_dev_hdl->shadow[offset - cpld_dev_hdl->start_addr];
+    return error;
+}
+
+/*
+ * Read every register of the cpld into its shadow with one block transfer
+ * param[in] dev_hdl - cpld device handle
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRCODE(ENOTSUP) when the shadow
+ * is disabled, SDI_DEVICE_ERRNO on failure
+ */
+t_std_error sdi_cpld_refresh(sdi_device_hdl_t dev_hdl)
+{
+    sdi_cpld_dev_hdl_t cpld_dev_hdl = NULL;
+    t_std_error error = STD_ERR_OK;
+
+    STD_ASSERT(dev_hdl != NULL);
+    cpld_dev_hdl = (sdi_cpld_dev_hdl_t) dev_hdl->private_data;
+
+    if (cpld_dev_hdl->shadow == NULL) {
+        return SDI_DEVICE_ERRCODE(ENOTSUP);
+    }
+
+    std_mutex_lock(&(cpld_dev_hdl->shadow_lock));
+    error = sdi_cpld_shadow_fill(dev_hdl);
+    std_mutex_unlock(&(cpld_dev_hdl->shadow_lock));
+
+    return error;
+}
+
+/*
+ * Read a cpld register, from the shadow when it is fresh
+ * param[in] dev_hdl - cpld device handle
+ * param[in] offset - register address
+ * param[out] buffer - register value
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+t_std_error sdi_cpld_reg_read(sdi_device_hdl_t dev_hdl, uint_t offset,
+                              uint8_t *buffer)
+{
+    sdi_cpld_dev_hdl_t cpld_dev_hdl = (sdi_cpld_dev_hdl_t) dev_hdl->private_data;
+    t_std_error error = STD_ERR_OK;
+
+    std_mutex_lock(&(cpld_dev_hdl->shadow_lock));
+    error = sdi_cpld_reg_get(dev_hdl, offset, buffer);
+    std_mutex_unlock(&(cpld_dev_hdl->shadow_lock));
+
+    return error;
+}
+
+/*
+ * Write a cpld register as a whole. The register may clear other registers
+ * on write, e.g. an interrupt acknowledge, so the shadow is read again on
+ * next use.
+ * param[in] dev_hdl - cpld device handle
+ * param[in] offset - register address
+ * param[in] value - value to be written
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+t_std_error sdi_cpld_reg_write(sdi_device_hdl_t dev_hdl, uint_t offset, uint8_t value)
+{
+    sdi_cpld_dev_hdl_t cpld_dev_hdl = (sdi_cpld_dev_hdl_t) dev_hdl->private_data;
+    t_std_error error = STD_ERR_OK;
+
+    std_mutex_lock(&(cpld_dev_hdl->shadow_lock));
+    error = sdi_bus_write_byte((sdi_bus_hdl_t) dev_hdl->bus_hdl, dev_hdl->addr,
+                               offset, value);
+    cpld_dev_hdl->shadow_time = 0;
+    if ((offset >= cpld_dev_hdl->start_addr) && (offset <= cpld_dev_hdl->end_addr)) {
+        cpld_dev_hdl->reg_owner[offset - cpld_dev_hdl->start_addr] = NULL;
+    }
+    std_mutex_unlock(&(cpld_dev_hdl->shadow_lock));
+
+    return error;
+}
+
+/*
+ * Read-modify-write a cpld register: register = (register & keep_mask) | bits
+ * Pins sharing the register are serialized by shadow_lock.
+ * param[in] dev_hdl - cpld device handle
+ * param[in] offset - register address
+ * param[in] keep_mask - bits of the register which are preserved
+ * param[in] bits - bits to be set in the register
+ * param[in] owner - pin or pin group writing the register
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+t_std_error sdi_cpld_reg_update(sdi_device_hdl_t dev_hdl, uint_t offset,
+                                uint8_t keep_mask, uint8_t bits, const void *owner)
+{
+    sdi_cpld_dev_hdl_t cpld_dev_hdl = (sdi_cpld_dev_hdl_t) dev_hdl->private_data;
+    t_std_error error = STD_ERR_OK;
+    uint8_t buffer = 0;
+
+    std_mutex_lock(&(cpld_dev_hdl->shadow_lock));
+    do {
+        error = sdi_cpld_reg_get(dev_hdl, offset, &buffer);
+        if (error != STD_ERR_OK) {
+            break;
+        }
+        buffer = (buffer & keep_mask) | bits;
+        error = sdi_bus_write_byte((sdi_bus_hdl_t) dev_hdl->bus_hdl, dev_hdl->addr,
+                                   offset, buffer);
+        if (error != STD_ERR_OK) {
+            /* Register content is unknown now */
+            cpld_dev_hdl->shadow_time = 0;
+            break;
+        }
+        if (cpld_dev_hdl->shadow != NULL) {
+            cpld_dev_hdl->shadow[offset - cpld_dev_hdl->start_addr] = buffer;
+        }
+    } while (0);
+    if ((offset >= cpld_dev_hdl->start_addr) && (offset <= cpld_dev_hdl->end_addr)) {
+        cpld_dev_hdl->reg_owner[offset - cpld_dev_hdl->start_addr] =
+            (error == STD_ERR_OK) ? owner : NULL;
+    }
+    std_mutex_unlock(&(cpld_dev_hdl->shadow_lock));
+
+    return error;
+}
+
+/*
+ * Check whether a range of cpld registers was last written by the same owner.
+ * Pins and pin groups sharing a register, or aliasing the same bits, take the
+ * ownership from each other when they write it.
+ * param[in] dev_hdl - cpld device handle
+ * param[in] start_addr - first register of the range
+ * param[in] end_addr - last register of the range, may be below start_addr
+ * param[in] owner - pin or pin group
+ * return true when owner was the last to write every register of the range
+ */
+bool sdi_cpld_reg_owned(sdi_device_hdl_t dev_hdl, uint_t start_addr, uint_t end_addr,
+                        const void *owner)
+{
+    sdi_cpld_dev_hdl_t cpld_dev_hdl = (sdi_cpld_dev_hdl_t) dev_hdl->private_data;
+    uint_t first = (start_addr < end_addr) ? start_addr : end_addr;
+    uint_t last = (start_addr < end_addr) ? end_addr : start_addr;
+    uint_t offset = 0;
+    bool owned = true;
+
+    if ((first < cpld_dev_hdl->start_addr) || (last > cpld_dev_hdl->end_addr)) {
+        /* Writes outside of the cpld range are not tracked */
+        return false;
+    }
+
+    std_mutex_lock(&(cpld_dev_hdl->shadow_lock));
+    for (offset = first; (offset <= last) && owned; offset++) {
+        owned = (cpld_dev_hdl->reg_owner[offset - cpld_dev_hdl->start_addr] == owner);
+    }
+    std_mutex_unlock(&(cpld_dev_hdl->shadow_lock));
+
+    return owned;
+}
@@ -53,7 +53,7 @@
 /*
  * Read the cpld pin level.
  * sequence of operation:
- * 1. Read value of cpld register using bus read operation.
+ * 1. Read value of cpld register, from the cpld shadow when fresh.
  * 2. Mask the value with bit corresponding to cpld pin
  * param[in] pin_hdl cpld pin handle
  * param[out] value cpld pin level is read into value
@@ -65,7 +65,6 @@ static t_std_error sdi_cpld_pin_read_level (sdi_pin_bus_hdl_t pin_hdl,
 {
     sdi_cpld_pin_t *cpld_pin = (sdi_cpld_pin_t *) pin_hdl;
     sdi_device_hdl_t dev_hdl = cpld_pin->cpld_hdl;
-    sdi_bus_hdl_t bus_hdl = (sdi_bus_hdl_t) dev_hdl->bus_hdl;
     uint8_t buffer = 0;
     t_std_error error = STD_ERR_OK;
     sdi_cpld_dev_hdl_t cpld_dev_hdl = (sdi_cpld_dev_hdl_t) dev_hdl->private_data;
@@ -74,8 +73,7 @@ static t_std_error sdi_cpld_pin_read_level (sdi_pin_bus_hdl_t pin_hdl,
 
 
     /* Read the cpld register on which this cpld pin is just a bit */
-    error = sdi_bus_read_byte(bus_hdl, dev_hdl->addr,
-                             cpld_pin->addr, &buffer);
+    error = sdi_cpld_reg_read(dev_hdl, cpld_pin->addr, &buffer);
     if (error != STD_ERR_OK) {
         return error;
     }
@@ -103,10 +101,11 @@ static t_std_error sdi_cpld_pin_read_level (sdi_pin_bus_hdl_t pin_hdl,
 /*
  * Update the cpld pin level with given value
  * sequence of operation:
- * 1. Read cpld register using bus read operation.
+ * 1. Read cpld register, from the cpld shadow when fresh.
  * 2. Mask the register value with bit corresponding to cpld pin and set bit with
  * given input level
  * 3. Write new value onto cpld register
+ * The read-modify-write is serialized with other pins of the cpld.
  * param[in] pin_hdl cpld pin handle
  * param[in] value cpld pin level to be written
  * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure,
@@ -117,9 +116,8 @@ static t_std_error sdi_cpld_pin_write_level(sdi_pin_bus_hdl_t pin_hdl,
 {
     sdi_cpld_pin_t *cpld_pin = (sdi_cpld_pin_t *) pin_hdl;
     sdi_device_hdl_t dev_hdl = cpld_pin->cpld_hdl;
-    sdi_bus_hdl_t bus_hdl = (sdi_bus_hdl_t) dev_hdl->bus_hdl;
-    uint8_t buffer = 0;
-    t_std_error error = STD_ERR_OK;
+    uint8_t pin_bit = 0;
+    bool set = false;
     sdi_cpld_dev_hdl_t cpld_dev_hdl = (sdi_cpld_dev_hdl_t) dev_hdl->private_data;
 
     STD_ASSERT(cpld_dev_hdl->width == SDI_CPLD_DEFAULT_REGISTER_WIDTH);
@@ -130,41 +128,18 @@ static t_std_error sdi_cpld_pin_write_level(sdi_pin_bus_hdl_t pin_hdl,
         return SDI_DEVICE_ERRCODE(ENOTSUP);
     }
 
-    /* Read the cpld register (on which this cpld pin is just a bit)
-     * value to buffer */
-    error = sdi_bus_read_byte(bus_hdl, dev_hdl->addr,
-                             cpld_pin->addr, &buffer);
-    if (error != STD_ERR_OK) {
-        return error;
-    }
+    STD_BIT_SET(pin_bit, (cpld_pin->offset));
 
-    if (pin_hdl->default_polarity == SDI_PIN_POLARITY_NORMAL) {
-        /* When pin's polarity is normal,
-        * - if pin level to be set is high, set the cpld pin offset in cpld
-        * register (buffer)
-        * - if the pin level to be set is low, clear the cpld pin offset in cpld
-        * register (buffer)
-        */
-        (value == SDI_PIN_LEVEL_HIGH) ?
-        STD_BIT_SET(buffer, (cpld_pin->offset)) :
-            STD_BIT_CLEAR(buffer, (cpld_pin->offset));
-    } else {
-        /* When pin's polarity is inverted,
-        * - if pin level to be set is high, clear the cpld pin offset in cpld
-        * register (buffer)
-        * - if the pin level to be set is low, set the cpld pin offset in cpld
-        * register (buffer)
-        */
-        (value == SDI_PIN_LEVEL_HIGH) ?
-        STD_BIT_CLEAR(buffer, (cpld_pin->offset)) :
-            STD_BIT_SET(buffer, (cpld_pin->offset));
-    }
+    /* When pin's polarity is normal, the cpld pin offset is set for high level
+     * and cleared for low level. When pin's polarity is inverted, it is
+     * cleared for high level and set for low level */
+    set = ((value == SDI_PIN_LEVEL_HIGH) ==
+           (pin_hdl->default_polarity == SDI_PIN_POLARITY_NORMAL));
 
-    /* Write the modified value of cpld regiter to effect the pin level
-     * change */
-    error = sdi_bus_write_byte(bus_hdl, dev_hdl->addr,
-                              cpld_pin->addr, buffer);
-    return error;
+    /* Update the cpld register (on which this cpld pin is just a bit)
+     * to effect the pin level change, other bits are preserved */
+    return sdi_cpld_reg_update(dev_hdl, cpld_pin->addr, (uint8_t) ~pin_bit,
+                               (set ? pin_bit : 0), cpld_pin);
 }
 
 /*
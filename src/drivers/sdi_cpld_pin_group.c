@@ -31,6 +31,13 @@
  *        <!- start_offset is cpld pin group's bit offset within start_addr --!>
  *        <!-- end_addr is cpld pin group's register's end address --!>
  *        <!- end_offset is cpld pin group's bit offset within end_addr --!>
+ *        <!-- optional event_pin is the name of the pin (typically a gpio
+ *             wired to the cpld interrupt output) whose edges signal a level
+ *             change of this pin group --!>
+ *        <!-- optional event_clear_addr is the cpld register acknowledging
+ *             the interrupt, written with event_clear_value (default 0xff)
+ *             once the event is consumed. Required when the cpld latches
+ *             the interrupt, else the event pin never signals again --!>
  *****************************************************************************/
 
 #include "sdi_cpld.h"
@@ -47,6 +54,7 @@
 #include "std_utils.h"
 #include "sdi_cpld_attr.h"
 #include "sdi_io_port_api.h"
+#include "sdi_pin_bus_api.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -90,7 +98,6 @@ static t_std_error sdi_cpld_pin_group_read_level (sdi_pin_group_bus_hdl_t pin_gr
 {
     sdi_cpld_pin_group_t *cpld_pin_group = (sdi_cpld_pin_group_t *) pin_group_hdl;
     sdi_device_hdl_t dev_hdl = cpld_pin_group->cpld_hdl;
-    sdi_bus_hdl_t bus_hdl = (sdi_bus_hdl_t) dev_hdl->bus_hdl;
     uint8_t buffer = 0;
     uint8_t data = 0;
     t_std_error error = STD_ERR_OK;
@@ -142,8 +149,9 @@ static t_std_error sdi_cpld_pin_group_read_level (sdi_pin_group_bus_hdl_t pin_gr
 
     /* Loop: until we read all cpld registers (indicated by length) in pin group */
     for (reg_count = 1; reg_count <= cpld_pin_group->length; reg_count++) {
-        /* Read the cpld register (that's part of pin group) value to buffer */
-        error = sdi_bus_read_byte(bus_hdl, dev_hdl->addr, offset, &buffer);
+        /* Read the cpld register (that's part of pin group) value to buffer,
+         * from the cpld shadow when fresh */
+        error = sdi_cpld_reg_read(dev_hdl, offset, &buffer);
         if (error != STD_ERR_OK) {
             return error;
         }
@@ -264,9 +272,9 @@ static t_std_error sdi_cpld_pin_group_write_level (sdi_pin_group_bus_hdl_t pin_g
 {
     sdi_cpld_pin_group_t *cpld_pin_group = (sdi_cpld_pin_group_t *) pin_group_hdl;
     sdi_device_hdl_t dev_hdl = cpld_pin_group->cpld_hdl;
-    sdi_bus_hdl_t bus_hdl = (sdi_bus_hdl_t) dev_hdl->bus_hdl;
-    uint8_t buffer = 0;
     uint8_t level = 0;
+    uint64_t sub_start = 0;
+    uint64_t sub_end = 0;
     uint_t data = value;
     t_std_error error = STD_ERR_OK;
     uint_t offset = 0;
@@ -297,10 +305,10 @@ static t_std_error sdi_cpld_pin_group_write_level (sdi_pin_group_bus_hdl_t pin_g
      *  ---------------------------------------------------------
      * Main Logic:
      * Set data = value (to be written to cpld pin group)
-     * Read a byte from start_addr of cpld using bus read api and store it in
+     * Read a byte from start_addr of cpld (from the shadow when fresh) and store it in
      * buffer. Mask last byte of data and bit-wise & with buffer, write it to
      * cpld start_addr.
-     * Read next byte from cpld using bus read api and store it in buffer. Shift
+     * Read next byte from cpld (from the shadow when fresh) into buffer. Shift
      * data by a byte, mask last byte of data and bit-wise & with buffer, write
      * it to cpld next address.
      * Repeat above until all bytes are updated.
@@ -319,11 +327,6 @@ static t_std_error sdi_cpld_pin_group_write_level (sdi_pin_group_bus_hdl_t pin_g
 
     /* Loop: until all cpld registers of pin group are written */
     for (reg_count = cpld_pin_group->length; reg_count != 0; reg_count--) {
-        /* Read the cpld register at offset into buffer. */
-        error = sdi_bus_read_byte(bus_hdl, dev_hdl->addr, offset, &buffer);
-        if (error != STD_ERR_OK) {
-            return error;
-        }
         /* Fetch the value to be written to the cpld register 'offset' */
         level = data & 0xFF;
         /* case a) For first and only cpld register (start_addr: byte1)
@@ -335,7 +338,8 @@ static t_std_error sdi_cpld_pin_group_write_level (sdi_pin_group_bus_hdl_t pin_g
             if (pin_group_hdl->default_polarity == SDI_PIN_POLARITY_INVERTED) {
                 SDI_CPLD_TOGGLE_AND_MASK(uint8_t, level, start_offset, end_offset);
             }
-            buffer = (uint8_t) sdi_cpld_bit_set_sub_bitstream((uint64_t)buffer, (uint64_t)level, start_offset, (end_offset + 1));
+            sub_start = start_offset;
+            sub_end = end_offset + 1;
         } else {
             if (reg_count == cpld_pin_group->length) {
                 /* case b) For first cpld register (start_addr: byte1)
@@ -346,7 +350,8 @@ static t_std_error sdi_cpld_pin_group_write_level (sdi_pin_group_bus_hdl_t pin_g
                 if (pin_group_hdl->default_polarity == SDI_PIN_POLARITY_INVERTED) {
                     SDI_CPLD_TOGGLE_AND_MASK(uint8_t, level, start_offset, (BITS_PER_BYTE - 1));
                 }
-                buffer = (uint8_t) sdi_cpld_bit_set_sub_bitstream((uint64_t)buffer, (uint64_t)level, start_offset, BITS_PER_BYTE);
+                sub_start = start_offset;
+                sub_end = BITS_PER_BYTE;
             }
             else if (reg_count == 1) {
                 /* case c) For last cpld register (end_addr: byte4)
@@ -357,8 +362,8 @@ static t_std_error sdi_cpld_pin_group_write_level (sdi_pin_group_bus_hdl_t pin_g
                 if (pin_group_hdl->default_polarity == SDI_PIN_POLARITY_INVERTED) {
                     SDI_CPLD_TOGGLE_AND_MASK(uint8_t, level, 0, end_offset);
                 }
-                buffer = (uint8_t)
-                sdi_cpld_bit_set_sub_bitstream((uint64_t)buffer, (uint64_t)level, 0, (end_offset + 1));
+                sub_start = 0;
+                sub_end = end_offset + 1;
             } else  {
                 /* case d) For and !first !last cpld register (say byte2)
                  * in pin group, mask second byte of data (level) and bit-wise & with buffer
@@ -367,11 +372,17 @@ static t_std_error sdi_cpld_pin_group_write_level (sdi_pin_group_bus_hdl_t pin_g
                 if (pin_group_hdl->default_polarity == SDI_PIN_POLARITY_INVERTED) {
                     level = ~level;
                 }
-                buffer = (uint8_t) sdi_cpld_bit_set_sub_bitstream((uint64_t)buffer, (uint64_t)level, 0, BITS_PER_BYTE);
+                sub_start = 0;
+                sub_end = BITS_PER_BYTE;
             }
         }
-        /* Write modified value of buffer to cpld offset */
-        error = sdi_bus_write_byte(bus_hdl, dev_hdl->addr, offset, buffer);
+        /* Set level between sub_start and sub_end of the cpld register at
+         * offset, preserving its other bits */
+        error = sdi_cpld_reg_update(dev_hdl, offset,
+                    (uint8_t) sdi_cpld_bit_set_sub_bitstream(0xFF, 0, sub_start, sub_end),
+                    (uint8_t) sdi_cpld_bit_set_sub_bitstream(0, (uint64_t)level,
+                                                             sub_start, sub_end),
+                    pin_group_hdl);
         if (error != STD_ERR_OK) {
             return error;
         }
@@ -441,6 +452,100 @@ static inline t_std_error sdi_cpld_pin_group_get_polarity (sdi_pin_group_bus_hdl
     return STD_ERR_OK;
 }
 
+/*
+ * Get the event pin of the cpld pin group
+ * param[in] cpld_pin_group cpld pin group
+ * return event pin handle, NULL when the pin group has no event pin
+ */
+static sdi_pin_bus_hdl_t sdi_cpld_pin_group_event_pin_get (sdi_cpld_pin_group_t *cpld_pin_group)
+{
+    if ((cpld_pin_group->event_pin_hdl == NULL)
+        && (cpld_pin_group->event_pin[0] != '\0')) {
+        cpld_pin_group->event_pin_hdl =
+            sdi_get_pin_bus_handle_by_name(cpld_pin_group->event_pin);
+    }
+    return cpld_pin_group->event_pin_hdl;
+}
+
+/*
+ * Get file descriptor signalling level changes of the cpld pin group. Level
+ * changes are signalled by the cpld interrupt pin.
+ * param[in] pin_group_hdl cpld pin group handle
+ * param[out] fd pollable file descriptor of the event pin
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRCODE(ENOTSUP) without event pin
+ */
+static t_std_error sdi_cpld_pin_group_event_fd_get (sdi_pin_group_bus_hdl_t pin_group_hdl,
+                                                    int *fd)
+{
+    sdi_pin_bus_hdl_t event_pin =
+        sdi_cpld_pin_group_event_pin_get((sdi_cpld_pin_group_t *) pin_group_hdl);
+
+    if (event_pin == NULL) {
+        return SDI_DEVICE_ERRCODE(ENOTSUP);
+    }
+    return sdi_pin_event_fd_get(event_pin, fd);
+}
+
+/*
+ * Consume pending level change events of the cpld pin group
+ * param[in] pin_group_hdl cpld pin group handle
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRCODE(ENOTSUP) without event pin
+ */
+static t_std_error sdi_cpld_pin_group_event_clear (sdi_pin_group_bus_hdl_t pin_group_hdl)
+{
+    sdi_cpld_pin_group_t *cpld_pin_group = (sdi_cpld_pin_group_t *) pin_group_hdl;
+    sdi_pin_bus_hdl_t event_pin = sdi_cpld_pin_group_event_pin_get(cpld_pin_group);
+    t_std_error error = STD_ERR_OK;
+
+    if (event_pin == NULL) {
+        return SDI_DEVICE_ERRCODE(ENOTSUP);
+    }
+    error = sdi_pin_event_clear(event_pin);
+    if ((error == STD_ERR_OK) && (cpld_pin_group->event_clear)) {
+        /* Release the interrupt line, so the next change raises an edge */
+        error = sdi_cpld_reg_write(cpld_pin_group->cpld_hdl,
+                                   cpld_pin_group->event_clear_addr,
+                                   cpld_pin_group->event_clear_value);
+    }
+    return error;
+}
+
+/*
+ * Refresh the register shadow of the cpld of the pin group with one block
+ * read, serving reads of every pin and pin group of the cpld
+ * param[in] pin_group_hdl cpld pin group handle
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRCODE(ENOTSUP) when the cpld
+ * has no register shadow
+ */
+static t_std_error sdi_cpld_pin_group_refresh (sdi_pin_group_bus_hdl_t pin_group_hdl)
+{
+    return sdi_cpld_refresh(((sdi_cpld_pin_group_t *) pin_group_hdl)->cpld_hdl);
+}
+
+/*
+ * Get the cpld refreshed by sdi_cpld_pin_group_refresh
+ * param[in] pin_group_hdl cpld pin group handle
+ * return cpld device handle
+ */
+static const void *sdi_cpld_pin_group_refresh_device (sdi_pin_group_bus_hdl_t pin_group_hdl)
+{
+    return ((sdi_cpld_pin_group_t *) pin_group_hdl)->cpld_hdl;
+}
+
+/*
+ * Check whether the registers of the cpld pin group still hold the level it
+ * wrote last, i.e. no other pin or pin group wrote them since
+ * param[in] pin_group_hdl cpld pin group handle
+ * return true when the pin group was the last to write its registers
+ */
+static bool sdi_cpld_pin_group_level_owned (sdi_pin_group_bus_hdl_t pin_group_hdl)
+{
+    sdi_cpld_pin_group_t *cpld_pin_group = (sdi_cpld_pin_group_t *) pin_group_hdl;
+
+    return sdi_cpld_reg_owned(cpld_pin_group->cpld_hdl, cpld_pin_group->start_addr,
+                              cpld_pin_group->end_addr, pin_group_hdl);
+}
+
 /*
  * cpld pin group operations object
  */
@@ -451,6 +556,11 @@ static sdi_pin_group_bus_ops_t sdi_cpld_pin_group_ops = {
     .sdi_pin_group_bus_get_direction = sdi_cpld_pin_group_get_direction,
     .sdi_pin_group_bus_set_polarity = sdi_cpld_pin_group_set_polarity,
     .sdi_pin_group_bus_get_polarity = sdi_cpld_pin_group_get_polarity,
+    .sdi_pin_group_bus_event_fd_get = sdi_cpld_pin_group_event_fd_get,
+    .sdi_pin_group_bus_event_clear = sdi_cpld_pin_group_event_clear,
+    .sdi_pin_group_bus_refresh = sdi_cpld_pin_group_refresh,
+    .sdi_pin_group_bus_refresh_device = sdi_cpld_pin_group_refresh_device,
+    .sdi_pin_group_bus_level_owned = sdi_cpld_pin_group_level_owned,
 };
 
 /*
@@ -590,6 +700,21 @@ static t_std_error sdi_cpld_pin_group_driver_register(std_config_node_t node,
     STD_ASSERT(node_attr != NULL);
     safestrncpy(pin_group_bus->bus.bus_name, node_attr, SDI_MAX_NAME_LEN);
 
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_EVENT_PIN);
+    if (node_attr != NULL) {
+        safestrncpy(cpld_pin_group->event_pin, node_attr, SDI_MAX_NAME_LEN);
+    }
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_CPLD_EVENT_CLEAR_ADDR);
+    if (node_attr != NULL) {
+        STD_ASSERT(cpld_pin_group->event_pin[0] != '\0');
+        cpld_pin_group->event_clear = true;
+        cpld_pin_group->event_clear_addr = (uint_t) strtoul(node_attr, NULL, 0);
+        node_attr = std_config_attr_get(node, SDI_DEV_ATTR_CPLD_EVENT_CLEAR_VALUE);
+        cpld_pin_group->event_clear_value =
+            (node_attr != NULL) ? (uint8_t) strtoul(node_attr, NULL, 0) : 0xff;
+    }
+
     std_mutex_lock_init_non_recursive(&(pin_group_bus->lock));
     pin_group_bus->ops = &sdi_cpld_pin_group_ops;
 
@@ -323,22 +323,22 @@ static t_std_error sdi_emc2305_fan_speed_get(sdi_resource_hdl_t real_resource_hd
     emc2305_data = (emc2305_device_t*)chip->private_data;
     STD_ASSERT(emc2305_data != NULL);
 
-    rc = sdi_smbus_read_byte(chip->bus_hdl, chip->addr.i2c_addr,
-                   fan_tach_reg[fan_id][EMC2305_INDEX0], &tach, SDI_I2C_FLAG_NONE);
+    /* TACH high and low bytes are read together in one batch */
+    sdi_i2c_batch_op_t ops[] = {
+        { .operation = SDI_I2C_READ, .offset = fan_tach_reg[fan_id][EMC2305_INDEX0],
+          .buffer = &tach, .len = 1 },
+        { .operation = SDI_I2C_READ, .offset = fan_tach_reg[fan_id][EMC2305_INDEX1],
+          .buffer = &ltach, .len = 1 },
+    };
+
+    rc = sdi_i2c_batch_execute(chip->bus_hdl, chip->addr.i2c_addr, ops,
+                               sizeof(ops)/sizeof(ops[0]), SDI_I2C_FLAG_NONE);
     if(rc != STD_ERR_OK) {
         SDI_DEVICE_ERRMSG_LOG("%s: read failure at addr: 0x%x reg: %d rc: %d",
                               __FUNCTION__, chip->addr.i2c_addr.i2c_addr,
                               fan_tach_reg[fan_id][EMC2305_INDEX0], rc);
         return rc;
     }
-    rc = sdi_smbus_read_byte(chip->bus_hdl, chip->addr.i2c_addr,
-                   fan_tach_reg[fan_id][EMC2305_INDEX1], &ltach, SDI_I2C_FLAG_NONE);
-    if(rc != STD_ERR_OK) {
-        SDI_DEVICE_ERRMSG_LOG("%s: read failure at addr: 0x%x reg: %d rc: %d",
-                              __FUNCTION__, chip->addr.i2c_addr.i2c_addr,
-                              fan_tach_reg[fan_id][EMC2305_INDEX1], rc);
-        return rc;
-    }
 
     count = (((tach << BITS_PER_BYTE) | ltach) >> EMC2305_FAN_LTACH_SHIFT_BITS);
     *speed = (((emc2305_data->emc2305_fan[fan_id].edges - 1) * EMC2305_TACH_FREQ *
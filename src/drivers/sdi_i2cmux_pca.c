@@ -39,6 +39,16 @@
  *      <i2c instance="5" mux_addr="0x72" mux_sel_value="0x8" bus_name="smbus0_3"></i2c>
  * </sdi_i2cmux_pca>
  *
+ * Optional attributes of sdi_i2cmux_pca node:
+ * deselect - when a selected channel is deselected,
+ *      always : on every channel bus release (default)
+ *      idle   : once the mux is not accessed for idle_timeout msec
+ *      never  : only when a channel of another mux address is selected
+ *   With idle and never, a channel stays connected to the parent bus after
+ *   the transaction and select writes are skipped while the same channel is
+ *   accessed again. Use them only when devices behind this mux don't clash
+ *   with devices on the parent bus or behind sibling muxes.
+ * idle_timeout - idle time in msec for deselect="idle"
  */
 
 #include "sdi_i2cmux_pca.h"
@@ -50,10 +60,97 @@
 #include "sdi_i2c_bus_framework.h"
 #include "std_utils.h"
 #include "std_assert.h"
+#include "std_time_tools.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <time.h>
+
+/**
+ * Idle time in msec after which the mux is deselected, when deselect policy
+ * is idle and no idle_timeout is configured
+ */
+#define SDI_I2CMUX_PCA_IDLE_TIMEOUT 100
+
+/**
+ * sdi_i2cmux_pca_time_msec
+ * get monotonic time in milli seconds
+ * return current time in milli seconds
+ */
+static uint64_t sdi_i2cmux_pca_time_msec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
+}
+
+/**
+ * sdi_i2cmux_pca_parent_resets
+ * get the number of resets of the i2c bus being multiplexed. Called with the
+ * parent bus acquired, so no reset can happen until it is released.
+ * param[in] mux - i2c mux device handle
+ * return number of resets, 0 if parent bus doesn't maintain counters
+ */
+static uint64_t sdi_i2cmux_pca_parent_resets(sdi_i2cmux_pca_hdl_t mux)
+{
+    sdi_i2c_bus_stats_t stats = { 0 };
+
+    if (sdi_i2c_bus_stats_get(mux->i2c_bus, &stats) != STD_ERR_OK) {
+        return 0;
+    }
+    return stats.resets;
+}
+
+/**
+ * sdi_i2cmux_pca_write_ctrl
+ * write control register of PCA mux. Parent i2c bus should be acquired.
+ * param[in] mux - i2c mux device handle
+ * param[in] mux_addr - i2c address of PCA mux
+ * param[in] value - channels to enable, 0 to deselect all channels
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_i2cmux_pca_write_ctrl(sdi_i2cmux_pca_hdl_t mux,
+                                             sdi_i2c_addr_t mux_addr,
+                                             uint8_t value)
+{
+    return sdi_smbus_execute(mux->i2c_bus, mux_addr, SDI_SMBUS_WRITE,
+                             SDI_SMBUS_BYTE_DATA, 0, &value,
+                             SDI_SMBUS_SIZE_NON_BLOCK, 0);
+}
+
+/**
+ * sdi_i2cmux_pca_deselect
+ * deselect the channel last selected on the mux. Parent i2c bus should be
+ * acquired.
+ * param[in] mux - i2c mux device handle
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_i2cmux_pca_deselect(sdi_i2cmux_pca_hdl_t mux)
+{
+    t_std_error error = STD_ERR_OK;
+    sdi_i2cmux_pca_chan_bus_handle_t chan = mux->selected_chan;
+
+    if (chan == NULL) {
+        return STD_ERR_OK;
+    }
+
+    /* Deselect the mux (all channels) */
+    SDI_DEVICE_TRACEMSG_LOG("%s:%d sending deselect on bus %s addr %02x\n",
+            __FUNCTION__, __LINE__, mux->i2c_bus_name, chan->mux_i2c_addr);
+    error = sdi_i2cmux_pca_write_ctrl(mux, chan->mux_i2c_addr, 0);
+    if (error != STD_ERR_OK) {
+        SDI_DEVICE_TRACEMSG_LOG("Error in in smbus write for pca channel deselect on %s",
+            mux->i2c_bus_name);
+        /* channel may still be selected, retry deselect on next select */
+        mux->selected_valid = false;
+        return error;
+    }
+
+    mux->selected_chan = NULL;
+    return STD_ERR_OK;
+}
 
 /**
  * sdi_i2cmux_pca_acquire_bus
@@ -61,7 +158,9 @@
  * sequence of operations:
  *  1. acquire mux device lock to prevent other access to mux device
  *  2. acquire i2c bus to which this mux is attached.
- *  3. select the channel by sending the I2C byte
+ *  3. select the channel by sending the I2C byte, unless the channel is
+ *     already selected and neither an i2c error nor a reset of the parent
+ *     bus happened since it was selected.
  * param[in] bus_handle - i2c mux channel bus handle
  * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
  */
@@ -70,6 +169,8 @@ static t_std_error sdi_i2cmux_pca_chan_acquire_bus(sdi_i2c_bus_hdl_t bus_handle)
     t_std_error error = STD_ERR_OK;
     sdi_i2cmux_pca_chan_bus_handle_t bus = (sdi_i2cmux_pca_chan_bus_handle_t) bus_handle;
     sdi_i2cmux_pca_hdl_t mux = bus->i2c_mux;
+    bool is_parent_bus_acquired = false;
+    uint64_t resets = 0;
 
     error = std_mutex_lock(&(mux->mux_lock));
     if (error != STD_ERR_OK) {
@@ -80,20 +181,49 @@ static t_std_error sdi_i2cmux_pca_chan_acquire_bus(sdi_i2c_bus_hdl_t bus_handle)
     }
 
     do {
-        /* Bus acquisition is handled by sdi_smbus_write_byte api */
+        error = sdi_i2c_acquire_bus(mux->i2c_bus);
+        if (error != STD_ERR_OK) {
+            SDI_DEVICE_ERRMSG_LOG("%s:%d acquiring bus failed with error %d\n",
+                    __FUNCTION__, __LINE__, error);
+            break;
+        }
+
+        is_parent_bus_acquired = true;
+
+        if (mux->deselect != SDI_I2CMUX_PCA_DESELECT_ALWAYS) {
+            resets = sdi_i2cmux_pca_parent_resets(mux);
+        }
+
+        if ((mux->selected_chan == bus) && (mux->selected_valid)
+                && (mux->parent_resets == resets)) {
+            break;
+        }
+
+        if ((mux->selected_chan != NULL)
+                && (mux->selected_chan->mux_i2c_addr.i2c_addr != bus->mux_i2c_addr.i2c_addr)) {
+            /* Channel of another mux device on this bus is still selected */
+            sdi_i2cmux_pca_deselect(mux);
+        }
+
         SDI_DEVICE_TRACEMSG_LOG("%s:%d sending select on bus %s addr %02x value %02x\n",
                 __FUNCTION__, __LINE__, mux->i2c_bus_name,
                 bus->mux_i2c_addr, bus->mux_sel_value);
-        error = sdi_smbus_write_byte(mux->i2c_bus, bus->mux_i2c_addr,
-                                    0, bus->mux_sel_value, 0);
+        mux->selected_chan = bus;
+        mux->selected_valid = false;
+        error = sdi_i2cmux_pca_write_ctrl(mux, bus->mux_i2c_addr, bus->mux_sel_value);
         if (error != STD_ERR_OK) {
             SDI_DEVICE_ERRMSG_LOG("%s:%d PCA channel select failed with error %d\n",
                     __FUNCTION__, __LINE__, error);
             break;
         }
+        mux->selected_valid = true;
+        mux->parent_resets = resets;
     } while(0);
 
     if (error != STD_ERR_OK) {
+        if (is_parent_bus_acquired == true) {
+            sdi_i2c_release_bus(mux->i2c_bus);
+        }
         std_mutex_unlock (&(mux->mux_lock));
     }
 
@@ -105,8 +235,8 @@ static t_std_error sdi_i2cmux_pca_chan_acquire_bus(sdi_i2c_bus_hdl_t bus_handle)
  * sdi_i2cmux_pca_chan_release_bus
  * release i2c mux channel bus
  * sequence of operations:
- * 1. send 0 to i2c mux
- * 2. release i2c mux channel bus
+ * 1. send 0 to i2c mux, if deselect policy is always
+ * 2. release i2c bus to which this mux is attached.
  * 3. release mux device lock.
  * param[in] bus_handle - i2c mux channel bus handle
  * return none
@@ -116,16 +246,43 @@ static void sdi_i2cmux_pca_chan_release_bus(sdi_i2c_bus_hdl_t bus_handle)
     sdi_i2cmux_pca_chan_bus_handle_t bus = (sdi_i2cmux_pca_chan_bus_handle_t) bus_handle;
     sdi_i2cmux_pca_hdl_t mux = bus->i2c_mux;
 
-    /* Deselect the mux (all channels) */
-    SDI_DEVICE_TRACEMSG_LOG("%s:%d sending deselect on bus %s addr %02x\n",
-            __FUNCTION__, __LINE__, mux->i2c_bus_name, bus->mux_i2c_addr);
-    if(STD_ERR_OK != sdi_smbus_write_byte(mux->i2c_bus, bus->mux_i2c_addr, 0, 0, 0)){
-        SDI_DEVICE_TRACEMSG_LOG("Error in in smbus write for pca channel bus release on %s",
-            mux->i2c_bus_name);
+    if (mux->deselect == SDI_I2CMUX_PCA_DESELECT_ALWAYS) {
+        sdi_i2cmux_pca_deselect(mux);
     }
+    mux->last_access = sdi_i2cmux_pca_time_msec();
+
+    sdi_i2c_release_bus(mux->i2c_bus);
     std_mutex_unlock (&(mux->mux_lock));
 }
 
+/**
+ * sdi_i2cmux_pca_deselect_thread
+ * deselect the mux once it is idle for idle timeout, so that devices on a
+ * channel are not left connected to the parent bus. Runs only when deselect
+ * policy is idle; mux is deselected within twice the idle timeout.
+ * param[in] param - i2c mux device handle
+ * return none
+ */
+static void *sdi_i2cmux_pca_deselect_thread(void *param)
+{
+    sdi_i2cmux_pca_hdl_t mux = (sdi_i2cmux_pca_hdl_t) param;
+
+    while (true) {
+        std_usleep(MILLI_TO_MICRO(mux->idle_timeout));
+
+        if (std_mutex_lock(&(mux->mux_lock)) != STD_ERR_OK) {
+            continue;
+        }
+        if ((mux->selected_chan != NULL)
+                && ((sdi_i2cmux_pca_time_msec() - mux->last_access) >= mux->idle_timeout)
+                && (sdi_i2c_acquire_bus(mux->i2c_bus) == STD_ERR_OK)) {
+            sdi_i2cmux_pca_deselect(mux);
+            sdi_i2c_release_bus(mux->i2c_bus);
+        }
+        std_mutex_unlock(&(mux->mux_lock));
+    }
+    return NULL;
+}
 /**
  * sdi_i2cmux_pca_chan_get_capability
  * get the capability of i2c mux channel bus
@@ -140,6 +297,22 @@ static void sdi_i2cmux_pca_chan_get_capability
     sdi_i2c_bus_get_capability(bus->i2c_mux->i2c_bus, capability);
 }
 
+/**
+ * sdi_i2cmux_pca_chan_get_stats
+ * get the counters of the i2c bus being multiplexed
+ * param[out] stats - i2c bus transaction and timing counters
+ * return none
+ */
+static void sdi_i2cmux_pca_chan_get_stats
+    (sdi_i2c_bus_hdl_t bus_handle, sdi_i2c_bus_stats_t *stats)
+{
+    sdi_i2cmux_pca_chan_bus_handle_t bus = (sdi_i2cmux_pca_chan_bus_handle_t) bus_handle;
+
+    if (sdi_i2c_bus_stats_get(bus->i2c_mux->i2c_bus, stats) != STD_ERR_OK) {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
 /**
  * sdi_i2cmux_pca_chan_execute
  * execute i2c bus operation
@@ -159,11 +332,97 @@ static t_std_error sdi_i2cmux_pca_chan_execute (sdi_i2c_bus_hdl_t bus_handle,
                                                 sdi_smbus_data_type_t data_type,
                                                 uint_t commandbuf, void *buffer,
                                                 size_t *block_len, uint_t flags)
+{
+    t_std_error error = STD_ERR_OK;
+    sdi_i2cmux_pca_chan_bus_handle_t bus = (sdi_i2cmux_pca_chan_bus_handle_t) bus_handle;
+
+    error = sdi_smbus_execute(bus->i2c_mux->i2c_bus, address, operation, data_type,
+                              commandbuf, buffer, block_len, flags);
+    if (error != STD_ERR_OK) {
+        /* bus error may have left mux in unknown state, select again */
+        bus->i2c_mux->selected_valid = false;
+    }
+    return error;
+}
+
+/**
+ * sdi_i2cmux_pca_chan_i2c_execute
+ * execute i2c bus transaction on the i2c bus being multiplexed
+ * param[in] bus_handle - i2c mux channel bus handle
+ * param[in] address - i2c address of slave device
+ * param[in] operation - i2c bus operation (read/write)
+ * param[in] cmd - list of read/write offsets
+ * param[in] cmdlen - no. of offsets
+ * param[out] buffer - data read from/written to i2c slave
+ * param[in] buflen - no.of bytes to read/write
+ * param[in] flags - options if any to be send to i2c execute
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_i2cmux_pca_chan_i2c_execute (sdi_i2c_bus_hdl_t bus_handle,
+                                                    sdi_i2c_addr_t address,
+                                                    sdi_i2c_operation_t operation,
+                                                    const uint8_t *cmd, uint_t cmdlen,
+                                                    void *buffer, uint_t buflen,
+                                                    uint_t flags)
+{
+    t_std_error error = STD_ERR_OK;
+    sdi_i2cmux_pca_chan_bus_handle_t bus = (sdi_i2cmux_pca_chan_bus_handle_t) bus_handle;
+
+    if (bus->i2c_mux->i2c_bus->ops->sdi_i2c_execute == NULL) {
+        return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
+    }
+
+    error = sdi_i2c_bus_execute(bus->i2c_mux->i2c_bus, address, operation, cmd, cmdlen,
+                                buffer, buflen, flags);
+    if ((error != STD_ERR_OK) && (error != SDI_DEVICE_ERRCODE(EOPNOTSUPP))) {
+        /* bus error may have left mux in unknown state, select again */
+        bus->i2c_mux->selected_valid = false;
+    }
+    return error;
+}
+
+/**
+ * sdi_i2cmux_pca_chan_batch_execute
+ * execute a batch of register transactions on the i2c bus being multiplexed
+ * param[in] bus_handle - i2c mux channel bus handle
+ * param[in] address - i2c address of slave device
+ * param[in] ops - transactions to execute
+ * param[in] count - number of transactions
+ * param[in] flags - options if any to be send to i2c execute
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_i2cmux_pca_chan_batch_execute (sdi_i2c_bus_hdl_t bus_handle,
+                                                      sdi_i2c_addr_t address,
+                                                      const sdi_i2c_batch_op_t *ops,
+                                                      uint_t count, uint_t flags)
+{
+    t_std_error error = STD_ERR_OK;
+    sdi_i2cmux_pca_chan_bus_handle_t bus = (sdi_i2cmux_pca_chan_bus_handle_t) bus_handle;
+    sdi_i2c_bus_hdl_t parent = bus->i2c_mux->i2c_bus;
+
+    if (parent->ops->sdi_i2c_batch_execute == NULL) {
+        return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
+    }
+
+    error = parent->ops->sdi_i2c_batch_execute(parent, address, ops, count, flags);
+    if ((error != STD_ERR_OK) && (error != SDI_DEVICE_ERRCODE(EOPNOTSUPP))) {
+        /* bus error may have left mux in unknown state, select again */
+        bus->i2c_mux->selected_valid = false;
+    }
+    return error;
+}
+
+/**
+ * sdi_i2cmux_pca_chan_get_parent
+ * get the i2c bus being multiplexed
+ * param[in] bus_handle - i2c mux channel bus handle
+ * return i2c bus handle to which this mux is attached
+ */
+static sdi_i2c_bus_hdl_t sdi_i2cmux_pca_chan_get_parent (sdi_i2c_bus_hdl_t bus_handle)
 {
     sdi_i2cmux_pca_chan_bus_handle_t bus = (sdi_i2cmux_pca_chan_bus_handle_t) bus_handle;
 
-    return sdi_smbus_execute(bus->i2c_mux->i2c_bus, address, operation, data_type,
-                             commandbuf, buffer, block_len, flags);
+    return bus->i2c_mux->i2c_bus;
 }
 
 /**
@@ -173,8 +432,12 @@ static t_std_error sdi_i2cmux_pca_chan_execute (sdi_i2c_bus_hdl_t bus_handle,
 static sdi_i2c_bus_ops_t sdi_i2cmux_chan_bus_operations = {
     .sdi_i2c_acquire_bus = sdi_i2cmux_pca_chan_acquire_bus,
     .sdi_smbus_execute = sdi_i2cmux_pca_chan_execute,
+    .sdi_i2c_execute = sdi_i2cmux_pca_chan_i2c_execute,
     .sdi_i2c_release_bus = sdi_i2cmux_pca_chan_release_bus,
     .sdi_i2c_get_capability = sdi_i2cmux_pca_chan_get_capability,
+    .sdi_i2c_get_stats = sdi_i2cmux_pca_chan_get_stats,
+    .sdi_i2c_batch_execute = sdi_i2cmux_pca_chan_batch_execute,
+    .sdi_i2c_get_parent = sdi_i2cmux_pca_chan_get_parent,
 };
 
 /**
@@ -275,6 +538,25 @@ static t_std_error sdi_i2cmux_pca_driver_register(std_config_node_t node,
     STD_ASSERT(node_attr != NULL);
     safestrncpy(i2cmux->i2c_bus_name, node_attr, SDI_MAX_NAME_LEN);
 
+    i2cmux->deselect = SDI_I2CMUX_PCA_DESELECT_ALWAYS;
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_SDI_I2CMUX_DESELECT);
+    if (node_attr != NULL) {
+        if (strcmp(node_attr, "idle") == 0) {
+            i2cmux->deselect = SDI_I2CMUX_PCA_DESELECT_IDLE;
+        } else if (strcmp(node_attr, "never") == 0) {
+            i2cmux->deselect = SDI_I2CMUX_PCA_DESELECT_NEVER;
+        } else if (strcmp(node_attr, "always") != 0) {
+            SDI_DEVICE_ERRMSG_LOG("%s:%d invalid deselect policy %s for %s\n",
+                    __FUNCTION__, __LINE__, node_attr, dev->alias);
+        }
+    }
+
+    i2cmux->idle_timeout = SDI_I2CMUX_PCA_IDLE_TIMEOUT;
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_SDI_I2CMUX_IDLE_TIMEOUT);
+    if (node_attr != NULL) {
+        i2cmux->idle_timeout = (uint_t) strtoul (node_attr, NULL, 0);
+    }
+
     *device_hdl = dev;
 
     for (cur_node = std_config_get_child(node); cur_node != NULL;
@@ -351,6 +633,20 @@ static t_std_error sdi_i2cmux_pca_driver_init(sdi_device_hdl_t device_hdl)
     sdi_init_bus_for_each_bus_in_list(&i2cmux->channel_list,
                                       sdi_i2cmux_channel_init, NULL);
 
+    if ((i2cmux->deselect == SDI_I2CMUX_PCA_DESELECT_IDLE)
+            && (i2cmux->idle_timeout != 0)) {
+        std_thread_init_struct(&(i2cmux->deselect_thread));
+        i2cmux->deselect_thread.name = "sdi-i2cmux-pca";
+        i2cmux->deselect_thread.thread_function =
+            (std_thread_function_t) sdi_i2cmux_pca_deselect_thread;
+        i2cmux->deselect_thread.param = i2cmux;
+        if (std_thread_create(&(i2cmux->deselect_thread)) != STD_ERR_OK) {
+            SDI_DEVICE_ERRMSG_LOG("%s:%d creating deselect thread failed, "
+                    "deselecting on every release\n", __FUNCTION__, __LINE__);
+            i2cmux->deselect = SDI_I2CMUX_PCA_DESELECT_ALWAYS;
+        }
+    }
+
     return error;
 }
 
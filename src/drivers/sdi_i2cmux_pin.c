@@ -71,7 +71,8 @@ For ex: gpio pin1 and gpio pin2 are used to enable a particular i2c mux channel:
  * acquire i2c mux channel bus
  * sequence of operations:
  *  1. acquire mux device lock to prevent other access to mux device
- *  2. select the channel by updating the pin group with channel id for this bus.
+ *  2. select the channel by updating the pin group with channel id for this bus,
+ *     unless the channel is still selected from the previous access.
  *  3. acquire this mux channel's bus lock
  *  4. acquire i2c bus to which this mux is attached.
  * param[in] bus_handle - i2c mux channel bus handle
@@ -100,7 +101,7 @@ static t_std_error sdi_i2cmux_pin_chan_acquire_bus(sdi_i2c_bus_hdl_t bus_handle)
 
         is_pin_group_bus_acquired = true;
 
-        error = sdi_pin_group_write_level(mux->pingroup_hdl, bus->i2c_mux_channel);
+        error = sdi_pin_group_write_level_cached(mux->pingroup_hdl, bus->i2c_mux_channel);
         if (error != STD_ERR_OK) {
             SDI_DEVICE_ERRMSG_LOG("%s:%d channel select failed with error %d\n",
                     __FUNCTION__, __LINE__, error);
@@ -109,6 +110,8 @@ static t_std_error sdi_i2cmux_pin_chan_acquire_bus(sdi_i2c_bus_hdl_t bus_handle)
 
         error = sdi_i2c_acquire_bus((bus->i2c_mux->i2cbus_hdl));
         if (error != STD_ERR_OK) {
+            /* Mux state is not trusted anymore */
+            sdi_pin_group_level_invalidate(mux->pingroup_hdl);
             SDI_DEVICE_ERRMSG_LOG("%s:%d acquiring bus failed with error %d\n",
                     __FUNCTION__, __LINE__, error);
             break;
@@ -159,6 +162,22 @@ static void sdi_i2cmux_pin_chan_get_capability
     sdi_i2c_bus_get_capability(bus->i2c_mux->i2cbus_hdl, capability);
 }
 
+/**
+ * sdi_i2cmux_pin_chan_get_stats
+ * get the counters of the i2c bus being multiplexed
+ * param[out] stats - i2c bus transaction and timing counters
+ * return none
+ */
+static void sdi_i2cmux_pin_chan_get_stats
+    (sdi_i2c_bus_hdl_t bus_handle, sdi_i2c_bus_stats_t *stats)
+{
+    sdi_i2cmux_pin_chan_bus_handle_t bus = (sdi_i2cmux_pin_chan_bus_handle_t) bus_handle;
+
+    if (sdi_i2c_bus_stats_get(bus->i2c_mux->i2cbus_hdl, stats) != STD_ERR_OK) {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
 /**
  * sdi_i2cmux_pin_chan_execute
  * execute i2c bus operation
@@ -178,11 +197,97 @@ static t_std_error sdi_i2cmux_pin_chan_execute (sdi_i2c_bus_hdl_t bus_handle,
                                                 sdi_smbus_data_type_t data_type,
                                                 uint_t commandbuf, void *buffer,
                                                 size_t *block_len, uint_t flags)
+{
+    sdi_i2cmux_pin_chan_bus_handle_t bus = (sdi_i2cmux_pin_chan_bus_handle_t) bus_handle;
+    t_std_error error = STD_ERR_OK;
+
+    error = sdi_smbus_execute(bus->i2c_mux->i2cbus_hdl, address, operation, data_type,
+                              commandbuf, buffer, block_len, flags);
+    if (error != STD_ERR_OK) {
+        /* A bus reset may have dropped the channel selection */
+        sdi_pin_group_level_invalidate(bus->i2c_mux->pingroup_hdl);
+    }
+    return error;
+}
+
+/**
+ * sdi_i2cmux_pin_chan_i2c_execute
+ * execute i2c bus transaction on the i2c bus being multiplexed
+ * param[in] bus_handle - i2c mux channel bus handle
+ * param[in] address - i2c address of slave device
+ * param[in] operation - i2c bus operation (read/write)
+ * param[in] cmd - list of read/write offsets
+ * param[in] cmdlen - no. of offsets
+ * param[out] buffer - data read from/written to i2c slave
+ * param[in] buflen - no.of bytes to read/write
+ * param[in] flags - options if any to be send to i2c execute
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_i2cmux_pin_chan_i2c_execute (sdi_i2c_bus_hdl_t bus_handle,
+                                                    sdi_i2c_addr_t address,
+                                                    sdi_i2c_operation_t operation,
+                                                    const uint8_t *cmd, uint_t cmdlen,
+                                                    void *buffer, uint_t buflen,
+                                                    uint_t flags)
+{
+    sdi_i2cmux_pin_chan_bus_handle_t bus = (sdi_i2cmux_pin_chan_bus_handle_t) bus_handle;
+    t_std_error error = STD_ERR_OK;
+
+    if (bus->i2c_mux->i2cbus_hdl->ops->sdi_i2c_execute == NULL) {
+        return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
+    }
+
+    error = sdi_i2c_bus_execute(bus->i2c_mux->i2cbus_hdl, address, operation, cmd, cmdlen,
+                                buffer, buflen, flags);
+    if (error != STD_ERR_OK) {
+        /* A bus reset may have dropped the channel selection */
+        sdi_pin_group_level_invalidate(bus->i2c_mux->pingroup_hdl);
+    }
+    return error;
+}
+
+/**
+ * sdi_i2cmux_pin_chan_batch_execute
+ * execute a batch of register transactions on the i2c bus being multiplexed
+ * param[in] bus_handle - i2c mux channel bus handle
+ * param[in] address - i2c address of slave device
+ * param[in] ops - transactions to execute
+ * param[in] count - number of transactions
+ * param[in] flags - options if any to be send to i2c execute
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_i2cmux_pin_chan_batch_execute (sdi_i2c_bus_hdl_t bus_handle,
+                                                      sdi_i2c_addr_t address,
+                                                      const sdi_i2c_batch_op_t *ops,
+                                                      uint_t count, uint_t flags)
+{
+    sdi_i2cmux_pin_chan_bus_handle_t bus = (sdi_i2cmux_pin_chan_bus_handle_t) bus_handle;
+    sdi_i2c_bus_hdl_t parent = bus->i2c_mux->i2cbus_hdl;
+    t_std_error error = STD_ERR_OK;
+
+    if (parent->ops->sdi_i2c_batch_execute == NULL) {
+        return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
+    }
+
+    error = parent->ops->sdi_i2c_batch_execute(parent, address, ops, count, flags);
+    if (error != STD_ERR_OK) {
+        /* A bus reset may have dropped the channel selection */
+        sdi_pin_group_level_invalidate(bus->i2c_mux->pingroup_hdl);
+    }
+    return error;
+}
+
+/**
+ * sdi_i2cmux_pin_chan_get_parent
+ * get the i2c bus being multiplexed
+ * param[in] bus_handle - i2c mux channel bus handle
+ * return i2c bus handle to which this mux is attached
+ */
+static sdi_i2c_bus_hdl_t sdi_i2cmux_pin_chan_get_parent (sdi_i2c_bus_hdl_t bus_handle)
 {
     sdi_i2cmux_pin_chan_bus_handle_t bus = (sdi_i2cmux_pin_chan_bus_handle_t) bus_handle;
 
-    return sdi_smbus_execute(bus->i2c_mux->i2cbus_hdl, address, operation, data_type,
-                             commandbuf, buffer, block_len, flags);
+    return bus->i2c_mux->i2cbus_hdl;
 }
 
 /**
@@ -192,8 +297,12 @@ static t_std_error sdi_i2cmux_pin_chan_execute (sdi_i2c_bus_hdl_t bus_handle,
 sdi_i2c_bus_ops_t sdi_i2cmux_chan_bus_operations = {
     .sdi_i2c_acquire_bus = sdi_i2cmux_pin_chan_acquire_bus,
     .sdi_smbus_execute = sdi_i2cmux_pin_chan_execute,
+    .sdi_i2c_execute = sdi_i2cmux_pin_chan_i2c_execute,
     .sdi_i2c_release_bus = sdi_i2cmux_pin_chan_release_bus,
     .sdi_i2c_get_capability = sdi_i2cmux_pin_chan_get_capability,
+    .sdi_i2c_get_stats = sdi_i2cmux_pin_chan_get_stats,
+    .sdi_i2c_batch_execute = sdi_i2cmux_pin_chan_batch_execute,
+    .sdi_i2c_get_parent = sdi_i2cmux_pin_chan_get_parent,
 };
 
 /**
@@ -85,6 +85,8 @@ t_std_error sdi_qsfp_presence_get (sdi_resource_hdl_t resource_hdl, bool *pres)
     if (rc == STD_ERR_OK){
         if( ( (STD_BIT_TEST(value, qsfp_priv_data->mod_pres_bitmask)) == 0) ) {
             *pres = false;
+            /* Eeprom shadow belongs to the removed module */
+            sdi_qsfp_module_cache_invalidate(resource_hdl);
         } else {
             *pres = true;
         }
@@ -93,6 +95,66 @@ t_std_error sdi_qsfp_presence_get (sdi_resource_hdl_t resource_hdl, bool *pres)
     return rc;
 }
 
+/**
+ * Gets the file descriptor signalling presence changes of qsfp module
+ * resource_hdl[in] - Handle of the qsfp resource
+ * fd[out]        - pollable file descriptor of the presence pin group
+ * return t_std_error
+ */
+t_std_error sdi_qsfp_presence_event_fd_get (sdi_resource_hdl_t resource_hdl, int *fd)
+{
+    sdi_device_hdl_t qsfp_device = NULL;
+    qsfp_device_t *qsfp_priv_data = NULL;
+    t_std_error rc = STD_ERR_OK;
+
+    STD_ASSERT(resource_hdl != NULL);
+    STD_ASSERT(fd != NULL);
+
+    qsfp_device = (sdi_device_hdl_t)resource_hdl;
+    qsfp_priv_data = (qsfp_device_t *)qsfp_device->private_data;
+    STD_ASSERT(qsfp_priv_data != NULL);
+
+    rc = sdi_pin_group_acquire_bus(qsfp_priv_data->mod_pres_hdl);
+    if (rc != STD_ERR_OK){
+        return rc;
+    }
+
+    rc = sdi_pin_group_event_fd_get(qsfp_priv_data->mod_pres_hdl, fd);
+
+    sdi_pin_group_release_bus(qsfp_priv_data->mod_pres_hdl);
+
+    return rc;
+}
+
+/**
+ * Consumes pending presence events of qsfp module
+ * resource_hdl[in] - Handle of the qsfp resource
+ * return t_std_error
+ */
+t_std_error sdi_qsfp_presence_event_clear (sdi_resource_hdl_t resource_hdl)
+{
+    sdi_device_hdl_t qsfp_device = NULL;
+    qsfp_device_t *qsfp_priv_data = NULL;
+    t_std_error rc = STD_ERR_OK;
+
+    STD_ASSERT(resource_hdl != NULL);
+
+    qsfp_device = (sdi_device_hdl_t)resource_hdl;
+    qsfp_priv_data = (qsfp_device_t *)qsfp_device->private_data;
+    STD_ASSERT(qsfp_priv_data != NULL);
+
+    rc = sdi_pin_group_acquire_bus(qsfp_priv_data->mod_pres_hdl);
+    if (rc != STD_ERR_OK){
+        return rc;
+    }
+
+    rc = sdi_pin_group_event_clear(qsfp_priv_data->mod_pres_hdl);
+
+    sdi_pin_group_release_bus(qsfp_priv_data->mod_pres_hdl);
+
+    return rc;
+}
+
 /**
  * Enable/Disable the module control parameters like low power mode and reset
  * control
@@ -291,6 +353,79 @@ t_std_error sdi_qsfp_module_control_status_get(sdi_resource_hdl_t resource_hdl,
     return rc;
 }
 
+/**
+ * Gets presence, reset and low power mode state of qsfp module, reading each
+ * pin group once for a batch of modules
+ * resource_hdl[in] - Handle of the qsfp resource
+ * levels[in]       - pin group levels of the batch
+ * flags[in]        - SDI_MEDIA_STATE_* bits of interest
+ * state[out]       - SDI_MEDIA_STATE_* bits of the module
+ * return t_std_error
+ */
+static t_std_error sdi_qsfp_state_get (sdi_resource_hdl_t resource_hdl,
+                                       sdi_media_pin_levels_t *levels,
+                                       uint_t flags, uint_t *state)
+{
+    sdi_device_hdl_t qsfp_device = NULL;
+    qsfp_device_t *qsfp_priv_data = NULL;
+    t_std_error rc = STD_ERR_OK;
+    uint_t value = 0;
+
+    STD_ASSERT(resource_hdl != NULL);
+    STD_ASSERT(state != NULL);
+
+    *state = 0;
+
+    qsfp_device = (sdi_device_hdl_t)resource_hdl;
+    qsfp_priv_data = (qsfp_device_t *)qsfp_device->private_data;
+    STD_ASSERT(qsfp_priv_data != NULL);
+
+    if ((flags & SDI_MEDIA_STATE_PRESENT) != 0) {
+        rc = sdi_media_pin_group_level_get(levels, qsfp_priv_data->mod_pres_hdl, &value);
+        if (rc != STD_ERR_OK){
+            SDI_DEVICE_ERRMSG_LOG("presence status get failed for %s",
+                    qsfp_device->alias);
+            return rc;
+        }
+        if (STD_BIT_TEST(value, qsfp_priv_data->mod_pres_bitmask) == 0) {
+            /* Eeprom shadow belongs to the removed module */
+            sdi_qsfp_module_cache_invalidate(resource_hdl);
+        } else {
+            *state |= SDI_MEDIA_STATE_PRESENT;
+        }
+    }
+
+    if (qsfp_priv_data->mod_type == QSFP_QSA_ADAPTER) {
+        return rc;
+    }
+
+    if ((flags & SDI_MEDIA_STATE_RESET) != 0) {
+        rc = sdi_media_pin_group_level_get(levels, qsfp_priv_data->mod_reset_hdl, &value);
+        if (rc != STD_ERR_OK){
+            SDI_DEVICE_ERRMSG_LOG("reset status get failed for %s",
+                    qsfp_device->alias);
+            return rc;
+        }
+        if (STD_BIT_TEST(value, qsfp_priv_data->mod_reset_bitmask) != 0) {
+            *state |= SDI_MEDIA_STATE_RESET;
+        }
+    }
+
+    if ((flags & SDI_MEDIA_STATE_LPMODE) != 0) {
+        rc = sdi_media_pin_group_level_get(levels, qsfp_priv_data->mod_lpmode_hdl, &value);
+        if (rc != STD_ERR_OK){
+            SDI_DEVICE_ERRMSG_LOG("lp mode status get failed for %s",
+                    qsfp_device->alias);
+            return rc;
+        }
+        if (STD_BIT_TEST(value, qsfp_priv_data->mod_lpmode_bitmask) != 0) {
+            *state |= SDI_MEDIA_STATE_LPMODE;
+        }
+    }
+
+    return rc;
+}
+
 /* Not yet implemented */
 
 t_std_error sdi_qsfp_module_info_get (sdi_resource_hdl_t resource_hdl,
@@ -308,7 +443,11 @@ t_std_error sdi_qsfp_port_info_get (sdi_resource_hdl_t resource_hdl,
 /* Callback handlers for QSFP */
 static media_ctrl_t qsfp_media = {
     .presence_get = sdi_qsfp_presence_get,
+    .presence_event_fd_get = sdi_qsfp_presence_event_fd_get,
+    .presence_event_clear = sdi_qsfp_presence_event_clear,
+    .state_get = sdi_qsfp_state_get,
     .module_init = sdi_qsfp_module_init,
+    .module_cache_invalidate = sdi_qsfp_module_cache_invalidate,
     .module_monitor_status_get = sdi_qsfp_module_monitor_status_get,
     .channel_monitor_status_get = sdi_qsfp_channel_monitor_status_get,
     .channel_status_get = sdi_qsfp_channel_status_get,
@@ -327,6 +466,7 @@ static media_ctrl_t qsfp_media = {
     .module_control_status_get = sdi_qsfp_module_control_status_get,
     .module_monitor_get = sdi_qsfp_module_monitor_get,
     .channel_monitor_get = sdi_qsfp_channel_monitor_get,
+    .dom_snapshot_get = sdi_qsfp_dom_snapshot_get,
     .feature_support_status_get = sdi_qsfp_feature_support_status_get,
     .read = sdi_qsfp_read,
     .write = sdi_qsfp_write,
@@ -412,6 +552,7 @@ static t_std_error sdi_qsfp_register (std_config_node_t node, void *bus_handle,
 
     qsfp_data = calloc(sizeof(qsfp_device_t), 1);
     STD_ASSERT(qsfp_data != NULL);
+    sdi_media_shadow_init(&(qsfp_data->eeprom));
 
     dev_hdl->bus_hdl = bus_handle;
     dev_hdl->callbacks = sdi_qsfp_entry_callbacks();
@@ -134,7 +134,10 @@ t_std_error sdi_qsfp28_dd_port_info_get (sdi_resource_hdl_t resource_hdl,
 /* Callback handlers for QSFP */
 static media_ctrl_t qsfp28_dd_media = {
     .presence_get = sdi_qsfp28_dd_presence_get,
+    .presence_event_fd_get = sdi_qsfp_presence_event_fd_get,
+    .presence_event_clear = sdi_qsfp_presence_event_clear,
     .module_init = sdi_qsfp28_dd_module_init,
+    .module_cache_invalidate = sdi_qsfp_module_cache_invalidate,
     .module_monitor_status_get = sdi_qsfp28_dd_module_monitor_status_get,
     .channel_monitor_status_get = sdi_qsfp28_dd_channel_monitor_status_get,
     .channel_status_get = sdi_qsfp28_dd_channel_status_get,
@@ -153,6 +156,7 @@ static media_ctrl_t qsfp28_dd_media = {
     .module_control_status_get = sdi_qsfp28_dd_module_control_status_get,
     .module_monitor_get = sdi_qsfp28_dd_module_monitor_get,
     .channel_monitor_get = sdi_qsfp28_dd_channel_monitor_get,
+    .dom_snapshot_get = sdi_qsfp28_dd_dom_snapshot_get,
     .feature_support_status_get = sdi_qsfp28_dd_feature_support_status_get,
     .read = sdi_qsfp28_dd_read,
     .write = sdi_qsfp28_dd_write,
@@ -238,6 +242,7 @@ static t_std_error sdi_qsfp28_dd_register (std_config_node_t node, void *bus_han
 
     qsfp28_dd_data = calloc(sizeof(qsfp28_dd_device_t), 1);
     STD_ASSERT(qsfp28_dd_data != NULL);
+    sdi_media_shadow_init(&(qsfp28_dd_data->eeprom));
 
     dev_hdl->bus_hdl = bus_handle;
     dev_hdl->callbacks = sdi_qsfp28_dd_entry_callbacks();
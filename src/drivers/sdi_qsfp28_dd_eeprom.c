@@ -273,6 +273,22 @@ t_std_error sdi_qsfp28_dd_channel_monitor_get (sdi_resource_hdl_t resource_hdl,
     channel += sdi_qsfp28_dd_channel_offset_get (resource_hdl);
     return sdi_qsfp_channel_monitor_get(resource_hdl, channel, monitor, value);
 }
+
+/**
+ * Read all module and channel monitors of the specified QSFP28-DD in one go
+ * resource_hdl[in]  - Handle of the resource
+ * channel_count[in] - number of channels of interest
+ * snapshot[out]     - monitors of the media
+ * return           - t_std_error
+ */
+t_std_error sdi_qsfp28_dd_dom_snapshot_get (sdi_resource_hdl_t resource_hdl, uint_t channel_count,
+                                            sdi_media_dom_snapshot_t *snapshot)
+{
+    return sdi_qsfp_dom_snapshot_read(resource_hdl,
+                                      sdi_qsfp28_dd_channel_offset_get(resource_hdl),
+                                      channel_count, snapshot);
+}
+
 /**
  * Get the inforamtion of whether optional features supported or not on a given
  * module
@@ -303,8 +303,8 @@ static inline t_std_error sdi_qsfp_module_select (sdi_device_hdl_t qsfp_device)
             return rc;
         }
 
-        rc = sdi_pin_group_write_level(qsfp_priv_data->mux_sel_hdl,
-                                       qsfp_priv_data->mux_sel_value);
+        rc = sdi_pin_group_write_level_cached(qsfp_priv_data->mux_sel_hdl,
+                                              qsfp_priv_data->mux_sel_value);
 
         if (rc != STD_ERR_OK){
             /* mux selection failed, hence release the lock.*/
@@ -327,8 +327,8 @@ static inline t_std_error sdi_qsfp_module_select (sdi_device_hdl_t qsfp_device)
             return rc;
         }
 
-        rc = sdi_pin_group_write_level(qsfp_priv_data->mod_sel_hdl,
-                                       qsfp_priv_data->mod_sel_value);
+        rc = sdi_pin_group_write_level_cached(qsfp_priv_data->mod_sel_hdl,
+                                              qsfp_priv_data->mod_sel_value);
 
         if (rc != STD_ERR_OK){
             /* module selection failed, hence release the lock.*/
@@ -439,6 +439,127 @@ static inline t_std_error sdi_qsfp_page_select (sdi_device_hdl_t qsfp_device,
     return rc;
 }
 
+static qsfp_category_t sdi_qsfp_get_category(uint_t identifier);
+
+/**
+ * Read upper page 0 of the module into its eeprom shadow, once per insertion.
+ * The shadow is used only for SFF-8636 modules whose CC_BASE and CC_EXT
+ * checksums match.
+ * qsfp_device[in] - qsfp device handle
+ * return none, shadow stays empty on read failure and is read again next time
+ */
+static void sdi_qsfp_shadow_load(sdi_device_hdl_t qsfp_device)
+{
+    qsfp_device_t *qsfp_priv_data = (qsfp_device_t *)qsfp_device->private_data;
+    sdi_media_shadow_t *shadow = &qsfp_priv_data->eeprom;
+    uint8_t data[SDI_MEDIA_PAGE_SIZE] = { 0 };
+    uint_t generation = 0;
+    t_std_error rc = STD_ERR_OK;
+    uint8_t status = 0;
+
+    if (!sdi_media_shadow_load_begin(shadow, &generation)) {
+        return;
+    }
+
+    if (qsfp_priv_data->eeprom_version >= QSFP28_DD_EEPROM_VERSION_3) {
+        sdi_media_shadow_publish(shadow, generation, data, SDI_MEDIA_SHADOW_INVALID);
+        return;
+    }
+
+    rc = sdi_qsfp_module_select(qsfp_device);
+    if (rc != STD_ERR_OK){
+        return;
+    }
+
+    do {
+        std_usleep(MILLI_TO_MICRO(qsfp_priv_data->delay));
+
+        rc = sdi_smbus_read_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
+                                 QSFP_STATUS_INDICATOR_OFFSET, &status, SDI_I2C_FLAG_NONE);
+        if (rc != STD_ERR_OK) {
+            break;
+        }
+
+        if (STD_BIT_TEST(status, QSFP_FLAT_MEM_BIT_OFFSET) == 0) {
+            rc = sdi_qsfp_page_select(qsfp_device, SDI_MEDIA_PAGE_DEFAULT);
+            if (rc != STD_ERR_OK) {
+                break;
+            }
+        }
+
+        rc = sdi_smbus_read_multi_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
+                                       QSFP_IDENTIFIER_OFFSET, data,
+                                       sizeof(data), SDI_I2C_FLAG_NONE);
+    } while(0);
+
+    sdi_qsfp_module_deselect(qsfp_priv_data);
+
+    if (rc != STD_ERR_OK) {
+        SDI_DEVICE_ERRMSG_LOG("qsfp eeprom shadow read failed for %s rc : %d",
+                              qsfp_device->alias, rc);
+        return;
+    }
+
+    /* QSFP-DD modules use a different page 0 layout */
+    if ((sdi_qsfp_get_category(data[0]) != SDI_CATEGORY_QSFPDD)
+            && (sdi_media_shadow_checksum_valid(data))) {
+        qsfp_priv_data->paging_support = (STD_BIT_TEST(status, QSFP_FLAT_MEM_BIT_OFFSET) == 0);
+        sdi_media_shadow_publish(shadow, generation, data, SDI_MEDIA_SHADOW_VALID);
+    } else {
+        SDI_DEVICE_TRACEMSG_LOG("qsfp eeprom checksum mismatch or unknown layout on %s,"
+                                " reading static fields from module", qsfp_device->alias);
+        sdi_media_shadow_publish(shadow, generation, data, SDI_MEDIA_SHADOW_INVALID);
+    }
+}
+
+/**
+ * Copy static fields of upper page 0 from the eeprom shadow of the module
+ * qsfp_device[in] - qsfp device handle
+ * offset[in] - offset of the field
+ * buf[out] - buffer for the field
+ * len[in] - length of the field
+ * return true if field is copied, false if it has to be read from the module
+ */
+static bool sdi_qsfp_shadow_copy(sdi_device_hdl_t qsfp_device, uint_t offset,
+                                 uint8_t *buf, size_t len)
+{
+    qsfp_device_t *qsfp_priv_data = (qsfp_device_t *)qsfp_device->private_data;
+
+    if ((offset < QSFP_IDENTIFIER_OFFSET)
+            || ((offset - QSFP_IDENTIFIER_OFFSET + len) > SDI_MEDIA_PAGE_SIZE)) {
+        return false;
+    }
+
+    sdi_qsfp_shadow_load(qsfp_device);
+    return sdi_media_shadow_read(&qsfp_priv_data->eeprom, offset - QSFP_IDENTIFIER_OFFSET,
+                                 buf, len);
+}
+
+/* This function fills the optional feature support flags from the eeprom
+ * shadow. Returns false if shadow is not usable. */
+static bool sdi_qsfp_shadow_feature_support_get(sdi_device_hdl_t qsfp_device,
+                                                sdi_media_supported_feature_t *feature_support)
+{
+    qsfp_device_t *qsfp_priv_data = (qsfp_device_t *)qsfp_device->private_data;
+    uint8_t options4 = 0;
+    uint8_t ext_identifier = 0;
+
+    if ((!sdi_qsfp_shadow_copy(qsfp_device, QSFP_OPTIONS4_OFFSET, &options4, 1))
+            || (!sdi_qsfp_shadow_copy(qsfp_device, QSFP_EXT_IDENTIFIER_OFFSET,
+                                      &ext_identifier, 1))) {
+        return false;
+    }
+
+    feature_support->qsfp_features.tx_control_support_status =
+        (STD_BIT_TEST(options4, QSFP_TX_DISABLE_BIT_OFFSET) != 0);
+    feature_support->qsfp_features.paging_support_status = qsfp_priv_data->paging_support;
+    feature_support->qsfp_features.rate_select_status =
+        (STD_BIT_TEST(options4, QSFP_RATE_SELECT_BIT_OFFSET) != 0);
+    feature_support->qsfp_features.software_controlled_power_mode_status =
+        ((ext_identifier & 0x03) != 0);
+    return true;
+}
+
 /* This function checks whether tx_disable implemented for this module */
 static inline t_std_error sdi_is_tx_control_supported(sdi_device_hdl_t qsfp_device,
                                                       bool *support_status)
@@ -1024,7 +1145,13 @@ t_std_error sdi_qsfp_channel_status_get (sdi_resource_hdl_t resource_hdl, uint_t
     sdi_device_hdl_t qsfp_device = NULL;
     qsfp_device_t *qsfp_priv_data = NULL;
     t_std_error rc = STD_ERR_OK;
-    uint8_t buf = 0;
+    uint8_t tx_control_buf = 0;
+    uint8_t tx_fault_buf = 0;
+    uint8_t tx_los_buf = 0;
+    uint8_t rx_los_buf = 0;
+    sdi_i2c_batch_op_t ops[4];
+    uint_t count = 0;
+    bool is_qsfp_dd = false;
 
     STD_ASSERT(resource_hdl != NULL);
     STD_ASSERT(status != NULL);
@@ -1043,6 +1170,44 @@ t_std_error sdi_qsfp_channel_status_get (sdi_resource_hdl_t resource_hdl, uint_t
         return SDI_DEVICE_ERR_PARAM;
     }
 
+    is_qsfp_dd = (qsfp_priv_data->mod_category == SDI_CATEGORY_QSFPDD);
+
+    /* All the status registers are read with a single batch */
+    if( ((flags) & (SDI_MEDIA_STATUS_TXDISABLE)) ) {
+        ops[count++] = (sdi_i2c_batch_op_t) {
+            .operation = SDI_I2C_READ, .buffer = &tx_control_buf, .len = 1,
+            .offset = is_qsfp_dd ? QSFP_DD_TX_CONTROL_OFFSET : QSFP_TX_CONTROL_OFFSET };
+    }
+
+    if( ((flags) & (SDI_MEDIA_STATUS_TXFAULT)) ) {
+        ops[count++] = (sdi_i2c_batch_op_t) {
+            .operation = SDI_I2C_READ, .buffer = &tx_fault_buf, .len = 1,
+            .offset = is_qsfp_dd ? QSFP_DD_CHANNEL_TXFAULT_INDICATOR
+                                 : QSFP_CHANNEL_TXFAULT_INDICATOR };
+    }
+
+    if (is_qsfp_dd) {
+        if( flags & SDI_MEDIA_STATUS_TXLOSS ) {
+            ops[count++] = (sdi_i2c_batch_op_t) {
+                .operation = SDI_I2C_READ, .buffer = &tx_los_buf, .len = 1,
+                .offset = QSFP_DD_CHANNEL_TX_LOS_INDICATOR };
+        }
+        if( flags & SDI_MEDIA_STATUS_RXLOSS ) {
+            ops[count++] = (sdi_i2c_batch_op_t) {
+                .operation = SDI_I2C_READ, .buffer = &rx_los_buf, .len = 1,
+                .offset = QSFP_DD_CHANNEL_RX_LOS_INDICATOR };
+        }
+    } else if( ( (flags) & ((SDI_MEDIA_STATUS_TXLOSS)|(SDI_MEDIA_STATUS_RXLOSS)) ) ) {
+        /* TX and RX LOS share a register on QSFP */
+        ops[count++] = (sdi_i2c_batch_op_t) {
+            .operation = SDI_I2C_READ, .buffer = &tx_los_buf, .len = 1,
+            .offset = QSFP_CHANNEL_LOS_INDICATOR };
+    }
+
+    if (count == 0) {
+        return STD_ERR_OK;
+    }
+
     rc = sdi_qsfp_module_select(qsfp_device);
     if (rc != STD_ERR_OK){
         return rc;
@@ -1051,100 +1216,41 @@ t_std_error sdi_qsfp_channel_status_get (sdi_resource_hdl_t resource_hdl, uint_t
     do {
         std_usleep(MILLI_TO_MICRO(qsfp_priv_data->delay));
 
-        if( ((flags) & (SDI_MEDIA_STATUS_TXDISABLE)) ) {
-            uint_t tx_control = (qsfp_priv_data->mod_category == SDI_CATEGORY_QSFPDD)
-                                     ? QSFP_DD_TX_CONTROL_OFFSET
-                                     : QSFP_TX_CONTROL_OFFSET;
-            rc = sdi_smbus_read_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
-                    tx_control, &buf, SDI_I2C_FLAG_NONE);
-            if (rc != STD_ERR_OK){
-                SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d"
-                        "rc : %d", qsfp_device->addr, rc);
-                break;
-            }
+        rc = sdi_i2c_batch_execute(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
+                                   ops, count, SDI_I2C_FLAG_NONE);
+        if (rc != STD_ERR_OK){
+            SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d"
+                    "rc : %d", qsfp_device->addr, rc);
+            break;
+        }
 
-            if ( (STD_BIT_TEST(buf, channel)) != 0 ) {
-                *status |= SDI_MEDIA_STATUS_TXDISABLE;
-            }
+        if( ((flags) & (SDI_MEDIA_STATUS_TXDISABLE))
+                && ((STD_BIT_TEST(tx_control_buf, channel)) != 0) ) {
+            *status |= SDI_MEDIA_STATUS_TXDISABLE;
         }
 
-        if( ((flags) & (SDI_MEDIA_STATUS_TXFAULT)) ) {
+        if( ((flags) & (SDI_MEDIA_STATUS_TXFAULT))
+                && ((STD_BIT_TEST(tx_fault_buf, channel)) != 0) ) {
+            *status |= SDI_MEDIA_STATUS_TXFAULT;
+        }
 
-            uint_t tx_fault = (qsfp_priv_data->mod_category == SDI_CATEGORY_QSFPDD)
-                                ? QSFP_DD_CHANNEL_TXFAULT_INDICATOR
-                                : QSFP_CHANNEL_TXFAULT_INDICATOR;
-            rc = sdi_smbus_read_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
-                    tx_fault, &buf, SDI_I2C_FLAG_NONE);
-            if (rc != STD_ERR_OK){
-                SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d"
-                        "rc : %d", qsfp_device->addr, rc);
-                break;
+        if (is_qsfp_dd) {
+            if( (flags & SDI_MEDIA_STATUS_TXLOSS)
+                    && (tx_los_buf & QSFP_DD_TX_LOS_FLAG(channel)) ) {
+                *status |= SDI_MEDIA_STATUS_TXLOSS;
             }
 
-            if ( (STD_BIT_TEST(buf, channel)) != 0 ) {
-                *status |= SDI_MEDIA_STATUS_TXFAULT;
+            if( (flags & SDI_MEDIA_STATUS_RXLOSS)
+                    && (rx_los_buf & QSFP_DD_RX_LOS_FLAG(channel)) ) {
+                *status |= SDI_MEDIA_STATUS_RXLOSS;
+            }
+        } else if( ( (flags) & ((SDI_MEDIA_STATUS_TXLOSS)|(SDI_MEDIA_STATUS_RXLOSS)) ) ) {
+            if( (tx_los_buf & QSFP_TX_LOS_FLAG(channel))  ) {
+                *status |= SDI_MEDIA_STATUS_TXLOSS;
             }
-        }
-
-        if( ( (flags) & ((SDI_MEDIA_STATUS_TXLOSS)|(SDI_MEDIA_STATUS_RXLOSS)) ) ) {
-
-            if (qsfp_priv_data->mod_category == SDI_CATEGORY_QSFPDD) {
-
-                if( flags & SDI_MEDIA_STATUS_TXLOSS ) {
-
-                    rc = sdi_smbus_read_byte(qsfp_device->bus_hdl,
-                            qsfp_device->addr.i2c_addr,
-                            QSFP_DD_CHANNEL_TX_LOS_INDICATOR, &buf,
-                            SDI_I2C_FLAG_NONE);
-
-                    if (rc != STD_ERR_OK){
-                        SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d"
-                                "rc : %d", qsfp_device->addr, rc);
-                        break;
-                    }
-
-                    if ( buf & QSFP_DD_TX_LOS_FLAG(channel) ) {
-
-                        *status |= SDI_MEDIA_STATUS_TXLOSS;
-                    }
-                }
-
-                if( flags & SDI_MEDIA_STATUS_RXLOSS ) {
-
-                    rc = sdi_smbus_read_byte(qsfp_device->bus_hdl,
-                            qsfp_device->addr.i2c_addr,
-                            QSFP_DD_CHANNEL_RX_LOS_INDICATOR, &buf,
-                            SDI_I2C_FLAG_NONE);
-
-                    if (rc != STD_ERR_OK){
-                        SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d"
-                                "rc : %d", qsfp_device->addr, rc);
-                        break;
-                    }
-
-                    if ( buf & QSFP_DD_RX_LOS_FLAG(channel) ) {
-
-                        *status |= SDI_MEDIA_STATUS_RXLOSS;
-                    }
-                }
-
-            } else {
-
-                rc = sdi_smbus_read_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
-                        QSFP_CHANNEL_LOS_INDICATOR, &buf, SDI_I2C_FLAG_NONE);
-                if (rc != STD_ERR_OK){
-                    SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d"
-                            "rc : %d", qsfp_device->addr, rc);
-                    break;
-                }
-
-                if( (buf & QSFP_TX_LOS_FLAG(channel))  ) {
-                    *status |= SDI_MEDIA_STATUS_TXLOSS;
-                }
 
-                if( (buf & QSFP_RX_LOS_FLAG(channel))  ) {
-                    *status |= SDI_MEDIA_STATUS_RXLOSS;
-                }
+            if( (tx_los_buf & QSFP_RX_LOS_FLAG(channel))  ) {
+                *status |= SDI_MEDIA_STATUS_RXLOSS;
             }
         }
     } while(0);
@@ -1317,6 +1423,8 @@ t_std_error sdi_qsfp_cdr_status_set (sdi_resource_hdl_t resource_hdl, uint_t cha
     qsfp_device_t *qsfp_priv_data = NULL;
     t_std_error rc = STD_ERR_OK;
     uint8_t buf = 0;
+    uint8_t tx_buf = 0;
+    uint8_t rx_buf = 0;
     uint_t support_status = 0;
 
     STD_ASSERT(resource_hdl != NULL);
@@ -1353,9 +1461,16 @@ t_std_error sdi_qsfp_cdr_status_set (sdi_resource_hdl_t resource_hdl, uint_t cha
 
         if (qsfp_priv_data->mod_category == SDI_CATEGORY_QSFPDD) {
 
-            //TX_CDR_CONTROL
-            rc = sdi_smbus_read_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
-                QSFP_DD_TX_CDR_CONTROL_OFFSET, &buf, SDI_I2C_FLAG_NONE);
+            /* TX and RX CDR controls are read and written back in one batch each */
+            sdi_i2c_batch_op_t ops[] = {
+                { .operation = SDI_I2C_READ, .offset = QSFP_DD_TX_CDR_CONTROL_OFFSET,
+                  .buffer = &tx_buf, .len = 1 },
+                { .operation = SDI_I2C_READ, .offset = QSFP_DD_RX_CDR_CONTROL_OFFSET,
+                  .buffer = &rx_buf, .len = 1 },
+            };
+
+            rc = sdi_i2c_batch_execute(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
+                    ops, sizeof(ops)/sizeof(ops[0]), SDI_I2C_FLAG_NONE);
 
             if (rc != STD_ERR_OK){
                 SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d rc : %d",
@@ -1365,46 +1480,26 @@ t_std_error sdi_qsfp_cdr_status_set (sdi_resource_hdl_t resource_hdl, uint_t cha
 
             if (enable == true){
                 if (support_status & (1 << QSFP_TX_CDR_CONTROL_BIT_OFFSET)) {
-                    STD_BIT_SET(buf, QSFP_DD_TX_CDR_CONTROL_BIT(channel));
+                    STD_BIT_SET(tx_buf, QSFP_DD_TX_CDR_CONTROL_BIT(channel));
                 }
 
+                if (support_status & (1 << QSFP_RX_CDR_CONTROL_BIT_OFFSET)) {
+                    STD_BIT_SET(rx_buf, QSFP_DD_RX_CDR_CONTROL_BIT(channel));
+                }
             } else {
                 if (support_status & (1 << QSFP_TX_CDR_CONTROL_BIT_OFFSET)) {
-                    STD_BIT_CLEAR(buf, QSFP_DD_TX_CDR_CONTROL_BIT(channel));
+                    STD_BIT_CLEAR(tx_buf, QSFP_DD_TX_CDR_CONTROL_BIT(channel));
                 }
-            }
 
-            rc = sdi_smbus_write_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
-                    QSFP_DD_TX_CDR_CONTROL_OFFSET, buf, SDI_I2C_FLAG_NONE);
-            if (rc != STD_ERR_OK){
-                SDI_DEVICE_ERRMSG_LOG("qsfp smbus write failed at addr : %d rc : %d",
-                        qsfp_device->addr, rc);
-            }
-
-
-            //RX_CDR_CONTROL
-            rc = sdi_smbus_read_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
-                QSFP_DD_RX_CDR_CONTROL_OFFSET, &buf, SDI_I2C_FLAG_NONE);
-
-            if (rc != STD_ERR_OK){
-                SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d rc : %d",
-                        qsfp_device->addr, rc);
-                break;
-            }
-
-            if (enable == true){
                 if (support_status & (1 << QSFP_RX_CDR_CONTROL_BIT_OFFSET)) {
-                    STD_BIT_SET(buf, QSFP_DD_RX_CDR_CONTROL_BIT(channel));
-                }
-
-            } else {
-                if (support_status & (1 << QSFP_RX_CDR_CONTROL_BIT_OFFSET)) {
-                    STD_BIT_CLEAR(buf, QSFP_DD_RX_CDR_CONTROL_BIT(channel));
+                    STD_BIT_CLEAR(rx_buf, QSFP_DD_RX_CDR_CONTROL_BIT(channel));
                 }
             }
 
-            rc = sdi_smbus_write_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
-                    QSFP_DD_RX_CDR_CONTROL_OFFSET, buf, SDI_I2C_FLAG_NONE);
+            ops[0].operation = SDI_I2C_WRITE;
+            ops[1].operation = SDI_I2C_WRITE;
+            rc = sdi_i2c_batch_execute(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
+                    ops, sizeof(ops)/sizeof(ops[0]), SDI_I2C_FLAG_NONE);
             if (rc != STD_ERR_OK){
                 SDI_DEVICE_ERRMSG_LOG("qsfp smbus write failed at addr : %d rc : %d",
                         qsfp_device->addr, rc);
@@ -1636,67 +1731,76 @@ t_std_error sdi_qsfp_parameter_get(sdi_resource_hdl_t resource_hdl,
 
         return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
     }
-    rc = sdi_qsfp_module_select(qsfp_device);
-    if (rc != STD_ERR_OK){
-        return rc;
-    }
 
-    do {
-        std_usleep(MILLI_TO_MICRO(qsfp_priv_data->delay));
-
-        /* verify assumption that length code conversion is needed  */
-        if (length_code_conversion_needed) {
-            rc = sdi_smbus_read_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
-                   QSFP28_DD_R3_LANE_ASSIGNMENT_OFFSET, &byte_buf, SDI_I2C_FLAG_NONE);
-            if (rc != STD_ERR_OK){
-                SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d rc : %d",
-                        ", when attempting lane assignment read for cable  ength checking."
-                                ,qsfp_device->addr, rc);
-                length_code_conversion_needed = false;
-                break;
-            }
-
-            /* length code method is only implemented in spec versions that use non-zero lane assignment */
-            length_code_conversion_needed = (bool)(byte_buf > 0);
+    /* Static fields of upper page 0 are served from the eeprom shadow */
+    if ((!length_code_conversion_needed) && (size <= sizeof(buf))
+            && (sdi_qsfp_shadow_copy(qsfp_device, offset, buf, size))) {
+        byte_buf = buf[0];
+        word_buf[0] = buf[0];
+        word_buf[1] = buf[1];
+    } else {
+        rc = sdi_qsfp_module_select(qsfp_device);
+        if (rc != STD_ERR_OK){
+            return rc;
         }
 
-        switch (size)
-        {
-            case SDI_QSFP_BYTE_SIZE:
-                rc = sdi_smbus_read_byte(qsfp_device->bus_hdl,
-                        qsfp_device->addr.i2c_addr, offset,
-                        &byte_buf, SDI_I2C_FLAG_NONE);
-                if (rc != STD_ERR_OK) {
-                    SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d reg : %d"
-                            "rc : %d", qsfp_device->addr, offset, rc);
-                }
-                break;
+        do {
+            std_usleep(MILLI_TO_MICRO(qsfp_priv_data->delay));
 
-            case SDI_QSFP_WORD_SIZE:
-                rc = sdi_smbus_read_word(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
-                        offset,&temp_buf, SDI_I2C_FLAG_NONE);
-               sdi_platform_util_write_16bit_to_bytearray_le(word_buf,temp_buf);
-                if (rc != STD_ERR_OK) {
-                    SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d reg : %d"
-                            "rc : %d", qsfp_device->addr, offset, rc);
+            /* verify assumption that length code conversion is needed  */
+            if (length_code_conversion_needed) {
+                rc = sdi_smbus_read_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
+                       QSFP28_DD_R3_LANE_ASSIGNMENT_OFFSET, &byte_buf, SDI_I2C_FLAG_NONE);
+                if (rc != STD_ERR_OK){
+                    SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d rc : %d",
+                            ", when attempting lane assignment read for cable  ength checking."
+                                    ,qsfp_device->addr, rc);
+                    length_code_conversion_needed = false;
+                    break;
                 }
-                break;
 
-            case SDI_QSFP_DOUBLE_WORD_SIZE:
-                rc = sdi_smbus_read_multi_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
-                        offset, buf, SDI_QSFP_DOUBLE_WORD_SIZE, SDI_I2C_FLAG_NONE);
-                if (rc != STD_ERR_OK) {
-                    SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d reg : %d"
-                            "rc : %d", qsfp_device->addr, offset, rc);
-                }
-                break;
+                /* length code method is only implemented in spec versions that use non-zero lane assignment */
+                length_code_conversion_needed = (bool)(byte_buf > 0);
+            }
 
-            default:
-                rc = SDI_DEVICE_ERRCODE(EINVAL);
-        }
-    } while(0);
+            switch (size)
+            {
+                case SDI_QSFP_BYTE_SIZE:
+                    rc = sdi_smbus_read_byte(qsfp_device->bus_hdl,
+                            qsfp_device->addr.i2c_addr, offset,
+                            &byte_buf, SDI_I2C_FLAG_NONE);
+                    if (rc != STD_ERR_OK) {
+                        SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d reg : %d"
+                                "rc : %d", qsfp_device->addr, offset, rc);
+                    }
+                    break;
 
-    sdi_qsfp_module_deselect(qsfp_priv_data);
+                case SDI_QSFP_WORD_SIZE:
+                    rc = sdi_smbus_read_word(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
+                            offset,&temp_buf, SDI_I2C_FLAG_NONE);
+                   sdi_platform_util_write_16bit_to_bytearray_le(word_buf,temp_buf);
+                    if (rc != STD_ERR_OK) {
+                        SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d reg : %d"
+                                "rc : %d", qsfp_device->addr, offset, rc);
+                    }
+                    break;
+
+                case SDI_QSFP_DOUBLE_WORD_SIZE:
+                    rc = sdi_smbus_read_multi_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
+                            offset, buf, SDI_QSFP_DOUBLE_WORD_SIZE, SDI_I2C_FLAG_NONE);
+                    if (rc != STD_ERR_OK) {
+                        SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d reg : %d"
+                                "rc : %d", qsfp_device->addr, offset, rc);
+                    }
+                    break;
+
+                default:
+                    rc = SDI_DEVICE_ERRCODE(EINVAL);
+            }
+        } while(0);
+
+        sdi_qsfp_module_deselect(qsfp_priv_data);
+    }
 
     if(rc == STD_ERR_OK) {
         if(size == SDI_QSFP_BYTE_SIZE) {
@@ -1764,37 +1868,36 @@ t_std_error sdi_qsfp_vendor_info_get(sdi_resource_hdl_t resource_hdl,
                                        size);
     }
 
-    rc = sdi_qsfp_module_select(qsfp_device);
-    if (rc != STD_ERR_OK){
-        return rc;
+    if (qsfp_priv_data->eeprom_version >= QSFP28_DD_EEPROM_VERSION_3) {
+        offset = vendor_reg_info_qsfp28_dd_r3[vendor_info_type].offset;
+        data_len = vendor_reg_info_qsfp28_dd_r3[vendor_info_type].size;
+        printable = vendor_reg_info_qsfp28_dd_r3[vendor_info_type].printable;
+    } else {
+        offset = vendor_reg_info[vendor_info_type].offset;
+        data_len = vendor_reg_info[vendor_info_type].size;
+        printable = vendor_reg_info[vendor_info_type].printable;
     }
 
-    do {
-        std_usleep(MILLI_TO_MICRO(qsfp_priv_data->delay));
+    /* Input buffer size should be greater than or equal to data len*/
+    STD_ASSERT(size >= data_len);
 
-        if (qsfp_priv_data->eeprom_version >= QSFP28_DD_EEPROM_VERSION_3) {
-            offset = vendor_reg_info_qsfp28_dd_r3[vendor_info_type].offset;
-            data_len = vendor_reg_info_qsfp28_dd_r3[vendor_info_type].size;
-            printable = vendor_reg_info_qsfp28_dd_r3[vendor_info_type].printable;
-        } else {
-            offset = vendor_reg_info[vendor_info_type].offset;
-            data_len = vendor_reg_info[vendor_info_type].size;
-            printable = vendor_reg_info[vendor_info_type].printable;
+    if (!sdi_qsfp_shadow_copy(qsfp_device, offset, data_buf, data_len - 1)) {
+        rc = sdi_qsfp_module_select(qsfp_device);
+        if (rc != STD_ERR_OK){
+            return rc;
         }
 
-        /* Input buffer size should be greater than or equal to data len*/
-        STD_ASSERT(size >= data_len);
+        std_usleep(MILLI_TO_MICRO(qsfp_priv_data->delay));
 
         rc = sdi_smbus_read_multi_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
                 offset, data_buf, data_len - 1, SDI_I2C_FLAG_NONE);
         if (rc != STD_ERR_OK) {
             SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d reg : %d"
                     "rc : %d", qsfp_device->addr, offset, rc);
-            break;
         }
-    } while(0);
 
-    sdi_qsfp_module_deselect(qsfp_priv_data);
+        sdi_qsfp_module_deselect(qsfp_priv_data);
+    }
 
     if( rc == STD_ERR_OK) {
         /* If the field is marked printable, then ensure that it contains only
@@ -1852,6 +1955,12 @@ t_std_error sdi_qsfp_transceiver_code_get(sdi_resource_hdl_t resource_hdl,
                                             transceiver_info);
     }
 
+    if (sdi_qsfp_shadow_copy(qsfp_device, QSFP_COMPLIANCE_CODE_OFFSET, buf,
+                             SDI_QSFP_QUAD_WORD_SIZE)) {
+        memcpy((char *)transceiver_info, (char *)buf, SDI_QSFP_QUAD_WORD_SIZE);
+        return STD_ERR_OK;
+    }
+
     rc = sdi_qsfp_module_select(qsfp_device);
     if (rc != STD_ERR_OK){
         return rc;
@@ -2253,6 +2362,9 @@ t_std_error sdi_qsfp_channel_monitor_get (sdi_resource_hdl_t resource_hdl, uint_
             *value = convert_qsfp_rx_power(buf);
         } else if(monitor == SDI_MEDIA_INTERNAL_TX_POWER_BIAS) {
             *value = convert_qsfp_tx_bias(buf);
+        } else if(monitor == SDI_MEDIA_INTERNAL_TX_OUTPUT_POWER) {
+            /* Same units as rx power */
+            *value = convert_qsfp_rx_power(buf);
         }
     }
     SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d"
@@ -2261,6 +2373,127 @@ t_std_error sdi_qsfp_channel_monitor_get (sdi_resource_hdl_t resource_hdl, uint_
     return rc;
 }
 
+/**
+ * Read module and channel monitors of a range of channels of the specified
+ * QSFP. The whole monitor register window is fetched in one block read.
+ * resource_hdl[in]  - Handle of the resource
+ * first_channel[in] - first channel of the range
+ * channel_count[in] - number of channels of interest
+ * snapshot[out]     - monitors of the media
+ * return           - t_std_error
+ */
+t_std_error sdi_qsfp_dom_snapshot_read (sdi_resource_hdl_t resource_hdl, uint_t first_channel,
+                                        uint_t channel_count, sdi_media_dom_snapshot_t *snapshot)
+{
+    sdi_device_hdl_t qsfp_device = NULL;
+    qsfp_device_t *qsfp_priv_data = NULL;
+    t_std_error rc = STD_ERR_OK;
+    uint8_t window[SDI_MEDIA_PAGE_SIZE] = { 0 };
+    uint_t temp_offset = QSFP_TEMPERATURE_OFFSET;
+    uint_t volt_offset = QSFP_DD_VOLTAGE_OFFSET;
+    uint_t tx_bias_offset = QSFP_TX1_POWER_BIAS_OFFSET;
+    uint_t max_channels = SDI_QSFP_CHANNEL_FOUR + 1;
+    uint_t end_offset = 0;
+    uint_t channel = 0;
+    uint_t lane = 0;
+    bool is_qsfp_dd = false;
+
+    STD_ASSERT(resource_hdl != NULL);
+    STD_ASSERT(snapshot != NULL);
+
+    qsfp_device = (sdi_device_hdl_t)resource_hdl;
+    qsfp_priv_data = (qsfp_device_t *)qsfp_device->private_data;
+    STD_ASSERT(qsfp_priv_data != NULL);
+
+    if (qsfp_priv_data->mod_type == QSFP_QSA_ADAPTER) {
+        return sdi_sfp_dom_snapshot_get(qsfp_priv_data->sfp_device, channel_count, snapshot);
+    }
+
+    /* Same registers as module and channel monitor get */
+    if (qsfp_priv_data->eeprom_version >= QSFP28_DD_EEPROM_VERSION_3 ){
+        temp_offset = QSFP28_DD_R3_TEMPERATURE_OFFSET;
+        volt_offset = QSFP28_DD_R3_VOLTAGE_OFFSET;
+    } else if (qsfp_priv_data->eeprom_version >= QSFP28_DD_EEPROM_VERSION_2) {
+        temp_offset = QSFP28_DD_R2_TEMPERATURE_OFFSET;
+        volt_offset = QSFP28_DD_R2_VOLTAGE_OFFSET;
+    }
+
+    is_qsfp_dd = (qsfp_priv_data->mod_category == SDI_CATEGORY_QSFPDD);
+    if (is_qsfp_dd) {
+        tx_bias_offset = QSFP_DD_TX1_BIAS_OFFSET;
+        max_channels = SDI_QSFP_CHANNEL_EIGHT + 1;
+    }
+
+    if (first_channel >= max_channels) {
+        channel_count = 0;
+    } else if ((first_channel + channel_count) > max_channels) {
+        channel_count = max_channels - first_channel;
+    }
+
+    /* Window ends with the last monitor of the last lane of interest */
+    end_offset = volt_offset + SDI_QSFP_WORD_SIZE;
+    if (channel_count != 0) {
+        lane = first_channel + channel_count - 1;
+        end_offset = (is_qsfp_dd ? QSFP_DD_TX1_POWER_OFFSET : tx_bias_offset)
+                      + ((lane + 1) * SDI_QSFP_WORD_SIZE);
+    }
+
+    rc = sdi_qsfp_module_select(qsfp_device);
+    if (rc != STD_ERR_OK){
+        return rc;
+    }
+
+    std_usleep(MILLI_TO_MICRO(qsfp_priv_data->delay));
+
+    rc = sdi_smbus_read_multi_byte(qsfp_device->bus_hdl, qsfp_device->addr.i2c_addr,
+            temp_offset, window, end_offset - temp_offset, SDI_I2C_FLAG_NONE);
+    if (rc != STD_ERR_OK){
+        SDI_DEVICE_ERRMSG_LOG("qsfp smbus read failed at addr : %d reg : %d ",
+                qsfp_device->addr, temp_offset);
+    }
+
+    sdi_qsfp_module_deselect(qsfp_priv_data);
+
+    if (rc != STD_ERR_OK) {
+        return rc;
+    }
+
+    snapshot->channel_count = channel_count;
+    snapshot->module_monitor_valid = true;
+    snapshot->temperature = convert_qsfp_temp(&window[0]);
+    snapshot->voltage = convert_qsfp_volt(&window[volt_offset - temp_offset]);
+
+    snapshot->rx_power_valid = (channel_count != 0);
+    snapshot->tx_bias_valid = (channel_count != 0);
+    snapshot->tx_power_valid = ((channel_count != 0) && is_qsfp_dd);
+    for (channel = 0; channel < channel_count; channel++) {
+        lane = (first_channel + channel) * SDI_QSFP_WORD_SIZE;
+        snapshot->rx_power[channel] =
+            convert_qsfp_rx_power(&window[QSFP_RX1_POWER_OFFSET + lane - temp_offset]);
+        snapshot->tx_bias[channel] =
+            convert_qsfp_tx_bias(&window[tx_bias_offset + lane - temp_offset]);
+        if (is_qsfp_dd) {
+            snapshot->tx_power[channel] =
+                convert_qsfp_rx_power(&window[QSFP_DD_TX1_POWER_OFFSET + lane - temp_offset]);
+        }
+    }
+
+    return rc;
+}
+
+/**
+ * Read all module and channel monitors of the specified QSFP in one go
+ * resource_hdl[in]  - Handle of the resource
+ * channel_count[in] - number of channels of interest
+ * snapshot[out]     - monitors of the media
+ * return           - t_std_error
+ */
+t_std_error sdi_qsfp_dom_snapshot_get (sdi_resource_hdl_t resource_hdl, uint_t channel_count,
+                                       sdi_media_dom_snapshot_t *snapshot)
+{
+    return sdi_qsfp_dom_snapshot_read(resource_hdl, 0, channel_count, snapshot);
+}
+
 /**
  * Get the inforamtion of whether optional features supported or not on a given
  * module
@@ -2288,6 +2521,10 @@ t_std_error sdi_qsfp_feature_support_status_get (sdi_resource_hdl_t resource_hdl
                                                   feature_support);
     }
 
+    if (sdi_qsfp_shadow_feature_support_get(qsfp_device, feature_support)) {
+        return STD_ERR_OK;
+    }
+
     rc = sdi_qsfp_module_select(qsfp_device);
     if (rc != STD_ERR_OK){
         return rc;
@@ -2736,6 +2973,25 @@ static qsfp_category_t sdi_qsfp_get_category(uint_t identifier)
     return category;
 }
 
+/*
+ * @brief Drop the eeprom data cached for the inserted module
+ * @param[in] resource_hdl - handle to the qsfp
+ * @return - none
+ */
+void sdi_qsfp_module_cache_invalidate(sdi_resource_hdl_t resource_hdl)
+{
+    sdi_device_hdl_t qsfp_device = NULL;
+    qsfp_device_t *qsfp_priv_data = NULL;
+
+    STD_ASSERT(resource_hdl != NULL);
+
+    qsfp_device = (sdi_device_hdl_t)resource_hdl;
+    qsfp_priv_data = (qsfp_device_t *)qsfp_device->private_data;
+    STD_ASSERT(qsfp_priv_data != NULL);
+
+    sdi_media_shadow_invalidate(&qsfp_priv_data->eeprom);
+}
+
 /*
  * @brief initialize the module
  * @param[in] resource_hdl - handle to the qsfp
@@ -2758,6 +3014,8 @@ t_std_error sdi_qsfp_module_init (sdi_resource_hdl_t resource_hdl, bool pres)
     STD_ASSERT(qsfp_priv_data != NULL);
 
   	qsfp_priv_data->eeprom_version = 0;
+    /* Static eeprom data of a previous module must not be served */
+    sdi_qsfp_module_cache_invalidate(resource_hdl);
   
     if (pres == false) {
         if (qsfp_priv_data->mod_type == QSFP_QSA_ADAPTER) {
@@ -85,6 +85,9 @@ static t_std_error sdi_sfp_presence_get (sdi_resource_hdl_t resource_hdl, bool *
     if( rc == STD_ERR_OK) {
         if(  (STD_BIT_TEST(value, sfp_priv_data->mod_pres_bitmask)) == 0 ) {
             *pres = false;
+            /* Eeprom shadow and calibration constants belong to the
+             * removed module */
+            sdi_sfp_module_cache_invalidate(resource_hdl);
         } else {
             *pres = true;
         }
@@ -92,6 +95,114 @@ static t_std_error sdi_sfp_presence_get (sdi_resource_hdl_t resource_hdl, bool *
     return rc;
 }
 
+/**
+ * Gets the file descriptor signalling presence changes of sfp module
+ * resource_hdl[in] - Handle of the sfp resource
+ * fd[out]        - pollable file descriptor of the presence pin group
+ * return t_std_error
+ */
+static t_std_error sdi_sfp_presence_event_fd_get (sdi_resource_hdl_t resource_hdl, int *fd)
+{
+    sdi_device_hdl_t sfp_device = NULL;
+    sfp_device_t *sfp_priv_data = NULL;
+    t_std_error rc = STD_ERR_OK;
+
+    STD_ASSERT(resource_hdl != NULL);
+    STD_ASSERT(fd != NULL);
+
+    sfp_device = (sdi_device_hdl_t)resource_hdl;
+    sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
+    STD_ASSERT(sfp_priv_data != NULL);
+
+    rc = sdi_pin_group_acquire_bus(sfp_priv_data->mod_pres_hdl);
+    if (rc != STD_ERR_OK){
+        return rc;
+    }
+
+    rc = sdi_pin_group_event_fd_get(sfp_priv_data->mod_pres_hdl, fd);
+
+    sdi_pin_group_release_bus(sfp_priv_data->mod_pres_hdl);
+
+    return rc;
+}
+
+/**
+ * Consumes pending presence events of sfp module
+ * resource_hdl[in] - Handle of the sfp resource
+ * return t_std_error
+ */
+static t_std_error sdi_sfp_presence_event_clear (sdi_resource_hdl_t resource_hdl)
+{
+    sdi_device_hdl_t sfp_device = NULL;
+    sfp_device_t *sfp_priv_data = NULL;
+    t_std_error rc = STD_ERR_OK;
+
+    STD_ASSERT(resource_hdl != NULL);
+
+    sfp_device = (sdi_device_hdl_t)resource_hdl;
+    sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
+    STD_ASSERT(sfp_priv_data != NULL);
+
+    rc = sdi_pin_group_acquire_bus(sfp_priv_data->mod_pres_hdl);
+    if (rc != STD_ERR_OK){
+        return rc;
+    }
+
+    rc = sdi_pin_group_event_clear(sfp_priv_data->mod_pres_hdl);
+
+    sdi_pin_group_release_bus(sfp_priv_data->mod_pres_hdl);
+
+    return rc;
+}
+
+/**
+ * Gets presence state of sfp module, reading the presence pin group once for
+ * a batch of modules. sfp has no reset or low power mode control.
+ * resource_hdl[in] - Handle of the sfp resource
+ * levels[in]       - pin group levels of the batch
+ * flags[in]        - SDI_MEDIA_STATE_* bits of interest
+ * state[out]       - SDI_MEDIA_STATE_* bits of the module
+ * return t_std_error
+ */
+static t_std_error sdi_sfp_state_get (sdi_resource_hdl_t resource_hdl,
+                                      sdi_media_pin_levels_t *levels,
+                                      uint_t flags, uint_t *state)
+{
+    sdi_device_hdl_t sfp_device = NULL;
+    sfp_device_t *sfp_priv_data = NULL;
+    t_std_error rc = STD_ERR_OK;
+    uint_t value = 0;
+
+    STD_ASSERT(resource_hdl != NULL);
+    STD_ASSERT(state != NULL);
+
+    *state = 0;
+
+    sfp_device = (sdi_device_hdl_t)resource_hdl;
+    sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
+    STD_ASSERT(sfp_priv_data != NULL);
+
+    if ((flags & SDI_MEDIA_STATE_PRESENT) == 0) {
+        return rc;
+    }
+
+    rc = sdi_media_pin_group_level_get(levels, sfp_priv_data->mod_pres_hdl, &value);
+    if (rc != STD_ERR_OK){
+        SDI_DEVICE_ERRMSG_LOG("presence status get failed for %s",
+                              sfp_device->alias);
+        return rc;
+    }
+
+    if (STD_BIT_TEST(value, sfp_priv_data->mod_pres_bitmask) == 0) {
+        /* Eeprom shadow and calibration constants belong to the
+         * removed module */
+        sdi_sfp_module_cache_invalidate(resource_hdl);
+    } else {
+        *state |= SDI_MEDIA_STATE_PRESENT;
+    }
+    return rc;
+}
+
 /**
  * Set the port LED based on the speed settings of the port
  * resource_hdl[in] - handle to sfp
@@ -177,7 +288,11 @@ t_std_error sdi_sfp_port_info_get (sdi_resource_hdl_t resource_hdl,
 /* Callback handlers for SFP */
 static media_ctrl_t sfp_media = {
     .presence_get = sdi_sfp_presence_get,
+    .presence_event_fd_get = sdi_sfp_presence_event_fd_get,
+    .presence_event_clear = sdi_sfp_presence_event_clear,
+    .state_get = sdi_sfp_state_get,
     .module_init = sdi_sfp_module_init,
+    .module_cache_invalidate = sdi_sfp_module_cache_invalidate,
     .module_monitor_status_get = sdi_sfp_module_monitor_status_get,
     .channel_monitor_status_get = sdi_sfp_channel_monitor_status_get,
     .channel_status_get = sdi_sfp_channel_status_get,
@@ -196,6 +311,7 @@ static media_ctrl_t sfp_media = {
     .module_control_status_get = NULL,  /* sdi_media_module_control_status_get is not supported on sfp */
     .module_monitor_get = sdi_sfp_module_monitor_get,
     .channel_monitor_get = sdi_sfp_channel_monitor_get,
+    .dom_snapshot_get = sdi_sfp_dom_snapshot_get,
     .feature_support_status_get = sdi_sfp_feature_support_status_get,
     .led_set = sdi_sfp_led_set,
     .read = sdi_sfp_read,
@@ -282,6 +398,7 @@ static t_std_error sdi_sfp_register (std_config_node_t node, void *bus_handle,
 
     sfp_data = calloc(sizeof(sfp_device_t), 1);
     STD_ASSERT(sfp_data != NULL);
+    sdi_media_shadow_init(&(sfp_data->eeprom));
 
     dev_hdl->bus_hdl = bus_handle;
     dev_hdl->callbacks = sdi_sfp_entry_callbacks();
@@ -56,6 +56,8 @@
 
 static t_std_error sdi_is_wavelength_tune_supported (sdi_device_hdl_t sfp_device, bool* status);
 static t_std_error sdi_sfp_page_select (sdi_device_hdl_t sfp_device, uint_t page);
+static t_std_error sdi_sfp_calib_get(sdi_device_hdl_t sfp_device, sfp_calib_cache_t *calib);
+static void sdi_sfp_calib_invalidate(sdi_device_hdl_t sfp_device);
 
  /*SFP parameter sizes */
 enum {
@@ -191,8 +193,8 @@ static inline t_std_error sdi_sfp_module_select(sdi_device_hdl_t sfp_device)
             return rc;
         }
 
-        rc = sdi_pin_group_write_level(sfp_priv_data->mux_sel_hdl,
-                                       sfp_priv_data->mux_sel_value);
+        rc = sdi_pin_group_write_level_cached(sfp_priv_data->mux_sel_hdl,
+                                              sfp_priv_data->mux_sel_value);
         if (rc != STD_ERR_OK){
             /* module selection failed, hence release the lock.*/
             sdi_pin_group_release_bus(sfp_priv_data->mux_sel_hdl);
@@ -212,8 +214,8 @@ static inline t_std_error sdi_sfp_module_select(sdi_device_hdl_t sfp_device)
             return rc;
         }
 
-        rc = sdi_pin_group_write_level(sfp_priv_data->mod_sel_hdl,
-                                       sfp_priv_data->mod_sel_value);
+        rc = sdi_pin_group_write_level_cached(sfp_priv_data->mod_sel_hdl,
+                                              sfp_priv_data->mod_sel_value);
         if (rc != STD_ERR_OK){
             /* module selection failed, hence release the lock.*/
             if(sfp_priv_data->mux_sel_hdl != NULL) {
@@ -245,6 +247,71 @@ static inline void sdi_sfp_module_deselect(sfp_device_t *sfp_priv_data)
     }
 }
 
+/**
+ * Read page A0 of the module into its eeprom shadow, once per insertion. The
+ * shadow is used only if CC_BASE and CC_EXT checksums match.
+ * sfp_device[in] - sfp device handle
+ * return none, shadow stays empty on read failure and is read again next time
+ */
+static void sdi_sfp_shadow_load(sdi_device_hdl_t sfp_device)
+{
+    sfp_device_t *sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
+    sdi_media_shadow_t *shadow = &sfp_priv_data->eeprom;
+    uint8_t data[SDI_MEDIA_PAGE_SIZE] = { 0 };
+    uint_t generation = 0;
+    t_std_error rc = STD_ERR_OK;
+
+    if (!sdi_media_shadow_load_begin(shadow, &generation)) {
+        return;
+    }
+
+    rc = sdi_sfp_module_select(sfp_device);
+    if(rc != STD_ERR_OK) {
+        return;
+    }
+
+    rc = sdi_smbus_read_multi_byte(sfp_device->bus_hdl, sfp_device->addr.i2c_addr,
+                                   SFP_IDENTIFIER_OFFSET, data, sizeof(data),
+                                   SDI_I2C_FLAG_NONE);
+
+    sdi_sfp_module_deselect(sfp_priv_data);
+
+    if (rc != STD_ERR_OK) {
+        SDI_DEVICE_ERRMSG_LOG("sfp eeprom shadow read failed for %s rc : %d",
+                              sfp_device->alias, rc);
+        return;
+    }
+
+    if (sdi_media_shadow_checksum_valid(data)) {
+        sdi_media_shadow_publish(shadow, generation, data, SDI_MEDIA_SHADOW_VALID);
+    } else {
+        SDI_DEVICE_TRACEMSG_LOG("sfp eeprom checksum mismatch on %s, reading static fields from module",
+                                sfp_device->alias);
+        sdi_media_shadow_publish(shadow, generation, data, SDI_MEDIA_SHADOW_INVALID);
+    }
+}
+
+/**
+ * Copy static fields of page A0 from the eeprom shadow of the module
+ * sfp_device[in] - sfp device handle
+ * offset[in] - offset of the field
+ * buf[out] - buffer for the field
+ * len[in] - length of the field
+ * return true if field is copied, false if it has to be read from the module
+ */
+static bool sdi_sfp_shadow_copy(sdi_device_hdl_t sfp_device, uint_t offset,
+                                uint8_t *buf, size_t len)
+{
+    sfp_device_t *sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
+
+    if ((offset + len) > SDI_MEDIA_PAGE_SIZE) {
+        return false;
+    }
+
+    sdi_sfp_shadow_load(sfp_device);
+    return sdi_media_shadow_read(&sfp_priv_data->eeprom, offset, buf, len);
+}
+
 /* This function checks whether Alarm/warning flags implemented for this module.
  * Make sure that module is already selected before calling this function */
 static inline t_std_error sdi_is_alarm_flags_supported(sdi_device_hdl_t sfp_device,
@@ -365,6 +432,36 @@ static inline t_std_error sdi_is_ext_mod_ctrl_supported(sdi_device_hdl_t sfp_dev
     return rc;
 }
 
+/* This function fills the optional feature support flags from the eeprom
+ * shadow. Returns false if shadow is not usable. */
+static bool sdi_sfp_shadow_feature_support_get(sdi_device_hdl_t sfp_device,
+                                               sdi_media_supported_feature_t *feature_support)
+{
+    uint8_t options2 = 0;
+    uint8_t diag_mon_type = 0;
+    uint8_t enhanced_options = 0;
+    uint8_t ext_mod_ctrl = 0;
+
+    if ((!sdi_sfp_shadow_copy(sfp_device, SFP_OPTIONS2_OFFSET, &options2, 1))
+            || (!sdi_sfp_shadow_copy(sfp_device, SFP_DIAG_MON_TYPE_OFFSET, &diag_mon_type, 1))
+            || (!sdi_sfp_shadow_copy(sfp_device, SFP_ENHANCED_OPTIONS_OFFSET, &enhanced_options, 1))
+            || (!sdi_sfp_shadow_copy(sfp_device, SFP_EXT_MOD_CTRL_SUPPORT_OFFSET, &ext_mod_ctrl, 1))) {
+        return false;
+    }
+
+    feature_support->sfp_features.alarm_support_status =
+        (STD_BIT_TEST(enhanced_options, SFP_ALARM_SUPPORT_BIT_OFFSET) != 0);
+    feature_support->sfp_features.diag_mntr_support_status =
+        (STD_BIT_TEST(diag_mon_type, SFP_DDM_SUPPORT_BIT_OFFSET) != 0);
+    feature_support->sfp_features.rate_select_status =
+        (STD_BIT_TEST(enhanced_options, SFP_RATE_SELECT_BIT_OFFSET) != 0);
+    feature_support->sfp_features.wavelength_tune_support_status =
+        ((options2 & SDI_SFP_TUNABLE_SUPPORT_BITMASK) != 0);
+    feature_support->sfp_features.ext_mod_ctrl_support_status =
+        (STD_BIT_TEST(ext_mod_ctrl, SFP_EXT_MOD_CTRL_BIT) != 0);
+    return true;
+}
+
 /* Quick herlper wrapper to get ext mod control support */
 static bool sdi_is_sfp_plus_aq_ext_mod_ctrl_sup (sdi_device_hdl_t sfp_device)
 {
@@ -1202,6 +1299,7 @@ t_std_error sdi_sfp_parameter_get(sdi_resource_hdl_t resource_hdl,
     t_std_error rc = STD_ERR_OK;
     uint8_t byte_buf = 0;
     uint8_t word_buf[2] = { 0 } ;
+    uint8_t options2 = 0;
     uint_t offset = 0;
     uint_t size = 0;
     uint16_t temp_buf = 0;
@@ -1223,6 +1321,22 @@ t_std_error sdi_sfp_parameter_get(sdi_resource_hdl_t resource_hdl,
         return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
     }
 
+    /* Static fields of page A0 are served from the eeprom shadow. Tunable
+     * media report the wavelength from page 02 of A2 */
+    if ((param != SDI_TUNE_WAVELENGTH_PICO_METERS) && (size <= sizeof(word_buf))
+            && (sdi_sfp_shadow_copy(sfp_device, offset, word_buf, size))
+            && ((param != SDI_MEDIA_WAVELENGTH)
+                || ((sdi_sfp_shadow_copy(sfp_device, SFP_OPTIONS2_OFFSET, &options2,
+                                         sizeof(options2)))
+                    && ((options2 & SDI_SFP_TUNABLE_SUPPORT_BITMASK) == 0)))) {
+        if(size == SDI_SFP_BYTE_SIZE) {
+            *value = (uint_t)word_buf[0];
+        } else {
+            *value = ( (word_buf[0] << 8) | (word_buf[1]) );
+        }
+        return STD_ERR_OK;
+    }
+
     rc = sdi_sfp_module_select(sfp_device);
     if(rc != STD_ERR_OK) {
         return rc;
@@ -1359,19 +1473,21 @@ t_std_error sdi_sfp_vendor_info_get(sdi_resource_hdl_t resource_hdl,
     /* Input buffer size should be greater than or equal to data len*/
     STD_ASSERT(size >= data_len);
 
-    rc = sdi_sfp_module_select(sfp_device);
-    if(rc != STD_ERR_OK) {
-        return rc;
-    }
+    if (!sdi_sfp_shadow_copy(sfp_device, offset, data_buf, data_len - 1)) {
+        rc = sdi_sfp_module_select(sfp_device);
+        if(rc != STD_ERR_OK) {
+            return rc;
+        }
 
-    rc = sdi_smbus_read_multi_byte(sfp_device->bus_hdl, sfp_device->addr.i2c_addr,
-                                   offset, data_buf, data_len - 1, SDI_I2C_FLAG_NONE);
-    if (rc != STD_ERR_OK) {
-        SDI_DEVICE_ERRMSG_LOG("sfp smbus read failed at addr : %d reg : %d for %s rc : %d",
-                              sfp_device->addr, offset, sfp_device->alias, rc);
-    }
+        rc = sdi_smbus_read_multi_byte(sfp_device->bus_hdl, sfp_device->addr.i2c_addr,
+                                       offset, data_buf, data_len - 1, SDI_I2C_FLAG_NONE);
+        if (rc != STD_ERR_OK) {
+            SDI_DEVICE_ERRMSG_LOG("sfp smbus read failed at addr : %d reg : %d for %s rc : %d",
+                                  sfp_device->addr, offset, sfp_device->alias, rc);
+        }
 
-    sdi_sfp_module_deselect(sfp_priv_data);
+        sdi_sfp_module_deselect(sfp_priv_data);
+    }
 
     if(rc == STD_ERR_OK) {
         /* If the field is marked printable, then ensure that it contains only
@@ -1423,22 +1539,25 @@ t_std_error sdi_sfp_transceiver_code_get(sdi_resource_hdl_t resource_hdl,
     sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
     STD_ASSERT(sfp_priv_data != NULL);
 
-    rc = sdi_sfp_module_select(sfp_device);
-    if(rc != STD_ERR_OK) {
-        return rc;
-    }
-
     memset(xvr_buff, 0, sizeof(xvr_buff));
-    rc = sdi_smbus_read_multi_byte(sfp_device->bus_hdl, sfp_device->addr.i2c_addr,
-                                   SFP_COMPLIANCE_CODE_OFFSET, xvr_buff,
-                                   SDI_SFP_QUAD_WORD_SIZE, SDI_I2C_FLAG_NONE);
+    if (!sdi_sfp_shadow_copy(sfp_device, SFP_COMPLIANCE_CODE_OFFSET, xvr_buff,
+                             SDI_SFP_QUAD_WORD_SIZE)) {
+        rc = sdi_sfp_module_select(sfp_device);
+        if(rc != STD_ERR_OK) {
+            return rc;
+        }
 
-    if (rc != STD_ERR_OK) {
-        SDI_DEVICE_ERRMSG_LOG("sfp smbus read failed at addr : %d for %s rc : %d",
-                              sfp_device->addr, sfp_device->alias, rc);
-    }
+        rc = sdi_smbus_read_multi_byte(sfp_device->bus_hdl, sfp_device->addr.i2c_addr,
+                                       SFP_COMPLIANCE_CODE_OFFSET, xvr_buff,
+                                       SDI_SFP_QUAD_WORD_SIZE, SDI_I2C_FLAG_NONE);
 
-    sdi_sfp_module_deselect(sfp_priv_data);
+        if (rc != STD_ERR_OK) {
+            SDI_DEVICE_ERRMSG_LOG("sfp smbus read failed at addr : %d for %s rc : %d",
+                                  sfp_device->addr, sfp_device->alias, rc);
+        }
+
+        sdi_sfp_module_deselect(sfp_priv_data);
+    }
 
     transceiver_info->sfp_descr.sdi_sfp_eth_10g_code
         = (xvr_buff[0] >> SFP_ETH_10G_CODE_BIT_SHIFT) & SFP_ETH_10G_CODE_MASK;
@@ -1476,16 +1595,10 @@ t_std_error sdi_sfp_threshold_get(sdi_resource_hdl_t resource_hdl,
     sdi_device_hdl_t sfp_device = NULL;
     sfp_device_t *sfp_priv_data = NULL;
     t_std_error rc = STD_ERR_OK;
-    uint_t diag_mon_value = 0;
     uint_t offset = 0;
     uint8_t threshold_buf[2] = { 0 };
     uint16_t temp_buf = 0;
-    sfp_calib_info_t calib_info = { 0 };
-    uint_t slope_offset = 0;
-    uint_t const_offset = 0;
-    sfp_rx_power_calib_info_t rx_pwr_calib_info = { 0 };
-    uint8_t rx_power_data[EXT_CAL_RX_POWER_LEN] = { 0 };
-    uint8_t *rx_power_data_ptr = NULL;
+    sfp_calib_cache_t calib = { 0 };
 
     STD_ASSERT(resource_hdl != NULL);
     STD_ASSERT(value != NULL);
@@ -1494,116 +1607,56 @@ t_std_error sdi_sfp_threshold_get(sdi_resource_hdl_t resource_hdl,
     sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
     STD_ASSERT(sfp_priv_data != NULL);
 
-    /* Check whether diag monitoring is supported on this device or not */
-    rc = sdi_sfp_parameter_get(resource_hdl, SDI_MEDIA_DIAG_MON_TYPE, &diag_mon_value);
-    if (rc != STD_ERR_OK) {
-        SDI_DEVICE_ERRMSG_LOG("Getting of diag monitoring value is failed for %s rc : %d",
-                              sfp_device->alias, rc);
-        return rc;
-    }
-
-    if( (STD_BIT_TEST(diag_mon_value, SFP_DDM_SUPPORT_BIT_OFFSET) == 0) ) {
-        return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
-    }
-
-    /* Get the calibration type */
-    if( (STD_BIT_TEST(diag_mon_value, SFP_CALIB_TYPE_EXTERNAL_BIT_OFFSET) != 0) ) {
-        calib_info.type = SFP_CALIB_TYPE_EXTERNAL;
-    } else  if( (STD_BIT_TEST(diag_mon_value, SFP_CALIB_TYPE_INTERNAL_BIT_OFFSET) != 0) ) {
-        calib_info.type = SFP_CALIB_TYPE_INTERNAL;
-    } else {
-        return (SDI_DEVICE_ERRCODE(EINVAL));
-    }
-
-    offset = threshold_reg_info[threshold_type].offset;
-
     switch(threshold_type)
     {
         case SDI_MEDIA_TEMP_HIGH_ALARM_THRESHOLD:
         case SDI_MEDIA_TEMP_LOW_ALARM_THRESHOLD:
         case SDI_MEDIA_TEMP_HIGH_WARNING_THRESHOLD:
         case SDI_MEDIA_TEMP_LOW_WARNING_THRESHOLD:
-            slope_offset = SFP_CALIB_TEMP_SLOPE_OFFSET;
-            const_offset = SFP_CALIB_TEMP_CONST_OFFSET;
-            break;
-
         case SDI_MEDIA_VOLT_HIGH_ALARM_THRESHOLD:
         case SDI_MEDIA_VOLT_LOW_ALARM_THRESHOLD:
         case SDI_MEDIA_VOLT_HIGH_WARNING_THRESHOLD:
         case SDI_MEDIA_VOLT_LOW_WARNING_THRESHOLD:
-            slope_offset = SFP_CALIB_VOLT_SLOPE_OFFSET;
-            const_offset = SFP_CALIB_VOLT_CONST_OFFSET;
-            break;
-
         case SDI_MEDIA_TX_BIAS_HIGH_ALARM_THRESHOLD:
         case SDI_MEDIA_TX_BIAS_LOW_ALARM_THRESHOLD:
         case SDI_MEDIA_TX_BIAS_HIGH_WARNING_THRESHOLD:
         case SDI_MEDIA_TX_BIAS_LOW_WARNING_THRESHOLD:
-            slope_offset = SFP_CALIB_TX_BIAS_SLOPE_OFFSET;
-            const_offset = SFP_CALIB_TX_BIAS_CONST_OFFSET;
-            break;
-
         case SDI_MEDIA_TX_PWR_HIGH_ALARM_THRESHOLD:
         case SDI_MEDIA_TX_PWR_LOW_ALARM_THRESHOLD:
         case SDI_MEDIA_TX_PWR_HIGH_WARNING_THRESHOLD:
         case SDI_MEDIA_TX_PWR_LOW_WARNING_THRESHOLD:
-            slope_offset = SFP_CALIB_TX_POWER_SLOPE_OFFSET;
-            const_offset = SFP_CALIB_TX_POWER_CONST_OFFSET;
-            break;
-
         case SDI_MEDIA_RX_PWR_HIGH_ALARM_THRESHOLD:
         case SDI_MEDIA_RX_PWR_LOW_ALARM_THRESHOLD:
         case SDI_MEDIA_RX_PWR_HIGH_WARNING_THRESHOLD:
         case SDI_MEDIA_RX_PWR_LOW_WARNING_THRESHOLD:
-            const_offset = SFP_CALIB_RX_POWER_CONST_START_OFFSET;
             break;
 
         default:
             return SDI_DEVICE_ERRCODE(EINVAL);
     }
 
-    rc = sdi_sfp_module_select(sfp_device);
-    if(rc != STD_ERR_OK) {
+    rc = sdi_sfp_calib_get(sfp_device, &calib);
+    if (rc != STD_ERR_OK) {
         return rc;
     }
 
-    do {
-        rc = sdi_smbus_read_word(sfp_device->bus_hdl, sfp_i2c_addr,
-                offset,&temp_buf, SDI_I2C_FLAG_NONE);
-        sdi_platform_util_write_16bit_to_bytearray_le(threshold_buf,temp_buf);
-        if(rc != STD_ERR_OK) {
-            SDI_DEVICE_ERRMSG_LOG("smbus read failed for threshold values with rc : %d", rc);
-            break;
-        }
+    if (!calib.ddm_supported) {
+        return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
+    }
 
-        if(calib_info.type == SFP_CALIB_TYPE_EXTERNAL) {
-            if(const_offset == SFP_CALIB_RX_POWER_CONST_START_OFFSET) {
-                rc = sdi_smbus_read_multi_byte(sfp_device->bus_hdl, sfp_i2c_addr,
-                        const_offset, rx_power_data, EXT_CAL_RX_POWER_LEN, SDI_I2C_FLAG_NONE);
-                if (rc != STD_ERR_OK) {
-                    SDI_DEVICE_ERRMSG_LOG("smbus read failed for rx power calibration constant with rc : %d",
-                                          rc);
-                    break;
-                }
-            } else {
-                rc = sdi_smbus_read_word(sfp_device->bus_hdl, sfp_i2c_addr, slope_offset,
-                      &temp_buf, SDI_I2C_FLAG_NONE);
-                sdi_platform_util_write_16bit_to_bytearray_le((calib_info.slope),temp_buf);
-                if (rc != STD_ERR_OK){
-                    SDI_DEVICE_ERRMSG_LOG("smbus read failed for temp slope constant rc : %d",rc);
-                    break;
+    offset = threshold_reg_info[threshold_type].offset;
 
-                }
+    rc = sdi_sfp_module_select(sfp_device);
+    if(rc != STD_ERR_OK) {
+        return rc;
+    }
 
-                rc = sdi_smbus_read_word(sfp_device->bus_hdl, sfp_i2c_addr, const_offset,
-                        &calib_info.offset, SDI_I2C_FLAG_NONE);
-                if (rc != STD_ERR_OK){
-                    SDI_DEVICE_ERRMSG_LOG("smbus read failed for temp offset constant rc : %d", rc);
-                    break;
-                }
-            }
-        }
-    } while(0);
+    rc = sdi_smbus_read_word(sfp_device->bus_hdl, sfp_i2c_addr,
+            offset,&temp_buf, SDI_I2C_FLAG_NONE);
+    sdi_platform_util_write_16bit_to_bytearray_le(threshold_buf,temp_buf);
+    if(rc != STD_ERR_OK) {
+        SDI_DEVICE_ERRMSG_LOG("smbus read failed for threshold values with rc : %d", rc);
+    }
 
     sdi_sfp_module_deselect(sfp_priv_data);
 
@@ -1612,40 +1665,27 @@ t_std_error sdi_sfp_threshold_get(sdi_resource_hdl_t resource_hdl,
             (threshold_type == SDI_MEDIA_TEMP_LOW_ALARM_THRESHOLD) ||
             (threshold_type == SDI_MEDIA_TEMP_HIGH_WARNING_THRESHOLD) ||
             (threshold_type == SDI_MEDIA_TEMP_LOW_WARNING_THRESHOLD) ) {
-            *value = convert_sfp_temp(threshold_buf, &calib_info);
+            *value = convert_sfp_temp(threshold_buf, &calib.temp);
         } else if( (threshold_type == SDI_MEDIA_VOLT_HIGH_ALARM_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_VOLT_LOW_ALARM_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_VOLT_HIGH_WARNING_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_VOLT_LOW_WARNING_THRESHOLD) ) {
-            *value = convert_sfp_volt(threshold_buf, &calib_info);
+            *value = convert_sfp_volt(threshold_buf, &calib.volt);
         } else if( (threshold_type == SDI_MEDIA_RX_PWR_HIGH_ALARM_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_RX_PWR_LOW_ALARM_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_RX_PWR_HIGH_WARNING_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_RX_PWR_LOW_WARNING_THRESHOLD) ) {
-            rx_pwr_calib_info.type = calib_info.type;
-            if(calib_info.type == SFP_CALIB_TYPE_EXTERNAL) {
-                rx_power_data_ptr = rx_power_data;
-                memcpy(rx_pwr_calib_info.rx_power_const_4, rx_power_data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
-                rx_power_data_ptr = rx_power_data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
-                memcpy(rx_pwr_calib_info.rx_power_const_3, rx_power_data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
-                rx_power_data_ptr = rx_power_data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
-                memcpy(rx_pwr_calib_info.rx_power_const_2, rx_power_data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
-                rx_power_data_ptr = rx_power_data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
-                memcpy(rx_pwr_calib_info.rx_power_const_1, rx_power_data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
-                rx_power_data_ptr = rx_power_data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
-                memcpy(rx_pwr_calib_info.rx_power_const_0, rx_power_data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
-            }
-            *value = convert_sfp_rx_power(threshold_buf, &rx_pwr_calib_info);
+            *value = convert_sfp_rx_power(threshold_buf, &calib.rx_power);
         } else if( (threshold_type == SDI_MEDIA_TX_BIAS_HIGH_ALARM_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_TX_BIAS_LOW_ALARM_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_TX_BIAS_HIGH_WARNING_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_TX_BIAS_LOW_WARNING_THRESHOLD) ) {
-            *value = convert_sfp_tx_bias_current(threshold_buf, &calib_info);
+            *value = convert_sfp_tx_bias_current(threshold_buf, &calib.tx_bias);
         } else if( (threshold_type == SDI_MEDIA_TX_PWR_HIGH_ALARM_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_TX_PWR_LOW_ALARM_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_TX_PWR_HIGH_WARNING_THRESHOLD) ||
                    (threshold_type == SDI_MEDIA_TX_PWR_LOW_WARNING_THRESHOLD) ) {
-            *value = convert_sfp_tx_power(threshold_buf, &calib_info);
+            *value = convert_sfp_tx_power(threshold_buf, &calib.tx_power);
         }
     }
     return rc;
@@ -1678,103 +1718,227 @@ t_std_error sdi_sfp_channel_monitor_threshold_get(sdi_resource_hdl_t resource_hd
 }
 
 /**
- * Read the received output power and calibration constant for output rx_power
+ * Read a monitor value(temperature/voltage/tx bias/tx power/rx power)
  *
  * bus_hdl[in] - Handle of the i2c bus
- * val_offset[in] - Register offset for rx output power
- * buf[out] - buffer for storing rx output power
- * rx_pwr_calib_info[out] - structure contains calibration related information
- * for rx power
- * vs_offset[in] - rx power calibration constant start offset
+ * val_offset[in] - Register offset for the monitor
+ * buf[out] - buffer for storing monitor value
  *
  * return - standard t_std_error
  */
-t_std_error sdi_sfp_rx_power_value_read(sdi_i2c_bus_hdl_t bus_hdl, uint_t val_offset,
-                                        uint16_t *buf, sfp_rx_power_calib_info_t *rx_pwr_calib_info,
-                                        uint_t vs_offset)
+static t_std_error sdi_sfp_monitor_value_read(sdi_i2c_bus_hdl_t bus_hdl, uint_t val_offset,
+                                              uint16_t *buf)
 {
     t_std_error rc = STD_ERR_OK;
-    uint8_t data[EXT_CAL_RX_POWER_LEN] = { 0 };
-    uint8_t *data_ptr = NULL;
 
     STD_ASSERT(bus_hdl != NULL);
-    STD_ASSERT(rx_pwr_calib_info != NULL);
     STD_ASSERT(buf != NULL);
 
     rc = sdi_smbus_read_word(bus_hdl, sfp_i2c_addr, val_offset, buf, SDI_I2C_FLAG_NONE);
     if (rc != STD_ERR_OK) {
-        SDI_DEVICE_ERRMSG_LOG("smbus read failed for temperature with rc : %d", rc);
-        return rc;
-    }
-
-    if(rx_pwr_calib_info->type == SFP_CALIB_TYPE_EXTERNAL) {
-        rc = sdi_smbus_read_multi_byte(bus_hdl, sfp_i2c_addr, vs_offset, data,
-                                       EXT_CAL_RX_POWER_LEN, SDI_I2C_FLAG_NONE);
-        if (rc != STD_ERR_OK) {
-            SDI_DEVICE_ERRMSG_LOG("smbus read failed for rx power calibration constant with rc : %d", rc);
-            return rc;
-        }
-        data_ptr = data;
-        memcpy(rx_pwr_calib_info->rx_power_const_4, data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
-        data_ptr = data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
-        memcpy(rx_pwr_calib_info->rx_power_const_3, data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
-        data_ptr = data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
-        memcpy(rx_pwr_calib_info->rx_power_const_2, data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
-        data_ptr = data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
-        memcpy(rx_pwr_calib_info->rx_power_const_1, data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
-        data_ptr = data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
-        memcpy(rx_pwr_calib_info->rx_power_const_0, data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
+        SDI_DEVICE_ERRMSG_LOG("smbus read failed for monitor at offset %u with rc : %d",
+                              val_offset, rc);
     }
     return rc;
 }
 
 /**
- * Read the requested module monitor values(temperature/votage) from offset specified by
- * val_offset and calibration constants for external calibration types
+ * Read the external calibration constants of a monitor
  *
  * bus_hdl[in] - Handle of the i2c bus
- * val_offset[in] - Register offset for module monitors(temperature/voltage)
- * buf[out] - buffer for storing module monitor values (temperature/voltage)
- * calib_info[out] - structure contains calibration related information
+ * calib_info[out] - structure filled with slope and offset
  * vs_offset[in] - Values Slope Offset for external calibration type
  * vc_offset[in] - Values Constant offset for external calibration type
  *
  * return - standard t_std_error
  */
-t_std_error sdi_sfp_module_monitor_value_read(sdi_i2c_bus_hdl_t bus_hdl, uint_t val_offset,
-                                              uint16_t *buf, sfp_calib_info_t *calib_info,
-                                              uint_t vs_offset, uint_t vc_offset)
+static t_std_error sdi_sfp_calib_constants_read(sdi_i2c_bus_hdl_t bus_hdl,
+                                                sfp_calib_info_t *calib_info,
+                                                uint_t vs_offset, uint_t vc_offset)
 {
     t_std_error rc = STD_ERR_OK;
     uint16_t temp_buf = 0;
-    STD_ASSERT(bus_hdl != NULL);
-    STD_ASSERT(calib_info != NULL);
-    STD_ASSERT(buf != NULL);
 
-    rc = sdi_smbus_read_word(bus_hdl, sfp_i2c_addr, val_offset, buf,
-            SDI_I2C_FLAG_NONE);
+    rc = sdi_smbus_read_word(bus_hdl, sfp_i2c_addr, vs_offset,
+            &temp_buf, SDI_I2C_FLAG_NONE);
     if (rc != STD_ERR_OK){
-        SDI_DEVICE_ERRMSG_LOG("smbus read failed for temperature with rc : %d", rc);
+        SDI_DEVICE_ERRMSG_LOG("smbus read failed for slope constant rc : %d",rc);
         return rc;
     }
+    sdi_platform_util_write_16bit_to_bytearray_le(calib_info->slope,temp_buf);
 
-    if(calib_info->type == SFP_CALIB_TYPE_EXTERNAL) {
-        rc = sdi_smbus_read_word(bus_hdl, sfp_i2c_addr, vs_offset,
-               &temp_buf, SDI_I2C_FLAG_NONE);
-        sdi_platform_util_write_16bit_to_bytearray_le(calib_info->slope,temp_buf);
-        if (rc != STD_ERR_OK){
-            SDI_DEVICE_ERRMSG_LOG("smbus read failed for temp slope constant rc : %d",rc);
+    rc = sdi_smbus_read_word(bus_hdl, sfp_i2c_addr, vc_offset,
+            &calib_info->offset, SDI_I2C_FLAG_NONE);
+    if (rc != STD_ERR_OK){
+        SDI_DEVICE_ERRMSG_LOG("smbus read failed for offset constant rc : %d", rc);
+    }
+    return rc;
+}
+
+/**
+ * Read the external calibration constants for rx power
+ *
+ * bus_hdl[in] - Handle of the i2c bus
+ * rx_pwr_calib_info[out] - structure filled with rx power constants
+ * vs_offset[in] - rx power calibration constant start offset
+ *
+ * return - standard t_std_error
+ */
+static t_std_error sdi_sfp_rx_power_calib_constants_read(sdi_i2c_bus_hdl_t bus_hdl,
+                                                         sfp_rx_power_calib_info_t *rx_pwr_calib_info,
+                                                         uint_t vs_offset)
+{
+    t_std_error rc = STD_ERR_OK;
+    uint8_t data[EXT_CAL_RX_POWER_LEN] = { 0 };
+    uint8_t *data_ptr = NULL;
+
+    rc = sdi_smbus_read_multi_byte(bus_hdl, sfp_i2c_addr, vs_offset, data,
+                                   EXT_CAL_RX_POWER_LEN, SDI_I2C_FLAG_NONE);
+    if (rc != STD_ERR_OK) {
+        SDI_DEVICE_ERRMSG_LOG("smbus read failed for rx power calibration constant with rc : %d", rc);
+        return rc;
+    }
+    data_ptr = data;
+    memcpy(rx_pwr_calib_info->rx_power_const_4, data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
+    data_ptr = data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
+    memcpy(rx_pwr_calib_info->rx_power_const_3, data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
+    data_ptr = data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
+    memcpy(rx_pwr_calib_info->rx_power_const_2, data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
+    data_ptr = data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
+    memcpy(rx_pwr_calib_info->rx_power_const_1, data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
+    data_ptr = data_ptr + EXT_CAL_RX_POWER_DATA_LEN;
+    memcpy(rx_pwr_calib_info->rx_power_const_0, data_ptr, EXT_CAL_RX_POWER_DATA_LEN);
+    return rc;
+}
+
+/**
+ * Drop the calibration cache, constants are read again on the next monitor
+ * or threshold read
+ *
+ * sfp_device[in] - sfp device handle
+ *
+ * return - none
+ */
+static void sdi_sfp_calib_invalidate(sdi_device_hdl_t sfp_device)
+{
+    sfp_device_t *sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
+
+    std_mutex_lock(&sfp_priv_data->eeprom.lock);
+    sfp_priv_data->calib.valid = false;
+    std_mutex_unlock(&sfp_priv_data->eeprom.lock);
+}
+
+/**
+ * Get the diag monitoring support and calibration constants of the inserted
+ * module. They are read from the module once per insertion and belong to the
+ * eeprom shadow generation they were read in, so every invalidation of the
+ * shadow drops them as well. Both are protected by the shadow lock.
+ *
+ * sfp_device[in] - sfp device handle
+ * calib[out] - copy of the calibration cache of the module
+ *
+ * return - standard t_std_error
+ */
+static t_std_error sdi_sfp_calib_get(sdi_device_hdl_t sfp_device, sfp_calib_cache_t *calib)
+{
+    sfp_device_t *sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
+    sfp_calib_cache_t cache = { 0 };
+    sfp_calib_info_type_t type = SFP_CALIB_TYPE_INTERNAL;
+    uint_t diag_mon_value = 0;
+    uint_t generation = 0;
+    t_std_error rc = STD_ERR_OK;
+    bool valid = false;
+
+    std_mutex_lock(&sfp_priv_data->eeprom.lock);
+    generation = sfp_priv_data->eeprom.generation;
+    valid = ((sfp_priv_data->calib.valid) && (sfp_priv_data->calib.generation == generation));
+    if (valid) {
+        *calib = sfp_priv_data->calib;
+    }
+    std_mutex_unlock(&sfp_priv_data->eeprom.lock);
+    if (valid) {
+        return STD_ERR_OK;
+    }
+
+    /* Check whether diag monitoring is supported on this device or not */
+    rc = sdi_sfp_parameter_get(sfp_device, SDI_MEDIA_DIAG_MON_TYPE, &diag_mon_value);
+    if (rc != STD_ERR_OK) {
+        SDI_DEVICE_ERRMSG_LOG("Getting of diag monitoring value is failed for %s rc : %d",
+                              sfp_device->alias, rc);
+        return rc;
+    }
+
+    cache.ddm_supported = (STD_BIT_TEST(diag_mon_value, SFP_DDM_SUPPORT_BIT_OFFSET) != 0);
+    if (cache.ddm_supported) {
+        /* Get the calibration type */
+        if( (STD_BIT_TEST(diag_mon_value, SFP_CALIB_TYPE_EXTERNAL_BIT_OFFSET) != 0) ) {
+            type = SFP_CALIB_TYPE_EXTERNAL;
+        } else  if( (STD_BIT_TEST(diag_mon_value, SFP_CALIB_TYPE_INTERNAL_BIT_OFFSET) != 0) ) {
+            type = SFP_CALIB_TYPE_INTERNAL;
+        } else {
+            return (SDI_DEVICE_ERRCODE(EINVAL));
+        }
+        cache.temp.type = type;
+        cache.volt.type = type;
+        cache.tx_bias.type = type;
+        cache.tx_power.type = type;
+        cache.rx_power.type = type;
+    }
+
+    if (cache.ddm_supported && (type == SFP_CALIB_TYPE_EXTERNAL)) {
+        rc = sdi_sfp_module_select(sfp_device);
+        if(rc != STD_ERR_OK) {
             return rc;
         }
 
-        rc = sdi_smbus_read_word(bus_hdl, sfp_i2c_addr, vc_offset,
-                &calib_info->offset, SDI_I2C_FLAG_NONE);
-        if (rc != STD_ERR_OK){
-            SDI_DEVICE_ERRMSG_LOG("smbus read failed for temp offset constant rc : %d", rc);
+        do {
+            rc = sdi_sfp_calib_constants_read(sfp_device->bus_hdl, &cache.temp,
+                                              SFP_CALIB_TEMP_SLOPE_OFFSET,
+                                              SFP_CALIB_TEMP_CONST_OFFSET);
+            if (rc != STD_ERR_OK) {
+                break;
+            }
+            rc = sdi_sfp_calib_constants_read(sfp_device->bus_hdl, &cache.volt,
+                                              SFP_CALIB_VOLT_SLOPE_OFFSET,
+                                              SFP_CALIB_VOLT_CONST_OFFSET);
+            if (rc != STD_ERR_OK) {
+                break;
+            }
+            rc = sdi_sfp_calib_constants_read(sfp_device->bus_hdl, &cache.tx_bias,
+                                              SFP_CALIB_TX_BIAS_SLOPE_OFFSET,
+                                              SFP_CALIB_TX_BIAS_CONST_OFFSET);
+            if (rc != STD_ERR_OK) {
+                break;
+            }
+            rc = sdi_sfp_calib_constants_read(sfp_device->bus_hdl, &cache.tx_power,
+                                              SFP_CALIB_TX_POWER_SLOPE_OFFSET,
+                                              SFP_CALIB_TX_POWER_CONST_OFFSET);
+            if (rc != STD_ERR_OK) {
+                break;
+            }
+            rc = sdi_sfp_rx_power_calib_constants_read(sfp_device->bus_hdl, &cache.rx_power,
+                                                       SFP_CALIB_RX_POWER_CONST_START_OFFSET);
+        } while(0);
+
+        sdi_sfp_module_deselect(sfp_priv_data);
+
+        if (rc != STD_ERR_OK) {
+            SDI_DEVICE_ERRMSG_LOG("calibration constants read failed with rc : %d on %s",
+                                  rc, sfp_device->alias);
             return rc;
         }
     }
-    return rc;
+
+    cache.valid = true;
+    cache.generation = generation;
+    /* Not cached if the module was swapped while the constants were read */
+    std_mutex_lock(&sfp_priv_data->eeprom.lock);
+    if (sfp_priv_data->eeprom.generation == generation) {
+        sfp_priv_data->calib = cache;
+    }
+    std_mutex_unlock(&sfp_priv_data->eeprom.lock);
+    *calib = cache;
+    return STD_ERR_OK;
 }
 
 /**
@@ -1791,8 +1955,7 @@ t_std_error sdi_sfp_module_monitor_get (sdi_resource_hdl_t resource_hdl,
     sfp_device_t *sfp_priv_data = NULL;
     t_std_error rc = STD_ERR_OK;
     uint8_t buf[2] = { 0 };
-    uint_t diag_mon_value = 0;
-    sfp_calib_info_t calib_info = { 0 };
+    sfp_calib_cache_t calib = { 0 };
 
     STD_ASSERT(resource_hdl != NULL);
     STD_ASSERT(value != NULL);
@@ -1801,28 +1964,15 @@ t_std_error sdi_sfp_module_monitor_get (sdi_resource_hdl_t resource_hdl,
     sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
     STD_ASSERT(sfp_priv_data != NULL);
 
-
-    /* Check whether diag monitoring is supported on this device or not */
-    rc = sdi_sfp_parameter_get(resource_hdl, SDI_MEDIA_DIAG_MON_TYPE, &diag_mon_value);
+    rc = sdi_sfp_calib_get(sfp_device, &calib);
     if (rc != STD_ERR_OK) {
-        SDI_DEVICE_ERRMSG_LOG("Getting of diag monitoring value is failed for %s rc : %d",
-                              sfp_device->alias, rc);
         return rc;
     }
 
-    if( (STD_BIT_TEST(diag_mon_value, SFP_DDM_SUPPORT_BIT_OFFSET) == 0) ) {
+    if (!calib.ddm_supported) {
         return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
     }
 
-    /* Get the calibration type */
-    if( (STD_BIT_TEST(diag_mon_value, SFP_CALIB_TYPE_EXTERNAL_BIT_OFFSET) != 0) ) {
-        calib_info.type = SFP_CALIB_TYPE_EXTERNAL;
-    } else  if( (STD_BIT_TEST(diag_mon_value, SFP_CALIB_TYPE_INTERNAL_BIT_OFFSET) != 0) ) {
-        calib_info.type = SFP_CALIB_TYPE_INTERNAL;
-    } else {
-        return (SDI_DEVICE_ERRCODE(EINVAL));
-    }
-
     rc = sdi_sfp_module_select(sfp_device);
     if(rc != STD_ERR_OK) {
         return rc;
@@ -1832,9 +1982,8 @@ t_std_error sdi_sfp_module_monitor_get (sdi_resource_hdl_t resource_hdl,
         switch (monitor)
         {
             case SDI_MEDIA_TEMP:
-                rc = sdi_sfp_module_monitor_value_read(sfp_device->bus_hdl, SFP_TEMPERATURE_OFFSET,
-                                                       (uint16_t *)buf, &calib_info, SFP_CALIB_TEMP_SLOPE_OFFSET,
-                                                       SFP_CALIB_TEMP_CONST_OFFSET);
+                rc = sdi_sfp_monitor_value_read(sfp_device->bus_hdl, SFP_TEMPERATURE_OFFSET,
+                                                (uint16_t *)buf);
                 if (rc != STD_ERR_OK){
                     SDI_DEVICE_ERRMSG_LOG("module monitor value read failed for temperature with rc : %d on %s",
                                           rc, sfp_device->alias);
@@ -1842,9 +1991,8 @@ t_std_error sdi_sfp_module_monitor_get (sdi_resource_hdl_t resource_hdl,
                 break;
 
             case SDI_MEDIA_VOLT:
-                rc = sdi_sfp_module_monitor_value_read(sfp_device->bus_hdl, SFP_VOLTAGE_OFFSET,
-                                                       (uint16_t *)buf, &calib_info, SFP_CALIB_VOLT_SLOPE_OFFSET,
-                                                       SFP_CALIB_VOLT_CONST_OFFSET);
+                rc = sdi_sfp_monitor_value_read(sfp_device->bus_hdl, SFP_VOLTAGE_OFFSET,
+                                                (uint16_t *)buf);
                 if (rc != STD_ERR_OK){
                     SDI_DEVICE_ERRMSG_LOG("module monitor value read failed for voltage with rc : %d on %s",
                             rc, sfp_device->alias);
@@ -1858,11 +2006,16 @@ t_std_error sdi_sfp_module_monitor_get (sdi_resource_hdl_t resource_hdl,
 
     sdi_sfp_module_deselect(sfp_priv_data);
 
+    if (rc != STD_ERR_OK) {
+        /* Module may have been replaced, reload constants on next read */
+        sdi_sfp_calib_invalidate(sfp_device);
+    }
+
     if(rc == STD_ERR_OK) {
         if(monitor == SDI_MEDIA_TEMP) {
-            *value = convert_sfp_temp(buf, &calib_info);
+            *value = convert_sfp_temp(buf, &calib.temp);
         } else if(monitor == SDI_MEDIA_VOLT) {
-            *value = convert_sfp_volt(buf, &calib_info);
+            *value = convert_sfp_volt(buf, &calib.volt);
         }
     }
     return rc;
@@ -1883,9 +2036,7 @@ t_std_error sdi_sfp_channel_monitor_get (sdi_resource_hdl_t resource_hdl, uint_t
     sfp_device_t *sfp_priv_data = NULL;
     t_std_error rc = STD_ERR_OK;
     uint8_t buf[2] = { 0 };
-    uint_t diag_mon_value = 0;
-    sfp_calib_info_t calib_info = { 0 };
-    sfp_rx_power_calib_info_t rx_power_calib_info = { 0 };
+    sfp_calib_cache_t calib = { 0 };
 
     STD_ASSERT(resource_hdl != NULL);
     STD_ASSERT(value != NULL);
@@ -1898,27 +2049,15 @@ t_std_error sdi_sfp_channel_monitor_get (sdi_resource_hdl_t resource_hdl, uint_t
         return (SDI_DEVICE_ERRCODE(EINVAL));
     }
 
-    /* Check whether diag monitoring is supported on this device or not */
-    rc = sdi_sfp_parameter_get(resource_hdl, SDI_MEDIA_DIAG_MON_TYPE, &diag_mon_value);
+    rc = sdi_sfp_calib_get(sfp_device, &calib);
     if (rc != STD_ERR_OK) {
-        SDI_DEVICE_ERRMSG_LOG("Getting of diag monitoring value is failed for %s rc : %d",
-                              sfp_device->alias, rc);
         return rc;
     }
 
-    if( (STD_BIT_TEST(diag_mon_value, SFP_DDM_SUPPORT_BIT_OFFSET) == 0) ) {
+    if (!calib.ddm_supported) {
         return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
     }
 
-    /* Get the calibration type */
-    if( (STD_BIT_TEST(diag_mon_value, SFP_CALIB_TYPE_EXTERNAL_BIT_OFFSET) != 0) ) {
-        calib_info.type = SFP_CALIB_TYPE_EXTERNAL;
-    } else  if( (STD_BIT_TEST(diag_mon_value, SFP_CALIB_TYPE_INTERNAL_BIT_OFFSET) != 0) ) {
-        calib_info.type = SFP_CALIB_TYPE_INTERNAL;
-    } else {
-        return (SDI_DEVICE_ERRCODE(EINVAL));
-    }
-
     rc = sdi_sfp_module_select(sfp_device);
     if(rc != STD_ERR_OK) {
         return rc;
@@ -1928,19 +2067,16 @@ t_std_error sdi_sfp_channel_monitor_get (sdi_resource_hdl_t resource_hdl, uint_t
         switch (monitor)
         {
             case SDI_MEDIA_INTERNAL_RX_POWER_MONITOR:
-                rx_power_calib_info.type = calib_info.type;
-                rc = sdi_sfp_rx_power_value_read(sfp_device->bus_hdl, SFP_RX_INPUT_POWER_OFFSET,
-                                                 (uint16_t *)buf, &rx_power_calib_info,
-                                                 SFP_CALIB_RX_POWER_CONST_START_OFFSET);
+                rc = sdi_sfp_monitor_value_read(sfp_device->bus_hdl, SFP_RX_INPUT_POWER_OFFSET,
+                                                (uint16_t *)buf);
                 if (rc != STD_ERR_OK){
                     SDI_DEVICE_ERRMSG_LOG("smbus read failed for rx power with rc : %d", rc);
                 }
                 break;
 
             case SDI_MEDIA_INTERNAL_TX_BIAS_CURRENT:
-                rc = sdi_sfp_module_monitor_value_read(sfp_device->bus_hdl, SFP_TX_BIAS_CURRENT_OFFSET,
-                                                       (uint16_t *)buf, &calib_info, SFP_CALIB_TX_BIAS_SLOPE_OFFSET,
-                                                       SFP_CALIB_TX_BIAS_CONST_OFFSET);
+                rc = sdi_sfp_monitor_value_read(sfp_device->bus_hdl, SFP_TX_BIAS_CURRENT_OFFSET,
+                                                (uint16_t *)buf);
                 if (rc != STD_ERR_OK){
                     SDI_DEVICE_ERRMSG_LOG("channel monitor value read failed for tx bias current with rc : %d on %s",
                                            rc, sfp_device->alias);
@@ -1948,9 +2084,8 @@ t_std_error sdi_sfp_channel_monitor_get (sdi_resource_hdl_t resource_hdl, uint_t
                 break;
 
             case SDI_MEDIA_INTERNAL_TX_OUTPUT_POWER:
-                rc = sdi_sfp_module_monitor_value_read(sfp_device->bus_hdl, SFP_TX_OUTPUT_POWER_OFFSET,
-                                                       (uint16_t *)buf, &calib_info, SFP_CALIB_TX_POWER_SLOPE_OFFSET,
-                                                       SFP_CALIB_TX_POWER_CONST_OFFSET);
+                rc = sdi_sfp_monitor_value_read(sfp_device->bus_hdl, SFP_TX_OUTPUT_POWER_OFFSET,
+                                                (uint16_t *)buf);
                 if (rc != STD_ERR_OK){
                     SDI_DEVICE_ERRMSG_LOG("channel monitor value read failed for tx output power with rc : %d on %s",
                                           rc, sfp_device->alias);
@@ -1963,18 +2098,104 @@ t_std_error sdi_sfp_channel_monitor_get (sdi_resource_hdl_t resource_hdl, uint_t
     } while(0);
     sdi_sfp_module_deselect(sfp_priv_data);
 
+    if (rc != STD_ERR_OK) {
+        /* Module may have been replaced, reload constants on next read */
+        sdi_sfp_calib_invalidate(sfp_device);
+    }
+
     if( rc == STD_ERR_OK) {
         if(monitor == SDI_MEDIA_INTERNAL_RX_POWER_MONITOR) {
-            *value = convert_sfp_rx_power(buf, &rx_power_calib_info);
+            *value = convert_sfp_rx_power(buf, &calib.rx_power);
         } else if(monitor == SDI_MEDIA_INTERNAL_TX_BIAS_CURRENT) {
-            *value = convert_sfp_tx_bias_current(buf, &calib_info);
+            *value = convert_sfp_tx_bias_current(buf, &calib.tx_bias);
         }else if(monitor == SDI_MEDIA_INTERNAL_TX_OUTPUT_POWER) {
-            *value = convert_sfp_tx_power(buf, &calib_info);
+            *value = convert_sfp_tx_power(buf, &calib.tx_power);
         }
     }
     return rc;
 }
 
+/**
+ * Read all module and channel monitors of the specified SFP in one go. The
+ * monitor registers of page A2 are fetched in one block read.
+ * resource_hdl[in]  - Handle of the resource
+ * channel_count[in] - number of channels of interest
+ * snapshot[out]     - monitors of the media
+ * return           - t_std_error
+ */
+t_std_error sdi_sfp_dom_snapshot_get (sdi_resource_hdl_t resource_hdl, uint_t channel_count,
+                                      sdi_media_dom_snapshot_t *snapshot)
+{
+    sdi_device_hdl_t sfp_device = NULL;
+    sfp_device_t *sfp_priv_data = NULL;
+    t_std_error rc = STD_ERR_OK;
+    uint8_t buf[SFP_RX_INPUT_POWER_OFFSET + 2 - SFP_TEMPERATURE_OFFSET] = { 0 };
+    sfp_calib_cache_t calib = { 0 };
+
+    STD_ASSERT(resource_hdl != NULL);
+    STD_ASSERT(snapshot != NULL);
+
+    sfp_device = (sdi_device_hdl_t)resource_hdl;
+    sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
+    STD_ASSERT(sfp_priv_data != NULL);
+
+    if (channel_count > (SDI_SFP_CHANNEL_NUM + 1)) {
+        channel_count = SDI_SFP_CHANNEL_NUM + 1;
+    }
+    snapshot->channel_count = channel_count;
+
+    rc = sdi_sfp_calib_get(sfp_device, &calib);
+    if (rc != STD_ERR_OK) {
+        return rc;
+    }
+
+    if (!calib.ddm_supported) {
+        /* Nothing to read, all monitors stay flagged invalid */
+        return STD_ERR_OK;
+    }
+
+    rc = sdi_sfp_module_select(sfp_device);
+    if(rc != STD_ERR_OK) {
+        return rc;
+    }
+
+    rc = sdi_smbus_read_multi_byte(sfp_device->bus_hdl, sfp_i2c_addr, SFP_TEMPERATURE_OFFSET,
+                                   buf, sizeof(buf), SDI_I2C_FLAG_NONE);
+    if (rc != STD_ERR_OK) {
+        SDI_DEVICE_ERRMSG_LOG("monitor values read failed with rc : %d on %s",
+                              rc, sfp_device->alias);
+    }
+
+    sdi_sfp_module_deselect(sfp_priv_data);
+
+    if (rc != STD_ERR_OK) {
+        /* Module may have been replaced, reload constants on next read */
+        sdi_sfp_calib_invalidate(sfp_device);
+        return rc;
+    }
+
+    snapshot->module_monitor_valid = true;
+    snapshot->temperature = convert_sfp_temp(buf, &calib.temp);
+    snapshot->voltage = convert_sfp_volt(&buf[SFP_VOLTAGE_OFFSET - SFP_TEMPERATURE_OFFSET],
+                                         &calib.volt);
+
+    if (channel_count != 0) {
+        snapshot->rx_power_valid = true;
+        snapshot->tx_bias_valid = true;
+        snapshot->tx_power_valid = true;
+        snapshot->rx_power[SDI_SFP_CHANNEL_NUM] =
+            convert_sfp_rx_power(&buf[SFP_RX_INPUT_POWER_OFFSET - SFP_TEMPERATURE_OFFSET],
+                                 &calib.rx_power);
+        snapshot->tx_bias[SDI_SFP_CHANNEL_NUM] =
+            convert_sfp_tx_bias_current(&buf[SFP_TX_BIAS_CURRENT_OFFSET - SFP_TEMPERATURE_OFFSET],
+                                        &calib.tx_bias);
+        snapshot->tx_power[SDI_SFP_CHANNEL_NUM] =
+            convert_sfp_tx_power(&buf[SFP_TX_OUTPUT_POWER_OFFSET - SFP_TEMPERATURE_OFFSET],
+                                 &calib.tx_power);
+    }
+    return rc;
+}
+
 /**
  * Get the inforamtion of whether optional features supported or not on a given
  * module
@@ -1997,6 +2218,10 @@ t_std_error sdi_sfp_feature_support_status_get (sdi_resource_hdl_t resource_hdl,
     sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
     STD_ASSERT(sfp_priv_data != NULL);
 
+    if (sdi_sfp_shadow_feature_support_get(sfp_device, feature_support)) {
+        return STD_ERR_OK;
+    }
+
     rc = sdi_sfp_module_select(sfp_device);
     if(rc != STD_ERR_OK) {
         return rc;
@@ -2396,6 +2621,26 @@ t_std_error sdi_sfp_phy_serdes_control (sdi_resource_hdl_t resource_hdl, uint_t
     return rc;
 }
 
+/*
+ * @brief Drop the eeprom data cached for the inserted module
+ * @param[in] resource_hdl - handle to the sfp
+ * @return - none
+ */
+void sdi_sfp_module_cache_invalidate(sdi_resource_hdl_t resource_hdl)
+{
+    sdi_device_hdl_t sfp_device = NULL;
+    sfp_device_t *sfp_priv_data = NULL;
+
+    STD_ASSERT(resource_hdl != NULL);
+
+    sfp_device = (sdi_device_hdl_t)resource_hdl;
+    sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
+    STD_ASSERT(sfp_priv_data != NULL);
+
+    /* Calibration cache belongs to the shadow generation, dropped with it */
+    sdi_media_shadow_invalidate(&sfp_priv_data->eeprom);
+}
+
 /*
  * @brief initialize pluged in module
  * @param[in] resource_hdl - handle to the sfp
@@ -2406,6 +2651,18 @@ t_std_error sdi_sfp_phy_serdes_control (sdi_resource_hdl_t resource_hdl, uint_t
 
 t_std_error sdi_sfp_module_init (sdi_resource_hdl_t resource_hdl, bool pres)
 {
+    sdi_device_hdl_t sfp_device = NULL;
+    sfp_device_t *sfp_priv_data = NULL;
+
+    STD_ASSERT(resource_hdl != NULL);
+
+    sfp_device = (sdi_device_hdl_t)resource_hdl;
+    sfp_priv_data = (sfp_device_t *)sfp_device->private_data;
+    STD_ASSERT(sfp_priv_data != NULL);
+
+    /* Static eeprom data of a previous module must not be served */
+    sdi_sfp_module_cache_invalidate(resource_hdl);
+
     return STD_ERR_OK;
 }
 
@@ -0,0 +1,1079 @@
+/*
+ * Copyright (c) 2019 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_gpiod.c
+ */
+
+
+/******************************************************************************
+ * Creates and Registers SDI GPIOD Pin/PinGroup Bus.
+ * Provides interfaces to access direction, level and polarity configuration of
+ * gpio lines through the gpio character device. All lines of a pin group are
+ * read and driven with a single ioctl, so multi-bit writes are atomic.
+ * Input lines can deliver edge events, used to signal level changes.
+ *****************************************************************************/
+
+#include "sdi_device_common.h"
+#include "sdi_driver_internal.h"
+#include "sdi_gpiod.h"
+#include "sdi_pin_bus_framework.h"
+#include "sdi_pin_group_bus_framework.h"
+#include "std_assert.h"
+#include "sdi_pin_bus_attr.h"
+#include "sdi_bus_attr.h"
+#include "sdi_common_attr.h"
+#include "std_utils.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/limits.h>
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+
+/**
+ * GPIOD Pin Configuration Format:
+ *   <sdi_gpiod instance="0" chip="0" pin="0" direction="out" level="0"
+ *            bus_name="gpio0" polarity="normal">
+ *   </sdi_gpiod>
+ *
+ * GPIOD Pin Group Configuration Format:
+ *   <sdi_gpiod_group instance="0" chip="0" pingroup="1,2" direction="out"
+ *            level="0" bus_name="gpio_group0" polarity="normal">
+ *   </sdi_gpiod_group>
+ *
+ * - instance : identifier for a pin
+ * - chip : gpio chip number, lines are accessed through /dev/gpiochip<chip>
+ * - pin : line offset within the gpio chip
+ * - pingroup : line offsets used to create a pin group (comma-sperated), the
+ * first line is the most significant bit of the pin group level
+ * - direction : default direction to be configured during initialization (out/in)
+ * When not specified, default direction is input
+ * - level : default level to be configured during init
+ * When not specified, default level is low(0) for an output pin/pingroup
+ * - bus_name : gpio pin name
+ * - polarity : default logic level to be configured during init
+ * (normal/inverted). When not specified, default polarity is 'normal'
+ *
+ */
+
+#ifdef GPIO_V2_GET_LINE_IOCTL
+
+/* Minimum number of pins required to form a pin group */
+#define MIN_NUMBER_OF_PINS_IN_GROUP        2
+
+/* Maximum number of pins of a group, limited by the width of the level */
+#define MAX_NUMBER_OF_PINS_IN_GROUP        (sizeof(uint_t) * 8)
+
+/* Pin/PinGroup Bus Lock Init failure */
+#define BUS_LOCK_INIT_FAILURE             -1
+
+/* Pin/PinGroup Bus Registration Failure */
+#define BUS_REGISTRATION_FAILURE          -2
+
+/* Invalid file descriptor */
+#define SDI_INVALID_FILE_FD               -1
+
+/**
+ * Mask covering every line of a line request
+ * param[in] lines - line request
+ * return line mask
+ */
+static inline uint64_t sdi_gpiod_lines_mask(const sdi_gpiod_lines_t *lines)
+{
+    return ((lines->line_count >= 64) ? ~((uint64_t)0)
+            : ((((uint64_t)1) << lines->line_count) - 1));
+}
+
+/**
+ * Fill the kernel line configuration for the given direction, polarity and
+ * output levels
+ * param[in] lines - line request
+ * param[in] direction - direction of all lines
+ * param[in] polarity - polarity of all lines
+ * param[in] values - output levels, used only for output lines
+ * param[out] config - kernel line configuration
+ * return none
+ */
+static void sdi_gpiod_line_config_fill(const sdi_gpiod_lines_t *lines,
+                                       sdi_pin_bus_direction_t direction,
+                                       sdi_pin_bus_polarity_t polarity,
+                                       uint64_t values,
+                                       struct gpio_v2_line_config *config)
+{
+    memset(config, 0, sizeof(*config));
+
+    config->flags = ((direction == SDI_PIN_BUS_OUTPUT) ? GPIO_V2_LINE_FLAG_OUTPUT
+                     : GPIO_V2_LINE_FLAG_INPUT);
+    if (polarity == SDI_PIN_POLARITY_INVERTED) {
+        config->flags |= GPIO_V2_LINE_FLAG_ACTIVE_LOW;
+    }
+
+    /* Edges are only detected on input lines */
+    if ((direction == SDI_PIN_BUS_INPUT) && (lines->edge_events)) {
+        config->flags |= (GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING);
+    }
+
+    /* Output levels are applied together with the direction, so lines never
+     * glitch to a stale level when turned to output */
+    if (direction == SDI_PIN_BUS_OUTPUT) {
+        config->num_attrs = 1;
+        config->attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+        config->attrs[0].attr.values = values;
+        config->attrs[0].mask = sdi_gpiod_lines_mask(lines);
+    }
+}
+
+/**
+ * Request the lines from their gpio chip with the given initial configuration
+ * param[in] lines - line request
+ * param[in] consumer - consumer label shown by the kernel for the lines
+ * param[in] direction - direction of all lines
+ * param[in] polarity - polarity of all lines
+ * param[in] values - output levels, used only for output lines
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_lines_request(sdi_gpiod_lines_t *lines, const char *consumer,
+                                           sdi_pin_bus_direction_t direction,
+                                           sdi_pin_bus_polarity_t polarity,
+                                           uint64_t values)
+{
+    char chip_path[PATH_MAX] = {0};
+    struct gpio_v2_line_request request;
+    t_std_error err = STD_ERR_OK;
+    uint_t index = 0;
+    int chip_fd = SDI_INVALID_FILE_FD;
+
+    STD_ASSERT(lines->line_count <= GPIO_V2_LINES_MAX);
+
+    memset(&request, 0, sizeof(request));
+    for (index = 0; index < lines->line_count; index++) {
+        request.offsets[index] = lines->line[index];
+    }
+    request.num_lines = lines->line_count;
+    safestrncpy(request.consumer, consumer, sizeof(request.consumer));
+    sdi_gpiod_line_config_fill(lines, direction, polarity, values, &request.config);
+
+    snprintf(chip_path, PATH_MAX, SDI_GPIOD_CHIP_PATH, lines->chip_num);
+    chip_fd = open(chip_path, O_RDWR | O_CLOEXEC);
+    if (chip_fd < 0) {
+        err = SDI_DEVICE_ERRNO;
+        SDI_DEVICE_ERRMSG_LOG("%s open failed with %d\n", chip_path, err);
+        return err;
+    }
+
+    if (ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &request) < 0) {
+        err = SDI_DEVICE_ERRNO;
+        SDI_DEVICE_ERRMSG_LOG("%s line request for %s failed with %d\n",
+            chip_path, consumer, err);
+    } else {
+        lines->line_fd = request.fd;
+        lines->direction = direction;
+        lines->polarity = polarity;
+        lines->values = values;
+    }
+
+    /* Line request stays valid after the chip is closed */
+    close(chip_fd);
+
+    return err;
+}
+
+/**
+ * Change direction and polarity of all lines in one go
+ * param[in] lines - line request
+ * param[in] direction - direction of all lines
+ * param[in] polarity - polarity of all lines
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_lines_config_set(sdi_gpiod_lines_t *lines,
+                                              sdi_pin_bus_direction_t direction,
+                                              sdi_pin_bus_polarity_t polarity)
+{
+    struct gpio_v2_line_config config;
+    t_std_error err = STD_ERR_OK;
+
+    if ((direction != SDI_PIN_BUS_INPUT) && (direction != SDI_PIN_BUS_OUTPUT)) {
+        return SDI_DEVICE_ERRCODE(EINVAL);
+    }
+
+    sdi_gpiod_line_config_fill(lines, direction, polarity, lines->values, &config);
+    if (ioctl(lines->line_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) < 0) {
+        err = SDI_DEVICE_ERRNO;
+        SDI_DEVICE_ERRMSG_LOG("gpio chip %u line config failed with %d\n",
+            lines->chip_num, err);
+        return err;
+    }
+
+    lines->direction = direction;
+    lines->polarity = polarity;
+    return err;
+}
+
+/**
+ * Read levels of all lines with one ioctl
+ * param[in] lines - line request
+ * param[out] values - levels, bit n is level of line[n]
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_lines_values_get(sdi_gpiod_lines_t *lines, uint64_t *values)
+{
+    struct gpio_v2_line_values line_values;
+    t_std_error err = STD_ERR_OK;
+
+    memset(&line_values, 0, sizeof(line_values));
+    line_values.mask = sdi_gpiod_lines_mask(lines);
+    if (ioctl(lines->line_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &line_values) < 0) {
+        err = SDI_DEVICE_ERRNO;
+        SDI_DEVICE_ERRMSG_LOG("gpio chip %u line read failed with %d\n",
+            lines->chip_num, err);
+        return err;
+    }
+
+    *values = line_values.bits;
+    return err;
+}
+
+/**
+ * Drive levels of all lines with one ioctl
+ * param[in] lines - line request
+ * param[in] values - levels, bit n is level of line[n]
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_lines_values_set(sdi_gpiod_lines_t *lines, uint64_t values)
+{
+    struct gpio_v2_line_values line_values;
+    t_std_error err = STD_ERR_OK;
+
+    memset(&line_values, 0, sizeof(line_values));
+    line_values.mask = sdi_gpiod_lines_mask(lines);
+    line_values.bits = values;
+    if (ioctl(lines->line_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &line_values) < 0) {
+        err = SDI_DEVICE_ERRNO;
+        SDI_DEVICE_ERRMSG_LOG("gpio chip %u line write failed with %d\n",
+            lines->chip_num, err);
+        return err;
+    }
+
+    lines->values = values;
+    return err;
+}
+
+/**
+ * Get the file descriptor delivering edge events of the lines, enabling edge
+ * detection on first use
+ * param[in] lines - line request
+ * param[out] fd - file descriptor of the line request
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_lines_event_fd_get(sdi_gpiod_lines_t *lines, int *fd)
+{
+    t_std_error err = STD_ERR_OK;
+    int flags = 0;
+
+    if (lines->line_fd == SDI_INVALID_FILE_FD) {
+        return SDI_DEVICE_ERRCODE(EBADF);
+    }
+    if (lines->direction != SDI_PIN_BUS_INPUT) {
+        return SDI_DEVICE_ERRCODE(EINVAL);
+    }
+
+    if (!lines->edge_events) {
+        lines->edge_events = true;
+        err = sdi_gpiod_lines_config_set(lines, lines->direction, lines->polarity);
+        if (err != STD_ERR_OK) {
+            lines->edge_events = false;
+            return err;
+        }
+        /* Events are drained without blocking the caller */
+        flags = fcntl(lines->line_fd, F_GETFL);
+        if ((flags < 0)
+            || (fcntl(lines->line_fd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+            return SDI_DEVICE_ERRNO;
+        }
+    }
+
+    *fd = lines->line_fd;
+    return err;
+}
+
+/**
+ * Drain pending edge events of the lines
+ * param[in] lines - line request
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_lines_event_clear(sdi_gpiod_lines_t *lines)
+{
+    struct gpio_v2_line_event events[16];
+    ssize_t len = 0;
+
+    if (!lines->edge_events) {
+        return SDI_DEVICE_ERRCODE(EINVAL);
+    }
+
+    do {
+        len = read(lines->line_fd, events, sizeof(events));
+    } while ((len == sizeof(events)) || ((len < 0) && (errno == EINTR)));
+
+    if ((len < 0) && (errno != EAGAIN)) {
+        return SDI_DEVICE_ERRNO;
+    }
+    return STD_ERR_OK;
+}
+
+/**
+ * Parse default direction attribute of a pin or pin group node
+ * param[in] node - bus node
+ * return configured direction, input when not configured
+ */
+static sdi_pin_bus_direction_t sdi_gpiod_direction_attr_get(std_config_node_t node)
+{
+    char *node_attr = std_config_attr_get(node, SDI_DEV_ATTR_PIN_DIRECTION);
+
+    if (node_attr == NULL) {
+        return SDI_PIN_BUS_INPUT;
+    }
+    if ((strncmp(node_attr, SDI_DEV_ATTR_INPUT_PIN,
+            SDI_DEV_ATTR_INPUT_PIN_LEN)) == 0) {
+        return SDI_PIN_BUS_INPUT;
+    }
+    if ((strncmp(node_attr, SDI_DEV_ATTR_OUTPUT_PIN,
+            SDI_DEV_ATTR_OUTPUT_PIN_LEN)) == 0) {
+        return SDI_PIN_BUS_OUTPUT;
+    }
+    SDI_DEVICE_ERRMSG_LOG("%s:%d invalid gpiod direction %s\n",
+        __FUNCTION__, __LINE__, node_attr);
+    STD_ASSERT(false);
+    return SDI_PIN_BUS_INPUT;
+}
+
+/**
+ * Parse default polarity attribute of a pin or pin group node
+ * param[in] node - bus node
+ * return configured polarity, normal when not configured
+ */
+static sdi_pin_bus_polarity_t sdi_gpiod_polarity_attr_get(std_config_node_t node)
+{
+    char *node_attr = std_config_attr_get(node, SDI_DEV_ATTR_PIN_POLARITY);
+
+    if (node_attr == NULL) {
+        return SDI_PIN_POLARITY_NORMAL;
+    }
+    if ((strncmp(node_attr, SDI_DEV_ATTR_POLARITY_NORMAL,
+            SDI_DEV_ATTR_POLARITY_NORMAL_LEN)) == 0) {
+        return SDI_PIN_POLARITY_NORMAL;
+    }
+    if ((strncmp(node_attr, SDI_DEV_ATTR_POLARITY_INVERTED,
+            SDI_DEV_ATTR_POLARITY_INVERTED_LEN)) == 0) {
+        return SDI_PIN_POLARITY_INVERTED;
+    }
+    SDI_DEVICE_ERRMSG_LOG("%s:%d invalid gpiod polarity %s\n",
+        __FUNCTION__, __LINE__, node_attr);
+    STD_ASSERT(false);
+    return SDI_PIN_POLARITY_NORMAL;
+}
+
+/**
+ * Read gpio pin level
+ * param[in] bus - gpiod pin bus
+ * param[out] value - gpio level read from gpio pin
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_level_read (sdi_pin_bus_hdl_t bus,
+                                         sdi_pin_bus_level_t *value)
+{
+    sdi_gpiod_pin_t *gpiod_pin = (sdi_gpiod_pin_t *) bus;
+    uint64_t values = 0;
+    t_std_error err = STD_ERR_OK;
+    /* bus is already validated by its caller (sdi_pin_read_level) */
+
+    err = sdi_gpiod_lines_values_get(&(gpiod_pin->lines), &values);
+    if (err == STD_ERR_OK) {
+        *value = ((values & 1) ? SDI_PIN_LEVEL_HIGH : SDI_PIN_LEVEL_LOW);
+    }
+    return err;
+}
+
+/**
+ * Change gpio pin level
+ * param[in] bus - gpiod pin bus
+ * param[in] value - can be either 0 or 1
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_level_write (sdi_pin_bus_hdl_t bus,
+                                          sdi_pin_bus_level_t value)
+{
+    sdi_gpiod_pin_t *gpiod_pin = (sdi_gpiod_pin_t *) bus;
+    /* bus is already validated by its caller (sdi_pin_write_level) */
+
+    return sdi_gpiod_lines_values_set(&(gpiod_pin->lines),
+                                      (value == SDI_PIN_LEVEL_HIGH) ? 1 : 0);
+}
+
+/**
+ * Get gpio pin direction. Line request owns the line, so the direction it
+ * was configured with is the current one.
+ * param[in] bus - gpiod pin bus
+ * param[out] direction - gpio direction currently configured on gpio pin.
+ * return STD_ERR_OK
+ */
+static t_std_error sdi_gpiod_direction_get (sdi_pin_bus_hdl_t bus,
+                                            sdi_pin_bus_direction_t *direction)
+{
+    sdi_gpiod_pin_t *gpiod_pin = (sdi_gpiod_pin_t *) bus;
+    /* bus is already validated by its caller (sdi_pin_get_direction) */
+
+    *direction = gpiod_pin->lines.direction;
+    return STD_ERR_OK;
+}
+
+/**
+ * Set gpio pin direction
+ * param[in] bus - gpiod pin bus
+ * param[in] direction - gpio direction to be configured.
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_direction_set (sdi_pin_bus_hdl_t bus,
+                                            sdi_pin_bus_direction_t direction)
+{
+    sdi_gpiod_pin_t *gpiod_pin = (sdi_gpiod_pin_t *) bus;
+    /* bus is already validated by its caller (sdi_pin_set_direction) */
+
+    return sdi_gpiod_lines_config_set(&(gpiod_pin->lines), direction,
+                                      gpiod_pin->lines.polarity);
+}
+
+/**
+ * Get gpio pin polarity
+ * param[in] bus - gpiod pin bus
+ * param[out] polarity - gpio polarity currently configured on gpio pin
+ * return STD_ERR_OK
+ */
+static t_std_error sdi_gpiod_polarity_get(sdi_pin_bus_hdl_t bus,
+                                          sdi_pin_bus_polarity_t *polarity)
+{
+    sdi_gpiod_pin_t *gpiod_pin = (sdi_gpiod_pin_t *) bus;
+    /* bus is already validated by its caller (sdi_pin_get_polarity) */
+
+    *polarity = gpiod_pin->lines.polarity;
+    return STD_ERR_OK;
+}
+
+/**
+ * Set gpio pin polarity
+ * param[in] bus - gpiod pin bus
+ * param[in] polarity - gpio polarity to be configured
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_polarity_set(sdi_pin_bus_hdl_t bus,
+                                          sdi_pin_bus_polarity_t polarity)
+{
+    sdi_gpiod_pin_t *gpiod_pin = (sdi_gpiod_pin_t *) bus;
+    /* bus is already validated by its caller (sdi_pin_set_polarity) */
+
+    return sdi_gpiod_lines_config_set(&(gpiod_pin->lines),
+                                      gpiod_pin->lines.direction, polarity);
+}
+
+/**
+ * Get file descriptor signalling gpio pin level changes
+ * param[in] bus - gpiod pin bus
+ * param[out] fd - pollable file descriptor of the pin
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_event_fd_get(sdi_pin_bus_hdl_t bus, int *fd)
+{
+    sdi_gpiod_pin_t *gpiod_pin = (sdi_gpiod_pin_t *) bus;
+    /* bus is already validated by its caller (sdi_pin_event_fd_get) */
+
+    return sdi_gpiod_lines_event_fd_get(&(gpiod_pin->lines), fd);
+}
+
+/**
+ * Consume pending gpio pin level change events
+ * param[in] bus - gpiod pin bus
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_event_clear(sdi_pin_bus_hdl_t bus)
+{
+    sdi_gpiod_pin_t *gpiod_pin = (sdi_gpiod_pin_t *) bus;
+    /* bus is already validated by its caller (sdi_pin_event_clear) */
+
+    return sdi_gpiod_lines_event_clear(&(gpiod_pin->lines));
+}
+
+/**
+ * gpiod pin operations to read/write gpio pin level, direction and polarity
+ * This ops is same for every pin exported by this driver.
+ */
+static sdi_pin_bus_ops_t sdi_gpiod_ops = {
+    .sdi_pin_bus_read_level = sdi_gpiod_level_read,
+    .sdi_pin_bus_write_level = sdi_gpiod_level_write,
+    .sdi_pin_bus_set_direction = sdi_gpiod_direction_set,
+    .sdi_pin_bus_get_direction = sdi_gpiod_direction_get,
+    .sdi_pin_bus_set_polarity = sdi_gpiod_polarity_set,
+    .sdi_pin_bus_get_polarity = sdi_gpiod_polarity_get,
+    .sdi_pin_bus_event_fd_get = sdi_gpiod_event_fd_get,
+    .sdi_pin_bus_event_clear = sdi_gpiod_event_clear,
+};
+
+/**
+ * Request the gpio line of the pin with its default direction, level and
+ * polarity
+ * param[in] bus_hdl - gpiod pin handle
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on error.
+ */
+static t_std_error sdi_gpiod_driver_init(sdi_bus_hdl_t bus_hdl)
+{
+    sdi_gpiod_pin_t *gpiod_pin = (sdi_gpiod_pin_t *) bus_hdl;
+    sdi_pin_bus_hdl_t pin_bus = NULL;
+    t_std_error err = STD_ERR_OK;
+
+    STD_ASSERT(gpiod_pin != NULL);
+
+    pin_bus = &(gpiod_pin->bus);
+
+    if (gpiod_pin->lines.line_fd == SDI_INVALID_FILE_FD) {
+        err = sdi_gpiod_lines_request(&(gpiod_pin->lines), pin_bus->bus.bus_name,
+                  pin_bus->default_direction, pin_bus->default_polarity,
+                  (pin_bus->default_level == SDI_PIN_LEVEL_HIGH) ? 1 : 0);
+        if (err != STD_ERR_OK) {
+            SDI_DEVICE_ERRMSG_LOG("%s:%d Bus %s gpio chip %u line %u request failed, err: %d\n",
+                __FUNCTION__, __LINE__, pin_bus->bus.bus_name,
+                gpiod_pin->lines.chip_num, gpiod_pin->lines.line[0], err);
+            return err;
+        }
+    }
+
+    sdi_bus_init_device_list(bus_hdl);
+
+    return err;
+}
+
+/**
+ * SDI GPIOD driver registration
+ * Creates gpiod pin object for every defined gpiod pin and registers with
+ * pin bus framework.
+ * param[in] node - gpiod bus node handle obtained by parsing configuration
+ * param[out] bus - to be filled with gpiod bus handle
+ * return returns STD_ERR_OK on success,
+ */
+static t_std_error sdi_gpiod_driver_register(std_config_node_t node,
+                                             sdi_bus_hdl_t *bus)
+{
+    sdi_gpiod_pin_t *gpiod_pin = NULL;
+    sdi_pin_bus_hdl_t pin_bus = NULL;
+    char *node_attr = NULL;
+    t_std_error error = STD_ERR_OK;
+
+    STD_ASSERT(bus != NULL);
+
+    gpiod_pin = (sdi_gpiod_pin_t *) calloc(sizeof(sdi_gpiod_pin_t), 1);
+    STD_ASSERT(gpiod_pin != NULL);
+
+    gpiod_pin->lines.line = (uint_t *) calloc(sizeof(uint_t), 1);
+    STD_ASSERT(gpiod_pin->lines.line != NULL);
+    gpiod_pin->lines.line_count = 1;
+    gpiod_pin->lines.line_fd = SDI_INVALID_FILE_FD;
+
+    pin_bus = &(gpiod_pin->bus);
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_INSTANCE);
+    STD_ASSERT(node_attr != NULL);
+    pin_bus->bus.bus_id = (uint_t) strtoul (node_attr, NULL, 0);
+
+    pin_bus->bus.bus_type = SDI_PIN_BUS;
+    pin_bus->bus.bus_init = sdi_gpiod_driver_init;
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_GPIO_CHIP);
+    STD_ASSERT(node_attr != NULL);
+    gpiod_pin->lines.chip_num = (uint_t) strtoul (node_attr, NULL, 0);
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_PIN_NUMBER);
+    STD_ASSERT(node_attr != NULL);
+    gpiod_pin->lines.line[0] = (uint_t) strtoul (node_attr, NULL, 0);
+
+    pin_bus->default_direction = sdi_gpiod_direction_attr_get(node);
+    pin_bus->default_polarity = sdi_gpiod_polarity_attr_get(node);
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_PIN_LEVEL);
+    if (node_attr != NULL) {
+        pin_bus->default_level = (int) strtoul (node_attr, NULL, 0);
+        STD_ASSERT(((pin_bus->default_level == SDI_PIN_LEVEL_LOW) ||
+            ((pin_bus->default_level == SDI_PIN_LEVEL_HIGH))));
+    } else {
+        pin_bus->default_level = SDI_PIN_LEVEL_LOW;
+    }
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_BUS_NAME);
+    STD_ASSERT(node_attr != NULL);
+    safestrncpy(pin_bus->bus.bus_name, node_attr, sizeof(pin_bus->bus.bus_name));
+
+    do {
+        if (std_mutex_lock_init_non_recursive(&(pin_bus->lock)) != STD_ERR_OK) {
+            error = BUS_LOCK_INIT_FAILURE;
+            SDI_DEVICE_ERRMSG_LOG("%s:%d Bus %s gpiod pin %u lock init failed\n",
+                __FUNCTION__, __LINE__, pin_bus->bus.bus_name,
+                gpiod_pin->lines.line[0]);
+            break;
+        }
+
+        pin_bus->ops = &sdi_gpiod_ops;
+
+        if (sdi_pin_bus_register((sdi_pin_bus_hdl_t )gpiod_pin) != STD_ERR_OK) {
+            error = BUS_REGISTRATION_FAILURE;
+            SDI_DEVICE_ERRMSG_LOG("%s:%d Bus %s gpiod pin %u registration failed\n",
+                __FUNCTION__, __LINE__, pin_bus->bus.bus_name,
+                gpiod_pin->lines.line[0]);
+            break;
+        }
+    } while (0);
+
+    if (error == STD_ERR_OK) {
+        *bus = (sdi_bus_hdl_t ) gpiod_pin;
+        sdi_bus_register_device_list(node, (sdi_bus_hdl_t) gpiod_pin);
+    } else {
+        if (error == BUS_REGISTRATION_FAILURE) {
+            std_mutex_destroy(&(pin_bus->lock));
+        }
+        free(gpiod_pin->lines.line);
+        free(gpiod_pin);
+    }
+
+    return error;
+}
+
+/**
+ * SDI gpiod Driver Object to hold gpiod registration and
+ * initialization function
+ * Note:
+ * Every bus driver must export function with name
+ * sdi_<bus_driver_name>_entry_callbacks
+ * so that the driver framework is able to look up and invoke it to get the
+ * callbacks
+ */
+const sdi_bus_driver_t * sdi_gpiod_entry_callbacks(void)
+{
+     /*Export Bus Driver table*/
+     static const sdi_bus_driver_t sdi_gpiod_entry = {
+        .bus_register = sdi_gpiod_driver_register,
+        .bus_init = sdi_gpiod_driver_init
+     };
+     return &sdi_gpiod_entry;
+}
+
+/**
+ * Convert a pin group level to line levels. First line of the group is the
+ * most significant bit of the level.
+ * param[in] lines - line request of the group
+ * param[in] value - pin group level
+ * return line levels, bit n is level of line[n]
+ */
+static uint64_t sdi_gpiod_group_value_to_lines(const sdi_gpiod_lines_t *lines, uint_t value)
+{
+    uint64_t values = 0;
+    uint_t index = 0;
+
+    for (index = 0; index < lines->line_count; index++) {
+        if (value & (1U << (lines->line_count - index - 1))) {
+            values |= (((uint64_t)1) << index);
+        }
+    }
+    return values;
+}
+
+/**
+ * Read value of the GPIOD Pin Group with a single ioctl
+ * param[in] bus_hdl - gpiod pin group bus handle
+ * param[out] value - GPIO pin group level currently configured in pin group
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_group_level_read(sdi_pin_group_bus_hdl_t bus_hdl,
+                                              uint_t *value)
+{
+    sdi_gpiod_group_t *gpiod_group = (sdi_gpiod_group_t *) bus_hdl;
+    sdi_gpiod_lines_t *lines = &(gpiod_group->lines);
+    uint64_t values = 0;
+    uint_t index = 0;
+    t_std_error err = STD_ERR_OK;
+    /* bus_hdl is already validated by its caller (sdi_pin_group_read_level) */
+
+    err = sdi_gpiod_lines_values_get(lines, &values);
+    if (err != STD_ERR_OK) {
+        SDI_DEVICE_ERRMSG_LOG("%s:%d Bus %s level can't be read, err: %d\n",
+            __FUNCTION__, __LINE__, bus_hdl->bus.bus_name, err);
+        return err;
+    }
+
+    *value = 0;
+    for (index = 0; index < lines->line_count; index++) {
+        if (values & (((uint64_t)1) << index)) {
+            *value |= (1U << (lines->line_count - index - 1));
+        }
+    }
+
+    return err;
+}
+
+/**
+ * Write value of the GPIOD Pin Group. All lines change with a single ioctl.
+ * param[in] bus_hdl - gpiod pin group bus handle
+ * param[in] value - level to be configured in given gpio pin group
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_group_level_write(sdi_pin_group_bus_hdl_t bus_hdl,
+                                               uint_t value)
+{
+    sdi_gpiod_group_t *gpiod_group = (sdi_gpiod_group_t *) bus_hdl;
+    sdi_gpiod_lines_t *lines = &(gpiod_group->lines);
+    t_std_error err = STD_ERR_OK;
+    /* bus_hdl is already validated by its caller (sdi_pin_group_write_level) */
+
+    STD_ASSERT((lines->line_count == MAX_NUMBER_OF_PINS_IN_GROUP)
+               || (value < (1U << lines->line_count)));
+
+    err = sdi_gpiod_lines_values_set(lines, sdi_gpiod_group_value_to_lines(lines, value));
+    if (err != STD_ERR_OK) {
+        SDI_DEVICE_ERRMSG_LOG("%s:%d Bus %s level can't be set to %u, err: %d\n",
+            __FUNCTION__, __LINE__, bus_hdl->bus.bus_name, value, err);
+    }
+    return err;
+}
+
+/**
+ * Configure pin group direction to Input/Output
+ * param[in] bus_hdl - gpiod pin group bus handle
+ * param[in] direction - direction to be configured to the given pin group
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_group_direction_set(sdi_pin_group_bus_hdl_t bus_hdl,
+                                                 sdi_pin_bus_direction_t direction)
+{
+    sdi_gpiod_group_t *gpiod_group = (sdi_gpiod_group_t *) bus_hdl;
+    /* bus_hdl is already validated by its caller (sdi_pin_group_set_direction) */
+
+    return sdi_gpiod_lines_config_set(&(gpiod_group->lines), direction,
+                                      gpiod_group->lines.polarity);
+}
+
+/**
+ * Get configured pin group direction
+ * param[in] bus_hdl - gpiod pin group bus handle
+ * param[out] direction - direction currently configured in pin group
+ * return STD_ERR_OK
+ */
+static t_std_error sdi_gpiod_group_direction_get(sdi_pin_group_bus_hdl_t bus_hdl,
+                                                 sdi_pin_bus_direction_t *direction)
+{
+    sdi_gpiod_group_t *gpiod_group = (sdi_gpiod_group_t *) bus_hdl;
+    /* bus_hdl is already validated by its caller (sdi_pin_group_get_direction) */
+
+    *direction = gpiod_group->lines.direction;
+    return STD_ERR_OK;
+}
+
+/**
+ * Set the polarity of the pin group
+ * param[in] bus_hdl - gpiod pin group bus handle
+ * param[in] polarity - polarity to be configured to the given pin group
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_group_polarity_set(sdi_pin_group_bus_hdl_t bus_hdl,
+                                                sdi_pin_bus_polarity_t polarity)
+{
+    sdi_gpiod_group_t *gpiod_group = (sdi_gpiod_group_t *) bus_hdl;
+    /* bus_hdl is already validated by its caller (sdi_pin_group_set_polarity) */
+
+    return sdi_gpiod_lines_config_set(&(gpiod_group->lines),
+                                      gpiod_group->lines.direction, polarity);
+}
+
+/**
+ * Get current configured pin group polarity
+ * param[in] bus_hdl - gpiod pin group bus handle
+ * param[out] polarity - current polarity configuration of the pin group
+ * return STD_ERR_OK
+ */
+static t_std_error sdi_gpiod_group_polarity_get(sdi_pin_group_bus_hdl_t bus_hdl,
+                                                sdi_pin_bus_polarity_t *polarity)
+{
+    sdi_gpiod_group_t *gpiod_group = (sdi_gpiod_group_t *) bus_hdl;
+    /* bus_hdl is already validated by its caller (sdi_pin_group_get_polarity) */
+
+    *polarity = gpiod_group->lines.polarity;
+    return STD_ERR_OK;
+}
+
+/**
+ * Get file descriptor signalling level changes of any pin of the group
+ * param[in] bus_hdl - gpiod pin group bus handle
+ * param[out] fd - pollable file descriptor of the pin group
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_group_event_fd_get(sdi_pin_group_bus_hdl_t bus_hdl,
+                                                int *fd)
+{
+    sdi_gpiod_group_t *gpiod_group = (sdi_gpiod_group_t *) bus_hdl;
+    /* bus_hdl is already validated by its caller (sdi_pin_group_event_fd_get) */
+
+    return sdi_gpiod_lines_event_fd_get(&(gpiod_group->lines), fd);
+}
+
+/**
+ * Consume pending level change events of the pin group
+ * param[in] bus_hdl - gpiod pin group bus handle
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_group_event_clear(sdi_pin_group_bus_hdl_t bus_hdl)
+{
+    sdi_gpiod_group_t *gpiod_group = (sdi_gpiod_group_t *) bus_hdl;
+    /* bus_hdl is already validated by its caller (sdi_pin_group_event_clear) */
+
+    return sdi_gpiod_lines_event_clear(&(gpiod_group->lines));
+}
+
+/**
+ * GPIOD Pin Group operations to get/set pin group level, direction and
+ * polarity */
+static sdi_pin_group_bus_ops_t sdi_gpiod_group_ops = {
+    .sdi_pin_group_bus_read_level = sdi_gpiod_group_level_read,
+    .sdi_pin_group_bus_write_level = sdi_gpiod_group_level_write,
+    .sdi_pin_group_bus_set_direction = sdi_gpiod_group_direction_set,
+    .sdi_pin_group_bus_get_direction = sdi_gpiod_group_direction_get,
+    .sdi_pin_group_bus_set_polarity = sdi_gpiod_group_polarity_set,
+    .sdi_pin_group_bus_get_polarity = sdi_gpiod_group_polarity_get,
+    .sdi_pin_group_bus_event_fd_get = sdi_gpiod_group_event_fd_get,
+    .sdi_pin_group_bus_event_clear = sdi_gpiod_group_event_clear,
+};
+
+/**
+ * Parse lines of a pin group
+ * param[in] gpiod_group - pointer to gpiod pin group object
+ * param[in] pin_group_str - line offsets seperated by comma, for ex: 1,2
+ * return none
+ */
+static void create_gpiod_group(sdi_gpiod_group_t *gpiod_group,
+                               const char *pin_group_str)
+{
+    size_t count = 0;
+    const char *token = NULL;
+    std_parsed_string_t handle;
+
+    if (std_parse_string(&handle, pin_group_str, ",")) {
+        count = std_parse_string_num_tokens(handle);
+        STD_ASSERT(count >= MIN_NUMBER_OF_PINS_IN_GROUP);
+        STD_ASSERT(count <= MAX_NUMBER_OF_PINS_IN_GROUP);
+
+        gpiod_group->lines.line_count = (uint_t)count;
+        gpiod_group->lines.line = (uint_t *) calloc(sizeof(uint_t), count);
+        STD_ASSERT(gpiod_group->lines.line != NULL);
+
+        count = 0;
+        while((token = std_parse_string_next(handle,&count))) {
+            gpiod_group->lines.line[count-1] = (uint_t) strtoul(token, NULL, 0);
+        }
+        std_parse_string_free(handle);
+    }
+}
+
+/**
+ * SDI GPIOD Group Initialization
+ * Request all lines of the pin group at once with the default direction,
+ * level and polarity
+ * param[in] bus_hdl - gpiod pin group handle
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_group_driver_init(sdi_bus_hdl_t bus_hdl)
+{
+    sdi_gpiod_group_t *gpiod_group = (sdi_gpiod_group_t *) bus_hdl;
+    sdi_pin_group_bus_hdl_t pin_group_bus = NULL;
+    sdi_gpiod_lines_t *lines = NULL;
+    t_std_error err = STD_ERR_OK;
+
+    STD_ASSERT(gpiod_group != NULL);
+
+    pin_group_bus = &(gpiod_group->bus);
+    lines = &(gpiod_group->lines);
+
+    if (lines->line_fd != SDI_INVALID_FILE_FD) {
+        return err;
+    }
+
+    err = sdi_gpiod_lines_request(lines, pin_group_bus->bus.bus_name,
+              pin_group_bus->default_direction, pin_group_bus->default_polarity,
+              sdi_gpiod_group_value_to_lines(lines, pin_group_bus->default_level));
+    if (err != STD_ERR_OK) {
+        SDI_DEVICE_ERRMSG_LOG("%s:%d Bus %s gpio chip %u id %d line request failed\n",
+            __FUNCTION__, __LINE__, pin_group_bus->bus.bus_name,
+            lines->chip_num, pin_group_bus->bus.bus_id);
+    }
+
+    return err;
+}
+
+/**
+ * SDI GPIOD Group driver registration
+ * Creates gpiod pin group object for every defined gpiod pin group
+ * and registers with pin group bus framework.
+ * param[in] node - gpiod pin group bus node handle obtained by parsing configuration
+ * param[out] bus - to be filled with gpiod pin group bus handle
+ * return STD_ERR_OK on success, SDI_DEVICE_ERRNO on failure
+ */
+static t_std_error sdi_gpiod_group_driver_register(std_config_node_t node,
+                                                   sdi_bus_hdl_t *bus)
+{
+    sdi_gpiod_group_t *gpiod_group = NULL;
+    char *node_attr = NULL;
+    sdi_pin_group_bus_hdl_t pin_group_bus = NULL;
+    t_std_error error = STD_ERR_OK;
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_PIN_GROUP);
+    STD_ASSERT(node_attr != NULL);
+
+    gpiod_group = (sdi_gpiod_group_t *) calloc(sizeof(sdi_gpiod_group_t), 1);
+    STD_ASSERT(gpiod_group != NULL);
+
+    gpiod_group->lines.line_fd = SDI_INVALID_FILE_FD;
+    create_gpiod_group(gpiod_group, node_attr);
+
+    pin_group_bus = &(gpiod_group->bus);
+    pin_group_bus->default_level = SDI_PIN_LEVEL_LOW;
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_PIN_LEVEL);
+    if (node_attr != NULL) {
+        pin_group_bus->default_level = (uint_t) strtoul (node_attr, NULL, 0);
+        STD_ASSERT((gpiod_group->lines.line_count == MAX_NUMBER_OF_PINS_IN_GROUP)
+                   || (pin_group_bus->default_level < (1U << gpiod_group->lines.line_count)));
+    }
+
+    pin_group_bus->bus.bus_type = SDI_PIN_GROUP_BUS;
+    pin_group_bus->bus.bus_init = sdi_gpiod_group_driver_init;
+
+    pin_group_bus->ops = &sdi_gpiod_group_ops;
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_INSTANCE);
+    STD_ASSERT(node_attr != NULL);
+    pin_group_bus->bus.bus_id = (uint_t) strtoul (node_attr, NULL, 0);
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_GPIO_CHIP);
+    STD_ASSERT(node_attr != NULL);
+    gpiod_group->lines.chip_num = (uint_t) strtoul (node_attr, NULL, 0);
+
+    pin_group_bus->default_direction = sdi_gpiod_direction_attr_get(node);
+    pin_group_bus->default_polarity = sdi_gpiod_polarity_attr_get(node);
+
+    node_attr = std_config_attr_get(node, SDI_DEV_ATTR_BUS_NAME);
+    STD_ASSERT(node_attr != NULL);
+    safestrncpy(pin_group_bus->bus.bus_name, node_attr, sizeof(pin_group_bus->bus.bus_name));
+
+    do {
+        if (std_mutex_lock_init_non_recursive(&(pin_group_bus->lock)) != STD_ERR_OK) {
+            error = BUS_LOCK_INIT_FAILURE;
+            SDI_DEVICE_ERRMSG_LOG("%s:%d Bus %s gpiod pin group id %u lock init failed\n",
+                __FUNCTION__, __LINE__, pin_group_bus->bus.bus_name,
+                pin_group_bus->bus.bus_id);
+            break;
+        }
+
+        if (sdi_pin_group_bus_register(pin_group_bus) != STD_ERR_OK) {
+            error = BUS_REGISTRATION_FAILURE;
+            SDI_DEVICE_ERRMSG_LOG("%s:%d Bus %s gpiod pin group id %u registration failed\n",
+                __FUNCTION__, __LINE__, pin_group_bus->bus.bus_name,
+                pin_group_bus->bus.bus_id);
+            break;
+        }
+    } while (0);
+
+    if (error == STD_ERR_OK) {
+        *bus = (sdi_bus_hdl_t ) gpiod_group;
+        sdi_bus_register_device_list(node, (sdi_bus_hdl_t) pin_group_bus);
+    } else {
+        if (error == BUS_REGISTRATION_FAILURE) {
+            std_mutex_destroy(&(pin_group_bus->lock));
+        }
+        free(gpiod_group->lines.line);
+        free(gpiod_group);
+    }
+
+    return error;
+}
+
+#else /* GPIO_V2_GET_LINE_IOCTL */
+
+/**
+ * Kernel headers without gpio character device v2 interface, gpiod pins and
+ * pin groups can not be created.
+ * param[in] node - bus node handle obtained by parsing configuration
+ * param[out] bus - not filled
+ * return SDI_DEVICE_ERRCODE(EOPNOTSUPP)
+ */
+static t_std_error sdi_gpiod_unsupported_register(std_config_node_t node,
+                                                  sdi_bus_hdl_t *bus)
+{
+    SDI_DEVICE_ERRMSG_LOG("%s:%d gpio character device v2 interface not available\n",
+        __FUNCTION__, __LINE__);
+    return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
+}
+
+/**
+ * Nothing to initialize without gpio character device v2 interface
+ * param[in] bus_hdl - bus handle
+ * return SDI_DEVICE_ERRCODE(EOPNOTSUPP)
+ */
+static t_std_error sdi_gpiod_unsupported_init(sdi_bus_hdl_t bus_hdl)
+{
+    return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
+}
+
+/**
+ * SDI gpiod Driver Object, see below
+ */
+const sdi_bus_driver_t * sdi_gpiod_entry_callbacks(void)
+{
+     static const sdi_bus_driver_t sdi_gpiod_entry = {
+        .bus_register = sdi_gpiod_unsupported_register,
+        .bus_init = sdi_gpiod_unsupported_init
+     };
+     return &sdi_gpiod_entry;
+}
+
+#define sdi_gpiod_group_driver_register    sdi_gpiod_unsupported_register
+#define sdi_gpiod_group_driver_init        sdi_gpiod_unsupported_init
+
+#endif /* GPIO_V2_GET_LINE_IOCTL */
+
+/**
+ * SDI gpiod group object to hold gpiod group registration and
+ * initialization function
+ * Note:
+ * Every bus driver must export function with name
+ * sdi_<bus_driver_name>_entry_callbacks
+ * so that the driver framework is able to look up and invoke it to get the
+ * callbacks
+ */
+const sdi_bus_driver_t * sdi_gpiod_group_entry_callbacks(void)
+{
+     /*Export Bus Driver table*/
+     static const sdi_bus_driver_t sdi_gpiod_group_entry = {
+        .bus_register = sdi_gpiod_group_driver_register,
+        .bus_init = sdi_gpiod_group_driver_init
+     };
+     return &sdi_gpiod_group_entry;
+}
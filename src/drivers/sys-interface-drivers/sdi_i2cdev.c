@@ -50,26 +50,35 @@
 #include <string.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include <sys/ioctl.h>
 #include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 
 #define SDI_MAX_IIC_RETRY 5
-#define SDI_IIC_WAIT_TIME 1000 /*1ms*/
+#define SDI_IIC_RETRY_WAIT_TIME 1000 /*1ms, default delay before first retry*/
+#define SDI_IIC_MAX_RETRY_WAIT_TIME 32000 /*32ms*/
 
 /**
  * format for i2c node representation in configuration:
  * <sys_i2c instance="0" sysfs_name="SMBus SCH adapter at 0400"
- *            bus_name="smbus0">
+ *            bus_name="smbus0" settle_delay="0" retry_delay="1000">
  * <!-- sysfs_name is name of the kernel driven i2c bus as in sysfs i2c name file
  *        bus_name is the name of the i2c bus used during look-up operations
+ *        settle_delay is the delay in usec after every transaction
+ *        retry_delay is the delay in usec before the first retry of a failed
+ *        transaction, it is doubled on every further retry
  * -->
  *    <i2c_slave_node(s) attributes=..></i2c_slave_node(s)>
- *    <!-- one ore more i2c slaves like tmp75 sensor, eeprom device -->
+ *    <!-- one ore more i2c slaves like tmp75 sensor, eeprom device.
+ *         A slave needing time between transactions specifies settle_delay,
+ *         it takes precedence when longer than the bus settle_delay -->
  * </sys_i2c>
  *
  * bus_name is optional. If bus_name is not specified, it is constructed by
  * appending instance to node name.
+ * settle_delay is optional, defaults to no delay.
+ * retry_delay is optional, defaults to SDI_IIC_RETRY_WAIT_TIME.
  *
  * @todo pending
  * - generate i2c bus instance internally instead of fetching from config file
@@ -113,7 +122,7 @@ SMBUS receive byte command offset
  */
 #define SDI_SMBUS_16BIT_CMD_DEF_OFFSET    0
 
-static inline t_std_error sdi_smbus_write_byte(int i2cdev_fd,
+static inline t_std_error sdi_smbus_write_byte(sdi_sys_i2c_bus_t *bus,
                                                sdi_smbus_operation_t operation,
                                                sdi_smbus_data_type_t data_type,
                                                uint_t commandbuf,
@@ -229,9 +238,135 @@ static t_std_error sdi_i2cdev_acquire_bus (sdi_i2c_bus_hdl_t i2c_bus)
 }
 
 
+/**
+ * sdi_i2cdev_time_usec
+ * Get the monotonic time in micro seconds for bus timing counters
+ */
+static inline uint64_t sdi_i2cdev_time_usec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec * 1000000) + (ts.tv_nsec / 1000));
+}
+
+/**
+ * sdi_i2cdev_stat_add
+ * Add to a bus counter. Counters are updated with the bus lock held and read
+ * without it, so they are stored atomically.
+ * param[in] counter - counter of the bus
+ * param[in] value - value to add
+ * return none
+ */
+static inline void sdi_i2cdev_stat_add(uint64_t *counter, uint64_t value)
+{
+    __atomic_store_n(counter, (*counter + value), __ATOMIC_RELAXED);
+}
+
+/**
+ * sdi_i2cdev_delay
+ * Sleep for the given delay and account it in the bus sleep time counter
+ * param[in] bus - kernel i2c bus handle
+ * param[in] delay - delay in micro seconds
+ * return none
+ */
+static void sdi_i2cdev_delay(sdi_sys_i2c_bus_t *bus, uint_t delay)
+{
+    uint64_t start_time = 0;
+
+    if (delay == 0) {
+        return;
+    }
+    start_time = sdi_i2cdev_time_usec();
+    std_usleep(delay);
+    sdi_i2cdev_stat_add(&(bus->stats.sleep_time_us), sdi_i2cdev_time_usec() - start_time);
+}
+
+/**
+ * sdi_i2cdev_settle
+ * Wait after a transaction for the longer of bus settle delay and the settle
+ * delay configured for the slave device
+ * param[in] bus - kernel i2c bus handle
+ * param[in] address - I2C slave Address
+ * return none
+ */
+static inline void sdi_i2cdev_settle(sdi_sys_i2c_bus_t *bus,
+                                     sdi_i2c_addr_t address)
+{
+    sdi_i2cdev_delay(bus, (address.settle_delay > bus->settle_delay) ?
+                          address.settle_delay : bus->settle_delay);
+}
+
+/**
+ * sdi_i2cdev_set_slave
+ * Program the slave address on i2cdev_fd, unless it is already programmed
+ * param[in] bus - kernel i2c bus handle
+ * param[in] address - I2C slave Address
+ * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
+ */
+static t_std_error sdi_i2cdev_set_slave(sdi_sys_i2c_bus_t *bus,
+                                        sdi_i2c_addr_t address)
+{
+    t_std_error error = STD_ERR_OK;
+
+    if (bus->slave_addr == address.i2c_addr) {
+        return STD_ERR_OK;
+    }
+
+    if (ioctl(bus->i2cdev_fd, I2C_SLAVE, address.i2c_addr) != STD_ERR_OK) {
+        error = SDI_DEVICE_ERRNO;
+        bus->slave_addr = SDI_I2CDEV_SLAVE_ADDR_NONE;
+        SDI_DEVICE_ERRMSG_LOG("%s:%d i2c bus %d set slave %2x failed %d\n",
+            __FUNCTION__, __LINE__, bus->bus.bus.bus_id, address.i2c_addr, error);
+        return error;
+    }
+
+    bus->slave_addr = address.i2c_addr;
+    return STD_ERR_OK;
+}
+
+/**
+ * sdi_i2cdev_set_pec
+ * Enable or disable SMBUS PEC on i2cdev_fd, unless it is already in the
+ * requested state
+ * param[in] bus - kernel i2c bus handle
+ * param[in] enable - true to enable PEC, false to disable PEC
+ * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
+ */
+static t_std_error sdi_i2cdev_set_pec(sdi_sys_i2c_bus_t *bus, bool enable)
+{
+    t_std_error error = STD_ERR_OK;
+
+    if (bus->pec_enabled == enable) {
+        return STD_ERR_OK;
+    }
+
+    if (ioctl(bus->i2cdev_fd, I2C_PEC, enable ? 1 : 0) != STD_ERR_OK) {
+        error = SDI_DEVICE_ERRNO;
+        SDI_DEVICE_ERRMSG_LOG("%s:%d i2c bus %d set PEC failed %d\n",
+            __FUNCTION__, __LINE__, bus->bus.bus.bus_id, error);
+        return error;
+    }
+
+    bus->pec_enabled = enable;
+    return STD_ERR_OK;
+}
+
+/**
+ * sdi_i2cdev_next_retry_delay
+ * Get the delay before the next retry, doubled on every retry
+ * param[in] retry_delay - delay used before the current retry
+ * return delay in micro seconds
+ */
+static inline uint_t sdi_i2cdev_next_retry_delay(uint_t retry_delay)
+{
+    return ((retry_delay * 2) > SDI_IIC_MAX_RETRY_WAIT_TIME) ?
+            SDI_IIC_MAX_RETRY_WAIT_TIME : (retry_delay * 2);
+}
+
 /* Run a script to attempt to clear locked-up I2C controller */
 
-static void i2c_reset(const char *func, int fd, sdi_smbus_operation_t operation, sdi_smbus_data_type_t data_type, uint_t commandbuf)
+static void i2c_reset(const char *func, sdi_sys_i2c_bus_t *bus, sdi_smbus_operation_t operation, sdi_smbus_data_type_t data_type, uint_t commandbuf)
 {
     static const char script[] = "/usr/libexec/opx-i2c-reset";
 
@@ -259,6 +394,9 @@ static void i2c_reset(const char *func, int fd, sdi_smbus_operation_t operation,
 
     (void) std_sys_execve_command(script, args, envp);
 
+    /* Devices on the bus, like muxes, may have lost their state */
+    sdi_i2cdev_stat_add(&(bus->stats.resets), 1);
+
     return;
 }
 
@@ -267,19 +405,21 @@ static void i2c_reset(const char *func, int fd, sdi_smbus_operation_t operation,
 /**
  * sdi_sys_smbus_execute
  * Execute the I2C SMBUS transaction by issuing an ioctl to kernel smbus driver
- * param[in] i2cdev_fd - opened file descriptor for i2c bus
+ * param[in] bus - kernel i2c bus handle
  * param[in] operation - SMBUS Read/Write Operation
  * param[in] data_type - SMBUS Transaction size
  * param[in] commandbuf - Address offset of SMBUS Transaction
  * param[out] data - Holds SMBUS Transaction data read/to write.
  * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
  */
-static t_std_error sdi_sys_smbus_execute(int i2cdev_fd,
+static t_std_error sdi_sys_smbus_execute(sdi_sys_i2c_bus_t *bus,
     sdi_smbus_operation_t operation, sdi_smbus_data_type_t data_type,
     uint_t commandbuf, union i2c_smbus_data *data)
 {
     t_std_error error = STD_ERR_OK;
     uint_t retry_count = SDI_MAX_IIC_RETRY;
+    uint_t retry_delay = bus->retry_delay;
+    uint64_t start_time = 0;
     struct i2c_smbus_ioctl_data cmd;
     cmd.read_write = operation;
     cmd.command = (uint8_t) commandbuf;
@@ -287,44 +427,148 @@ static t_std_error sdi_sys_smbus_execute(int i2cdev_fd,
     cmd.data = data;
 
     do {
-        error = ioctl(i2cdev_fd, I2C_SMBUS, &cmd);
+        start_time = sdi_i2cdev_time_usec();
+        error = ioctl(bus->i2cdev_fd, I2C_SMBUS, &cmd);
+        sdi_i2cdev_stat_add(&(bus->stats.io_time_us), sdi_i2cdev_time_usec() - start_time);
+        sdi_i2cdev_stat_add(&(bus->stats.transactions), 1);
         if (error != STD_ERR_OK) {
-            i2c_reset(__FUNCTION__, i2cdev_fd, operation, data_type, commandbuf);
+            i2c_reset(__FUNCTION__, bus, operation, data_type, commandbuf);
             retry_count--;
-            std_usleep(SDI_IIC_WAIT_TIME);
+            if (retry_count != 0) {
+                sdi_i2cdev_stat_add(&(bus->stats.retries), 1);
+                sdi_i2cdev_delay(bus, retry_delay);
+                retry_delay = sdi_i2cdev_next_retry_delay(retry_delay);
+            }
         }
     } while( (error != STD_ERR_OK) && (retry_count != 0) );
 
-    std_usleep(SDI_IIC_WAIT_TIME);
-
     if (error != STD_ERR_OK) {
         SDI_DEVICE_ERRMSG_LOG("%s:%d smbus transaction on i2cdev_fd %d,"
                 "operation %d command %d size %d data %p failed with error %d and errno:0x%x\n",
-                __FUNCTION__, __LINE__, i2cdev_fd, operation, commandbuf, data_type,
+                __FUNCTION__, __LINE__, bus->i2cdev_fd, operation, commandbuf, data_type,
                 data, error, errno);
         error = SDI_DEVICE_ERRNO;
         if ((errno == EIO) || (errno == ETIMEDOUT)) {
             /* attempt to recover from i2c bus hang if IO error or connection timedout*/
-            i2c_reset(__FUNCTION__, i2cdev_fd, operation, data_type, commandbuf);
+            i2c_reset(__FUNCTION__, bus, operation, data_type, commandbuf);
         }
     } else if(retry_count != SDI_MAX_IIC_RETRY) {
         SDI_DEVICE_ERRMSG_LOG("%s:%d smbus transaction on i2cdev_fd %d, operation %d command %d size %d data %p is succeeded after %u retries\n",
-                              __FUNCTION__, __LINE__, i2cdev_fd, operation, commandbuf, data_type, data, (SDI_MAX_IIC_RETRY - retry_count));
+                              __FUNCTION__, __LINE__, bus->i2cdev_fd, operation, commandbuf, data_type, data, (SDI_MAX_IIC_RETRY - retry_count));
     }
 
     return error;
 }
 
+/**
+ * sdi_sys_i2c_rdwr_execute
+ * Execute a combined I2C transaction by issuing I2C_RDWR ioctl to kernel
+ * i2c driver. All the messages are sent with repeated start in between, so
+ * an offset write followed by a read of any length costs a single ioctl.
+ * param[in] bus - kernel i2c bus handle
+ * param[in] msgs - i2c messages to be transferred
+ * param[in] nmsgs - number of i2c messages
+ * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure,
+ * SDI_DEVICE_ERRCODE(EOPNOTSUPP) when the adapter rejects the messages
+ */
+static t_std_error sdi_sys_i2c_rdwr_execute(sdi_sys_i2c_bus_t *bus,
+    struct i2c_msg *msgs, uint_t nmsgs)
+{
+    int rc = 0;
+    t_std_error error = STD_ERR_OK;
+    uint_t retry_count = SDI_MAX_IIC_RETRY;
+    uint_t retry_delay = bus->retry_delay;
+    uint64_t start_time = 0;
+    uint_t commandbuf = ((msgs[0].flags & I2C_M_RD) == 0) ? msgs[0].buf[0] : 0;
+    struct i2c_rdwr_ioctl_data cmd;
+    cmd.msgs = msgs;
+    cmd.nmsgs = nmsgs;
+
+    do {
+        start_time = sdi_i2cdev_time_usec();
+        rc = ioctl(bus->i2cdev_fd, I2C_RDWR, &cmd);
+        sdi_i2cdev_stat_add(&(bus->stats.io_time_us), sdi_i2cdev_time_usec() - start_time);
+        sdi_i2cdev_stat_add(&(bus->stats.transactions), 1);
+        if ((rc < 0) && (errno == EOPNOTSUPP)) {
+            /* Adapter can't do this combination of messages, nothing was sent */
+            SDI_DEVICE_TRACEMSG_LOG("%s:%d i2c rdwr of %u msgs not supported on i2cdev_fd %d\n",
+                    __FUNCTION__, __LINE__, nmsgs, bus->i2cdev_fd);
+            return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
+        }
+        if (rc < 0) {
+            i2c_reset(__FUNCTION__, bus, SDI_SMBUS_READ,
+                      SDI_SMBUS_BLOCK_DATA, commandbuf);
+            retry_count--;
+            if (retry_count != 0) {
+                sdi_i2cdev_stat_add(&(bus->stats.retries), 1);
+                sdi_i2cdev_delay(bus, retry_delay);
+                retry_delay = sdi_i2cdev_next_retry_delay(retry_delay);
+            }
+        }
+    } while( (rc < 0) && (retry_count != 0) );
+
+    if (rc < 0) {
+        SDI_DEVICE_ERRMSG_LOG("%s:%d i2c rdwr transaction on i2cdev_fd %d,"
+                "addr 0x%x command %d nmsgs %u failed with errno:0x%x\n",
+                __FUNCTION__, __LINE__, bus->i2cdev_fd, msgs[0].addr, commandbuf,
+                nmsgs, errno);
+        error = SDI_DEVICE_ERRNO;
+        if ((errno == EIO) || (errno == ETIMEDOUT)) {
+            /* attempt to recover from i2c bus hang if IO error or connection timedout*/
+            i2c_reset(__FUNCTION__, bus, SDI_SMBUS_READ,
+                      SDI_SMBUS_BLOCK_DATA, commandbuf);
+        }
+    } else if(retry_count != SDI_MAX_IIC_RETRY) {
+        SDI_DEVICE_ERRMSG_LOG("%s:%d i2c rdwr transaction on i2cdev_fd %d, addr 0x%x command %d nmsgs %u is succeeded after %u retries\n",
+                              __FUNCTION__, __LINE__, bus->i2cdev_fd, msgs[0].addr, commandbuf, nmsgs, (SDI_MAX_IIC_RETRY - retry_count));
+    }
+
+    return error;
+}
+
+/**
+ * sdi_smbus_read_i2c_block
+ * Read buflen bytes starting at offset specified by commandbuf using SMBUS
+ * I2C block read transactions, I2C_SMBUS_BLOCK_MAX bytes at a time.
+ * param[in] bus - kernel i2c bus handle
+ * param[in] commandbuf - Address offset for SMBUS Transaction
+ * param[out] buf - Store the result of I2C Read in Buffer
+ * param[in] buflen - no.of bytes to read
+ * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
+ */
+static t_std_error sdi_smbus_read_i2c_block(sdi_sys_i2c_bus_t *bus, uint_t commandbuf,
+    uint8_t *buf, uint_t buflen)
+{
+    t_std_error error = STD_ERR_OK;
+    union i2c_smbus_data data;
+    uint_t chunk = 0;
+
+    while (buflen != 0) {
+        chunk = (buflen > I2C_SMBUS_BLOCK_MAX) ? I2C_SMBUS_BLOCK_MAX : buflen;
+        data.block[0] = chunk;
+        error = sdi_sys_smbus_execute(bus, SDI_SMBUS_READ,
+                    I2C_SMBUS_I2C_BLOCK_DATA, commandbuf, &data);
+        if (error != STD_ERR_OK) {
+            return error;
+        }
+        memcpy(buf, &data.block[1], chunk);
+        buf += chunk;
+        buflen -= chunk;
+        commandbuf += chunk;
+    }
+    return error;
+}
+
 /**
  * sdi_smbus_recv_byte
  * Read a byte using I2C from I2C Bus File descriptor opened on i2cdev_fd
- * param[in] i2cdev_fd - opened file descriptor for i2c bus
+ * param[in] bus - kernel i2c bus handle
  * param[in] operation - SMBUS Read/Write Operation
  * param[in] data_type - SMBUS Transaction size
  * param[out] buffer - Store the result of I2C SMBUS Byte Read Operation
  * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
  */
-static inline t_std_error sdi_smbus_recv_byte(int i2cdev_fd,
+static inline t_std_error sdi_smbus_recv_byte(sdi_sys_i2c_bus_t *bus,
     sdi_smbus_operation_t operation, sdi_smbus_data_type_t data_type,
     void *buffer)
 
@@ -332,7 +576,7 @@ static inline t_std_error sdi_smbus_recv_byte(int i2cdev_fd,
     t_std_error error = STD_ERR_OK;
     union i2c_smbus_data data = { .byte = 0 };
 
-    error = sdi_sys_smbus_execute(i2cdev_fd, operation, data_type,
+    error = sdi_sys_smbus_execute(bus, operation, data_type,
                 SDI_SMBUS_RECV_BYTE_CMD_OFFSET, &data);
     if (error == STD_ERR_OK) {
         *(uint8_t *)buffer = SDI_MAX_BYTE_VAL & data.byte;
@@ -343,17 +587,17 @@ static inline t_std_error sdi_smbus_recv_byte(int i2cdev_fd,
 /**
  * sdi_smbus_send_byte
  * Write a byte using I2C from I2C Bus File descriptor opened on i2cdev_fd
- * param[in] i2cdev_fd - opened file descriptor for i2c bus
+ * param[in] bus - kernel i2c bus handle
  * param[in] operation - SMBUS Read/Write Operation
  * param[in] data_type - SMBUS Transaction size
  * param[in] commandbuf - Address offset for SMBUS Transaction
  * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
  */
-static inline t_std_error sdi_smbus_send_byte(int i2cdev_fd,
+static inline t_std_error sdi_smbus_send_byte(sdi_sys_i2c_bus_t *bus,
     sdi_smbus_operation_t operation, sdi_smbus_data_type_t data_type,
     uint_t commandbuf)
 {
-    return sdi_sys_smbus_execute(i2cdev_fd, operation, data_type,
+    return sdi_sys_smbus_execute(bus, operation, data_type,
         commandbuf, NULL);
 }
 
@@ -362,14 +606,14 @@ static inline t_std_error sdi_smbus_send_byte(int i2cdev_fd,
  * sdi_smbus_read_byte
  * Read a byte from offset specified by commandbuf using I2C from I2C Bus File
  * descriptor opened on i2cdev_fd
- * param[in] i2cdev_fd - opened file descriptor for i2c bus
+ * param[in] bus - kernel i2c bus handle
  * param[in] operation - SMBUS Read/Write Operation
  * param[in] data_type - SMBUS Transaction size
  * param[in] commandbuf - Address offset for SMBUS Transaction
  * param[out] buffer - Store the result of I2C Read in Buffer
  * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
  */
-static inline t_std_error sdi_smbus_read_byte(int i2cdev_fd,
+static inline t_std_error sdi_smbus_read_byte(sdi_sys_i2c_bus_t *bus,
     sdi_smbus_operation_t operation, sdi_smbus_data_type_t data_type,
     uint_t commandbuf, void *buffer)
 
@@ -377,7 +621,7 @@ static inline t_std_error sdi_smbus_read_byte(int i2cdev_fd,
     union i2c_smbus_data data = { .byte = 0 };
     t_std_error error = STD_ERR_OK;
 
-    error = sdi_sys_smbus_execute(i2cdev_fd, operation, data_type,
+    error = sdi_sys_smbus_execute(bus, operation, data_type,
         commandbuf, &data);
     if (error == STD_ERR_OK) {
         *(uint8_t *)buffer = SDI_MAX_BYTE_VAL & data.byte;
@@ -389,20 +633,20 @@ static inline t_std_error sdi_smbus_read_byte(int i2cdev_fd,
  * sdi_smbus_write_byte
  * Write a byte at offset specified by commandbuf using I2C from I2C Bus File
  * descriptor opened on i2cdev_fd
- * param[in] i2cdev_fd - opened file descriptor for i2c bus
+ * param[in] bus - kernel i2c bus handle
  * param[in] operation - SMBUS Read/Write Operation
  * param[in] data_type - SMBUS Transaction size
  * param[in] commandbuf - Address offset for SMBUS Transaction
  * param[out] buffer - Write the byte in Buffer to I2C Bus
  * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
  */
-static inline t_std_error sdi_smbus_write_byte(int i2cdev_fd,
+static inline t_std_error sdi_smbus_write_byte(sdi_sys_i2c_bus_t *bus,
     sdi_smbus_operation_t operation, sdi_smbus_data_type_t data_type,
     uint_t commandbuf, void *buffer)
 {
     union i2c_smbus_data data = { .byte = (*(uint8_t *)buffer) };
 
-    return sdi_sys_smbus_execute(i2cdev_fd, operation, data_type,
+    return sdi_sys_smbus_execute(bus, operation, data_type,
             commandbuf, &data);
 }
 
@@ -410,30 +654,33 @@ static inline t_std_error sdi_smbus_write_byte(int i2cdev_fd,
  * sdi_smbus_write_block
  * Write a block at offset specified by commandbuf using I2C
  * from I2C Bus File descriptor opened on i2cdev_fd
- * param[in] i2cdev_fd - opened file descriptor for i2c bus
+ * param[in] bus - kernel i2c bus handle
  * param[in] operation - SMBUS Read/Write Operation
  * param[in] data_type - SMBUS Transaction size
  * param[in] commandbuf - Address offset for SMBUS Transaction
  * param[out] buffer - Write the block in Buffer to I2C Bus
  * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
  */
-static inline t_std_error sdi_smbus_write_block(int i2cdev_fd,
+static inline t_std_error sdi_smbus_write_block(sdi_sys_i2c_bus_t *bus,
     sdi_smbus_operation_t operation, sdi_smbus_data_type_t data_type,
     uint_t commandbuf, void *buffer)
 {
     union i2c_smbus_data *data = buffer;
 
-    return sdi_sys_smbus_execute(i2cdev_fd, operation, data_type,
+    return sdi_sys_smbus_execute(bus, operation, data_type,
             commandbuf, data);
 }
 
 /**
  * sdi_i2c_read
- * Read a byte from offset specified by commandbuf using I2C from I2C Bus File
- * descriptor opened on i2cdev_fd
- * Note: This api is used, when cmdlen is 2 or 16bit offset. for other cases,
- * use smbus apis.
- * param[in] i2cdev_fd - opened file descriptor for i2c bus
+ * Read buflen bytes from offset specified by cmd using I2C from I2C Bus File
+ * descriptor opened on the bus.
+ * The transfer method is picked from the bus capability:
+ * - I2C capable bus : single combined I2C_RDWR transaction of any length
+ * - SMBUS I2C block capable bus : I2C_SMBUS_BLOCK_MAX byte chunks, only for
+ *   8bit offsets
+ * - otherwise a single byte read with 16bit offset using smbus apis.
+ * param[in] bus - kernel i2c bus handle
  * param[in] address   - I2C slave Address
  * param[in] cmd : list of read offsets
  * param[in] cmdlen : no. of offsets
@@ -441,24 +688,48 @@ static inline t_std_error sdi_smbus_write_block(int i2cdev_fd,
  * param[in] buflen : no.of bytes to read
  * param[in] flag : options if any to be sent @sa sdi_i2c_flags for
  * supported flags
- * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
+ * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure,
+ * SDI_DEVICE_ERRCODE(EOPNOTSUPP) when the bus can't do the requested read
  */
-static inline t_std_error sdi_i2c_read(int i2cdev_fd, sdi_i2c_addr_t address,
+static inline t_std_error sdi_i2c_read(sdi_sys_i2c_bus_t *bus, sdi_i2c_addr_t address,
                                             const uint8_t *cmd, uint_t cmdlen,
                                             void *buf, uint_t buflen, uint_t flag)
 {
     union i2c_smbus_data data = { .byte = 0 };
     t_std_error error = STD_ERR_OK;
+    struct i2c_msg msgs[2];
+    uint_t nmsgs = 0;
+
+    if ((bus->capability & I2C_FUNC_I2C) && ((flag & SDI_I2C_FLAG_PEC) == 0)) {
+        if (cmdlen != 0) {
+            msgs[nmsgs].addr = address.i2c_addr;
+            msgs[nmsgs].flags = 0;
+            msgs[nmsgs].len = cmdlen;
+            msgs[nmsgs].buf = (uint8_t *)cmd;
+            nmsgs++;
+        }
+        msgs[nmsgs].addr = address.i2c_addr;
+        msgs[nmsgs].flags = I2C_M_RD;
+        msgs[nmsgs].len = buflen;
+        msgs[nmsgs].buf = buf;
+        nmsgs++;
 
-    if (cmdlen == 2) {
+        return sdi_sys_i2c_rdwr_execute(bus, msgs, nmsgs);
+    }
+
+    if ((cmdlen == 1) && (bus->capability & I2C_FUNC_SMBUS_READ_I2C_BLOCK)) {
+        return sdi_smbus_read_i2c_block(bus, *cmd, buf, buflen);
+    }
+
+    if ((cmdlen == 2) && (buflen == 1)) {
         uint8_t buffer = *cmd;
 
-        error = sdi_smbus_write_byte(i2cdev_fd, SDI_SMBUS_WRITE, I2C_SMBUS_BYTE_DATA,
+        error = sdi_smbus_write_byte(bus, SDI_SMBUS_WRITE, I2C_SMBUS_BYTE_DATA,
                                     *(cmd++), &buffer);
         if (error != STD_ERR_OK) {
             return error;
         }
-        error = sdi_sys_smbus_execute(i2cdev_fd, SDI_SMBUS_READ, I2C_SMBUS_BYTE,
+        error = sdi_sys_smbus_execute(bus, SDI_SMBUS_READ, I2C_SMBUS_BYTE,
                                       SDI_SMBUS_16BIT_CMD_DEF_OFFSET, &data);
     } else {
         return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
@@ -475,7 +746,7 @@ static inline t_std_error sdi_i2c_read(int i2cdev_fd, sdi_i2c_addr_t address,
  * descriptor opened on i2cdev_fd
  * Note: This api is used, when cmdlen is 2 or 16bit offset. for other cases,
  * use smbus apis.
- * param[in] i2cdev_fd - opened file descriptor for i2c bus
+ * param[in] bus - kernel i2c bus handle
  * param[in] address   - I2C device Address
  * param[in] cmd : list of write offsets
  * param[in] cmdlen : no. of offsets
@@ -485,7 +756,7 @@ static inline t_std_error sdi_i2c_read(int i2cdev_fd, sdi_i2c_addr_t address,
  * supported flags
  * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
  */
-static inline t_std_error sdi_i2c_write(int i2cdev_fd, sdi_i2c_addr_t address,
+static inline t_std_error sdi_i2c_write(sdi_sys_i2c_bus_t *bus, sdi_i2c_addr_t address,
                                             const uint8_t *cmd, uint_t cmdlen,
                                             void *buf, uint_t buflen, uint_t flag)
 {
@@ -493,7 +764,7 @@ static inline t_std_error sdi_i2c_write(int i2cdev_fd, sdi_i2c_addr_t address,
 
     if (cmdlen == 2) {
         data.word = (*cmd | ((*(uint8_t *)buf) << BITS_PER_BYTE));
-        return sdi_sys_smbus_execute(i2cdev_fd, SDI_SMBUS_WRITE, I2C_SMBUS_WORD_DATA,
+        return sdi_sys_smbus_execute(bus, SDI_SMBUS_WRITE, I2C_SMBUS_WORD_DATA,
                                      *(cmd++), &data);
     } else {
         return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
@@ -504,14 +775,14 @@ static inline t_std_error sdi_i2c_write(int i2cdev_fd, sdi_i2c_addr_t address,
  * sdi_smbus_read_word
  * Read a word from offset specified by commandbuf using I2C from I2C Bus File
  * descriptor opened on i2cdev_fd
- * param[in] i2cdev_fd - opened file descriptor for i2c bus
+ * param[in] bus - kernel i2c bus handle
  * param[in] operation - SMBUS Read/Write Operation
  * param[in] data_type - SMBUS Transaction size
  * param[in] commandbuf - Address offset for SMBUS Transaction
  * param[out] buffer - Store the result of I2C Read in Buffer
  * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
  */
-static inline t_std_error sdi_smbus_read_word(int i2cdev_fd,
+static inline t_std_error sdi_smbus_read_word(sdi_sys_i2c_bus_t *bus,
     sdi_smbus_operation_t operation, sdi_smbus_data_type_t data_type,
     uint_t commandbuf, void *buffer)
 
@@ -519,7 +790,7 @@ static inline t_std_error sdi_smbus_read_word(int i2cdev_fd,
     t_std_error error = STD_ERR_OK;
     union i2c_smbus_data data = { .word = 0 };
 
-    error = sdi_sys_smbus_execute(i2cdev_fd, operation, data_type,
+    error = sdi_sys_smbus_execute(bus, operation, data_type,
             commandbuf, &data);
     if (error == STD_ERR_OK) {
         *(uint16_t *)buffer = SDI_MAX_WORD_VAL & data.word;
@@ -531,20 +802,20 @@ static inline t_std_error sdi_smbus_read_word(int i2cdev_fd,
  * sdi_smbus_write_word
  * Write a word at offset specified by commandbuf using I2C from I2C Bus File
  * descriptor opened on i2cdev_fd
- * param[in] i2cdev_fd - opened file descriptor for i2c bus
+ * param[in] bus - kernel i2c bus handle
  * param[in] operation - SMBUS Read/Write Operation
  * param[in] data_type - SMBUS Transaction size
  * param[in] commandbuf - Address offset for SMBUS Transaction
  * param[out] buffer - Write the byte in Buffer to I2C Bus
  * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure
  */
-static inline t_std_error sdi_smbus_write_word(int i2cdev_fd,
+static inline t_std_error sdi_smbus_write_word(sdi_sys_i2c_bus_t *bus,
     sdi_smbus_operation_t operation, sdi_smbus_data_type_t data_type,
     uint_t commandbuf, void *buffer)
 {
     union i2c_smbus_data data = { .word = (*(uint16_t *)buffer) };
 
-    return sdi_sys_smbus_execute(i2cdev_fd, operation, data_type,
+    return sdi_sys_smbus_execute(bus, operation, data_type,
             commandbuf, &data);
 }
 
@@ -568,23 +839,26 @@ static t_std_error sdi_i2cdev_i2c_execute(sdi_i2c_bus_hdl_t i2c_bus,
                    uint_t flags)
 {
     sdi_sys_i2c_bus_t * bus = (sdi_sys_i2c_bus_t *) i2c_bus;
-    int i2cdev_fd = bus->i2cdev_fd;
     t_std_error error = STD_ERR_OK;
 
-    if (ioctl(i2cdev_fd, I2C_SLAVE, address.i2c_addr) != STD_ERR_OK) {
-        error = SDI_DEVICE_ERRNO;
-        SDI_DEVICE_ERRMSG_LOG("%s:%d i2c bus %d set slave %2x failed %d",
-            __FUNCTION__, __LINE__, i2c_bus->bus.bus_id, address.i2c_addr, error);
+    error = sdi_i2cdev_set_slave(bus, address);
+    if (error != STD_ERR_OK) {
+        return error;
+    }
+
+    /* PEC may be left enabled by a previous SMBUS transaction */
+    error = sdi_i2cdev_set_pec(bus, false);
+    if (error != STD_ERR_OK) {
         return error;
     }
 
     switch (operation) {
         case SDI_I2C_WRITE:
-             error = sdi_i2c_write(i2cdev_fd, address, cmd, cmdlen, buffer,
+             error = sdi_i2c_write(bus, address, cmd, cmdlen, buffer,
 buflen, flags);
              break;
         case SDI_I2C_READ:
-             error = sdi_i2c_read(i2cdev_fd, address, cmd, cmdlen, buffer,
+             error = sdi_i2c_read(bus, address, cmd, cmdlen, buffer,
 buflen, flags);
              break;
         default:
@@ -594,6 +868,8 @@ buflen, flags);
              break;
     }
 
+    sdi_i2cdev_settle(bus, address);
+
     if (error != STD_ERR_OK) {
         SDI_DEVICE_ERRMSG_LOG("i2c bus %d operation:%d failed %d",
                                i2c_bus->bus.bus_id, operation, error);
@@ -632,62 +908,57 @@ static t_std_error sdi_i2cdev_smbus_execute(sdi_i2c_bus_hdl_t i2c_bus,
     uint_t flags)
 {
     sdi_sys_i2c_bus_t * bus = (sdi_sys_i2c_bus_t *) i2c_bus;
-    int i2cdev_fd = bus->i2cdev_fd;
     t_std_error error = STD_ERR_OK;
     uint8_t temp_buf = 0;
     uint16_t temp_word = 0;
 
-    if (ioctl(i2cdev_fd, I2C_SLAVE, address.i2c_addr) != STD_ERR_OK) {
-        error = SDI_DEVICE_ERRNO;
-        SDI_DEVICE_ERRMSG_LOG("%s:%d i2c bus %d set slave %2x failed %d\n",
-            __FUNCTION__, __LINE__, i2c_bus->bus.bus_id, address.i2c_addr, error);
+    error = sdi_i2cdev_set_slave(bus, address);
+    if (error != STD_ERR_OK) {
         return error;
     }
 
-    /*Enabling the SMBUS PEC */
-    if(flags == SDI_I2C_FLAG_PEC)
-    {
-        if (ioctl(i2cdev_fd, I2C_PEC, 1) != STD_ERR_OK) {
-            error = SDI_DEVICE_ERRNO;
-            SDI_DEVICE_ERRMSG_LOG("%s:%d i2c bus %d set PEC failed %d\n",
-                __FUNCTION__, __LINE__, i2c_bus->bus.bus_id, error);
-            return error;
-        }
+    /*
+     * PEC state is kept on the fd across transactions, so back to back PEC
+     * transactions (like PMBus polling) don't toggle it every time
+     */
+    error = sdi_i2cdev_set_pec(bus, (flags == SDI_I2C_FLAG_PEC));
+    if (error != STD_ERR_OK) {
+        return error;
     }
 
     switch (data_type) {
         case SDI_SMBUS_BYTE:
             if (operation == SDI_SMBUS_WRITE) {
-                error = sdi_smbus_send_byte(i2cdev_fd, operation,
+                error = sdi_smbus_send_byte(bus, operation,
                     I2C_SMBUS_BYTE, commandbuf);
             } else {
-                error = sdi_smbus_recv_byte(i2cdev_fd, operation,
+                error = sdi_smbus_recv_byte(bus, operation,
                     I2C_SMBUS_BYTE, buffer);
             }
             break;
         case SDI_SMBUS_BYTE_DATA:
             if (operation == SDI_SMBUS_WRITE) {
                 if (address.addr_mode_16bit == 0) {
-                    error = sdi_smbus_write_byte(i2cdev_fd,
+                    error = sdi_smbus_write_byte(bus,
                                operation, I2C_SMBUS_BYTE_DATA, commandbuf, buffer);
                 } else {
                     temp_buf = *(uint8_t *)buffer;
                     temp_word = ((temp_buf << 8) | (commandbuf & 0xff));
-                    error = sdi_smbus_write_word(i2cdev_fd,
+                    error = sdi_smbus_write_word(bus,
                                operation, I2C_SMBUS_WORD_DATA, (commandbuf >> 8) & 0xff,
                                &temp_word);
                 }
             } else {
                 if (address.addr_mode_16bit == 0) {
-                    error = sdi_smbus_read_byte(i2cdev_fd,
+                    error = sdi_smbus_read_byte(bus,
                                operation, I2C_SMBUS_BYTE_DATA, commandbuf, buffer);
                 } else {
                     temp_buf = (commandbuf & 0xff);
-                    error = sdi_smbus_write_byte(i2cdev_fd,
+                    error = sdi_smbus_write_byte(bus,
                                SDI_SMBUS_WRITE, I2C_SMBUS_BYTE_DATA, (commandbuf >> 8) & 0xff,
                                &temp_buf);
                     if (error == STD_ERR_OK) {
-                        error = sdi_smbus_recv_byte(i2cdev_fd, operation,
+                        error = sdi_smbus_recv_byte(bus, operation,
                                     I2C_SMBUS_BYTE, buffer);
                     } else {
                         SDI_DEVICE_ERRMSG_LOG("%s:%d i2c bus %d 16bit addr mode write byte data failed %d\n",
@@ -698,36 +969,36 @@ static t_std_error sdi_i2cdev_smbus_execute(sdi_i2c_bus_hdl_t i2c_bus,
             break;
         case SDI_SMBUS_WORD_DATA:
             if (operation == SDI_SMBUS_WRITE) {
-                error = sdi_smbus_write_word(i2cdev_fd,
+                error = sdi_smbus_write_word(bus,
                     operation, I2C_SMBUS_WORD_DATA, commandbuf, buffer);
             } else {
-                error = sdi_smbus_read_word(i2cdev_fd,
+                error = sdi_smbus_read_word(bus,
                     operation, I2C_SMBUS_WORD_DATA, commandbuf, buffer);
             }
             break;
     case SDI_SMBUS_BLOCK_DATA:
         if (operation == SDI_SMBUS_WRITE) {
             if (address.addr_mode_16bit == 0) {
-                error = sdi_smbus_write_block(i2cdev_fd,
+                error = sdi_smbus_write_block(bus,
                            operation, I2C_SMBUS_I2C_BLOCK_BROKEN, commandbuf, buffer);
             } else {
                 temp_buf = *(uint8_t *)buffer;
                 temp_word = ((temp_buf << 8) | (commandbuf & 0xff));
-                error = sdi_smbus_write_word(i2cdev_fd,
+                error = sdi_smbus_write_word(bus,
                            operation, I2C_SMBUS_I2C_BLOCK_BROKEN, (commandbuf >> 8) & 0xff,
                            &temp_word);
             }
         } else {
             if (address.addr_mode_16bit == 0) {
-                error = sdi_smbus_read_byte(i2cdev_fd,
+                error = sdi_smbus_read_byte(bus,
                            operation, I2C_SMBUS_I2C_BLOCK_BROKEN, commandbuf, buffer);
             } else {
                 temp_buf = (commandbuf & 0xff);
-                error = sdi_smbus_write_byte(i2cdev_fd,
+                error = sdi_smbus_write_byte(bus,
                            SDI_SMBUS_WRITE, I2C_SMBUS_I2C_BLOCK_BROKEN, (commandbuf >> 8) & 0xff,
                            &temp_buf);
                 if (error == STD_ERR_OK) {
-                    error = sdi_smbus_recv_byte(i2cdev_fd, operation,
+                    error = sdi_smbus_recv_byte(bus, operation,
                                 I2C_SMBUS_I2C_BLOCK_BROKEN, buffer);
                 } else {
                     SDI_DEVICE_ERRMSG_LOG("%s:%d i2c bus %d 16bit addr mode write byte data failed %d\n",
@@ -743,19 +1014,102 @@ static t_std_error sdi_i2cdev_smbus_execute(sdi_i2c_bus_hdl_t i2c_bus,
             break;
     }
 
+    sdi_i2cdev_settle(bus, address);
+
     if (error != STD_ERR_OK) {
         SDI_DEVICE_ERRMSG_LOG("i2c bus %d operation:%d datatype:%d failed %d\n",
                                i2c_bus->bus.bus_id, operation, data_type, error);
     }
 
-    /*Disabling the PEC after the operation is completed*/
-    if(flags == SDI_I2C_FLAG_PEC)
-    {
-        if (ioctl(i2cdev_fd, I2C_PEC, 0) != STD_ERR_OK) {
-            error = SDI_DEVICE_ERRNO;
-            SDI_DEVICE_ERRMSG_LOG("%s:%d i2c bus %d set PEC failed %d\n",
-                __FUNCTION__, __LINE__, i2c_bus->bus.bus_id, error);
+    return error;
+}
+
+/**
+ * sdi_i2cdev_batch_execute
+ * Execute a batch of register transactions as I2C_RDWR messages: an offset
+ * write and a read message for every read, an offset plus data write message
+ * for every write. The whole batch is a single ioctl unless the adapter
+ * rejects such transfers or a settle delay is needed between transactions,
+ * in which case every transaction is a separate ioctl.
+ * param[in] i2c_bus - I2C Bus handle
+ * param[in] address - I2C Slave Address
+ * param[in] ops - transactions to execute
+ * param[in] count - number of transactions
+ * param[in] flags - options if any, PEC is not supported
+ * return STD_ERR_OK on Success, SDI_DEVICE_ERRNO on Failure,
+ * SDI_DEVICE_ERRCODE(EOPNOTSUPP) when the batch can't be done with I2C_RDWR
+ */
+static t_std_error sdi_i2cdev_batch_execute(sdi_i2c_bus_hdl_t i2c_bus,
+    sdi_i2c_addr_t address, const sdi_i2c_batch_op_t *ops, uint_t count,
+    uint_t flags)
+{
+    sdi_sys_i2c_bus_t * bus = (sdi_sys_i2c_bus_t *) i2c_bus;
+    t_std_error error = STD_ERR_OK;
+    struct i2c_msg msgs[SDI_I2C_BATCH_MAX_OPS * 2];
+    uint8_t wbuf[SDI_I2C_BATCH_MAX_OPS][SDI_I2C_BATCH_MAX_WRITE_LEN + 2];
+    uint_t op_msg[SDI_I2C_BATCH_MAX_OPS + 1];
+    uint_t offset_len = (address.addr_mode_16bit) ? 2 : 1;
+    uint_t nmsgs = 0;
+    uint_t index = 0;
+    uint_t len = 0;
+
+    if (((bus->capability & I2C_FUNC_I2C) == 0)
+            || ((flags & SDI_I2C_FLAG_PEC) != 0)
+            || (count > SDI_I2C_BATCH_MAX_OPS)) {
+        return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
+    }
+
+    for (index = 0; index < count; index++) {
+        if ((ops[index].operation == SDI_I2C_WRITE)
+                && (ops[index].len > SDI_I2C_BATCH_MAX_WRITE_LEN)) {
+            return SDI_DEVICE_ERRCODE(EOPNOTSUPP);
+        }
+
+        len = 0;
+        if (address.addr_mode_16bit) {
+            wbuf[index][len++] = (ops[index].offset >> 8) & 0xff;
+        }
+        wbuf[index][len++] = ops[index].offset & 0xff;
+
+        op_msg[index] = nmsgs;
+        msgs[nmsgs].addr = address.i2c_addr;
+        msgs[nmsgs].flags = 0;
+        msgs[nmsgs].buf = wbuf[index];
+
+        if (ops[index].operation == SDI_I2C_WRITE) {
+            memcpy(&wbuf[index][len], ops[index].buffer, ops[index].len);
+            msgs[nmsgs++].len = len + ops[index].len;
+        } else {
+            msgs[nmsgs++].len = offset_len;
+            msgs[nmsgs].addr = address.i2c_addr;
+            msgs[nmsgs].flags = I2C_M_RD;
+            msgs[nmsgs].len = ops[index].len;
+            msgs[nmsgs++].buf = ops[index].buffer;
+        }
+    }
+    op_msg[count] = nmsgs;
+
+    if ((!bus->rdwr_split) && (address.settle_delay == 0)
+            && (bus->settle_delay == 0)) {
+        error = sdi_sys_i2c_rdwr_execute(bus, msgs, nmsgs);
+        if (error != SDI_DEVICE_ERRCODE(EOPNOTSUPP)) {
+            return error;
         }
+        /* Don't try multi transaction transfers on this adapter again */
+        bus->rdwr_split = true;
+    }
+
+    for (index = 0; index < count; index++) {
+        error = sdi_sys_i2c_rdwr_execute(bus, &msgs[op_msg[index]],
+                                         op_msg[index + 1] - op_msg[index]);
+        if (error != STD_ERR_OK) {
+            if ((index != 0) && (error == SDI_DEVICE_ERRCODE(EOPNOTSUPP))) {
+                /* part of the batch is executed, caller can't fall back */
+                error = SDI_DEVICE_ERRCODE(EIO);
+            }
+            break;
+        }
+        sdi_i2cdev_settle(bus, address);
     }
 
     return error;
@@ -788,6 +1142,26 @@ void sdi_sys_i2c_get_capability (sdi_i2c_bus_hdl_t i2c_bus,
     *capability = bus->capability;
 }
 
+/**
+ * sdi_sys_i2c_get_stats
+ * Get the transaction and timing counters of I2C BUS, without acquiring the
+ * bus
+ * param[in] i2c_bus i2c bus handle
+ * param[out] stats filled by this function with counters of this i2c bus
+ * return none
+ */
+static void sdi_sys_i2c_get_stats (sdi_i2c_bus_hdl_t i2c_bus,
+    sdi_i2c_bus_stats_t *stats)
+{
+    sdi_sys_i2c_bus_t *bus = (sdi_sys_i2c_bus_t *) i2c_bus;
+
+    stats->transactions = __atomic_load_n(&(bus->stats.transactions), __ATOMIC_RELAXED);
+    stats->retries = __atomic_load_n(&(bus->stats.retries), __ATOMIC_RELAXED);
+    stats->io_time_us = __atomic_load_n(&(bus->stats.io_time_us), __ATOMIC_RELAXED);
+    stats->sleep_time_us = __atomic_load_n(&(bus->stats.sleep_time_us), __ATOMIC_RELAXED);
+    stats->resets = __atomic_load_n(&(bus->stats.resets), __ATOMIC_RELAXED);
+}
+
 /**
  * sdi_i2cdev_bus_ops
  * SDI I2C Bus Operations for interfacing with kernel i2c driver
@@ -798,6 +1172,8 @@ static sdi_i2c_bus_ops_t sdi_i2cdev_bus_ops = {
     .sdi_i2c_execute = sdi_i2cdev_i2c_execute,
     .sdi_i2c_release_bus = sdi_i2cdev_release_bus,
     .sdi_i2c_get_capability = sdi_sys_i2c_get_capability,
+    .sdi_i2c_get_stats = sdi_sys_i2c_get_stats,
+    .sdi_i2c_batch_execute = sdi_i2cdev_batch_execute,
 };
 
 /**
@@ -844,6 +1220,9 @@ static t_std_error sdi_i2cdev_driver_init(sdi_bus_hdl_t bus)
         return error;
     }
 
+    sys_i2c_bus->slave_addr = SDI_I2CDEV_SLAVE_ADDR_NONE;
+    sys_i2c_bus->pec_enabled = false;
+
     error = ioctl(sys_i2c_bus->i2cdev_fd, I2C_FUNCS,
             &sys_i2c_bus->capability);
     if (error != STD_ERR_OK) {
@@ -935,7 +1314,19 @@ static t_std_error sdi_i2cdev_driver_register(std_config_node_t node,
         return error;
     }
 
+    sys_i2c_bus->retry_delay = SDI_IIC_RETRY_WAIT_TIME;
+    str = std_config_attr_get(node, SDI_DEV_ATTR_RETRY_DELAY);
+    if (str != NULL) {
+        sys_i2c_bus->retry_delay = (uint_t) strtoul(str, NULL, 0);
+    }
+
+    str = std_config_attr_get(node, SDI_DEV_ATTR_SETTLE_DELAY);
+    if (str != NULL) {
+        sys_i2c_bus->settle_delay = (uint_t) strtoul(str, NULL, 0);
+    }
+
     sys_i2c_bus->i2cdev_fd = INVALID_FILE_FD;
+    sys_i2c_bus->slave_addr = SDI_I2CDEV_SLAVE_ADDR_NONE;
 
     sdi_bus_register((sdi_bus_hdl_t) sys_i2c_bus);
 
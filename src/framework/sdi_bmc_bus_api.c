@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 
 #define ARRAY_SIZE(a)         (sizeof(a)/sizeof(a[0]))
@@ -53,6 +54,66 @@ static bmc_sdi_entity_map_t entity_map[] =
 };
 
 
+/**
+ * sdi_bmc_sensor_reading_write_begin marks the reading of a sensor as being
+ * written. Writers are the OpenIPMI handlers and the pollers, they rarely
+ * overlap, so the sequence lock is claimed by compare and swap.
+ */
+void sdi_bmc_sensor_reading_write_begin (sdi_bmc_sensor_t *sensor)
+{
+    uint32_t seq;
+
+    STD_ASSERT(sensor != NULL);
+    for (;;) {
+        seq = __atomic_load_n(&sensor->reading_lock, __ATOMIC_RELAXED);
+        if (((seq & 1) == 0)
+                && __atomic_compare_exchange_n(&sensor->reading_lock, &seq, seq + 1,
+                                               false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    /* Keep the stores of the reading after the lock */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/**
+ * sdi_bmc_sensor_reading_write_end stamps and publishes the reading of a
+ * sensor.
+ */
+void sdi_bmc_sensor_reading_write_end (sdi_bmc_sensor_t *sensor)
+{
+    struct timespec now;
+
+    STD_ASSERT(sensor != NULL);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sensor->res.reading.timestamp = ((uint64_t)now.tv_sec * 1000) + (now.tv_nsec / 1000000);
+    sensor->res.reading.sample_seq++;
+    __atomic_store_n(&sensor->reading_lock, sensor->reading_lock + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * sdi_bmc_sensor_reading_get copies the reading of a sensor, retrying while
+ * it is being written, so that the copy is never torn.
+ */
+void sdi_bmc_sensor_reading_get (sdi_bmc_sensor_t *sensor, sdi_bmc_reading_t *reading)
+{
+    uint32_t seq;
+
+    STD_ASSERT(sensor != NULL);
+    STD_ASSERT(reading != NULL);
+    for (;;) {
+        seq = __atomic_load_n(&sensor->reading_lock, __ATOMIC_ACQUIRE);
+        if ((seq & 1) != 0) {
+            continue;
+        }
+        memcpy(reading, &sensor->res.reading, sizeof(*reading));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&sensor->reading_lock, __ATOMIC_RELAXED) == seq) {
+            break;
+        }
+    }
+}
+
 /**
  * sdi_bmc_dc_sensor_reading_get_by_name is to get the discrete sensor
  * reading by using sensor name.
@@ -60,6 +121,7 @@ static bmc_sdi_entity_map_t entity_map[] =
 t_std_error sdi_bmc_dc_sensor_reading_get_by_name (char *sensor_id, uint32_t *data)
 {
     sdi_bmc_sensor_t *sensor = NULL;
+    sdi_bmc_reading_t reading;
 
     STD_ASSERT(sensor_id != NULL);
     STD_ASSERT(data != NULL);
@@ -70,7 +132,12 @@ t_std_error sdi_bmc_dc_sensor_reading_get_by_name (char *sensor_id, uint32_t *da
     if (sensor->reading_type != SDI_SDR_READING_DISCRETE) {
         return SDI_ERRCODE(ENOTSUP);
     }
-    *data = sensor->res.reading.discrete_state;
+    if (__atomic_load_n(&(sensor->cached), __ATOMIC_ACQUIRE)) {
+        /* Restored from the SDR cache and not discovered yet */
+        return SDI_ERRCODE(EAGAIN);
+    }
+    sdi_bmc_sensor_reading_get(sensor, &reading);
+    *data = reading.discrete_state;
     return STD_ERR_OK;
 }
 
@@ -82,6 +149,7 @@ t_std_error sdi_bmc_dc_sensor_reading_get_by_name (char *sensor_id, uint32_t *da
 t_std_error sdi_bmc_th_sensor_reading_get_by_name (char *sensor_id, double *data)
 {
     sdi_bmc_sensor_t *sensor = NULL;
+    sdi_bmc_reading_t reading;
 
     STD_ASSERT(sensor_id != NULL);
     STD_ASSERT(data != NULL);
@@ -92,7 +160,12 @@ t_std_error sdi_bmc_th_sensor_reading_get_by_name (char *sensor_id, double *data
     if (sensor->reading_type != SDI_SDR_READING_THRESHOLD) {
         return SDI_ERRCODE(ENOTSUP);
     }
-    *data = sensor->res.reading.data;
+    if (__atomic_load_n(&(sensor->cached), __ATOMIC_ACQUIRE)) {
+        /* Restored from the SDR cache and not discovered yet */
+        return SDI_ERRCODE(EAGAIN);
+    }
+    sdi_bmc_sensor_reading_get(sensor, &reading);
+    *data = reading.data;
     return STD_ERR_OK;
 }
 
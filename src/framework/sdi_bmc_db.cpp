@@ -21,75 +21,90 @@
 #include "sdi_bmc_db.h"
 #include "std_utils.h"
 
-#include <map>
-#include <string>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <string.h>
 #include <iostream>
 
-typedef std::map<std::string, void *> sdi_data_map_t;
-typedef std::pair<std::string, void *> sdi_data_pair_t;
-typedef std::pair<sdi_data_map_t::iterator,bool> sdi_data_return_t;
-
-
-static sdi_data_map_t entity_map;
-static sdi_data_map_t sensor_map;
+/**
+ * Sensor record of the sensor map. Sensors are keyed by entity id, entity
+ * instance and sensor id; sensors added by sensor id only are keyed by the
+ * entity id and instance their id ends with, if any.
+ */
+typedef struct sdi_bmc_sensor_rec_s {
+    bool              keyed; /** Key has entity id and instance */
+    uint32_t          id; /** Entity id of the key */
+    uint32_t          instance; /** Entity instance of the key */
+    sdi_bmc_sensor_t  *sensor; /** Sensor record, its address is stable */
+} sdi_bmc_sensor_rec_t;
+
+typedef std::unordered_map<uint64_t, sdi_bmc_entity_t *> sdi_entity_map_t;
+typedef std::unordered_multimap<uint64_t, sdi_bmc_sensor_rec_t> sdi_sensor_map_t;
+typedef std::vector<sdi_bmc_sensor_rec_t> sdi_sensor_name_list_t;
+typedef std::unordered_map<uint64_t, sdi_sensor_name_list_t> sdi_sensor_name_map_t;
+
+static sdi_entity_map_t entity_map;
+static sdi_sensor_map_t sensor_map;   /* Sensors by hash of their key */
+static sdi_sensor_name_map_t sensor_name_map; /* Sensors by hash of their id, in key order */
+static std::vector<sdi_bmc_sensor_t *> sensor_retired; /* Removed sensors, never freed */
 static std_mutex_lock_create_static_init_fast(_ipmi_entity_lock);
 static std_mutex_lock_create_static_init_fast(_ipmi_sensor_lock);
 
+#define SDI_BMC_DB_HASH_INIT   (14695981039346656037ULL)
+#define SDI_BMC_DB_HASH_PRIME  (1099511628211ULL)
+
 /**
- * Insert data record into a specified map
+ * FNV-1a hash of a buffer, chained from hash.
  */
-static bool sdi_data_insert (sdi_data_map_t &data_map, const char *key, void *data_obj)
+static inline uint64_t sdi_bmc_db_hash (uint64_t hash, const void *buf, size_t len)
 {
-    sdi_data_map_t::iterator it;
-
-    it = data_map.find(key);
-    if (it != data_map.end()) {
-        return false;
-    }
+    const uint8_t *byte = (const uint8_t *) buf;
 
-    sdi_data_return_t ret = data_map.insert(sdi_data_pair_t(key, data_obj));
-    if (ret.second == false) {
-        return false;
+    while (len-- > 0) {
+        hash = (hash ^ *byte++) * SDI_BMC_DB_HASH_PRIME;
     }
-
-    return true;
+    return hash;
 }
 
 /**
- * Remove record from a specified map.
+ * Length of a sensor id as stored in the sensor record.
  */
-static void *sdi_data_remove (sdi_data_map_t &data_map, const char *key)
+static inline size_t sdi_bmc_sensor_name_len (const char *name)
 {
-    sdi_data_map_t::iterator it;
-    void                    *data_obj;
+    return strnlen(name, IPMI_MAX_NAME_LEN - 1);
+}
 
-    it = data_map.find(key);
-    if (it == data_map.end()) {
-        return NULL;
-    }
-                    
-    data_obj = it->second;
-    data_map.erase(it);
-    return data_obj;
+/**
+ * Hash of a sensor id.
+ */
+static inline uint64_t sdi_bmc_sensor_name_hash (const char *name)
+{
+    return sdi_bmc_db_hash(SDI_BMC_DB_HASH_INIT, name, sdi_bmc_sensor_name_len(name));
 }
 
 /**
- * Fetch record from a specified map.
+ * Hash of a sensor key, keyed is false for sensors without entity id and
+ * instance.
  */
-static void *sdi_data_get (sdi_data_map_t &data_map, const char *key)
+static inline uint64_t sdi_bmc_sensor_key_hash (bool keyed, uint32_t id, uint32_t instance,
+                                                const char *name)
 {
-    sdi_data_map_t::iterator it = data_map.find(key);
+    uint64_t hash = SDI_BMC_DB_HASH_INIT;
 
-    return (it == data_map.end() ? 0 : it->second);
+    if (keyed) {
+        hash = sdi_bmc_db_hash(hash, &id, sizeof(id));
+        hash = sdi_bmc_db_hash(hash, &instance, sizeof(instance));
+    }
+    return sdi_bmc_db_hash(hash, name, sdi_bmc_sensor_name_len(name));
 }
 
 /**
  * Entity key generation function.
  */
-static inline const char *sdi_bmc_entity_key (char *key, uint32_t len, uint32_t id, uint32_t instance)
+static inline uint64_t sdi_bmc_entity_key (uint32_t id, uint32_t instance)
 {
-    snprintf(key, len, "entity.%u.%u", id, instance);
-    return ((const char *) key);
+    return ((((uint64_t) id) << 32) | instance);
 }
 
 /*
@@ -98,12 +113,15 @@ static inline const char *sdi_bmc_entity_key (char *key, uint32_t len, uint32_t
 
 sdi_bmc_entity_t *sdi_bmc_db_entity_add (uint32_t id, uint32_t instance)
 {
-    char key[SDI_DB_KEY_LEN] = "";
+    uint64_t key = sdi_bmc_entity_key(id, instance);
     sdi_bmc_entity_t  *ent = NULL;
+    sdi_entity_map_t::iterator it;
 
-    sdi_bmc_entity_key(key, sizeof(key), id, instance);
     std_mutex_lock(&_ipmi_entity_lock);
-    if ((ent = (sdi_bmc_entity_t *)sdi_data_get(entity_map, key)) == NULL) {
+    it = entity_map.find(key);
+    if (it != entity_map.end()) {
+        ent = it->second;
+    } else {
         ent = (sdi_bmc_entity_t *) calloc(1, sizeof(sdi_bmc_entity_t));
         if (ent == NULL) {
             std_mutex_unlock(&_ipmi_entity_lock);
@@ -112,11 +130,7 @@ sdi_bmc_entity_t *sdi_bmc_db_entity_add (uint32_t id, uint32_t instance)
         ent->entity_id = id;
         ent->entity_instance = instance;
         ent->present = false;
-        if (sdi_data_insert(entity_map, key, ent) == false) {
-            SDI_ERRMSG_LOG("Adding entity in DB failed(%u.%u)", id, instance);
-            free(ent);
-            ent = NULL;
-        }
+        entity_map.insert(sdi_entity_map_t::value_type(key, ent));
     }
     std_mutex_unlock(&_ipmi_entity_lock);
     return ent;
@@ -128,12 +142,14 @@ sdi_bmc_entity_t *sdi_bmc_db_entity_add (uint32_t id, uint32_t instance)
 
 sdi_bmc_entity_t *sdi_bmc_db_entity_get (uint32_t id, uint32_t instance)
 {
-    char key[SDI_DB_KEY_LEN] = "";
     sdi_bmc_entity_t  *ent = NULL;
+    sdi_entity_map_t::iterator it;
 
-    sdi_bmc_entity_key(key, sizeof(key), id, instance);
     std_mutex_lock(&_ipmi_entity_lock);
-    ent = (sdi_bmc_entity_t *) sdi_data_get(entity_map, key);
+    it = entity_map.find(sdi_bmc_entity_key(id, instance));
+    if (it != entity_map.end()) {
+        ent = it->second;
+    }
     std_mutex_unlock(&_ipmi_entity_lock);
     return ent;
 }
@@ -144,12 +160,15 @@ sdi_bmc_entity_t *sdi_bmc_db_entity_get (uint32_t id, uint32_t instance)
 
 bool sdi_bmc_db_entity_remove (uint32_t id, uint32_t instance)
 {
-    char key[SDI_DB_KEY_LEN] = "";
     sdi_bmc_entity_t  *ent = NULL;
+    sdi_entity_map_t::iterator it;
 
-    sdi_bmc_entity_key(key, sizeof(key), id, instance);
     std_mutex_lock(&_ipmi_entity_lock);
-    ent = (sdi_bmc_entity_t *) sdi_data_remove(entity_map, key);
+    it = entity_map.find(sdi_bmc_entity_key(id, instance));
+    if (it != entity_map.end()) {
+        ent = it->second;
+        entity_map.erase(it);
+    }
     std_mutex_unlock(&_ipmi_entity_lock);
     if (ent != NULL) {
         free(ent);
@@ -164,12 +183,12 @@ bool sdi_bmc_db_entity_remove (uint32_t id, uint32_t instance)
 
 void sdi_bmc_db_for_each_entity (sdi_bmc_register_entity_t callback_fn)
 {
-    sdi_data_map_t::iterator it;
+    sdi_entity_map_t::iterator it;
 
     if (callback_fn == NULL) return;
     std_mutex_lock(&_ipmi_entity_lock);
     for (it = entity_map.begin(); it != entity_map.end(); ++it) {
-        sdi_bmc_entity_t  *ent = (sdi_bmc_entity_t *) it->second;
+        sdi_bmc_entity_t  *ent = it->second;
         if (ent->present == true) {
             callback_fn(ent);
         }
@@ -184,10 +203,10 @@ void sdi_bmc_db_for_each_entity (sdi_bmc_register_entity_t callback_fn)
 
 void sdi_bmc_db_entity_cleanup(void)
 {
-    sdi_data_map_t::iterator it;
+    sdi_entity_map_t::iterator it;
     std_mutex_lock(&_ipmi_entity_lock);
     for (it = entity_map.begin(); it != entity_map.end(); ++it) {
-        sdi_bmc_entity_t  *ent = (sdi_bmc_entity_t *) it->second;
+        sdi_bmc_entity_t  *ent = it->second;
         if (ent != NULL) {
             free(ent);
             it->second = NULL;
@@ -204,35 +223,139 @@ void sdi_bmc_db_entity_cleanup(void)
 void sdi_bmc_db_entity_dump (void)
 {
     std::cout << "BMC Entity DB:\n";
-    sdi_data_map_t::iterator it;
+    sdi_entity_map_t::iterator it;
 
     for (it = entity_map.begin(); it != entity_map.end(); ++it) {
-        sdi_bmc_entity_t  *ent = (sdi_bmc_entity_t *) it->second;
-        std::cout << it->first << "==>" << ent->entity_id << "." << ent->entity_instance << " present :" << ent->present 
+        sdi_bmc_entity_t  *ent = it->second;
+        std::cout << "entity." << ent->entity_id << "." << ent->entity_instance << " present :" << ent->present
             << " Type :" << ent->type << " Sdi type :" << ent->sdi_type << '\n';
     }
 }
 
 /**
- * Sensor key create function.
+ * Find the sensor record of a key, sensor lock must be held. Returns the end
+ * of the sensor map if there is none.
  */
-static inline const char *sdi_bmc_sensor_key (char *key, uint32_t len, uint32_t id, uint32_t instance, char *name)
+static sdi_sensor_map_t::iterator sdi_bmc_sensor_rec_find (bool keyed, uint32_t id,
+                                                          uint32_t instance, const char *name)
 {
-    snprintf(key, len, "sensor.%u.%u.%s", id, instance,name);
-    return ((const char *) key);
+    size_t len = sdi_bmc_sensor_name_len(name);
+    std::pair<sdi_sensor_map_t::iterator, sdi_sensor_map_t::iterator> range =
+        sensor_map.equal_range(sdi_bmc_sensor_key_hash(keyed, id, instance, name));
+
+    for (sdi_sensor_map_t::iterator it = range.first; it != range.second; ++it) {
+        sdi_bmc_sensor_rec_t *rec = &it->second;
+        if ((rec->keyed == keyed) && (!keyed || ((rec->id == id) && (rec->instance == instance)))
+                && (strncmp(rec->sensor->name, name, len) == 0)
+                && (rec->sensor->name[len] == '\0')) {
+            return it;
+        }
+    }
+    return sensor_map.end();
 }
 
-static inline const char *sdi_bmc_sensor_key_by_name (char *key, uint32_t len, char *name)
+/**
+ * Compare the keys of two sensor records in the order of their
+ * "sensor.<id>.<instance>.<sensor id>" or "sensor.<sensor id>" spelling.
+ */
+static int sdi_bmc_sensor_rec_cmp (const sdi_bmc_sensor_rec_t *a, const sdi_bmc_sensor_rec_t *b)
 {
-    char  *sub_key = NULL;
-    sub_key = strchr(name, '.');
+    char key_a[SDI_DB_KEY_LEN] = "";
+    char key_b[SDI_DB_KEY_LEN] = "";
 
-    if (sub_key != NULL) {
-        snprintf(key, len, "sensor%s.%s", sub_key, name);
+    if (a->keyed) {
+        snprintf(key_a, sizeof(key_a), "%u.%u.%s", a->id, a->instance, a->sensor->name);
     } else {
-        snprintf(key, len, "sensor.%s", name);
+        safestrncpy(key_a, a->sensor->name, sizeof(key_a));
     }
-    return ((const char *) key);
+    if (b->keyed) {
+        snprintf(key_b, sizeof(key_b), "%u.%u.%s", b->id, b->instance, b->sensor->name);
+    } else {
+        safestrncpy(key_b, b->sensor->name, sizeof(key_b));
+    }
+    return strcmp(key_a, key_b);
+}
+
+/**
+ * Order of sensor records in the sensor id index.
+ */
+static bool sdi_bmc_sensor_rec_less (const sdi_bmc_sensor_rec_t &a, const sdi_bmc_sensor_rec_t &b)
+{
+    return (sdi_bmc_sensor_rec_cmp(&a, &b) < 0);
+}
+
+/**
+ * Allocate a sensor record and add it to the sensor maps, sensor lock must be
+ * held.
+ */
+static sdi_bmc_sensor_t *sdi_bmc_sensor_rec_add (bool keyed, uint32_t id, uint32_t instance,
+                                                 const char *name)
+{
+    sdi_bmc_sensor_rec_t rec;
+
+    rec.keyed = keyed;
+    rec.id = id;
+    rec.instance = instance;
+    rec.sensor = (sdi_bmc_sensor_t *) calloc(1, sizeof(sdi_bmc_sensor_t));
+    if (rec.sensor == NULL) {
+        return NULL;
+    }
+    safestrncpy(rec.sensor->name, name, IPMI_MAX_NAME_LEN);
+    sensor_map.insert(sdi_sensor_map_t::value_type(
+                sdi_bmc_sensor_key_hash(keyed, id, instance, name), rec));
+    /* Keep the sensors of an id in key order, so that lookup by id returns
+     * the first match without comparing keys */
+    sdi_sensor_name_list_t &list = sensor_name_map[sdi_bmc_sensor_name_hash(name)];
+    list.insert(std::upper_bound(list.begin(), list.end(), rec, sdi_bmc_sensor_rec_less), rec);
+    return rec.sensor;
+}
+
+/**
+ * Remove a sensor from the sensor id index, sensor lock must be held.
+ */
+static void sdi_bmc_sensor_name_unlink (sdi_bmc_sensor_t *sensor)
+{
+    sdi_sensor_name_map_t::iterator it;
+
+    it = sensor_name_map.find(sdi_bmc_sensor_name_hash(sensor->name));
+    if (it == sensor_name_map.end()) {
+        return;
+    }
+    for (sdi_sensor_name_list_t::iterator rec = it->second.begin(); rec != it->second.end(); ++rec) {
+        if (rec->sensor == sensor) {
+            it->second.erase(rec);
+            break;
+        }
+    }
+    if (it->second.empty()) {
+        sensor_name_map.erase(it);
+    }
+}
+
+/**
+ * Sensor id added by name which ends with ".<entity id>.<entity instance>"
+ * shares the key of the sensor with that entity id and instance.
+ */
+static bool sdi_bmc_sensor_name_key (const char *name, uint32_t *id, uint32_t *instance)
+{
+    const char *sub_key = strchr(name, '.');
+    char       key[SDI_DB_KEY_LEN] = "";
+    char       *end = NULL;
+
+    if (sub_key == NULL) {
+        return false;
+    }
+    *id = strtoul(sub_key + 1, &end, 10);
+    if (*end != '.') {
+        return false;
+    }
+    *instance = strtoul(end + 1, &end, 10);
+    if (*end != '\0') {
+        return false;
+    }
+    /* Only the canonical spelling of the numbers makes the same key */
+    snprintf(key, sizeof(key), ".%u.%u", *id, *instance);
+    return (strcmp(key, sub_key) == 0);
 }
 
 /**
@@ -241,25 +364,15 @@ static inline const char *sdi_bmc_sensor_key_by_name (char *key, uint32_t len, c
 
 sdi_bmc_sensor_t *sdi_bmc_db_sensor_add (uint32_t id, uint32_t instance, char *name)
 {
-    char key[SDI_DB_KEY_LEN] = "";
     sdi_bmc_sensor_t  *sensor = NULL;
+    sdi_sensor_map_t::iterator it;
 
-    sdi_bmc_sensor_key(key, sizeof(key), id, instance, name);
     std_mutex_lock(&_ipmi_sensor_lock);
-    if ((sensor = (sdi_bmc_sensor_t *) sdi_data_get(sensor_map, key)) == NULL) {
-        sensor = (sdi_bmc_sensor_t *) calloc(1, sizeof(sdi_bmc_sensor_t));
-        if (sensor == NULL) {
-            std_mutex_unlock(&_ipmi_sensor_lock);
-            return NULL;
-        }
+    if ((it = sdi_bmc_sensor_rec_find(true, id, instance, name)) != sensor_map.end()) {
+        sensor = it->second.sensor;
+    } else if ((sensor = sdi_bmc_sensor_rec_add(true, id, instance, name)) != NULL) {
         sensor->entity_id = id;
         sensor->entity_instance = instance;
-        safestrncpy(sensor->name, name, IPMI_MAX_NAME_LEN);
-        if (sdi_data_insert(sensor_map, key, sensor) == false) {
-            SDI_ERRMSG_LOG("Adding sensor in DB failed(%u.%u.%s)", id, instance, name);
-            free(sensor);
-            sensor = NULL;
-        }
     }
     std_mutex_unlock(&_ipmi_sensor_lock);
     return sensor;
@@ -267,24 +380,16 @@ sdi_bmc_sensor_t *sdi_bmc_db_sensor_add (uint32_t id, uint32_t instance, char *n
 
 sdi_bmc_sensor_t *sdi_bmc_db_sensor_add_by_name (char *name)
 {
-    char key[SDI_DB_KEY_LEN] = "";
     sdi_bmc_sensor_t  *sensor = NULL;
-
-    sdi_bmc_sensor_key_by_name(key, sizeof(key), name);
+    sdi_sensor_map_t::iterator it;
+    uint32_t id = 0, instance = 0;
+    bool keyed = sdi_bmc_sensor_name_key(name, &id, &instance);
 
     std_mutex_lock(&_ipmi_sensor_lock);
-    if ((sensor = (sdi_bmc_sensor_t *) sdi_data_get(sensor_map, key)) == NULL) {
-        sensor = (sdi_bmc_sensor_t *) calloc(1, sizeof(sdi_bmc_sensor_t));
-        if (sensor == NULL) {
-            std_mutex_unlock(&_ipmi_sensor_lock);
-            return NULL;
-        }
-        safestrncpy(sensor->name, name, IPMI_MAX_NAME_LEN);
-        if (sdi_data_insert(sensor_map, key, sensor) == false) {
-            SDI_ERRMSG_LOG("Adding sensor in DB failed(%s)", name);
-            free(sensor);
-            sensor = NULL;
-        }
+    if ((it = sdi_bmc_sensor_rec_find(keyed, id, instance, name)) != sensor_map.end()) {
+        sensor = it->second.sensor;
+    } else {
+        sensor = sdi_bmc_sensor_rec_add(keyed, id, instance, name);
     }
     std_mutex_unlock(&_ipmi_sensor_lock);
     return sensor;
@@ -295,12 +400,13 @@ sdi_bmc_sensor_t *sdi_bmc_db_sensor_add_by_name (char *name)
 
 sdi_bmc_sensor_t *sdi_bmc_db_sensor_get (uint32_t id, uint32_t instance, char *name)
 {
-    char key[SDI_DB_KEY_LEN] = "";
     sdi_bmc_sensor_t  *sensor = NULL;
+    sdi_sensor_map_t::iterator it;
 
-    sdi_bmc_sensor_key(key, sizeof(key), id, instance, name);
     std_mutex_lock(&_ipmi_sensor_lock);
-    sensor = (sdi_bmc_sensor_t *) sdi_data_get(sensor_map, key);
+    if ((it = sdi_bmc_sensor_rec_find(true, id, instance, name)) != sensor_map.end()) {
+        sensor = it->second.sensor;
+    }
     std_mutex_unlock(&_ipmi_sensor_lock);
     return sensor;
 }
@@ -311,15 +417,20 @@ sdi_bmc_sensor_t *sdi_bmc_db_sensor_get (uint32_t id, uint32_t instance, char *n
 
 sdi_bmc_sensor_t *sdi_bmc_db_sensor_get_by_name (char *name)
 {
-    sdi_data_map_t::iterator it;
     sdi_bmc_sensor_t *ret = NULL;
+    sdi_sensor_name_map_t::iterator it;
 
     std_mutex_lock(&_ipmi_sensor_lock);
-    for (it = sensor_map.begin(); it != sensor_map.end(); ++it) {
-        sdi_bmc_sensor_t *sensor = (sdi_bmc_sensor_t *) it->second;
-        if (strcmp(sensor->name, name) == 0) {
-            ret = sensor;
-            break;
+    it = sensor_name_map.find(sdi_bmc_sensor_name_hash(name));
+    if (it != sensor_name_map.end()) {
+        /* Same sensor id in several entities, the lowest key comes first as
+         * the lookup always returned */
+        for (sdi_sensor_name_list_t::iterator rec = it->second.begin();
+                rec != it->second.end(); ++rec) {
+            if (strcmp(rec->sensor->name, name) == 0) {
+                ret = rec->sensor;
+                break;
+            }
         }
     }
     std_mutex_unlock(&_ipmi_sensor_lock);
@@ -332,27 +443,46 @@ sdi_bmc_sensor_t *sdi_bmc_db_sensor_get_by_name (char *name)
 
 bool sdi_bmc_db_sensor_remove (uint32_t id, uint32_t instance, char *name)
 {
-    char key[SDI_DB_KEY_LEN] = "";
     sdi_bmc_sensor_t  *sensor = NULL;
-
-    sdi_bmc_sensor_key(key, sizeof(key), id, instance, name);
+    sdi_sensor_map_t::iterator it;
 
     std_mutex_lock(&_ipmi_sensor_lock);
-    sensor = (sdi_bmc_sensor_t *) sdi_data_remove(sensor_map, key);
+    it = sdi_bmc_sensor_rec_find(true, id, instance, name);
+    if (it != sensor_map.end()) {
+        sensor = it->second.sensor;
+        sensor_map.erase(it);
+        sdi_bmc_sensor_name_unlink(sensor);
+        /* OpenIPMI callbacks may still hold the record */
+        sensor_retired.push_back(sensor);
+    }
     std_mutex_unlock(&_ipmi_sensor_lock);
+    return true;
+}
 
-    if (sensor != NULL) {
-        if (sensor->ev_state != NULL) {
-            free(sensor->ev_state);
-            sensor->ev_state = NULL;
-        }
-        if (sensor->thresholds != NULL) {
-            free(sensor->thresholds);
-            sensor->thresholds = NULL;
+/**
+ * Remove the sensors restored from the SDR cache which were not discovered.
+ * Callers may still hold their records, so they are retired, not freed.
+ */
+
+uint32_t sdi_bmc_db_sensor_prune_cached (void)
+{
+    sdi_sensor_map_t::iterator it;
+    uint32_t count = 0;
+
+    std_mutex_lock(&_ipmi_sensor_lock);
+    for (it = sensor_map.begin(); it != sensor_map.end(); ) {
+        sdi_bmc_sensor_t *sensor = it->second.sensor;
+        if (!sensor->cached) {
+            ++it;
+            continue;
         }
-     free(sensor);
+        sdi_bmc_sensor_name_unlink(sensor);
+        it = sensor_map.erase(it);
+        sensor_retired.push_back(sensor);
+        count++;
     }
-    return true;
+    std_mutex_unlock(&_ipmi_sensor_lock);
+    return count;
 }
 
 /**
@@ -363,13 +493,13 @@ bool sdi_bmc_db_sensor_remove (uint32_t id, uint32_t instance, char *name)
 void sdi_bmc_db_for_each_sensor (uint32_t entity_id, uint32_t instance, 
                                  sdi_bmc_register_resource_t callback_fn, void *data)
 {
-    sdi_data_map_t::iterator it;
+    sdi_sensor_map_t::iterator it;
 
     if (callback_fn == NULL) return;
 
     std_mutex_lock(&_ipmi_sensor_lock);
     for (it = sensor_map.begin(); it != sensor_map.end(); ++it) {
-        sdi_bmc_sensor_t *sensor = (sdi_bmc_sensor_t *) it->second;
+        sdi_bmc_sensor_t *sensor = it->second.sensor;
         if ((sensor->entity_id == entity_id)
                 && (sensor->entity_instance == instance)) {
             callback_fn(sensor, data);
@@ -380,29 +510,23 @@ void sdi_bmc_db_for_each_sensor (uint32_t entity_id, uint32_t instance,
 }
 
 /**
- * Sensor map cleanup function.
+ * Sensor map cleanup function. OpenIPMI event handlers and pending requests
+ * hold sensor records as their cb_data, and resources hold them as their
+ * SDRs, so the records are retired rather than freed.
  */
 
 void sdi_bmc_db_sensor_cleanup(void)
 {
-    sdi_data_map_t::iterator it;
+    sdi_sensor_map_t::iterator it;
     std_mutex_lock(&_ipmi_sensor_lock);
     for (it = sensor_map.begin(); it != sensor_map.end(); ++it) {
-        sdi_bmc_sensor_t  *sensor = (sdi_bmc_sensor_t *) it->second;
-        if (sensor != NULL) {
-            if (sensor->ev_state != NULL) {
-                free(sensor->ev_state);
-                sensor->ev_state = NULL;
-            }
-            if (sensor->thresholds != NULL) {
-                free(sensor->thresholds);
-                sensor->thresholds = NULL;
-            }
-            free(sensor);
-            it->second = NULL;
+        if (it->second.sensor != NULL) {
+            sensor_retired.push_back(it->second.sensor);
+            it->second.sensor = NULL;
         }
     }
     sensor_map.clear();
+    sensor_name_map.clear();
     std_mutex_unlock(&_ipmi_sensor_lock);
 }
 
@@ -413,11 +537,11 @@ void sdi_bmc_db_sensor_cleanup(void)
 void sdi_bmc_db_sensor_dump (void)
 {
     std::cout << "BMC Sensor DB:\n";
-    sdi_data_map_t::iterator it;
+    sdi_sensor_map_t::iterator it;
 
     for (it = sensor_map.begin(); it != sensor_map.end(); ++it) {
-        sdi_bmc_sensor_t  *sensor = (sdi_bmc_sensor_t *) it->second;
-        std::cout << it->first << "==>" << it->second << sensor->entity_id << "." << sensor->entity_instance << "sensor name :" 
+        sdi_bmc_sensor_t  *sensor = it->second.sensor;
+        std::cout << it->first << "==>" << sensor << sensor->entity_id << "." << sensor->entity_instance << "sensor name :" 
             << sensor->name << " type :" <<  sensor->type;
 
         if ((sensor->reading_type == SDI_SDR_READING_THRESHOLD)
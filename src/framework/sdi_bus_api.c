@@ -21,7 +21,8 @@
 
 /******************************************************************************
  * Implements SDI BUS Read/Write APIs
- * Note: Only byte read/byte write for I2C/IO Bus are implemented.
+ * Note: Only byte read/byte write for I2C/IO Bus are implemented, plus block
+ * read which is a single transfer on I2C.
  * TODO: When the need arises, Add support for word/4byte and support for other
  * buses.
  *****************************************************************************/
@@ -146,3 +147,39 @@ t_std_error sdi_bus_write_byte(sdi_bus_hdl_t bus_hdl, sdi_device_addr_t addr,
     }
     return rc;
 }
+
+/*
+ * Read consecutive bytes starting at a specified offset of a device using bus
+ * api.
+ * param[in] bus_hdl - Bus handle on which device data to be read is attached.
+ * param[in] addr - Device address
+ * param[in] offset - Offset of the first byte within device
+ * param[out] buffer - Data read from device, must hold len bytes.
+ * param[in] len - Number of bytes to read
+ * return STD_ERR_OK on success, SDI_ERRCODE(ENOTSUP) if unsupported or
+ * STD failure code on error.
+ */
+t_std_error sdi_bus_read_block(sdi_bus_hdl_t bus_hdl, sdi_device_addr_t addr,
+                               uint_t offset, uint8_t *buffer, uint_t len)
+{
+    t_std_error rc = STD_ERR_OK;
+    uint_t index = 0;
+
+    if (bus_hdl->bus_type == SDI_I2C_BUS) {
+        rc = sdi_smbus_read_multi_byte((sdi_i2c_bus_hdl_t)bus_hdl,
+                                       addr.i2c_addr, offset, buffer, len,
+                                       SDI_I2C_FLAG_NONE);
+        if (rc != STD_ERR_OK) {
+            SDI_ERRMSG_LOG("%s:%d Read %u bytes of %s Addr 0x%x Offset 0x%x "
+                           "failed with error %d", __FUNCTION__, __LINE__, len,
+                           bus_hdl->bus_name, addr.i2c_addr.i2c_addr, offset, rc);
+        }
+        return rc;
+    }
+
+    /* Port mapped buses have no block access, reads are cheap anyway */
+    for (index = 0; (index < len) && (rc == STD_ERR_OK); index++) {
+        rc = sdi_bus_read_byte(bus_hdl, addr, offset + index, &buffer[index]);
+    }
+    return rc;
+}
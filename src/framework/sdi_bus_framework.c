@@ -51,6 +51,9 @@ void sdi_bus_init_list(sdi_bus_list_t *list)
 {
     std_dll_init(&list->head);
     std_mutex_lock_init_non_recursive(&list->lock);
+    memset(&list->name_index, 0, sizeof(list->name_index));
+    memset(&list->id_index, 0, sizeof(list->id_index));
+    pthread_rwlock_init(&list->index_lock, NULL);
 }
 
 /**
@@ -91,6 +94,12 @@ t_std_error sdi_bus_enqueue_list(sdi_bus_list_t *list, sdi_bus_hdl_t bus)
     }
     bus_node->bus = bus;
     std_dll_insertatback(&(list->head), &(bus_node->node));
+
+    pthread_rwlock_wrlock(&list->index_lock);
+    sdi_name_hash_add(&list->name_index, bus->bus_name, bus);
+    sdi_name_hash_add_id(&list->id_index, bus->bus_id, bus);
+    pthread_rwlock_unlock(&list->index_lock);
+
     ret = std_mutex_unlock(&list->lock);
     return ret;
 }
@@ -116,6 +125,12 @@ static t_std_error sdi_bus_dequeue_list(sdi_bus_node_t *bus_node)
         return ret;
     }
     std_dll_remove(&(list->head), &(bus_node->node));
+
+    pthread_rwlock_wrlock(&list->index_lock);
+    sdi_name_hash_remove(&list->name_index, bus_node->bus);
+    sdi_name_hash_remove(&list->id_index, bus_node->bus);
+    pthread_rwlock_unlock(&list->index_lock);
+
     free(bus_node);
     ret = std_mutex_unlock(&list->lock);
     return ret;
@@ -277,9 +292,7 @@ t_std_error sdi_bus_for_each(sdi_bus_type_t bus_type, void (*fn)(sdi_bus_hdl_t b
 /**
  * sdi_bus_get_handle
  * Get bus handle for a bus type with matching bus identifier/name
- * @todo:
- * Move this to common-utils by implementing an api like #g-list-find-custom
- * http://developer.gimp.org/api/2.0/glib/glib-Doubly-Linked-Lists.html
+ * Lookups only share the index lock, so they don't serialize with each other.
  *
  * Parameters:
  * bus_type[in]       - type of bus i2c/pin/pingroup
@@ -289,48 +302,27 @@ t_std_error sdi_bus_for_each(sdi_bus_type_t bus_type, void (*fn)(sdi_bus_hdl_t b
 static sdi_bus_t * sdi_bus_get_handle(sdi_bus_type_t bus_type,
     sdi_bus_search_type_t compare_type, void *bus_arg)
 {
-    t_std_error    ret = STD_ERR_OK;
     sdi_bus_list_t *list = NULL;
-    sdi_bus_node_t *dll_node = NULL;
-    bool hdl_found = false;
+    sdi_bus_t *bus = NULL;
 
     STD_ASSERT (bus_arg != NULL);
 
     list = sdi_bus_get_list_by_bus_type(bus_type);
     STD_ASSERT (list != NULL);
 
-    ret = std_mutex_lock(&list->lock);
-    if (ret != STD_ERR_OK) {
+    if (pthread_rwlock_rdlock(&list->index_lock) != 0) {
         return NULL;
     }
 
-    for((dll_node = (sdi_bus_node_t *)std_dll_getfirst(&list->head));
-        (dll_node != NULL);
-        (dll_node = (sdi_bus_node_t *)std_dll_getnext(&list->head, &dll_node->node)))
-    {
-        if ((dll_node->bus != NULL)) {
-            if (compare_type == SDI_COMPARE_BY_ID) {
-                if (((*(uint_t *)bus_arg) == dll_node->bus->bus_id)) {
-                    hdl_found = true;
-                    break;
-                }
-            }else if(compare_type == SDI_COMPARE_BY_NAME) {
-                if (!(strncmp((char *)bus_arg, dll_node->bus->bus_name, SDI_MAX_NAME_LEN))) {
-                    hdl_found = true;
-                    break;
-                }
-            }
-        }
+    if (compare_type == SDI_COMPARE_BY_ID) {
+        bus = (sdi_bus_t *) sdi_name_hash_find_id(&list->id_index, *(uint_t *)bus_arg);
+    } else if (compare_type == SDI_COMPARE_BY_NAME) {
+        bus = (sdi_bus_t *) sdi_name_hash_find(&list->name_index, (char *)bus_arg);
     }
 
-    if((std_mutex_unlock(&list->lock)) != STD_ERR_OK){
-        return NULL;
-    }
+    pthread_rwlock_unlock(&list->index_lock);
 
-    if(!hdl_found){
-        return NULL;
-    }
-    return dll_node->bus;
+    return bus;
 }
 
 /**
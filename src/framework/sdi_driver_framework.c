@@ -38,7 +38,11 @@
 #include "std_error_codes.h"
 #include "sdi_sys_common.h"
 #include "sdi_bus_framework.h"
+#include "sdi_common_attr.h"
+#include "sdi_name_hash.h"
 #include "std_assert.h"
+#include "std_mutex_lock.h"
+#include "std_utils.h"
 #include "dlfcn.h"
 #include <string.h>
 #include <stdlib.h>
@@ -58,6 +62,65 @@ typedef struct sdi_device_node {
 /* DLL handle for SDI Driver */
 static void *dl_hdl = NULL;
 
+/* Driver entry resolved from the SDI Driver library, memoized per driver name
+ * since every device instance of a driver resolves the same symbol */
+typedef struct sdi_driver_symbol {
+    char name[SDI_MAX_NAME_LEN]; /**< driver name, key of the cache */
+    const void *entry; /**< sdi_driver_t or sdi_bus_driver_t of the driver */
+} sdi_driver_symbol_t;
+
+/* Resolved device and bus drivers, bus and device drivers have separate
+ * name spaces */
+static sdi_name_hash_t device_driver_cache;
+static sdi_name_hash_t bus_driver_cache;
+static std_mutex_lock_create_static_init_fast(driver_cache_lock);
+
+/**
+ * Get the memoized entry of a driver
+ * Parameters:
+ * cache[in] - device or bus driver cache
+ * driver_name[in] - name of the driver
+ * return entry of the driver, NULL if it is not resolved yet
+ */
+static const void *sdi_driver_cache_find(sdi_name_hash_t *cache, const char *driver_name)
+{
+    sdi_driver_symbol_t *symbol = NULL;
+
+    std_mutex_lock(&driver_cache_lock);
+    symbol = (sdi_driver_symbol_t *)sdi_name_hash_find(cache, driver_name);
+    std_mutex_unlock(&driver_cache_lock);
+
+    return ((symbol != NULL) ? symbol->entry : NULL);
+}
+
+/**
+ * Memoize the entry of a driver
+ * Parameters:
+ * cache[in] - device or bus driver cache
+ * driver_name[in] - name of the driver
+ * entry[in] - resolved entry of the driver
+ */
+static void sdi_driver_cache_add(sdi_name_hash_t *cache, const char *driver_name,
+                                 const void *entry)
+{
+    sdi_driver_symbol_t *symbol = NULL;
+
+    symbol = (sdi_driver_symbol_t *)calloc(1, sizeof(*symbol));
+    STD_ASSERT(symbol != NULL);
+    safestrncpy(symbol->name, driver_name, sizeof(symbol->name));
+    symbol->entry = entry;
+
+    std_mutex_lock(&driver_cache_lock);
+    if (sdi_name_hash_find(cache, symbol->name) == NULL) {
+        sdi_name_hash_add(cache, symbol->name, symbol);
+        symbol = NULL;
+    }
+    std_mutex_unlock(&driver_cache_lock);
+
+    /* Resolved concurrently by an other thread */
+    free(symbol);
+}
+
 /**
  * Get Device Driver's Symbol Address by looking-up sdi device driver
  * library based on symbol name
@@ -73,6 +136,13 @@ static const sdi_driver_t *sdi_get_device_driver(const char *driver_name)
 
     STD_ASSERT(dl_hdl != NULL);
     STD_ASSERT(driver_name != NULL);
+
+    driver_entry_callbacks = (const sdi_driver_t *)
+        sdi_driver_cache_find(&device_driver_cache, driver_name);
+    if (driver_entry_callbacks != NULL) {
+        return driver_entry_callbacks;
+    }
+
     snprintf(entry_str, sizeof(entry_str), "sdi_%s_entry_callbacks", driver_name);
 
     query_api = ((sdi_device_entry_callback)dlsym(dl_hdl, entry_str));
@@ -89,6 +159,7 @@ static const sdi_driver_t *sdi_get_device_driver(const char *driver_name)
     }
 
     STD_ASSERT(driver_entry_callbacks != NULL);
+    sdi_driver_cache_add(&device_driver_cache, driver_name, driver_entry_callbacks);
     return driver_entry_callbacks;
 }
 
@@ -107,6 +178,13 @@ sdi_bus_driver_t *sdi_get_bus_driver(const char *bus_driver_name)
 
     STD_ASSERT(dl_hdl != NULL);
     STD_ASSERT(bus_driver_name != NULL);
+
+    bus_entry_callbacks = (sdi_bus_driver_t *)
+        sdi_driver_cache_find(&bus_driver_cache, bus_driver_name);
+    if (bus_entry_callbacks != NULL) {
+        return bus_entry_callbacks;
+    }
+
     snprintf(entry_str, sizeof(entry_str), SDI_BUS_ENTRY_CALLBACK, bus_driver_name);
 
     api_name = ((sdi_bus_entry_callback)dlsym(dl_hdl, entry_str));
@@ -114,6 +192,7 @@ sdi_bus_driver_t *sdi_get_bus_driver(const char *bus_driver_name)
         bus_entry_callbacks = api_name();
     }
     STD_ASSERT(bus_entry_callbacks != NULL);
+    sdi_driver_cache_add(&bus_driver_cache, bus_driver_name, bus_entry_callbacks);
 
     return bus_entry_callbacks;
 }
@@ -145,12 +224,15 @@ static void sdi_add_device(sdi_device_hdl_t hdl)
  * *dev_hdl[out]  - Handle to registered device is filled in *dev_hdl if
  * dev_hdl is not NULL. Buses not interested in tracking device handle can pass
  * NULL.
+ * Settle delay of a device on i2c bus is common to all drivers, hence it is
+ * parsed here and stored in device's i2c address.
  * returns - Error if node or bus is not valid
  */
 t_std_error sdi_register_driver(std_config_node_t node, sdi_bus_hdl_t bus_hdl, sdi_device_hdl_t *device_hdl)
 {
     t_std_error error = STD_ERR_OK;
     const char *driver_name = NULL;
+    const char *node_attr = NULL;
     const sdi_driver_t *driver = NULL;
     sdi_device_hdl_t dev_hdl = NULL;
 
@@ -165,6 +247,11 @@ t_std_error sdi_register_driver(std_config_node_t node, sdi_bus_hdl_t bus_hdl, s
 
     error = driver->register_fn(node, bus_hdl, &dev_hdl);
     if (error == STD_ERR_OK) {
+        node_attr = std_config_attr_get(node, SDI_DEV_ATTR_SETTLE_DELAY);
+        if ((node_attr != NULL) && (bus_hdl->bus_type == SDI_I2C_BUS)) {
+            dev_hdl->addr.i2c_addr.settle_delay =
+                (uint16_t) strtoul(node_attr, NULL, 0);
+        }
         sdi_add_device(dev_hdl);
         if (device_hdl != NULL) {
             *device_hdl = dev_hdl;
@@ -24,6 +24,7 @@
  *****************************************************************************/
 
 #include <linux/i2c.h>
+#include <errno.h>
 #include "std_assert.h"
 #include "sdi_i2c_bus_api.h"
 
@@ -241,9 +242,37 @@ t_std_error sdi_i2c_write(sdi_i2c_bus_hdl_t bus_handle,
     return rc;
 }
 
+/**
+ * sdi_i2c_block_read_supported
+ * Check whether a multi byte read can be issued to the slave as one block
+ * transfer (I2C combined transaction or SMBUS I2C block read) instead of one
+ * SMBUS transaction per byte. PEC is only supported on SMBUS transactions.
+ */
+static bool sdi_i2c_block_read_supported(sdi_i2c_bus_hdl_t bus_handle,
+                                         sdi_i2c_addr_t i2c_addr, uint_t flags)
+{
+    sdi_i2c_bus_capability_t capability = 0;
+
+    if ((bus_handle->ops->sdi_i2c_execute == NULL)
+            || ((flags & SDI_I2C_FLAG_PEC) != 0)) {
+        return false;
+    }
+
+    sdi_i2c_bus_get_capability(bus_handle, &capability);
+
+    if ((capability & SDI_I2C_FUNC_I2C) != 0) {
+        return true;
+    }
+
+    return (((capability & SDI_I2C_FUNC_SMBUS_READ_I2C_BLOCK) != 0)
+            && (i2c_addr.addr_mode_16bit == false));
+}
+
 /**
  * sdi_smbus_read_multi_byte
- * Execute SMBUS Read multiple bytes From Slave one after another.
+ * Execute SMBUS Read multiple bytes From Slave.
+ * When the bus supports block transfers, all bytes are read with a single
+ * block transfer, else bytes are read one after another.
  * Format:
  * start (1) : slave address (7) : wr (1) : ACK (1) : cmd (8) : ACK(1) :
  * start (1) : slave address (7) : rd (1) : ACK (1) : DATABYTE (8) : ack(1) :
@@ -254,6 +283,8 @@ t_std_error sdi_smbus_read_multi_byte(sdi_i2c_bus_hdl_t bus_handle,
                                 uint8_t *buffer, uint_t byte_count, uint_t flags)
 {
     uint_t count = 0;
+    uint8_t offset[2] = {0};
+    uint_t offset_len = 0;
     t_std_error error = STD_ERR_OK;
 
     STD_ASSERT(bus_handle != NULL);
@@ -267,6 +298,22 @@ t_std_error sdi_smbus_read_multi_byte(sdi_i2c_bus_hdl_t bus_handle,
         return error;
     }
 
+    if ((byte_count > 1)
+            && (sdi_i2c_block_read_supported(bus_handle, i2c_addr, flags))) {
+        if (i2c_addr.addr_mode_16bit) {
+            offset[offset_len++] = (cmd >> 8) & 0xff;
+        }
+        offset[offset_len++] = cmd & 0xff;
+
+        error = sdi_i2c_bus_execute(bus_handle, i2c_addr, SDI_I2C_READ,
+                                    offset, offset_len, buffer, byte_count, flags);
+        if (error != SDI_ERRCODE(EOPNOTSUPP)) {
+            sdi_i2c_release_bus(bus_handle);
+            return error;
+        }
+        /* Block transfer is not possible, fall back to byte reads */
+    }
+
     for(count = 0; (count < byte_count); count++)
     {
         error = sdi_smbus_execute(bus_handle, i2c_addr,
@@ -427,3 +474,122 @@ t_std_error sdi_smbus_write_i2c_block_data(sdi_i2c_bus_hdl_t bus_handle,
 
     return error;
 }
+
+/**
+ * sdi_i2c_batch_op_execute
+ * Execute one transaction of a batch with SMBUS byte transactions. Bus should
+ * be acquired by the caller.
+ */
+static t_std_error sdi_i2c_batch_op_execute(sdi_i2c_bus_hdl_t bus_handle,
+                                            sdi_i2c_addr_t i2c_addr,
+                                            const sdi_i2c_batch_op_t *op,
+                                            uint_t flags)
+{
+    uint_t count = 0;
+    t_std_error error = STD_ERR_OK;
+    sdi_smbus_operation_t operation =
+        (op->operation == SDI_I2C_READ) ? SDI_SMBUS_READ : SDI_SMBUS_WRITE;
+
+    for (count = 0; count < op->len; count++) {
+        error = sdi_smbus_execute(bus_handle, i2c_addr, operation,
+                                  SDI_SMBUS_BYTE_DATA, (op->offset + count),
+                                  (op->buffer + count), SDI_SMBUS_SIZE_NON_BLOCK,
+                                  flags);
+        if (error != STD_ERR_OK) {
+            break;
+        }
+    }
+    return error;
+}
+
+/**
+ * sdi_i2c_batch_execute
+ * Execute a batch of register reads and writes on a slave under a single
+ * bus acquisition.
+ */
+t_std_error sdi_i2c_batch_execute(sdi_i2c_bus_hdl_t bus_handle,
+                                  sdi_i2c_addr_t i2c_addr,
+                                  const sdi_i2c_batch_op_t *ops, uint_t count,
+                                  uint_t flags)
+{
+    uint_t index = 0;
+    t_std_error error = STD_ERR_OK;
+
+    STD_ASSERT(bus_handle != NULL);
+
+    STD_ASSERT(bus_handle->bus.bus_type == SDI_I2C_BUS);
+
+    STD_ASSERT(ops != NULL);
+
+    if ((count == 0) || (count > SDI_I2C_BATCH_MAX_OPS)) {
+        return SDI_ERRCODE(EINVAL);
+    }
+
+    error = sdi_i2c_acquire_bus(bus_handle);
+    if (error != STD_ERR_OK) {
+        return error;
+    }
+
+    if (bus_handle->ops->sdi_i2c_batch_execute != NULL) {
+        error = bus_handle->ops->sdi_i2c_batch_execute(bus_handle, i2c_addr,
+                                                       ops, count, flags);
+        if (error != SDI_ERRCODE(EOPNOTSUPP)) {
+            sdi_i2c_release_bus(bus_handle);
+            return error;
+        }
+        /* Batch can't be done in one go, execute transactions one by one */
+    }
+
+    for (index = 0; index < count; index++) {
+        error = sdi_i2c_batch_op_execute(bus_handle, i2c_addr, &ops[index], flags);
+        if (error != STD_ERR_OK) {
+            break;
+        }
+    }
+
+    sdi_i2c_release_bus(bus_handle);
+
+    return error;
+}
+
+/**
+ * sdi_i2c_bus_root_get
+ * Get the i2c bus driven by the i2c adapter carrying transactions of this bus.
+ */
+sdi_i2c_bus_hdl_t sdi_i2c_bus_root_get(sdi_i2c_bus_hdl_t bus_handle)
+{
+    sdi_i2c_bus_hdl_t parent = NULL;
+
+    STD_ASSERT(bus_handle != NULL);
+
+    STD_ASSERT(bus_handle->bus.bus_type == SDI_I2C_BUS);
+
+    while ((bus_handle->ops->sdi_i2c_get_parent != NULL)
+            && ((parent = bus_handle->ops->sdi_i2c_get_parent(bus_handle)) != NULL)) {
+        bus_handle = parent;
+    }
+
+    return bus_handle;
+}
+
+/**
+ * sdi_i2c_bus_stats_get
+ * Get the transaction and timing counters of the bus.
+ */
+t_std_error sdi_i2c_bus_stats_get(sdi_i2c_bus_hdl_t bus_handle,
+                                  sdi_i2c_bus_stats_t *stats)
+{
+    STD_ASSERT(bus_handle != NULL);
+
+    STD_ASSERT(bus_handle->bus.bus_type == SDI_I2C_BUS);
+
+    STD_ASSERT(stats != NULL);
+
+    if (bus_handle->ops->sdi_i2c_get_stats == NULL) {
+        return SDI_ERRCODE(ENOTSUP);
+    }
+
+    bus_handle->ops->sdi_i2c_get_stats(bus_handle, stats);
+
+    return STD_ERR_OK;
+}
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2019 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_name_hash.c
+ */
+
+
+/******************************************************************************
+ * Name or identifier indexed hash table used by the SDI frameworks.
+ *****************************************************************************/
+
+#include "sdi_name_hash.h"
+#include "sdi_sys_common.h"
+#include "std_assert.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Number of buckets of a table on first addition, doubled whenever the table
+ * holds more objects than buckets
+ */
+#define SDI_NAME_HASH_INIT_BUCKETS    64
+
+/**
+ * FNV-1a hash of a name
+ * name[in] - null terminated name
+ * return hash value
+ */
+static uint_t sdi_name_hash_value(const char *name)
+{
+    uint32_t value = 2166136261U;
+    uint_t index = 0;
+
+    for (index = 0; (index < SDI_MAX_NAME_LEN) && (name[index] != '\0'); index++) {
+        value ^= (uint8_t) name[index];
+        value *= 16777619U;
+    }
+    return value;
+}
+
+/**
+ * Hash of an identifier, Fibonacci hashing
+ * id[in] - identifier
+ * return hash value
+ */
+static inline uint_t sdi_name_hash_id_value(uint_t id)
+{
+    return (uint32_t) (id * 2654435761U) >> 8;
+}
+
+/**
+ * Hash of the key of an entry
+ * entry[in] - entry
+ * return hash value
+ */
+static inline uint_t sdi_name_hash_entry_value(const sdi_name_hash_entry_t *entry)
+{
+    return (entry->name != NULL) ? sdi_name_hash_value(entry->name)
+                                 : sdi_name_hash_id_value(entry->id);
+}
+
+/**
+ * Append an entry at the end of its bucket, keeping the order of addition
+ * buckets[in] - bucket array
+ * bucket_count[in] - number of buckets, a power of 2
+ * entry[in] - entry to append
+ */
+static void sdi_name_hash_link(sdi_name_hash_entry_t **buckets, uint_t bucket_count,
+                               sdi_name_hash_entry_t *entry)
+{
+    sdi_name_hash_entry_t **link =
+        &buckets[sdi_name_hash_entry_value(entry) & (bucket_count - 1)];
+
+    while (*link != NULL) {
+        link = &((*link)->next);
+    }
+    entry->next = NULL;
+    *link = entry;
+}
+
+/**
+ * Double the number of buckets of a table
+ * hash[in] - name hash
+ */
+static void sdi_name_hash_grow(sdi_name_hash_t *hash)
+{
+    uint_t bucket_count = (hash->bucket_count == 0) ? SDI_NAME_HASH_INIT_BUCKETS
+                                                    : (hash->bucket_count * 2);
+    sdi_name_hash_entry_t **buckets = NULL;
+    sdi_name_hash_entry_t *entry = NULL;
+    sdi_name_hash_entry_t *next = NULL;
+    uint_t index = 0;
+
+    buckets = (sdi_name_hash_entry_t **) calloc(bucket_count, sizeof(*buckets));
+    STD_ASSERT(buckets != NULL);
+
+    /* Entries of a name stay in one bucket and in their relative order */
+    for (index = 0; index < hash->bucket_count; index++) {
+        for (entry = hash->buckets[index]; entry != NULL; entry = next) {
+            next = entry->next;
+            sdi_name_hash_link(buckets, bucket_count, entry);
+        }
+    }
+
+    free(hash->buckets);
+    hash->buckets = buckets;
+    hash->bucket_count = bucket_count;
+}
+
+/**
+ * Add an entry to a hash
+ * hash[in] - name or identifier hash
+ * name[in] - name of the object, NULL when keyed by identifier
+ * id[in] - identifier of the object
+ * value[in] - the object
+ */
+static void sdi_name_hash_insert(sdi_name_hash_t *hash, const char *name, uint_t id,
+                                 void *value)
+{
+    sdi_name_hash_entry_t *entry = NULL;
+
+    STD_ASSERT(hash != NULL);
+
+    if (hash->count >= hash->bucket_count) {
+        sdi_name_hash_grow(hash);
+    }
+
+    entry = (sdi_name_hash_entry_t *) calloc(1, sizeof(*entry));
+    STD_ASSERT(entry != NULL);
+
+    entry->name = name;
+    entry->id = id;
+    entry->value = value;
+    sdi_name_hash_link(hash->buckets, hash->bucket_count, entry);
+    hash->count++;
+}
+
+/**
+ * Add an object to a name hash
+ * hash[in] - name hash
+ * name[in] - name of the object, referenced by the hash
+ * value[in] - the object
+ */
+void sdi_name_hash_add(sdi_name_hash_t *hash, const char *name, void *value)
+{
+    STD_ASSERT(name != NULL);
+
+    sdi_name_hash_insert(hash, name, 0, value);
+}
+
+/**
+ * Add an object to a hash keyed by identifier
+ * hash[in] - identifier hash
+ * id[in] - identifier of the object
+ * value[in] - the object
+ */
+void sdi_name_hash_add_id(sdi_name_hash_t *hash, uint_t id, void *value)
+{
+    sdi_name_hash_insert(hash, NULL, id, value);
+}
+
+/**
+ * Remove an object from a hash
+ * hash[in] - name or identifier hash
+ * value[in] - the object
+ */
+void sdi_name_hash_remove(sdi_name_hash_t *hash, void *value)
+{
+    sdi_name_hash_entry_t **link = NULL;
+    sdi_name_hash_entry_t *entry = NULL;
+    uint_t index = 0;
+
+    STD_ASSERT(hash != NULL);
+
+    for (index = 0; index < hash->bucket_count; index++) {
+        link = &hash->buckets[index];
+        while (*link != NULL) {
+            entry = *link;
+            if (entry->value == value) {
+                *link = entry->next;
+                free(entry);
+                hash->count--;
+            } else {
+                link = &entry->next;
+            }
+        }
+    }
+}
+
+/**
+ * Find an entry of a name from a given entry on
+ * entry[in] - first entry to consider
+ * name[in] - name to look up
+ * return entry, NULL if not found
+ */
+static sdi_name_hash_entry_t *sdi_name_hash_match(const sdi_name_hash_entry_t *entry,
+                                                  const char *name)
+{
+    for (; entry != NULL; entry = entry->next) {
+        if ((entry->name != NULL) && (strncmp(entry->name, name, SDI_MAX_NAME_LEN) == 0)) {
+            return (sdi_name_hash_entry_t *) entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Get the first entry added with a name
+ * hash[in] - name hash
+ * name[in] - name to look up
+ * return entry, NULL if no object has that name
+ */
+sdi_name_hash_entry_t *sdi_name_hash_first(const sdi_name_hash_t *hash, const char *name)
+{
+    STD_ASSERT(hash != NULL);
+    STD_ASSERT(name != NULL);
+
+    if (hash->bucket_count == 0) {
+        return NULL;
+    }
+    return sdi_name_hash_match(hash->buckets[sdi_name_hash_value(name)
+                                             & (hash->bucket_count - 1)], name);
+}
+
+/**
+ * Get the entry added with the same name after a given entry
+ * entry[in] - entry of the name
+ * return entry, NULL if no other object has that name
+ */
+sdi_name_hash_entry_t *sdi_name_hash_next(const sdi_name_hash_entry_t *entry)
+{
+    STD_ASSERT(entry != NULL);
+
+    return sdi_name_hash_match(entry->next, entry->name);
+}
+
+/**
+ * Get the first object added with a name
+ * hash[in] - name hash
+ * name[in] - name to look up
+ * return the object, NULL if no object has that name
+ */
+void *sdi_name_hash_find(const sdi_name_hash_t *hash, const char *name)
+{
+    sdi_name_hash_entry_t *entry = sdi_name_hash_first(hash, name);
+
+    return (entry == NULL) ? NULL : entry->value;
+}
+
+/**
+ * Get the first object added with an identifier
+ * hash[in] - identifier hash
+ * id[in] - identifier to look up
+ * return the object, NULL if no object has that identifier
+ */
+void *sdi_name_hash_find_id(const sdi_name_hash_t *hash, uint_t id)
+{
+    const sdi_name_hash_entry_t *entry = NULL;
+
+    STD_ASSERT(hash != NULL);
+
+    if (hash->bucket_count == 0) {
+        return NULL;
+    }
+    for (entry = hash->buckets[sdi_name_hash_id_value(id) & (hash->bucket_count - 1)];
+         entry != NULL; entry = entry->next) {
+        if ((entry->name == NULL) && (entry->id == id)) {
+            return entry->value;
+        }
+    }
+    return NULL;
+}
@@ -26,8 +26,11 @@
 
 
 #include "sdi_pin_bus_api.h"
+#include "sdi_sys_common.h"
 #include "std_assert.h"
 
+#include <errno.h>
+
 /**
  * sdi_validate_pin_bus_handle
  * Validate pin bus handle.
@@ -204,3 +207,64 @@ t_std_error sdi_pin_get_polarity(sdi_pin_bus_hdl_t bus,
     return error;
 
 }
+
+/**
+ * sdi_pin_event_fd_get
+ * Get a file descriptor which becomes readable when the pin level changes
+ * param[in] bus - sdi pin bus object
+ * param[out] fd - pollable event file descriptor of the pin
+ * return STD_ERR_OK on SUCCESS, SDI_ERRCODE(ENOTSUP) when not supported by
+ * the pin, SDI_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_event_fd_get(sdi_pin_bus_hdl_t bus, int *fd)
+{
+    t_std_error error = STD_ERR_OK;
+
+    sdi_validate_pin_bus_handle(bus);
+
+    STD_ASSERT(fd != NULL);
+
+    if (bus->ops->sdi_pin_bus_event_fd_get == NULL) {
+        return SDI_ERRCODE(ENOTSUP);
+    }
+
+    error = std_mutex_lock (&(bus->lock));
+    if (error != STD_ERR_OK) {
+        return error;
+    }
+
+    error = bus->ops->sdi_pin_bus_event_fd_get(bus, fd);
+
+    std_mutex_unlock (&(bus->lock));
+
+    return error;
+}
+
+/**
+ * sdi_pin_event_clear
+ * Consume pending level change events of the pin
+ * param[in] bus - sdi pin bus object
+ * return STD_ERR_OK on SUCCESS, SDI_ERRCODE(ENOTSUP) when not supported by
+ * the pin, SDI_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_event_clear(sdi_pin_bus_hdl_t bus)
+{
+    t_std_error error = STD_ERR_OK;
+
+    sdi_validate_pin_bus_handle(bus);
+
+    if (bus->ops->sdi_pin_bus_event_clear == NULL) {
+        return SDI_ERRCODE(ENOTSUP);
+    }
+
+    error = std_mutex_lock (&(bus->lock));
+    if (error != STD_ERR_OK) {
+        return error;
+    }
+
+    error = bus->ops->sdi_pin_bus_event_clear(bus);
+
+    std_mutex_unlock (&(bus->lock));
+
+    return error;
+}
@@ -26,8 +26,11 @@
 
 
 #include "sdi_pin_group_bus_api.h"
+#include "sdi_sys_common.h"
 #include "std_assert.h"
 
+#include <errno.h>
+
 /**
  * sdi_validate_pin_group_bus_handle
  * Validate pin group bus handle.
@@ -97,9 +100,46 @@ t_std_error sdi_pin_group_write_level(sdi_pin_group_bus_hdl_t bus,
 
     error = bus->ops->sdi_pin_group_bus_write_level(bus, value);
 
+    /* Pins may be partially written on failure */
+    bus->written_level = value;
+    bus->written_level_valid = (error == STD_ERR_OK);
+
     return error;
 }
 
+/**
+ * sdi_pin_group_write_level_cached
+ * Write value of the Pin Group, unless it is the level last written
+ * param[in] bus - sdi pin group bus object
+ * param[in] value - uint_t value of pin to be written to
+ * return STD_ERR_OK on SUCCESS, SDI_DEVICE_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_group_write_level_cached(sdi_pin_group_bus_hdl_t bus,
+                                             uint_t value)
+{
+    sdi_validate_pin_group_bus_handle(bus);
+
+    if ((bus->written_level_valid) && (bus->written_level == value)
+            && ((bus->ops->sdi_pin_group_bus_level_owned == NULL)
+                || (bus->ops->sdi_pin_group_bus_level_owned(bus)))) {
+        return STD_ERR_OK;
+    }
+
+    return sdi_pin_group_write_level(bus, value);
+}
+
+/**
+ * sdi_pin_group_level_invalidate
+ * Forget the level last written to the Pin Group
+ * param[in] bus - sdi pin group bus object
+ */
+void sdi_pin_group_level_invalidate(sdi_pin_group_bus_hdl_t bus)
+{
+    sdi_validate_pin_group_bus_handle(bus);
+
+    bus->written_level_valid = false;
+}
+
 /**
  * sdi_pin_group_set_direction
  * Configure the direction of pin group
@@ -116,6 +156,9 @@ t_std_error sdi_pin_group_set_direction(sdi_pin_group_bus_hdl_t bus,
 
     error = bus->ops->sdi_pin_group_bus_set_direction(bus, direction);
 
+    /* Driven level depends on direction and polarity */
+    bus->written_level_valid = false;
+
     return error;
 
 }
@@ -158,6 +201,9 @@ t_std_error sdi_pin_group_set_polarity(sdi_pin_group_bus_hdl_t bus,
 
     error = bus->ops->sdi_pin_group_bus_set_polarity(bus, polarity);
 
+    /* Driven level depends on direction and polarity */
+    bus->written_level_valid = false;
+
     return error;
 
 }
@@ -183,3 +229,78 @@ t_std_error sdi_pin_group_get_polarity(sdi_pin_group_bus_hdl_t bus,
     return error;
 
 }
+
+/**
+ * sdi_pin_group_event_fd_get
+ * Get a file descriptor which becomes readable when the level of any pin of
+ * the pin group changes
+ * param[in] bus - sdi pin group bus object
+ * param[out] fd - pollable event file descriptor of the pin group
+ * return STD_ERR_OK on SUCCESS, SDI_ERRCODE(ENOTSUP) when not supported by
+ * the pin group, SDI_DEVICE_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_group_event_fd_get(sdi_pin_group_bus_hdl_t bus, int *fd)
+{
+    sdi_validate_pin_group_bus_handle(bus);
+
+    STD_ASSERT(fd != NULL);
+
+    if (bus->ops->sdi_pin_group_bus_event_fd_get == NULL) {
+        return SDI_ERRCODE(ENOTSUP);
+    }
+
+    return bus->ops->sdi_pin_group_bus_event_fd_get(bus, fd);
+}
+
+/**
+ * sdi_pin_group_event_clear
+ * Consume pending level change events of the pin group
+ * param[in] bus - sdi pin group bus object
+ * return STD_ERR_OK on SUCCESS, SDI_ERRCODE(ENOTSUP) when not supported by
+ * the pin group, SDI_DEVICE_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_group_event_clear(sdi_pin_group_bus_hdl_t bus)
+{
+    sdi_validate_pin_group_bus_handle(bus);
+
+    if (bus->ops->sdi_pin_group_bus_event_clear == NULL) {
+        return SDI_ERRCODE(ENOTSUP);
+    }
+
+    return bus->ops->sdi_pin_group_bus_event_clear(bus);
+}
+
+/**
+ * sdi_pin_group_refresh
+ * Re-read the device backing the pin group in one access
+ * param[in] bus - sdi pin group bus object
+ * return STD_ERR_OK on SUCCESS, SDI_ERRCODE(ENOTSUP) when not supported by
+ * the pin group, SDI_DEVICE_ERRNO on FAILURE
+ */
+t_std_error sdi_pin_group_refresh(sdi_pin_group_bus_hdl_t bus)
+{
+    sdi_validate_pin_group_bus_handle(bus);
+
+    if (bus->ops->sdi_pin_group_bus_refresh == NULL) {
+        return SDI_ERRCODE(ENOTSUP);
+    }
+
+    return bus->ops->sdi_pin_group_bus_refresh(bus);
+}
+
+/**
+ * sdi_pin_group_refresh_device
+ * Identify the device re-read by sdi_pin_group_refresh
+ * param[in] bus - sdi pin group bus object
+ * return device backing the pin group, NULL when it can not be refreshed
+ */
+const void *sdi_pin_group_refresh_device(sdi_pin_group_bus_hdl_t bus)
+{
+    sdi_validate_pin_group_bus_handle(bus);
+
+    if (bus->ops->sdi_pin_group_bus_refresh_device == NULL) {
+        return NULL;
+    }
+
+    return bus->ops->sdi_pin_group_bus_refresh_device(bus);
+}
@@ -29,15 +29,42 @@
 #include "sdi_nvram_internal.h"
 #include "sdi_power_monitor_internal.h"
 #include "sdi_entity_info_internal.h"
+#include "sdi_name_hash.h"
 #include "std_assert.h"
 #include "std_llist.h"
 #include "std_utils.h"
+#include "std_condition_variable.h"
+#include "std_thread_tools.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
 
 static std_dll_head resource_list;
 
+/**
+ * Resources of resource_list indexed by name
+ */
+static sdi_name_hash_t resource_index;
+
+/**
+ * When sdi_resource_init_schedule initialises the resources
+ */
+static sdi_resource_init_mode_t resource_init_mode = SDI_RESOURCE_INIT_EAGER;
+
+/**
+ * Resources whose deferred init is run in background by the pre-warm thread
+ */
+static struct {
+    std_mutex_type_t lock;
+    std_condition_var_t cond;
+    sdi_resource_priv_hdl_t head;
+    sdi_resource_priv_hdl_t tail;
+    bool running;
+    std_thread_create_param_t thread;
+} resource_prewarm = { .lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER };
+
 /**
  * sdi_resource_node_t - holds resource specific data
  */
@@ -77,6 +104,7 @@ sdi_resource_type_t sdi_internal_resource_type_get(sdi_resource_hdl_t hdl)
 void sdi_resource_mgr_init(void)
 {
     std_dll_init(&resource_list);
+    memset(&resource_index, 0, sizeof(resource_index));
 }
 
 /**
@@ -99,8 +127,10 @@ void sdi_resource_add(sdi_resource_type_t type, const char *name, void *callback
     newnode->resource_hdl->type = type;
     newnode->resource_hdl->callback_hdl = callback_hdl;
     newnode->resource_hdl->callback_fns = callback_fns;
+    std_mutex_lock_init_non_recursive(&newnode->resource_hdl->init_lock);
 
     std_dll_insertatback(&resource_list, (std_dll *)newnode);
+    sdi_name_hash_add(&resource_index, newnode->resource_hdl->name, newnode->resource_hdl);
 }
 
 /**
@@ -112,19 +142,9 @@ void sdi_resource_add(sdi_resource_type_t type, const char *name, void *callback
  */
 sdi_resource_hdl_t sdi_find_resource_by_name(const char *name)
 {
-    sdi_resource_node_t *node = NULL;
-
     STD_ASSERT(name != NULL);
-    node = (sdi_resource_node_t *)std_dll_getfirst(&resource_list);
-    while(node)
-    {
-        if (strncmp(sdi_resource_name_get(node->resource_hdl), name, SDI_MAX_NAME_LEN) == 0)
-        {
-            return (sdi_resource_hdl_t) (node->resource_hdl);
-        }
-        node=(sdi_resource_node_t *)std_dll_getnext(&resource_list, (std_dll *)node);
-    }
-    return NULL;
+
+    return (sdi_resource_hdl_t) sdi_name_hash_find(&resource_index, name);
 }
 
 /**
@@ -210,3 +230,151 @@ t_std_error sdi_resource_init(sdi_resource_hdl_t hdl, void *data)
 
     return rc;
 }
+
+/**
+ * Set the resource init mode.
+ * param[in] mode - resource init mode
+ */
+void sdi_resource_init_mode_set(sdi_resource_init_mode_t mode)
+{
+    resource_init_mode = mode;
+}
+
+/**
+ * Returns true if init of the resource type does something and hence can be
+ * deferred till the first access of the resource.
+ */
+static bool sdi_resource_init_deferrable(sdi_resource_type_t type)
+{
+    switch (type) {
+        case SDI_RESOURCE_FAN:
+        case SDI_RESOURCE_ENTITY_INFO:
+        case SDI_RESOURCE_TEMPERATURE:
+        case SDI_RESOURCE_NVRAM:
+        case SDI_RESOURCE_POWER_MONITOR:
+        case SDI_RESOURCE_EXT_CONTROL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Pre-warm thread, runs the deferred init of the queued resources.
+ * Runs at idle priority so that it doesn't compete with the first accesses,
+ * which init their resource themselves.
+ */
+static void *sdi_resource_prewarm_thread(void *param)
+{
+    struct sched_param sched = { .sched_priority = 0 };
+    sdi_resource_priv_hdl_t resource_hdl = NULL;
+
+    /* Best effort, pre-warm is only an optimisation */
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &sched);
+
+    std_mutex_lock(&resource_prewarm.lock);
+    for (;;) {
+        while (resource_prewarm.head == NULL) {
+            std_condition_var_wait(&resource_prewarm.cond, &resource_prewarm.lock);
+        }
+        resource_hdl = resource_prewarm.head;
+        resource_prewarm.head = resource_hdl->prewarm_next;
+        if (resource_prewarm.head == NULL) {
+            resource_prewarm.tail = NULL;
+        }
+        resource_hdl->prewarm_next = NULL;
+        std_mutex_unlock(&resource_prewarm.lock);
+
+        sdi_resource_init_ensure(resource_hdl);
+
+        std_mutex_lock(&resource_prewarm.lock);
+    }
+
+    return NULL;
+}
+
+/**
+ * Queue the resource for the pre-warm thread, starting it on first use.
+ */
+static void sdi_resource_prewarm_queue(sdi_resource_priv_hdl_t resource_hdl)
+{
+    std_mutex_lock(&resource_prewarm.lock);
+    if ((resource_hdl->prewarm_next != NULL) || (resource_prewarm.tail == resource_hdl)) {
+        /* Already queued, entity got re-initialised */
+        std_mutex_unlock(&resource_prewarm.lock);
+        return;
+    }
+    if (resource_prewarm.tail != NULL) {
+        resource_prewarm.tail->prewarm_next = resource_hdl;
+    } else {
+        resource_prewarm.head = resource_hdl;
+    }
+    resource_prewarm.tail = resource_hdl;
+
+    if (!resource_prewarm.running) {
+        std_thread_init_struct(&resource_prewarm.thread);
+        resource_prewarm.thread.name = "sdi-res-prewarm";
+        resource_prewarm.thread.thread_function =
+            (std_thread_function_t) sdi_resource_prewarm_thread;
+        resource_prewarm.thread.param = NULL;
+        if (std_thread_create(&resource_prewarm.thread) == STD_ERR_OK) {
+            resource_prewarm.running = true;
+        } else {
+            /* Resources still get initialised on their first access */
+            std_thread_destroy_struct(&resource_prewarm.thread);
+            SDI_ERRMSG_LOG("Failed to create resource pre-warm thread\n");
+        }
+    }
+    std_condition_var_signal(&resource_prewarm.cond);
+    std_mutex_unlock(&resource_prewarm.lock);
+}
+
+/**
+ * Initialize the resource now or, in lazy init modes, mark it to be
+ * initialised on its first access.
+ * param[in] hdl - handle to the resource whose information has to be initialised.
+ * param[in] data - data to initialise
+ * return STD_ERR_OK on success and standard error on failure
+ */
+t_std_error sdi_resource_init_schedule(sdi_resource_hdl_t hdl, void *data)
+{
+    sdi_resource_priv_hdl_t resource_hdl = (sdi_resource_priv_hdl_t)hdl;
+
+    STD_ASSERT(resource_hdl != NULL);
+
+    if ((resource_init_mode == SDI_RESOURCE_INIT_EAGER)
+        || (!sdi_resource_init_deferrable(resource_hdl->type))) {
+        return sdi_resource_init(hdl, data);
+    }
+
+    std_mutex_lock(&resource_hdl->init_lock);
+    resource_hdl->init_data = (data != NULL) ? *((uint_t *)data) : 0;
+    __atomic_store_n(&resource_hdl->init_deferred, true, __ATOMIC_RELEASE);
+    std_mutex_unlock(&resource_hdl->init_lock);
+
+    if (resource_init_mode == SDI_RESOURCE_INIT_LAZY_PREWARM) {
+        sdi_resource_prewarm_queue(resource_hdl);
+    }
+
+    return STD_ERR_OK;
+}
+
+/**
+ * Run the deferred init of the resource unless an other thread already did.
+ * param[in] hdl - handle to the resource
+ */
+void sdi_resource_deferred_init(sdi_resource_hdl_t hdl)
+{
+    sdi_resource_priv_hdl_t resource_hdl = (sdi_resource_priv_hdl_t)hdl;
+
+    STD_ASSERT(resource_hdl != NULL);
+
+    std_mutex_lock(&resource_hdl->init_lock);
+    if (resource_hdl->init_deferred) {
+        /* Failure is logged by sdi_resource_init, it is not retried just as
+         * eager init isn't */
+        sdi_resource_init(hdl, &resource_hdl->init_data);
+        __atomic_store_n(&resource_hdl->init_deferred, false, __ATOMIC_RELEASE);
+    }
+    std_mutex_unlock(&resource_hdl->init_lock);
+}
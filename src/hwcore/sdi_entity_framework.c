@@ -46,6 +46,17 @@
 #define SDI_STR_FIXED_SLOT           "FIXED_SLOT"
 #define SDI_FIXED_SLOT_SIZE          10
 
+/**
+ * Number of entity types, see sdi_entity_type_t
+ */
+#define SDI_ENTITY_TYPE_COUNT        (SDI_ENTITY_PSU_TRAY + 1)
+
+/**
+ * Entities with a higher instance number are not indexed, lookup falls back
+ * to a scan of the entity list for them
+ */
+#define SDI_ENTITY_INSTANCE_INDEX_MAX    1024
+
 static const char *reset_type_attr_str[MAX_NUM_RESET] = {"warm_reset", "cold_reset"};
 
 /**
@@ -61,6 +72,20 @@ typedef struct sdi_entity_node {
     sdi_entity_hdl_t entity_hdl; /**< entity specific data*/
 } sdi_entity_node_t;
 
+/**
+ * sdi_entity_type_index_t - Entities of a type indexed by instance
+ */
+typedef struct sdi_entity_type_index {
+    sdi_entity_hdl_t *entities; /**< entities indexed by instance, NULL if none */
+    uint_t size; /**< number of entries of entities */
+    uint_t count; /**< number of entities of the type in entity list */
+} sdi_entity_type_index_t;
+
+/**
+ * var Entities of entity list indexed by type and instance
+ */
+static sdi_entity_type_index_t entity_type_index[SDI_ENTITY_TYPE_COUNT];
+
 /**
  * sdi_entity_resource_node_t - Used to maintain the list of resources on linked list
  */
@@ -108,22 +133,10 @@ static sdi_entity_node_t *sdi_entity_find_next(sdi_entity_node_t *node)
  */
 uint_t sdi_entity_count_get(sdi_entity_type_t etype)
 {
-    uint_t entity_count = 0;
-    sdi_entity_node_t *hdl = NULL;
-    sdi_entity_priv_hdl_t entity_hdl = NULL;
-
-    for (hdl = sdi_entity_find_first(); (hdl != NULL);
-         hdl = sdi_entity_find_next(hdl))
-    {
-        entity_hdl = (sdi_entity_priv_hdl_t)hdl->entity_hdl;
-
-        if(entity_hdl->type == etype)
-        {
-            entity_count++;
-        }
+    if ((uint_t) etype >= SDI_ENTITY_TYPE_COUNT) {
+        return 0;
     }
-    return entity_count;
-
+    return entity_type_index[etype].count;
 }
 
 /**
@@ -156,6 +169,14 @@ sdi_entity_hdl_t sdi_entity_lookup(sdi_entity_type_t etype, uint_t instance)
     sdi_entity_node_t *hdl = NULL;
     sdi_entity_priv_hdl_t entity_hdl = NULL;
 
+    if ((uint_t) etype >= SDI_ENTITY_TYPE_COUNT) {
+        return NULL;
+    }
+
+    if (instance < SDI_ENTITY_INSTANCE_INDEX_MAX) {
+        return (instance < entity_type_index[etype].size)
+               ? entity_type_index[etype].entities[instance] : NULL;
+    }
 
     for (hdl = sdi_entity_find_first(); (hdl != NULL);
          hdl = sdi_entity_find_next(hdl))
@@ -200,25 +221,21 @@ static bool resource_entity_ppid_match(sdi_resource_priv_hdl_t hdl)
 uint_t sdi_entity_resource_count_get(sdi_entity_hdl_t hdl, sdi_resource_type_t resource_type)
 {
     uint_t resource_count = 0;
-    sdi_entity_resource_node_t *node = NULL;
+    uint_t index = 0;
     sdi_entity_priv_hdl_t entity_hdl = NULL;
-    sdi_resource_priv_hdl_t resource_hdl = NULL;
-    std_dll_head *resource_head = NULL;
 
     STD_ASSERT(hdl != NULL);
 
     entity_hdl = (sdi_entity_priv_hdl_t)hdl;
-    resource_head = (std_dll_head *)entity_hdl->resource_list;
-    STD_ASSERT(resource_head != NULL);
 
-    for ((node=(sdi_entity_resource_node_t *)std_dll_getfirst(resource_head));
-         (node != NULL);
-         (node=(sdi_entity_resource_node_t *)std_dll_getnext(resource_head, (std_dll *)node)))
+    if ((uint_t) resource_type >= SDI_RESOURCE_MAX) {
+        return 0;
+    }
+
+    for (index = 0; index < entity_hdl->resource_count[resource_type]; index++)
     {
-        resource_hdl = (sdi_resource_priv_hdl_t) node->hdl;
-        if(resource_entity_ppid_match(resource_hdl)
-           && resource_hdl->type == resource_type
-           )
+        if (resource_entity_ppid_match(
+                (sdi_resource_priv_hdl_t) entity_hdl->resources[resource_type][index]))
         {
             resource_count++;
         }
@@ -237,27 +254,22 @@ uint_t sdi_entity_resource_count_get(sdi_entity_hdl_t hdl, sdi_resource_type_t r
 sdi_resource_hdl_t sdi_entity_resource_lookup(sdi_entity_hdl_t hdl,
                                               sdi_resource_type_t resource, const char *alias)
 {
-    sdi_entity_resource_node_t *node = NULL;
+    sdi_name_hash_entry_t *entry = NULL;
     sdi_entity_priv_hdl_t entity_hdl = NULL;
-    sdi_resource_priv_hdl_t resource_hdl = NULL;
-    std_dll_head *resource_head = NULL;
 
     STD_ASSERT(hdl != NULL);
+    STD_ASSERT(alias != NULL);
 
     entity_hdl = (sdi_entity_priv_hdl_t)hdl;
-    resource_head = (std_dll_head *)entity_hdl->resource_list;
-    STD_ASSERT(resource_head != NULL);
 
-    for ((node=(sdi_entity_resource_node_t *)std_dll_getfirst(resource_head));
-         (node != NULL);
-         (node=(sdi_entity_resource_node_t *)std_dll_getnext(resource_head, (std_dll *)node)))
+    /* Resources sharing an alias differ by the entity ppid they apply to */
+    for (entry = sdi_name_hash_first(&entity_hdl->resource_index, alias);
+         (entry != NULL);
+         entry = sdi_name_hash_next(entry))
     {
-        resource_hdl = (sdi_resource_priv_hdl_t)node->hdl;
-        if (resource_entity_ppid_match(resource_hdl)
-            && strncmp(resource_hdl->alias, alias, SDI_MAX_NAME_LEN) == 0
-            )
+        if (resource_entity_ppid_match((sdi_resource_priv_hdl_t)entry->value))
         {
-            return node->hdl;
+            return (sdi_resource_hdl_t)entry->value;
         }
     }
     return NULL;
@@ -345,6 +357,44 @@ sdi_entity_hdl_t sdi_entity_create(sdi_entity_type_t type, uint_t instance, cons
     return (sdi_entity_hdl_t)entity_hdl;
 }
 
+/**
+ * Index an entity by type and instance
+ *
+ * hdl[in] - handle of the entity added to entity list
+ * first[in] - true if the entity was added at the front of entity list, so
+ * lookup finds it before an entity of the same type and instance
+ */
+static void sdi_entity_index_add(sdi_entity_hdl_t hdl, bool first)
+{
+    sdi_entity_priv_hdl_t entity_hdl = (sdi_entity_priv_hdl_t)hdl;
+    sdi_entity_type_index_t *type_index = NULL;
+    sdi_entity_hdl_t *entities = NULL;
+    uint_t size = 0;
+
+    STD_ASSERT((uint_t) entity_hdl->type < SDI_ENTITY_TYPE_COUNT);
+    type_index = &entity_type_index[entity_hdl->type];
+    type_index->count++;
+
+    if (entity_hdl->instance >= SDI_ENTITY_INSTANCE_INDEX_MAX) {
+        return;
+    }
+
+    if (entity_hdl->instance >= type_index->size) {
+        size = entity_hdl->instance + 1;
+        entities = (sdi_entity_hdl_t *)realloc(type_index->entities,
+                                               size * sizeof(*entities));
+        STD_ASSERT(entities != NULL);
+        memset(&entities[type_index->size], 0,
+               (size - type_index->size) * sizeof(*entities));
+        type_index->entities = entities;
+        type_index->size = size;
+    }
+
+    if (first || (type_index->entities[entity_hdl->instance] == NULL)) {
+        type_index->entities[entity_hdl->instance] = hdl;
+    }
+}
+
 /**
  * Add the entity specified by hdl to the entity-pool.
  *
@@ -358,6 +408,7 @@ void sdi_entity_add(sdi_entity_hdl_t hdl)
     newnode->entity_hdl = hdl;
 
     std_dll_insertatback(&entity_list, (std_dll *)newnode);
+    sdi_entity_index_add(hdl, false);
 }
 
 /**
@@ -370,8 +421,12 @@ void sdi_entity_add(sdi_entity_hdl_t hdl)
 void sdi_entity_add_resource(sdi_entity_hdl_t ehdl, sdi_resource_hdl_t resource, const char *name)
 {
     sdi_entity_resource_node_t *newnode = NULL;
+    sdi_entity_priv_hdl_t entity_hdl = (sdi_entity_priv_hdl_t)ehdl;
+    sdi_resource_type_t type = sdi_internal_resource_type_get(resource);
+    sdi_resource_hdl_t *resources = NULL;
 
     STD_ASSERT(name != NULL);
+    STD_ASSERT((uint_t) type < SDI_RESOURCE_MAX);
 
     newnode = (sdi_entity_resource_node_t *)calloc(1, sizeof(sdi_entity_resource_node_t));
     STD_ASSERT(newnode != NULL);
@@ -379,9 +434,18 @@ void sdi_entity_add_resource(sdi_entity_hdl_t ehdl, sdi_resource_hdl_t resource,
     safestrncpy(((sdi_resource_priv_hdl_t)resource)->alias, name,
             sizeof(((sdi_resource_priv_hdl_t)resource)->alias));
     newnode->hdl = resource;
-    std_dll_insertatback(((sdi_entity_priv_hdl_t)ehdl)->resource_list, (std_dll *)newnode);
+    std_dll_insertatback(entity_hdl->resource_list, (std_dll *)newnode);
+
+    ((sdi_resource_priv_hdl_t) resource)->parent = entity_hdl;
 
-    ((sdi_resource_priv_hdl_t) resource)->parent = (sdi_entity_priv_hdl_t) ehdl;
+    sdi_name_hash_add(&entity_hdl->resource_index,
+                      ((sdi_resource_priv_hdl_t)resource)->alias, resource);
+
+    resources = (sdi_resource_hdl_t *)realloc(entity_hdl->resources[type],
+            (entity_hdl->resource_count[type] + 1) * sizeof(*resources));
+    STD_ASSERT(resources != NULL);
+    resources[entity_hdl->resource_count[type]++] = resource;
+    entity_hdl->resources[type] = resources;
 }
 
 
@@ -429,6 +493,7 @@ static void sdi_add_entity(sdi_entity_hdl_t entity_hdl)
 
     node->entity_hdl = entity_hdl;
     std_dll_insertatfront(&entity_list, (std_dll *)node);
+    sdi_entity_index_add(entity_hdl, true);
 }
 
 /**
@@ -645,6 +710,12 @@ void sdi_register_entity(std_config_node_t node)
         }
     }
 
+    config_attr = std_config_attr_get(node, "init_after");
+    if (config_attr != NULL) {
+        entity_priv_hdl->init_after = strdup(config_attr);
+        STD_ASSERT(entity_priv_hdl->init_after != NULL);
+    }
+
     config_attr = std_config_attr_get(node, "gpr_register");
     if (config_attr != NULL) {
         entity_priv_hdl->gpr_pin_grp_hdl =
@@ -669,6 +740,7 @@ void sdi_register_entities(const char * entity_cfg_file)
 {
     std_config_hdl_t cfg_hdl;
     std_config_node_t root, entity;
+    char *init_mode = NULL;
 
     STD_ASSERT(entity_cfg_file != NULL);
 
@@ -677,7 +749,19 @@ void sdi_register_entities(const char * entity_cfg_file)
 
     STD_ASSERT(root != NULL);
 
+    /* resource_init="lazy" defers resource init till their first access,
+     * "lazy_prewarm" additionally runs the deferred inits in background */
+    init_mode = std_config_attr_get(root, "resource_init");
+    if ((init_mode != NULL) && (strcmp(init_mode, "lazy") == 0)) {
+        sdi_resource_init_mode_set(SDI_RESOURCE_INIT_LAZY);
+    } else if ((init_mode != NULL) && (strcmp(init_mode, "lazy_prewarm") == 0)) {
+        sdi_resource_init_mode_set(SDI_RESOURCE_INIT_LAZY_PREWARM);
+    } else {
+        sdi_resource_init_mode_set(SDI_RESOURCE_INIT_EAGER);
+    }
+
     std_dll_init(&entity_list);
+    memset(entity_type_index, 0, sizeof(entity_type_index));
 
     for (entity=std_config_get_child(root);(entity != NULL); entity=std_config_next_node(entity))
     {
@@ -744,7 +828,7 @@ t_std_error sdi_entity_init(sdi_entity_hdl_t hdl)
                 /* TODO: Decide max speed to initialise, in case of read failure */
               }
           }
-          ret = sdi_resource_init(node->hdl, &data);
+          ret = sdi_resource_init_schedule(node->hdl, &data);
           if (ret != STD_ERR_OK) {
               SDI_ERRMSG_LOG("Resource init failed %s.rc=%d\n",
                              sdi_resource_name_get(node->hdl), ret);
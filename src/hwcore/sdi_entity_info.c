@@ -43,6 +43,9 @@ t_std_error sdi_entity_info_read(sdi_resource_hdl_t resource_hdl,
                                  sdi_entity_info_t *entity_info)
 {
     sdi_entity_priv_hdl_t entity_priv_hdl = ((sdi_resource_priv_hdl_t) resource_hdl)->parent;
+
+    /* entity_info is filled in by the init of the resource */
+    sdi_resource_init_ensure(resource_hdl);
     if (!entity_priv_hdl->entity_info_valid)  return (SDI_ERRCODE(ENODATA));
 
     memcpy(entity_info, &entity_priv_hdl->entity_info, sizeof(*entity_info));
@@ -50,6 +50,8 @@ t_std_error sdi_ext_ctrl_get(sdi_resource_hdl_t resource_hdl, int *ext_ctrl, int
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(resource_hdl);
+
     rc = ((ext_ctrl_t *)ext_ctrl_hdl->callback_fns)->
         ext_ctrl_get(ext_ctrl_hdl->callback_hdl, ext_ctrl, size);
     if(rc != STD_ERR_OK) {
@@ -82,6 +84,8 @@ t_std_error sdi_ext_ctrl_set(sdi_resource_hdl_t resource_hdl, int *ext_ctrl, int
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(resource_hdl);
+
     rc = ((ext_ctrl_t *)ext_ctrl_hdl->callback_fns)->
         ext_ctrl_set(ext_ctrl_hdl->callback_hdl, ext_ctrl, size);
     if(rc != STD_ERR_OK)
@@ -47,6 +47,8 @@ t_std_error sdi_fan_speed_get(sdi_resource_hdl_t hdl, uint_t *speed)
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(hdl);
+
     rc = ((fan_ctrl_t *)fan_hdl->callback_fns)->speed_get(hdl, fan_hdl->callback_hdl, speed);
     if(rc != STD_ERR_OK)
     {
@@ -73,6 +75,8 @@ t_std_error sdi_fan_speed_set(sdi_resource_hdl_t hdl, uint_t speed)
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(hdl);
+
     if(((fan_ctrl_t *)fan_hdl->callback_fns)->speed_set == NULL) {
         return  SDI_ERRCODE(EOPNOTSUPP);
     }
@@ -105,6 +109,8 @@ t_std_error sdi_fan_status_get(sdi_resource_hdl_t hdl, bool *status)
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(hdl);
+
     rc = ((fan_ctrl_t *)fan_hdl->callback_fns)->status_get(fan_hdl->callback_hdl,status);
     if(rc != STD_ERR_OK)
     {
@@ -121,6 +127,8 @@ uint_t sdi_fan_speed_rpm_to_pct(sdi_resource_hdl_t hdl, uint_t rpm)
     sdi_resource_priv_hdl_t fan_hdl = (sdi_resource_priv_hdl_t) hdl;
     uint_t (*f)(sdi_resource_hdl_t, void *, uint_t)
         = ((fan_ctrl_t *) fan_hdl->callback_fns)->speed_rpm_to_pct;
+
+    sdi_resource_init_ensure(hdl);
     if (f == 0) {
         /* No callback given => fall back to % of max speed */
         sdi_entity_priv_hdl_t e = fan_hdl->parent;
@@ -137,6 +145,8 @@ uint_t sdi_fan_speed_pct_to_rpm(sdi_resource_hdl_t hdl, uint_t pct)
     sdi_resource_priv_hdl_t fan_hdl = (sdi_resource_priv_hdl_t) hdl;
     uint_t (*f)(sdi_resource_hdl_t, void *, uint_t)
         = ((fan_ctrl_t *) fan_hdl->callback_fns)->speed_pct_to_rpm;
+
+    sdi_resource_init_ensure(hdl);
     if (f == 0) {
         /* No callback given => fall back to fraction of max speed */
         sdi_entity_priv_hdl_t e = fan_hdl->parent;
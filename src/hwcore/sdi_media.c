@@ -26,6 +26,7 @@
 #include "sdi_media.h"
 #include "sdi_resource_internal.h"
 #include "std_assert.h"
+#include <string.h>
 
 /**
  * Get the present status of the specific media
@@ -858,6 +859,106 @@ t_std_error sdi_media_channel_monitor_get (sdi_resource_hdl_t resource_hdl,
     return rc;
 }
 
+/**
+ * Compose a DOM snapshot from the individual monitor callbacks, for media
+ * drivers which cannot read all monitors at once
+ * media_hdl[in]     - media resource
+ * channel_count[in] - number of channels of interest
+ * snapshot[out]     - monitors of the media
+ * return           - standard t_std_error
+ */
+static t_std_error sdi_media_dom_snapshot_compose (sdi_resource_priv_hdl_t media_hdl,
+                                                   uint_t channel_count,
+                                                   sdi_media_dom_snapshot_t *snapshot)
+{
+    media_ctrl_t *media_ops = (media_ctrl_t *)media_hdl->callback_fns;
+    sdi_media_channel_monitor_t monitor[] = { SDI_MEDIA_INTERNAL_RX_POWER_MONITOR,
+                                              SDI_MEDIA_INTERNAL_TX_BIAS_CURRENT,
+                                              SDI_MEDIA_INTERNAL_TX_OUTPUT_POWER };
+    float *value[] = { snapshot->rx_power, snapshot->tx_bias, snapshot->tx_power };
+    bool *valid[] = { &snapshot->rx_power_valid, &snapshot->tx_bias_valid,
+                      &snapshot->tx_power_valid };
+    t_std_error rc = STD_ERR_OK;
+    t_std_error err = STD_ERR_OK;
+    uint_t index = 0;
+    uint_t channel = 0;
+
+    err = media_ops->module_monitor_get(media_hdl->callback_hdl, SDI_MEDIA_TEMP,
+                                        &snapshot->temperature);
+    if (err == STD_ERR_OK) {
+        err = media_ops->module_monitor_get(media_hdl->callback_hdl, SDI_MEDIA_VOLT,
+                                            &snapshot->voltage);
+    }
+    snapshot->module_monitor_valid = (err == STD_ERR_OK);
+    if (!snapshot->module_monitor_valid) {
+        snapshot->temperature = 0;
+        snapshot->voltage = 0;
+        if (STD_ERR_EXT_PRIV(err) != EOPNOTSUPP) {
+            rc = err;
+        }
+    }
+
+    for (index = 0; index < (sizeof(monitor) / sizeof(monitor[0])); index++) {
+        *valid[index] = (channel_count != 0);
+        for (channel = 0; channel < channel_count; channel++) {
+            err = media_ops->channel_monitor_get(media_hdl->callback_hdl, channel,
+                                                 monitor[index], &value[index][channel]);
+            if (err != STD_ERR_OK) {
+                *valid[index] = false;
+                memset(value[index], 0, sizeof(snapshot->rx_power));
+                if ((rc == STD_ERR_OK) && (STD_ERR_EXT_PRIV(err) != EOPNOTSUPP)) {
+                    rc = err;
+                }
+                break;
+            }
+        }
+    }
+
+    return rc;
+}
+
+/**
+ * Read all module and channel monitors of the specified media in one go.
+ * resource_hdl[in]  - handle of the media resource
+ * channel_count[in] - number of channels of interest
+ * snapshot[out]     - monitors of the media
+ * return           - standard t_std_error
+ */
+t_std_error sdi_media_dom_snapshot_get (sdi_resource_hdl_t resource_hdl, uint_t channel_count,
+                                        sdi_media_dom_snapshot_t *snapshot)
+{
+    t_std_error rc = STD_ERR_OK;
+    sdi_resource_priv_hdl_t media_hdl = NULL;
+
+    STD_ASSERT(snapshot != NULL);
+    STD_ASSERT(resource_hdl != NULL);
+
+    media_hdl = (sdi_resource_priv_hdl_t)resource_hdl;
+
+    if (media_hdl->type != SDI_RESOURCE_MEDIA){
+        return(SDI_ERRCODE(EPERM));
+    }
+
+    if (channel_count > SDI_MEDIA_DOM_MAX_CHANNELS) {
+        channel_count = SDI_MEDIA_DOM_MAX_CHANNELS;
+    }
+    memset(snapshot, 0, sizeof(*snapshot));
+    snapshot->channel_count = channel_count;
+
+    if (((media_ctrl_t *)media_hdl->callback_fns)->dom_snapshot_get != NULL) {
+        rc = ((media_ctrl_t *)media_hdl->callback_fns)->dom_snapshot_get(media_hdl->callback_hdl,
+                                                                         channel_count, snapshot);
+    } else {
+        rc = sdi_media_dom_snapshot_compose(media_hdl, channel_count, snapshot);
+    }
+    if (rc != STD_ERR_OK){
+        SDI_ERRMSG_LOG("Failed to get dom snapshot for %s error code : %d(0x%x)",
+                        media_hdl->name, rc, rc);
+    }
+
+    return rc;
+}
+
 
 
 /**
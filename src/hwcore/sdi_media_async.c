@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2019 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_media_async.c
+ */
+
+
+/*******************************************************************************
+ * Asynchronous media requests, executed by the worker of the i2c adapter of
+ * the media.
+ ******************************************************************************/
+
+#include "sdi_media.h"
+#include "sdi_media_worker.h"
+#include "sdi_sys_common.h"
+#include "std_mutex_lock.h"
+#include "std_assert.h"
+
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+/**
+ * Media requests which can be executed asynchronously
+ */
+typedef enum {
+    SDI_MEDIA_ASYNC_PRESENCE,
+    SDI_MEDIA_ASYNC_MODULE_MONITOR,
+    SDI_MEDIA_ASYNC_CHANNEL_MONITOR,
+    SDI_MEDIA_ASYNC_VENDOR_INFO,
+    SDI_MEDIA_ASYNC_READ_GENERIC,
+} sdi_media_async_op_t;
+
+/**
+ * Asynchronous media request
+ */
+struct sdi_media_async_req {
+    sdi_media_work_t work;
+    sdi_media_async_op_t op;
+    sdi_resource_hdl_t resource_hdl;
+    union {
+        struct {
+            bool *presence;
+        } presence;
+        struct {
+            sdi_media_module_monitor_t monitor;
+            float *value;
+        } module_monitor;
+        struct {
+            uint_t channel;
+            sdi_media_channel_monitor_t monitor;
+            float *value;
+        } channel_monitor;
+        struct {
+            sdi_media_vendor_info_type_t type;
+            char *buf;
+            size_t buf_size;
+        } vendor_info;
+        struct {
+            sdi_media_eeprom_addr_t addr;
+            uint8_t *data;
+            size_t data_len;
+        } read_generic;
+    } args;
+    sdi_media_async_cb_t cb;
+    void *cookie;
+    bool done; /* protected by sdi_media_async_lock */
+    t_std_error rc;
+};
+
+/* Protects completion state of requests and creation of the eventfd */
+static std_mutex_lock_create_static_init_fast(sdi_media_async_lock);
+
+/* eventfd signalled on completion of requests without callback */
+static int sdi_media_async_fd = -1;
+
+/**
+ * Get the completion eventfd, creating it on first use
+ * fd[out] - eventfd
+ * return t_std_error
+ */
+t_std_error sdi_media_async_fd_get (int *fd)
+{
+    t_std_error rc = STD_ERR_OK;
+
+    STD_ASSERT(fd != NULL);
+
+    std_mutex_lock(&sdi_media_async_lock);
+    if (sdi_media_async_fd < 0) {
+        sdi_media_async_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+    if (sdi_media_async_fd < 0) {
+        rc = SDI_ERRCODE(errno);
+    } else {
+        *fd = sdi_media_async_fd;
+    }
+    std_mutex_unlock(&sdi_media_async_lock);
+
+    return rc;
+}
+
+/**
+ * Execute a request and complete it
+ * arg[in] - request
+ * return none
+ */
+static void sdi_media_async_execute(void *arg)
+{
+    struct sdi_media_async_req *req = (struct sdi_media_async_req *) arg;
+    t_std_error rc = STD_ERR_OK;
+
+    switch (req->op) {
+        case SDI_MEDIA_ASYNC_PRESENCE:
+            rc = sdi_media_presence_get(req->resource_hdl, req->args.presence.presence);
+            break;
+        case SDI_MEDIA_ASYNC_MODULE_MONITOR:
+            rc = sdi_media_module_monitor_get(req->resource_hdl,
+                                              req->args.module_monitor.monitor,
+                                              req->args.module_monitor.value);
+            break;
+        case SDI_MEDIA_ASYNC_CHANNEL_MONITOR:
+            rc = sdi_media_channel_monitor_get(req->resource_hdl,
+                                               req->args.channel_monitor.channel,
+                                               req->args.channel_monitor.monitor,
+                                               req->args.channel_monitor.value);
+            break;
+        case SDI_MEDIA_ASYNC_VENDOR_INFO:
+            rc = sdi_media_vendor_info_get(req->resource_hdl,
+                                           req->args.vendor_info.type,
+                                           req->args.vendor_info.buf,
+                                           req->args.vendor_info.buf_size);
+            break;
+        case SDI_MEDIA_ASYNC_READ_GENERIC:
+            rc = sdi_media_read_generic(req->resource_hdl,
+                                        &(req->args.read_generic.addr),
+                                        req->args.read_generic.data,
+                                        req->args.read_generic.data_len);
+            break;
+        default:
+            rc = SDI_ERRCODE(EINVAL);
+            break;
+    }
+
+    if (req->cb != NULL) {
+        req->cb(req, rc, req->cookie);
+        free(req);
+        return;
+    }
+
+    std_mutex_lock(&sdi_media_async_lock);
+    req->rc = rc;
+    req->done = true;
+    std_mutex_unlock(&sdi_media_async_lock);
+
+    eventfd_write(sdi_media_async_fd, 1);
+}
+
+/**
+ * Allocate a request
+ * resource_hdl[in] - handle of the media resource
+ * op[in]           - media request
+ * cb[in]           - completion callback, NULL to complete through the eventfd
+ * cookie[in]       - cookie passed to cb
+ * hdl[in]          - where handle of the request is returned
+ * rc[out]          - result, error when no request is returned
+ * return request, NULL on error
+ */
+static struct sdi_media_async_req *sdi_media_async_alloc(sdi_resource_hdl_t resource_hdl,
+                                                         sdi_media_async_op_t op,
+                                                         sdi_media_async_cb_t cb,
+                                                         void *cookie,
+                                                         sdi_media_async_hdl_t *hdl,
+                                                         t_std_error *rc)
+{
+    struct sdi_media_async_req *req = NULL;
+    int fd = -1;
+
+    STD_ASSERT(resource_hdl != NULL);
+
+    if ((cb == NULL) && (hdl == NULL)) {
+        *rc = SDI_ERRCODE(EINVAL);
+        return NULL;
+    }
+    if (cb == NULL) {
+        /* Make sure completion can be signalled before anything is queued */
+        *rc = sdi_media_async_fd_get(&fd);
+        if (*rc != STD_ERR_OK) {
+            return NULL;
+        }
+    }
+
+    req = (struct sdi_media_async_req *) calloc(1, sizeof(*req));
+    if (req == NULL) {
+        *rc = SDI_ERRCODE(ENOMEM);
+        return NULL;
+    }
+    req->op = op;
+    req->resource_hdl = resource_hdl;
+    req->cb = cb;
+    req->cookie = cookie;
+    req->work.fn = sdi_media_async_execute;
+    req->work.arg = req;
+
+    *rc = STD_ERR_OK;
+    return req;
+}
+
+/**
+ * Submit a request to the worker of the media. Media which are not on an i2c
+ * bus have their request executed on the calling thread.
+ * req[in] - request
+ * hdl[out] - handle of the request, NULL for requests with callback as the
+ *            worker releases them once the callback returns
+ * return t_std_error
+ */
+static t_std_error sdi_media_async_submit(struct sdi_media_async_req *req,
+                                          sdi_media_async_hdl_t *hdl)
+{
+    /* Request without callback is released by sdi_media_async_complete only,
+     * so its handle is set before it can complete */
+    if (hdl != NULL) {
+        *hdl = (req->cb == NULL) ? req : NULL;
+    }
+    if (sdi_media_work_queue(req->resource_hdl, &(req->work)) != STD_ERR_OK) {
+        sdi_media_async_execute(req);
+    }
+    return STD_ERR_OK;
+}
+
+/**
+ * Collect the result of a request without callback and release it
+ * req[in] - request
+ * rc[out] - result of the request
+ * return t_std_error
+ */
+t_std_error sdi_media_async_complete (sdi_media_async_hdl_t req, t_std_error *rc)
+{
+    bool done = false;
+
+    STD_ASSERT(req != NULL);
+    STD_ASSERT(rc != NULL);
+
+    std_mutex_lock(&sdi_media_async_lock);
+    done = req->done;
+    std_mutex_unlock(&sdi_media_async_lock);
+
+    if (!done) {
+        return SDI_ERRCODE(EAGAIN);
+    }
+    *rc = req->rc;
+    free(req);
+    return STD_ERR_OK;
+}
+
+/**
+ * Asynchronous version of sdi_media_presence_get
+ */
+t_std_error sdi_media_presence_get_async (sdi_resource_hdl_t resource_hdl,
+                                          bool *presence, sdi_media_async_cb_t cb,
+                                          void *cookie, sdi_media_async_hdl_t *req)
+{
+    struct sdi_media_async_req *async_req = NULL;
+    t_std_error rc = STD_ERR_OK;
+
+    STD_ASSERT(presence != NULL);
+
+    async_req = sdi_media_async_alloc(resource_hdl, SDI_MEDIA_ASYNC_PRESENCE,
+                                      cb, cookie, req, &rc);
+    if (async_req == NULL) {
+        return rc;
+    }
+    async_req->args.presence.presence = presence;
+    return sdi_media_async_submit(async_req, req);
+}
+
+/**
+ * Asynchronous version of sdi_media_module_monitor_get
+ */
+t_std_error sdi_media_module_monitor_get_async (sdi_resource_hdl_t resource_hdl,
+                                                sdi_media_module_monitor_t monitor,
+                                                float *value, sdi_media_async_cb_t cb,
+                                                void *cookie, sdi_media_async_hdl_t *req)
+{
+    struct sdi_media_async_req *async_req = NULL;
+    t_std_error rc = STD_ERR_OK;
+
+    STD_ASSERT(value != NULL);
+
+    async_req = sdi_media_async_alloc(resource_hdl, SDI_MEDIA_ASYNC_MODULE_MONITOR,
+                                      cb, cookie, req, &rc);
+    if (async_req == NULL) {
+        return rc;
+    }
+    async_req->args.module_monitor.monitor = monitor;
+    async_req->args.module_monitor.value = value;
+    return sdi_media_async_submit(async_req, req);
+}
+
+/**
+ * Asynchronous version of sdi_media_channel_monitor_get
+ */
+t_std_error sdi_media_channel_monitor_get_async (sdi_resource_hdl_t resource_hdl,
+                                                 uint_t channel,
+                                                 sdi_media_channel_monitor_t monitor,
+                                                 float *value, sdi_media_async_cb_t cb,
+                                                 void *cookie, sdi_media_async_hdl_t *req)
+{
+    struct sdi_media_async_req *async_req = NULL;
+    t_std_error rc = STD_ERR_OK;
+
+    STD_ASSERT(value != NULL);
+
+    async_req = sdi_media_async_alloc(resource_hdl, SDI_MEDIA_ASYNC_CHANNEL_MONITOR,
+                                      cb, cookie, req, &rc);
+    if (async_req == NULL) {
+        return rc;
+    }
+    async_req->args.channel_monitor.channel = channel;
+    async_req->args.channel_monitor.monitor = monitor;
+    async_req->args.channel_monitor.value = value;
+    return sdi_media_async_submit(async_req, req);
+}
+
+/**
+ * Asynchronous version of sdi_media_vendor_info_get
+ */
+t_std_error sdi_media_vendor_info_get_async (sdi_resource_hdl_t resource_hdl,
+                                             sdi_media_vendor_info_type_t vendor_info_type,
+                                             char *vendor_info, size_t buf_size,
+                                             sdi_media_async_cb_t cb, void *cookie,
+                                             sdi_media_async_hdl_t *req)
+{
+    struct sdi_media_async_req *async_req = NULL;
+    t_std_error rc = STD_ERR_OK;
+
+    STD_ASSERT(vendor_info != NULL);
+
+    async_req = sdi_media_async_alloc(resource_hdl, SDI_MEDIA_ASYNC_VENDOR_INFO,
+                                      cb, cookie, req, &rc);
+    if (async_req == NULL) {
+        return rc;
+    }
+    async_req->args.vendor_info.type = vendor_info_type;
+    async_req->args.vendor_info.buf = vendor_info;
+    async_req->args.vendor_info.buf_size = buf_size;
+    return sdi_media_async_submit(async_req, req);
+}
+
+/**
+ * Asynchronous version of sdi_media_read_generic
+ */
+t_std_error sdi_media_read_generic_async (sdi_resource_hdl_t resource_hdl,
+                                          sdi_media_eeprom_addr_t *addr,
+                                          uint8_t *data, size_t data_len,
+                                          sdi_media_async_cb_t cb, void *cookie,
+                                          sdi_media_async_hdl_t *req)
+{
+    struct sdi_media_async_req *async_req = NULL;
+    t_std_error rc = STD_ERR_OK;
+
+    STD_ASSERT(addr != NULL);
+    STD_ASSERT(data != NULL);
+
+    async_req = sdi_media_async_alloc(resource_hdl, SDI_MEDIA_ASYNC_READ_GENERIC,
+                                      cb, cookie, req, &rc);
+    if (async_req == NULL) {
+        return rc;
+    }
+    async_req->args.read_generic.addr = *addr;
+    async_req->args.read_generic.data = data;
+    async_req->args.read_generic.data_len = data_len;
+    return sdi_media_async_submit(async_req, req);
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2019 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_media_poll.c
+ */
+
+
+/*******************************************************************************
+ * Sweep of presence and DOM data of many media, in parallel per i2c adapter.
+ ******************************************************************************/
+
+#include "sdi_media.h"
+#include "sdi_media_worker.h"
+#include "sdi_sys_common.h"
+#include "std_mutex_lock.h"
+#include "std_condition_variable.h"
+#include "std_assert.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * State of a sweep shared by all its work
+ */
+typedef struct {
+    std_mutex_type_t lock;
+    std_condition_var_t cond; /* signalled when the last media is polled */
+    uint_t pending; /* media not polled yet */
+} sdi_media_poll_sweep_t;
+
+/**
+ * Work to poll one media of a sweep
+ */
+typedef struct {
+    sdi_media_work_t work;
+    sdi_media_poll_t *media;
+    sdi_media_poll_sweep_t *sweep;
+    bool queued;
+} sdi_media_poll_work_t;
+
+/**
+ * Read presence and DOM data of one media
+ * media[in,out] - media to poll
+ * return none
+ */
+static void sdi_media_poll_one(sdi_media_poll_t *media)
+{
+    sdi_media_dom_snapshot_t snapshot;
+    uint_t channel_count = media->channel_count;
+    t_std_error rc = STD_ERR_OK;
+
+    media->present = false;
+    media->temperature = 0;
+    media->voltage = 0;
+    memset(media->rx_power, 0, sizeof(media->rx_power));
+    memset(media->tx_bias, 0, sizeof(media->tx_bias));
+    memset(media->tx_power, 0, sizeof(media->tx_power));
+
+    rc = sdi_media_presence_get(media->resource_hdl, &(media->present));
+    if ((rc != STD_ERR_OK) || (!media->present)) {
+        media->rc = rc;
+        return;
+    }
+
+    if (channel_count > SDI_MEDIA_POLL_MAX_CHANNELS) {
+        channel_count = SDI_MEDIA_POLL_MAX_CHANNELS;
+    }
+
+    /* DOM values not supported by the media are 0 in the snapshot */
+    media->rc = sdi_media_dom_snapshot_get(media->resource_hdl, channel_count, &snapshot);
+    if (media->rc != STD_ERR_OK) {
+        return;
+    }
+
+    media->temperature = snapshot.temperature;
+    media->voltage = snapshot.voltage;
+    memcpy(media->rx_power, snapshot.rx_power, channel_count * sizeof(float));
+    memcpy(media->tx_bias, snapshot.tx_bias, channel_count * sizeof(float));
+    memcpy(media->tx_power, snapshot.tx_power, channel_count * sizeof(float));
+}
+
+/**
+ * Poll one media of a sweep and signal the sweep when it is the last one
+ * arg[in] - work of the media
+ * return none
+ */
+static void sdi_media_poll_work(void *arg)
+{
+    sdi_media_poll_work_t *work = (sdi_media_poll_work_t *) arg;
+    sdi_media_poll_sweep_t *sweep = work->sweep;
+
+    sdi_media_poll_one(work->media);
+
+    std_mutex_lock(&(sweep->lock));
+    sweep->pending--;
+    if (sweep->pending == 0) {
+        std_condition_var_signal(&(sweep->cond));
+    }
+    std_mutex_unlock(&(sweep->lock));
+}
+
+/**
+ * Collect presence and DOM data of a set of media in one sweep
+ * media[in,out] - media to poll, results are filled in every entry
+ * count[in]     - number of entries in media
+ * return t_std_error
+ */
+t_std_error sdi_media_poll (sdi_media_poll_t *media, uint_t count)
+{
+    sdi_media_poll_sweep_t sweep;
+    sdi_media_poll_work_t *work = NULL;
+    uint_t index = 0;
+
+    STD_ASSERT(media != NULL);
+
+    /* Sweep waits on the workers, e.g. from an async completion callback */
+    if (sdi_media_work_on_worker()) {
+        SDI_ERRMSG_LOG("Media poll called on a media worker thread");
+        return SDI_ERRCODE(EDEADLK);
+    }
+
+    if (count == 0) {
+        return STD_ERR_OK;
+    }
+
+    work = (sdi_media_poll_work_t *) calloc(count, sizeof(sdi_media_poll_work_t));
+    if (work == NULL) {
+        return SDI_ERRCODE(ENOMEM);
+    }
+
+    memset(&sweep, 0, sizeof(sweep));
+    if ((std_mutex_lock_init_non_recursive(&(sweep.lock)) != STD_ERR_OK)
+            || (std_condition_var_init(&(sweep.cond)) != STD_ERR_OK)) {
+        free(work);
+        return SDI_ERRCODE(ENOMEM);
+    }
+    sweep.pending = count;
+
+    /* Hand media on i2c buses to the worker of their adapter first ... */
+    for (index = 0; index < count; index++) {
+        STD_ASSERT(media[index].resource_hdl != NULL);
+        work[index].work.fn = sdi_media_poll_work;
+        work[index].work.arg = &work[index];
+        work[index].media = &media[index];
+        work[index].sweep = &sweep;
+        work[index].queued =
+            (sdi_media_work_queue(media[index].resource_hdl, &(work[index].work)) == STD_ERR_OK);
+    }
+
+    /* ... and poll the rest on this thread meanwhile */
+    for (index = 0; index < count; index++) {
+        if (!work[index].queued) {
+            sdi_media_poll_work(&work[index]);
+        }
+    }
+
+    std_mutex_lock(&(sweep.lock));
+    while (sweep.pending != 0) {
+        std_condition_var_wait(&(sweep.cond), &(sweep.lock));
+    }
+    std_mutex_unlock(&(sweep.lock));
+
+    std_condition_var_destroy(&(sweep.cond));
+    std_mutex_destroy(&(sweep.lock));
+    free(work);
+
+    return STD_ERR_OK;
+}
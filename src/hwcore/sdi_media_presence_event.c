@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2019 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_media_presence_event.c
+ */
+
+
+/*******************************************************************************
+ * Presence change notification of media. A single monitor thread waits on the
+ * event file descriptors of presence pin groups and reads presence only when
+ * a pin group signals a change. Media whose presence pins can not signal
+ * changes are read periodically by the same thread.
+ ******************************************************************************/
+
+#include "sdi_media.h"
+#include "sdi_media_internal.h"
+#include "sdi_resource_internal.h"
+#include "sdi_sys_common.h"
+#include "std_mutex_lock.h"
+#include "std_thread_tools.h"
+#include "std_assert.h"
+
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+
+/* Maximum number of ready file descriptors handled per wakeup */
+#define SDI_MEDIA_PRESENCE_EVENT_MAX_READY      16
+
+/**
+ * Media registered for presence change notification
+ */
+typedef struct {
+    sdi_resource_hdl_t resource_hdl;
+    int event_fd; /* event file descriptor of the presence pins, -1 when polled */
+    bool presence; /* last presence read */
+    bool changed; /* presence change not collected yet */
+} sdi_media_presence_entry_t;
+
+/**
+ * Presence read of a media, collected by a scan of the monitor thread
+ */
+typedef struct {
+    sdi_resource_hdl_t resource_hdl;
+    bool presence; /* presence read */
+    bool read_ok; /* presence read succeeded */
+} sdi_media_presence_scan_t;
+
+/* Protects everything below */
+static std_mutex_lock_create_static_init_fast(sdi_media_presence_event_lock);
+
+static sdi_media_presence_entry_t *sdi_media_presence_entries = NULL;
+static uint_t sdi_media_presence_entry_count = 0;
+static uint_t sdi_media_presence_polled_count = 0;
+/* Scan buffer, used by the monitor thread only */
+static sdi_media_presence_scan_t *sdi_media_presence_scan = NULL;
+static uint_t sdi_media_presence_scan_max = 0;
+
+/* eventfd signalled when presence changes are pending */
+static int sdi_media_presence_event_fd = -1;
+/* eventfd waking the monitor thread when media are registered */
+static int sdi_media_presence_wake_fd = -1;
+static int sdi_media_presence_epoll_fd = -1;
+static std_thread_create_param_t sdi_media_presence_thread;
+
+/**
+ * Get operations and driver handle of a media
+ * resource_hdl[in] - handle of the media resource
+ * callback_hdl[out] - driver handle of the media
+ * return operations of the media
+ */
+static inline media_ctrl_t *sdi_media_presence_event_ops(sdi_resource_hdl_t resource_hdl,
+                                                         void **callback_hdl)
+{
+    sdi_resource_priv_hdl_t media_hdl = (sdi_resource_priv_hdl_t)resource_hdl;
+
+    *callback_hdl = media_hdl->callback_hdl;
+    return (media_ctrl_t *)media_hdl->callback_fns;
+}
+
+/**
+ * Current time in milliseconds
+ * return monotonic time
+ */
+static uint64_t sdi_media_presence_event_now_ms(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (((uint64_t)now.tv_sec * 1000) + (now.tv_nsec / 1000000));
+}
+
+/**
+ * Fall back to polling for every media sharing an event file descriptor which
+ * can not be cleared. Called with sdi_media_presence_event_lock held.
+ * fd[in] - event file descriptor
+ * return none
+ */
+static void sdi_media_presence_event_demote(int fd)
+{
+    uint_t index = 0;
+
+    epoll_ctl(sdi_media_presence_epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+    for (index = 0; index < sdi_media_presence_entry_count; index++) {
+        if (sdi_media_presence_entries[index].event_fd == fd) {
+            sdi_media_presence_entries[index].event_fd = -1;
+            sdi_media_presence_polled_count++;
+        }
+    }
+}
+
+/**
+ * Read presence of every media using an event file descriptor and record
+ * changes. Media are collected under the lock, presence is cleared and read
+ * without it, so event collection and registration don't wait on the bus.
+ * fd[in] - event file descriptor which is ready, -1 for polled media
+ * return none
+ */
+static void sdi_media_presence_event_scan(int fd)
+{
+    sdi_media_presence_scan_t *scan = NULL;
+    sdi_media_presence_entry_t *entry = NULL;
+    media_ctrl_t *ops = NULL;
+    void *callback_hdl = NULL;
+    uint_t scan_count = 0;
+    uint_t index = 0;
+    uint_t slot = 0;
+    bool demote = false;
+    bool signal = false;
+
+    std_mutex_lock(&sdi_media_presence_event_lock);
+    if (sdi_media_presence_scan_max < sdi_media_presence_entry_count) {
+        scan = (sdi_media_presence_scan_t *) realloc(sdi_media_presence_scan,
+                   sdi_media_presence_entry_count * sizeof(*scan));
+        if (scan == NULL) {
+            std_mutex_unlock(&sdi_media_presence_event_lock);
+            SDI_ERRMSG_LOG("Reading media presence failed, out of memory");
+            return;
+        }
+        sdi_media_presence_scan = scan;
+        sdi_media_presence_scan_max = sdi_media_presence_entry_count;
+    }
+    scan = sdi_media_presence_scan;
+    for (index = 0; index < sdi_media_presence_entry_count; index++) {
+        if (sdi_media_presence_entries[index].event_fd == fd) {
+            scan[scan_count].resource_hdl = sdi_media_presence_entries[index].resource_hdl;
+            scan[scan_count].read_ok = false;
+            scan_count++;
+        }
+    }
+    std_mutex_unlock(&sdi_media_presence_event_lock);
+
+    if (scan_count == 0) {
+        return;
+    }
+
+    /* Clear before reading, so a change after the read signals again.
+     * Media sharing the file descriptor are cleared at once */
+    if (fd >= 0) {
+        ops = sdi_media_presence_event_ops(scan[0].resource_hdl, &callback_hdl);
+        if (ops->presence_event_clear(callback_hdl) != STD_ERR_OK) {
+            SDI_ERRMSG_LOG("Clearing presence events of %s failed, polling presence",
+                           ((sdi_resource_priv_hdl_t)scan[0].resource_hdl)->name);
+            demote = true;
+        }
+    }
+
+    for (slot = 0; slot < scan_count; slot++) {
+        /* A presence event may be a fast swap which leaves presence unchanged,
+         * eeprom data cached for the previous module must not be served */
+        if (fd >= 0) {
+            ops = sdi_media_presence_event_ops(scan[slot].resource_hdl, &callback_hdl);
+            if (ops->module_cache_invalidate != NULL) {
+                ops->module_cache_invalidate(callback_hdl);
+            }
+        }
+        scan[slot].read_ok = (sdi_media_presence_get(scan[slot].resource_hdl,
+                                                     &(scan[slot].presence)) == STD_ERR_OK);
+    }
+
+    std_mutex_lock(&sdi_media_presence_event_lock);
+    if (demote) {
+        sdi_media_presence_event_demote(fd);
+    }
+    /* Entries may have moved while unlocked, match them by handle */
+    for (slot = 0; slot < scan_count; slot++) {
+        if (!scan[slot].read_ok) {
+            continue;
+        }
+        for (index = 0; index < sdi_media_presence_entry_count; index++) {
+            entry = &(sdi_media_presence_entries[index]);
+            if (entry->resource_hdl == scan[slot].resource_hdl) {
+                break;
+            }
+        }
+        if ((index < sdi_media_presence_entry_count)
+                && (scan[slot].presence != entry->presence)) {
+            entry->presence = scan[slot].presence;
+            entry->changed = true;
+            signal = true;
+        }
+    }
+    std_mutex_unlock(&sdi_media_presence_event_lock);
+
+    if (signal) {
+        eventfd_write(sdi_media_presence_event_fd, 1);
+    }
+}
+
+/**
+ * Monitor thread, reads presence when presence pins signal a change and
+ * periodically for media without event file descriptor
+ * param[in] - not used
+ * return none
+ */
+static void *sdi_media_presence_event_thread(void *param)
+{
+    struct epoll_event ready[SDI_MEDIA_PRESENCE_EVENT_MAX_READY];
+    uint64_t next_poll = 0;
+    uint64_t now = 0;
+    eventfd_t value = 0;
+    int timeout = -1;
+    int count = 0;
+    int index = 0;
+
+    next_poll = sdi_media_presence_event_now_ms() + SDI_MEDIA_PRESENCE_EVENT_POLL_INTERVAL_MS;
+    for (;;) {
+        timeout = -1;
+        std_mutex_lock(&sdi_media_presence_event_lock);
+        if (sdi_media_presence_polled_count > 0) {
+            now = sdi_media_presence_event_now_ms();
+            timeout = (next_poll > now) ? (int)(next_poll - now) : 0;
+        }
+        std_mutex_unlock(&sdi_media_presence_event_lock);
+
+        count = epoll_wait(sdi_media_presence_epoll_fd, ready,
+                           SDI_MEDIA_PRESENCE_EVENT_MAX_READY, timeout);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            SDI_ERRMSG_LOG("Media presence monitor stopped, epoll_wait error %d", errno);
+            return NULL;
+        }
+
+        for (index = 0; index < count; index++) {
+            if (ready[index].data.fd == sdi_media_presence_wake_fd) {
+                eventfd_read(sdi_media_presence_wake_fd, &value);
+            } else {
+                sdi_media_presence_event_scan(ready[index].data.fd);
+            }
+        }
+
+        now = sdi_media_presence_event_now_ms();
+        if (now >= next_poll) {
+            sdi_media_presence_event_scan(-1);
+            next_poll = now + SDI_MEDIA_PRESENCE_EVENT_POLL_INTERVAL_MS;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Create the eventfds, the epoll set and the monitor thread on first use.
+ * Called with sdi_media_presence_event_lock held.
+ * return t_std_error
+ */
+static t_std_error sdi_media_presence_event_init(void)
+{
+    struct epoll_event event;
+    t_std_error rc = STD_ERR_OK;
+
+    if (sdi_media_presence_epoll_fd >= 0) {
+        return STD_ERR_OK;
+    }
+
+    sdi_media_presence_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    sdi_media_presence_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    sdi_media_presence_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+    do {
+        if ((sdi_media_presence_event_fd < 0) || (sdi_media_presence_wake_fd < 0)
+                || (sdi_media_presence_epoll_fd < 0)) {
+            rc = SDI_ERRCODE(errno);
+            break;
+        }
+
+        event.events = EPOLLIN;
+        event.data.fd = sdi_media_presence_wake_fd;
+        if (epoll_ctl(sdi_media_presence_epoll_fd, EPOLL_CTL_ADD,
+                      sdi_media_presence_wake_fd, &event) < 0) {
+            rc = SDI_ERRCODE(errno);
+            break;
+        }
+
+        std_thread_init_struct(&sdi_media_presence_thread);
+        sdi_media_presence_thread.name = "sdi-media-presence";
+        sdi_media_presence_thread.thread_function =
+            (std_thread_function_t) sdi_media_presence_event_thread;
+        sdi_media_presence_thread.param = NULL;
+        rc = std_thread_create(&sdi_media_presence_thread);
+    } while (0);
+
+    if (rc != STD_ERR_OK) {
+        SDI_ERRMSG_LOG("Creating media presence monitor failed, error %d", rc);
+        if (sdi_media_presence_event_fd >= 0) {
+            close(sdi_media_presence_event_fd);
+        }
+        if (sdi_media_presence_wake_fd >= 0) {
+            close(sdi_media_presence_wake_fd);
+        }
+        if (sdi_media_presence_epoll_fd >= 0) {
+            close(sdi_media_presence_epoll_fd);
+        }
+        sdi_media_presence_event_fd = -1;
+        sdi_media_presence_wake_fd = -1;
+        sdi_media_presence_epoll_fd = -1;
+    }
+    return rc;
+}
+
+/**
+ * Register a media for presence change notification
+ * resource_hdl[in] - handle of the media resource
+ * fd[out]          - eventfd signalled when presence changes are pending
+ * return t_std_error
+ */
+t_std_error sdi_media_presence_event_register (sdi_resource_hdl_t resource_hdl, int *fd)
+{
+    sdi_media_presence_entry_t *entries = NULL;
+    sdi_media_presence_entry_t *entry = NULL;
+    struct epoll_event event;
+    media_ctrl_t *ops = NULL;
+    void *callback_hdl = NULL;
+    t_std_error rc = STD_ERR_OK;
+    uint_t index = 0;
+    int event_fd = -1;
+    bool presence = false;
+
+    STD_ASSERT(resource_hdl != NULL);
+    STD_ASSERT(fd != NULL);
+
+    if (((sdi_resource_priv_hdl_t)resource_hdl)->type != SDI_RESOURCE_MEDIA) {
+        return SDI_ERRCODE(EPERM);
+    }
+
+    /* Read without the lock, so the monitor doesn't wait on the bus. A change
+     * after the read is seen by the next scan: a pending event of the file
+     * descriptor is reported as soon as it joins the epoll set */
+    if (sdi_media_presence_get(resource_hdl, &presence) != STD_ERR_OK) {
+        presence = false;
+    }
+
+    std_mutex_lock(&sdi_media_presence_event_lock);
+    do {
+        rc = sdi_media_presence_event_init();
+        if (rc != STD_ERR_OK) {
+            break;
+        }
+        *fd = sdi_media_presence_event_fd;
+
+        for (index = 0; index < sdi_media_presence_entry_count; index++) {
+            if (sdi_media_presence_entries[index].resource_hdl == resource_hdl) {
+                break;
+            }
+        }
+        if (index < sdi_media_presence_entry_count) {
+            /* Already registered */
+            break;
+        }
+
+        entries = (sdi_media_presence_entry_t *) realloc(sdi_media_presence_entries,
+                      (sdi_media_presence_entry_count + 1) * sizeof(*entries));
+        if (entries == NULL) {
+            rc = SDI_ERRCODE(ENOMEM);
+            break;
+        }
+        sdi_media_presence_entries = entries;
+
+        ops = sdi_media_presence_event_ops(resource_hdl, &callback_hdl);
+        if ((ops->presence_event_fd_get != NULL)
+                && (ops->presence_event_fd_get(callback_hdl, &event_fd) == STD_ERR_OK)) {
+            event.events = EPOLLIN;
+            event.data.fd = event_fd;
+            /* Media on the same pin group share the file descriptor */
+            if ((epoll_ctl(sdi_media_presence_epoll_fd, EPOLL_CTL_ADD, event_fd, &event) < 0)
+                    && (errno != EEXIST)) {
+                event_fd = -1;
+            }
+        } else {
+            event_fd = -1;
+        }
+
+        entry = &(sdi_media_presence_entries[sdi_media_presence_entry_count]);
+        entry->resource_hdl = resource_hdl;
+        entry->event_fd = event_fd;
+        entry->changed = false;
+        entry->presence = presence;
+        sdi_media_presence_entry_count++;
+        if (event_fd < 0) {
+            sdi_media_presence_polled_count++;
+        }
+    } while (0);
+    std_mutex_unlock(&sdi_media_presence_event_lock);
+
+    if (rc == STD_ERR_OK) {
+        /* Let the monitor pick up the new media */
+        eventfd_write(sdi_media_presence_wake_fd, 1);
+    }
+    return rc;
+}
+
+/**
+ * Collect pending presence changes
+ * events[out]   - filled with pending presence changes
+ * max_count[in] - number of entries in events
+ * count[out]    - number of entries filled
+ * return t_std_error
+ */
+t_std_error sdi_media_presence_event_get (sdi_media_presence_event_t *events,
+                                          uint_t max_count, uint_t *count)
+{
+    sdi_media_presence_entry_t *entry = NULL;
+    eventfd_t value = 0;
+    uint_t index = 0;
+    bool pending = false;
+
+    STD_ASSERT(count != NULL);
+    STD_ASSERT((events != NULL) || (max_count == 0));
+
+    *count = 0;
+
+    std_mutex_lock(&sdi_media_presence_event_lock);
+    if (sdi_media_presence_event_fd >= 0) {
+        eventfd_read(sdi_media_presence_event_fd, &value);
+    }
+    for (index = 0; index < sdi_media_presence_entry_count; index++) {
+        entry = &(sdi_media_presence_entries[index]);
+        if (!entry->changed) {
+            continue;
+        }
+        if (*count == max_count) {
+            pending = true;
+            break;
+        }
+        events[*count].resource_hdl = entry->resource_hdl;
+        events[*count].presence = entry->presence;
+        entry->changed = false;
+        (*count)++;
+    }
+    if (pending) {
+        eventfd_write(sdi_media_presence_event_fd, 1);
+    }
+    std_mutex_unlock(&sdi_media_presence_event_lock);
+
+    return STD_ERR_OK;
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2019 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_media_state.c
+ */
+
+
+/*******************************************************************************
+ * Presence, reset and low power mode state of many media, reading every pin
+ * group carrying these signals once.
+ ******************************************************************************/
+
+#include "sdi_media.h"
+#include "sdi_media_internal.h"
+#include "sdi_resource_internal.h"
+#include "sdi_pin_group_bus_api.h"
+#include "sdi_sys_common.h"
+#include "std_assert.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Initial number of entries of the pin group levels of a batch
+ */
+#define SDI_MEDIA_PIN_LEVELS_INIT_SIZE    8
+
+/**
+ * Get the level of a pin group, reading it only on first use in a batch.
+ * A pin group read for the first time is refreshed first, so pin groups backed
+ * by a device register shadow reflect the current levels. The device is
+ * refreshed once per batch, pin groups sharing it are served by that refresh.
+ * levels[in] - pin group levels of the batch
+ * hdl[in]    - pin group handle
+ * value[out] - level of the pin group
+ * return t_std_error
+ */
+t_std_error sdi_media_pin_group_level_get(sdi_media_pin_levels_t *levels,
+                                          sdi_pin_group_bus_hdl_t hdl, uint_t *value)
+{
+    sdi_media_pin_level_t *level = NULL;
+    t_std_error rc = STD_ERR_OK;
+    uint_t index = 0;
+    bool refreshed = false;
+
+    STD_ASSERT(levels != NULL);
+    STD_ASSERT(value != NULL);
+
+    for (index = 0; index < levels->count; index++) {
+        if (levels->levels[index].hdl == hdl) {
+            *value = levels->levels[index].level;
+            return levels->levels[index].rc;
+        }
+    }
+
+    if (levels->count == levels->size) {
+        uint_t size = (levels->size == 0) ? SDI_MEDIA_PIN_LEVELS_INIT_SIZE
+                                          : (levels->size * 2);
+
+        level = (sdi_media_pin_level_t *) realloc(levels->levels, size * sizeof(*level));
+        if (level == NULL) {
+            return SDI_ERRCODE(ENOMEM);
+        }
+        levels->levels = level;
+        levels->size = size;
+    }
+
+    level = &(levels->levels[levels->count]);
+    level->hdl = hdl;
+    level->device = sdi_pin_group_refresh_device(hdl);
+    level->level = 0;
+
+    for (index = 0; (index < levels->count) && (level->device != NULL); index++) {
+        if ((levels->levels[index].device == level->device)
+                && (levels->levels[index].rc == STD_ERR_OK)) {
+            /* Device already refreshed in this batch */
+            refreshed = true;
+            break;
+        }
+    }
+
+    rc = sdi_pin_group_acquire_bus(hdl);
+    if (rc == STD_ERR_OK) {
+        if (!refreshed) {
+            rc = sdi_pin_group_refresh(hdl);
+        }
+        if ((rc == STD_ERR_OK) || (STD_ERR_EXT_PRIV(rc) == ENOTSUP)) {
+            rc = sdi_pin_group_read_level(hdl, &(level->level));
+        }
+        sdi_pin_group_release_bus(hdl);
+    }
+    level->rc = rc;
+    levels->count++;
+
+    *value = level->level;
+    return rc;
+}
+
+/**
+ * Get state of one media through presence_get and module_control_status_get,
+ * for media which don't provide state_get
+ * media_hdl[in] - Handle of the resource
+ * flags[in]     - SDI_MEDIA_STATE_* bits of interest
+ * state[out]    - SDI_MEDIA_STATE_* bits of the media
+ * return t_std_error
+ */
+static t_std_error sdi_media_state_get_fallback(sdi_resource_hdl_t media_hdl,
+                                                uint_t flags, uint_t *state)
+{
+    t_std_error rc = STD_ERR_OK;
+    bool status = false;
+
+    *state = 0;
+
+    rc = sdi_media_presence_get(media_hdl, &status);
+    if (rc != STD_ERR_OK) {
+        return rc;
+    }
+    if (status) {
+        *state |= SDI_MEDIA_STATE_PRESENT;
+    }
+
+    if ((flags & SDI_MEDIA_STATE_RESET) != 0) {
+        status = false;
+        rc = sdi_media_module_control_status_get(media_hdl, SDI_MEDIA_RESET, &status);
+        if ((rc != STD_ERR_OK) && (STD_ERR_EXT_PRIV(rc) != EOPNOTSUPP)) {
+            return rc;
+        }
+        if ((rc == STD_ERR_OK) && status) {
+            *state |= SDI_MEDIA_STATE_RESET;
+        }
+    }
+
+    if ((flags & SDI_MEDIA_STATE_LPMODE) != 0) {
+        status = false;
+        rc = sdi_media_module_control_status_get(media_hdl, SDI_MEDIA_LP_MODE, &status);
+        if ((rc != STD_ERR_OK) && (STD_ERR_EXT_PRIV(rc) != EOPNOTSUPP)) {
+            return rc;
+        }
+        if ((rc == STD_ERR_OK) && status) {
+            *state |= SDI_MEDIA_STATE_LPMODE;
+        }
+    }
+
+    return STD_ERR_OK;
+}
+
+/**
+ * Set bit index of a bitmap, when the bitmap is requested
+ * bitmap[in] - bitmap or NULL
+ * index[in]  - bit number
+ * return none
+ */
+static inline void sdi_media_bitmap_set(uint8_t *bitmap, uint_t index)
+{
+    if (bitmap != NULL) {
+        bitmap[index / 8] |= (uint8_t) (1 << (index % 8));
+    }
+}
+
+/**
+ * Get presence, and optionally reset and low power mode state, of a set of
+ * media
+ * resource_hdl[in] - handles of the media resources
+ * count[in]        - number of entries in resource_hdl
+ * bitmap[out]      - bitmaps to fill
+ * return t_std_error
+ */
+t_std_error sdi_media_presence_bitmap_get (sdi_resource_hdl_t *resource_hdl, uint_t count,
+                                           sdi_media_state_bitmap_t *bitmap)
+{
+    sdi_media_pin_levels_t levels = { 0 };
+    sdi_resource_priv_hdl_t media_hdl = NULL;
+    media_ctrl_t *media_ops = NULL;
+    t_std_error rc = STD_ERR_OK;
+    t_std_error media_rc = STD_ERR_OK;
+    uint_t flags = SDI_MEDIA_STATE_PRESENT;
+    uint_t state = 0;
+    uint_t index = 0;
+    size_t size = SDI_MEDIA_BITMAP_BYTES(count);
+
+    STD_ASSERT(resource_hdl != NULL);
+    STD_ASSERT(bitmap != NULL);
+    STD_ASSERT(bitmap->presence != NULL);
+
+    memset(bitmap->presence, 0, size);
+    if (bitmap->reset != NULL) {
+        memset(bitmap->reset, 0, size);
+        flags |= SDI_MEDIA_STATE_RESET;
+    }
+    if (bitmap->lpmode != NULL) {
+        memset(bitmap->lpmode, 0, size);
+        flags |= SDI_MEDIA_STATE_LPMODE;
+    }
+    if (bitmap->failed != NULL) {
+        memset(bitmap->failed, 0, size);
+    }
+
+    for (index = 0; index < count; index++) {
+        STD_ASSERT(resource_hdl[index] != NULL);
+
+        media_hdl = (sdi_resource_priv_hdl_t)resource_hdl[index];
+        if (media_hdl->type != SDI_RESOURCE_MEDIA) {
+            media_rc = SDI_ERRCODE(EPERM);
+        } else {
+            media_ops = (media_ctrl_t *)media_hdl->callback_fns;
+            if (media_ops->state_get != NULL) {
+                media_rc = media_ops->state_get(media_hdl->callback_hdl, &levels, flags, &state);
+            } else {
+                media_rc = sdi_media_state_get_fallback(resource_hdl[index], flags, &state);
+            }
+        }
+
+        if (media_rc != STD_ERR_OK) {
+            SDI_ERRMSG_LOG("Failed to get the media state for %s error code : %d(0x%x)",
+                           media_hdl->name, media_rc, media_rc);
+            sdi_media_bitmap_set(bitmap->failed, index);
+            rc = media_rc;
+            continue;
+        }
+
+        if ((state & SDI_MEDIA_STATE_PRESENT) != 0) {
+            sdi_media_bitmap_set(bitmap->presence, index);
+        }
+        if ((state & SDI_MEDIA_STATE_RESET) != 0) {
+            sdi_media_bitmap_set(bitmap->reset, index);
+        }
+        if ((state & SDI_MEDIA_STATE_LPMODE) != 0) {
+            sdi_media_bitmap_set(bitmap->lpmode, index);
+        }
+    }
+
+    free(levels.levels);
+    return rc;
+}
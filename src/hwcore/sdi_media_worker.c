@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2019 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN  *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ *  LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sdi_media_worker.c
+ */
+
+
+/*******************************************************************************
+ * Per i2c adapter workers executing media work queued by media APIs.
+ ******************************************************************************/
+
+#include "sdi_media_worker.h"
+#include "sdi_resource_internal.h"
+#include "sdi_driver_internal.h"
+#include "sdi_i2c_bus_api.h"
+#include "sdi_sys_common.h"
+#include "std_mutex_lock.h"
+#include "std_condition_variable.h"
+#include "std_thread_tools.h"
+#include "std_assert.h"
+
+#include <stdlib.h>
+
+/**
+ * Worker of a root i2c bus
+ */
+typedef struct sdi_media_worker {
+    std_dll node; /* node in worker list, must be first */
+    sdi_i2c_bus_hdl_t root_bus; /* root i2c bus served by this worker */
+    std_mutex_type_t lock; /* lock for the work queue */
+    std_condition_var_t cond; /* signalled when work is queued */
+    std_dll_head queue; /* queued work */
+    std_thread_create_param_t thread; /* worker thread */
+} sdi_media_worker_t;
+
+static std_mutex_lock_create_static_init_fast(sdi_media_worker_list_lock);
+static std_dll_head sdi_media_worker_list;
+static bool sdi_media_worker_list_init = false;
+/* true on media worker threads */
+static __thread bool sdi_media_worker_self = false;
+
+/**
+ * Worker thread, executes queued work in order
+ * param[in] param - worker
+ * return none
+ */
+static void *sdi_media_worker_thread(void *param)
+{
+    sdi_media_worker_t *worker = (sdi_media_worker_t *) param;
+    sdi_media_work_t *work = NULL;
+
+    sdi_media_worker_self = true;
+    while (true) {
+        std_mutex_lock(&(worker->lock));
+        while ((work = (sdi_media_work_t *) std_dll_getfirst(&(worker->queue))) == NULL) {
+            std_condition_var_wait(&(worker->cond), &(worker->lock));
+        }
+        std_dll_remove(&(worker->queue), &(work->node));
+        std_mutex_unlock(&(worker->lock));
+
+        work->fn(work->arg);
+    }
+    return NULL;
+}
+
+/**
+ * Get the worker of a root i2c bus, create it if it doesn't exist.
+ * Should be called with worker list lock held.
+ * param[in] root_bus - root i2c bus
+ * return worker, NULL if it couldn't be created
+ */
+static sdi_media_worker_t *sdi_media_worker_get(sdi_i2c_bus_hdl_t root_bus)
+{
+    sdi_media_worker_t *worker = NULL;
+
+    if (!sdi_media_worker_list_init) {
+        std_dll_init(&sdi_media_worker_list);
+        sdi_media_worker_list_init = true;
+    }
+
+    for (worker = (sdi_media_worker_t *) std_dll_getfirst(&sdi_media_worker_list);
+            worker != NULL;
+            worker = (sdi_media_worker_t *) std_dll_getnext(&sdi_media_worker_list,
+                                                           &(worker->node))) {
+        if (worker->root_bus == root_bus) {
+            return worker;
+        }
+    }
+
+    worker = (sdi_media_worker_t *) calloc(1, sizeof(sdi_media_worker_t));
+    if (worker == NULL) {
+        return NULL;
+    }
+
+    worker->root_bus = root_bus;
+    std_dll_init(&(worker->queue));
+    if ((std_mutex_lock_init_non_recursive(&(worker->lock)) != STD_ERR_OK)
+            || (std_condition_var_init(&(worker->cond)) != STD_ERR_OK)) {
+        free(worker);
+        return NULL;
+    }
+
+    std_thread_init_struct(&(worker->thread));
+    worker->thread.name = "sdi-media-worker";
+    worker->thread.thread_function = (std_thread_function_t) sdi_media_worker_thread;
+    worker->thread.param = worker;
+    if (std_thread_create(&(worker->thread)) != STD_ERR_OK) {
+        SDI_ERRMSG_LOG("Creating media worker for i2c bus %s failed",
+                       root_bus->bus.bus_name);
+        std_condition_var_destroy(&(worker->cond));
+        std_mutex_destroy(&(worker->lock));
+        free(worker);
+        return NULL;
+    }
+
+    std_dll_insertatback(&sdi_media_worker_list, &(worker->node));
+    return worker;
+}
+
+/**
+ * Queue work on the worker of the root i2c bus of a media.
+ * resource_hdl[in] - handle of the media resource
+ * work[in]         - work to execute
+ * return STD_ERR_OK when queued, error when caller has to execute the work
+ */
+t_std_error sdi_media_work_queue(sdi_resource_hdl_t resource_hdl,
+                                 sdi_media_work_t *work)
+{
+    sdi_resource_priv_hdl_t media_hdl = (sdi_resource_priv_hdl_t) resource_hdl;
+    sdi_device_hdl_t dev_hdl = NULL;
+    sdi_bus_hdl_t bus_hdl = NULL;
+    sdi_media_worker_t *worker = NULL;
+
+    STD_ASSERT(resource_hdl != NULL);
+    STD_ASSERT(work != NULL);
+
+    if (media_hdl->type != SDI_RESOURCE_MEDIA) {
+        return SDI_ERRCODE(EPERM);
+    }
+
+    dev_hdl = (sdi_device_hdl_t) media_hdl->callback_hdl;
+    bus_hdl = (dev_hdl != NULL) ? (sdi_bus_hdl_t) dev_hdl->bus_hdl : NULL;
+    if ((bus_hdl == NULL) || (bus_hdl->bus_type != SDI_I2C_BUS)) {
+        return SDI_ERRCODE(EOPNOTSUPP);
+    }
+
+    std_mutex_lock(&sdi_media_worker_list_lock);
+    worker = sdi_media_worker_get(sdi_i2c_bus_root_get((sdi_i2c_bus_hdl_t) bus_hdl));
+    std_mutex_unlock(&sdi_media_worker_list_lock);
+
+    if (worker == NULL) {
+        return SDI_ERRCODE(ENOMEM);
+    }
+
+    std_mutex_lock(&(worker->lock));
+    std_dll_insertatback(&(worker->queue), &(work->node));
+    std_condition_var_signal(&(worker->cond));
+    std_mutex_unlock(&(worker->lock));
+
+    return STD_ERR_OK;
+}
+
+/**
+ * Check whether the caller runs on a media worker thread
+ * return true on a media worker thread
+ */
+bool sdi_media_work_on_worker(void)
+{
+    return sdi_media_worker_self;
+}
@@ -27,6 +27,8 @@ t_std_error sdi_nvram_size(
         return (SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(resource_hdl);
+
     sdi_resource_priv_hdl_t nvram_hdl = (sdi_resource_priv_hdl_t) resource_hdl;
     t_std_error rc = (*((nvram_t *) nvram_hdl->callback_fns)->size)(nvram_hdl->callback_hdl, size);
     if (rc != STD_ERR_OK) {
@@ -47,6 +49,8 @@ t_std_error sdi_nvram_read(
         return (SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(resource_hdl);
+
     sdi_resource_priv_hdl_t nvram_hdl = (sdi_resource_priv_hdl_t) resource_hdl;
     t_std_error rc = (*((nvram_t *) nvram_hdl->callback_fns)->read)(nvram_hdl->callback_hdl, buf, ofs, len);
     if (rc != STD_ERR_OK) {
@@ -67,6 +71,8 @@ t_std_error sdi_nvram_write(
         return (SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(resource_hdl);
+
     sdi_resource_priv_hdl_t nvram_hdl = (sdi_resource_priv_hdl_t) resource_hdl;
     t_std_error rc = (*((nvram_t *) nvram_hdl->callback_fns)->write)(nvram_hdl->callback_hdl, buf, ofs, len);
     if (rc != STD_ERR_OK) {
@@ -47,6 +47,8 @@ t_std_error sdi_power_monitor_current_amp_get(sdi_resource_hdl_t monitor_hdl, fl
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(monitor_hdl);
+
     rc = ((power_monitor_t *)power_monitor_hdl->callback_fns)->
         current_amp_get(power_monitor_hdl->callback_hdl, current_amp);
     if(rc != STD_ERR_OK)
@@ -76,6 +78,8 @@ t_std_error sdi_power_monitor_voltage_volt_get(sdi_resource_hdl_t monitor_hdl, f
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(monitor_hdl);
+
     rc = ((power_monitor_t *)power_monitor_hdl->callback_fns)->
         voltage_volt_get(power_monitor_hdl->callback_hdl, voltage_volt);
     if(rc != STD_ERR_OK)
@@ -105,6 +109,8 @@ t_std_error sdi_power_monitor_power_watt_get(sdi_resource_hdl_t monitor_hdl, flo
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(monitor_hdl);
+
     rc = ((power_monitor_t *)power_monitor_hdl->callback_fns)->
                     power_watt_get(power_monitor_hdl->callback_hdl, power_watt);
     if(rc != STD_ERR_OK)
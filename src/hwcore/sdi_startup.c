@@ -28,6 +28,19 @@
 #include "sdi_sys_common.h"
 #include "private/sdi_entity_internal.h"
 #include "std_bit_ops.h"
+#include "std_mutex_lock.h"
+#include "std_condition_variable.h"
+#include "std_thread_tools.h"
+#include "std_assert.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Maximum number of threads initialising entities at startup
+ */
+#define SDI_SYS_ENTITY_INIT_WORKERS     4
 
 /**
  * @var sdi_init_status used to get the sdi initialization status
@@ -35,30 +48,270 @@
 static bool sdi_init_status = false;
 
 /**
- * Initialize the specified entity.
- * Upon Initialization, default configurations as specified for platform would
- * be applied
- * param[in] hdl - handle to the entity whose information has to be initialised.
- * param[out] init_status - entity initialization status.
+ * Initialisation of one entity at startup
+ */
+typedef struct sdi_sys_entity_job {
+    sdi_entity_hdl_t hdl; /* entity to initialise */
+    struct sdi_sys_entity_job **deps; /* jobs to be done before this one */
+    uint_t dep_count; /* number of entries of deps */
+    bool started;
+    bool done;
+    t_std_error rc;
+    uint64_t time_ms; /* time taken by sdi_entity_init */
+} sdi_sys_entity_job_t;
+
+/**
+ * Initialisation of all fixed entities at startup, shared by the workers
+ */
+typedef struct {
+    std_mutex_type_t lock;
+    std_condition_var_t cond; /* broadcast when a job is done */
+    sdi_sys_entity_job_t *jobs; /* in entity list order */
+    uint_t count; /* number of entries of jobs */
+    uint_t running; /* jobs started and not done */
+} sdi_sys_entity_init_t;
+
+/**
+ * Current time in milliseconds
+ * return monotonic time
+ */
+static uint64_t sdi_sys_now_ms(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (((uint64_t)now.tv_sec * 1000) + (now.tv_nsec / 1000000));
+}
+
+/**
+ * Add the fixed entities to the startup jobs. User(like PAS) will initialize
+ * Hot-Swappable entities.
+ * param[in] hdl - handle to the entity
+ * param[in] init - startup initialisation
  * return None
  */
-static void sdi_sys_entity_init(sdi_entity_hdl_t hdl, void *init_status)
+static void sdi_sys_entity_job_add(sdi_entity_hdl_t hdl, void *init)
 {
-    t_std_error ret = STD_ERR_OK;
+    sdi_sys_entity_init_t *entity_init = (sdi_sys_entity_init_t *)init;
 
-   /* Initialize fixed entities.User(like PAS) will initialize Hot-Swappable entities*/
     if (STD_BIT_TEST((((sdi_entity_priv_hdl_t)hdl)->oper_support_flag),
                         SDI_HOTSWAPPABLE) == 0) {
-        ret = sdi_entity_init(hdl);
-        /* Find the initial failure, it could be the reason for the subsequent
-         * component or entity failures */
-        if ((init_status != NULL) && (ret != STD_ERR_OK) &&
-                            (*((t_std_error *)init_status) == STD_ERR_OK)) {
-            *((t_std_error *)init_status) = ret;
+        entity_init->jobs[entity_init->count++].hdl = hdl;
+    }
+}
+
+/**
+ * Count the entities
+ * param[in] hdl - handle to the entity
+ * param[in] count - number of entities
+ * return None
+ */
+static void sdi_sys_entity_count(sdi_entity_hdl_t hdl, void *count)
+{
+    (*((uint_t *)count))++;
+}
+
+/**
+ * Resolve the init_after names of an entity into jobs. Entities which are not
+ * initialised at startup are not waited for.
+ * param[in] entity_init - startup initialisation
+ * param[in] job - job whose dependencies are resolved
+ * return None
+ */
+static void sdi_sys_entity_deps_resolve(sdi_sys_entity_init_t *entity_init,
+                                        sdi_sys_entity_job_t *job)
+{
+    sdi_entity_priv_hdl_t entity_hdl = (sdi_entity_priv_hdl_t)job->hdl;
+    char *names = NULL;
+    char *name = NULL;
+    char *save = NULL;
+    uint_t index = 0;
+
+    if (entity_hdl->init_after == NULL) {
+        return;
+    }
+
+    job->deps = (sdi_sys_entity_job_t **)calloc(entity_init->count, sizeof(*job->deps));
+    names = strdup(entity_hdl->init_after);
+    STD_ASSERT((job->deps != NULL) && (names != NULL));
+
+    for (name = strtok_r(names, ", ", &save); name != NULL;
+         name = strtok_r(NULL, ", ", &save)) {
+        for (index = 0; index < entity_init->count; index++) {
+            if ((&entity_init->jobs[index] != job)
+                && (strncmp(((sdi_entity_priv_hdl_t)entity_init->jobs[index].hdl)->name,
+                            name, SDI_MAX_NAME_LEN) == 0)) {
+                job->deps[job->dep_count++] = &entity_init->jobs[index];
+                break;
+            }
+        }
+    }
+    free(names);
+}
+
+/**
+ * Check whether every dependency of a job is done
+ * param[in] job - startup job
+ * return true if the job can be started
+ */
+static bool sdi_sys_entity_job_ready(const sdi_sys_entity_job_t *job)
+{
+    uint_t index = 0;
+
+    for (index = 0; index < job->dep_count; index++) {
+        if (!job->deps[index]->done) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Startup worker, initialises entities whose dependencies are done till
+ * every entity is started
+ * param[in] param - startup initialisation
+ * return None
+ */
+static void *sdi_sys_entity_init_worker(void *param)
+{
+    sdi_sys_entity_init_t *entity_init = (sdi_sys_entity_init_t *)param;
+    sdi_sys_entity_job_t *job = NULL;
+    uint64_t start = 0;
+    uint_t index = 0;
+    bool pending = false;
+
+    std_mutex_lock(&entity_init->lock);
+    while (true) {
+        job = NULL;
+        pending = false;
+        for (index = 0; index < entity_init->count; index++) {
+            if (entity_init->jobs[index].started) {
+                continue;
+            }
+            pending = true;
+            if (sdi_sys_entity_job_ready(&entity_init->jobs[index])) {
+                job = &entity_init->jobs[index];
+                break;
+            }
+        }
+
+        if (!pending) {
+            break;
+        }
+
+        if (job == NULL) {
+            if (entity_init->running != 0) {
+                std_condition_var_wait(&entity_init->cond, &entity_init->lock);
+                continue;
+            }
+            /* Nothing running and nothing ready: init_after has a cycle */
+            for (index = 0; job == NULL; index++) {
+                if (!entity_init->jobs[index].started) {
+                    job = &entity_init->jobs[index];
+                }
+            }
+            SDI_ERRMSG_LOG("Entity(%s) init_after dependencies can't be met, initialising it",
+                           ((sdi_entity_priv_hdl_t)job->hdl)->name);
+        }
+
+        job->started = true;
+        entity_init->running++;
+        std_mutex_unlock(&entity_init->lock);
+
+        start = sdi_sys_now_ms();
+        job->rc = sdi_entity_init(job->hdl);
+        job->time_ms = sdi_sys_now_ms() - start;
+
+        std_mutex_lock(&entity_init->lock);
+        job->done = true;
+        entity_init->running--;
+        std_condition_var_broadcast(&entity_init->cond);
+    }
+    std_mutex_unlock(&entity_init->lock);
+
+    return NULL;
+}
+
+/**
+ * Initialize the fixed entities on a pool of workers. Entities are
+ * initialised concurrently, each one after the entities named by its
+ * init_after attribute. Entities sharing a bus serialize on the bus lock,
+ * those on independent buses proceed in parallel.
+ * return STD_ERR_OK on success, otherwise error of the first entity, in entity
+ * list order, which failed
+ */
+static t_std_error sdi_sys_entities_init(void)
+{
+    sdi_sys_entity_init_t entity_init;
+    std_thread_create_param_t workers[SDI_SYS_ENTITY_INIT_WORKERS];
+    t_std_error rc = STD_ERR_OK;
+    uint_t worker_count = 0;
+    uint_t entity_count = 0;
+    uint_t index = 0;
+    uint64_t start = sdi_sys_now_ms();
+
+    memset(&entity_init, 0, sizeof(entity_init));
+    sdi_entity_for_each(&sdi_sys_entity_count, &entity_count);
+    if (entity_count == 0) {
+        return STD_ERR_OK;
+    }
+
+    entity_init.jobs = (sdi_sys_entity_job_t *)calloc(entity_count, sizeof(*entity_init.jobs));
+    STD_ASSERT(entity_init.jobs != NULL);
+    sdi_entity_for_each(&sdi_sys_entity_job_add, &entity_init);
+    for (index = 0; index < entity_init.count; index++) {
+        sdi_sys_entity_deps_resolve(&entity_init, &entity_init.jobs[index]);
+    }
+
+    std_mutex_lock_init_non_recursive(&entity_init.lock);
+    std_condition_var_init(&entity_init.cond);
+
+    /* Calling thread works too, additional workers only when there are more
+     * entities */
+    for (index = 0; (index < (SDI_SYS_ENTITY_INIT_WORKERS - 1))
+                    && ((index + 1) < entity_init.count); index++) {
+        std_thread_init_struct(&workers[worker_count]);
+        workers[worker_count].name = "sdi-entity-init";
+        workers[worker_count].thread_function =
+            (std_thread_function_t) sdi_sys_entity_init_worker;
+        workers[worker_count].param = &entity_init;
+        if (std_thread_create(&workers[worker_count]) != STD_ERR_OK) {
+            std_thread_destroy_struct(&workers[worker_count]);
+            break;
+        }
+        worker_count++;
+    }
+
+    sdi_sys_entity_init_worker(&entity_init);
+    for (index = 0; index < worker_count; index++) {
+        std_thread_join(&workers[index]);
+        std_thread_destroy_struct(&workers[index]);
+    }
+
+    /* Find the initial failure, it could be the reason for the subsequent
+     * component or entity failures */
+    for (index = 0; index < entity_init.count; index++) {
+        sdi_sys_entity_job_t *job = &entity_init.jobs[index];
+
+        SDI_INFOMSG_LOG("Entity(%s) init took %llu ms, rc=%d\n",
+                        ((sdi_entity_priv_hdl_t)job->hdl)->name,
+                        (unsigned long long)job->time_ms, job->rc);
+        if ((job->rc != STD_ERR_OK) && (rc == STD_ERR_OK)) {
+            rc = job->rc;
             SDI_ERRMSG_LOG("Entity(%s) Init failed.rc=%d \n",
-                          ((sdi_entity_priv_hdl_t)hdl)->name, ret);
+                          ((sdi_entity_priv_hdl_t)job->hdl)->name, rc);
         }
+        free(job->deps);
     }
+    SDI_INFOMSG_LOG("%u entities initialised in %llu ms by %u threads\n",
+                    entity_init.count, (unsigned long long)(sdi_sys_now_ms() - start),
+                    worker_count + 1);
+
+    std_condition_var_destroy(&entity_init.cond);
+    std_mutex_destroy(&entity_init.lock);
+    free(entity_init.jobs);
+
+    return rc;
 }
 
 /**
@@ -76,7 +329,7 @@ t_std_error sdi_sys_init(void)
     sdi_register_drivers(SDI_DEVICE_CONFIG_FILE);
     sdi_register_entities(SDI_ENTITY_CONFIG_FILE);
     /* Initialise each entities */
-    sdi_entity_for_each(&sdi_sys_entity_init, &rc);
+    rc = sdi_sys_entities_init();
     if (rc != STD_ERR_OK) {
         SDI_ERRMSG_LOG("Atleast one Entity failed in the init."
                        "Check the SDI log for detail.rc=%d \n", rc);
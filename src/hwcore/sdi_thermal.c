@@ -47,6 +47,8 @@ t_std_error sdi_temperature_get(sdi_resource_hdl_t sensor_hdl, int *temp)
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(sensor_hdl);
+
     rc = ((temperature_sensor_t *)temp_sensor_hdl->callback_fns)->
         temperature_get(temp_sensor_hdl->callback_hdl,temp);
     if(rc != STD_ERR_OK)
@@ -76,6 +78,8 @@ t_std_error sdi_temperature_threshold_get(sdi_resource_hdl_t sensor_hdl,
     {
         return(SDI_ERRCODE(EPERM));
     }
+
+    sdi_resource_init_ensure(sensor_hdl);
     rc = ((temperature_sensor_t *)temp_sensor_hdl->callback_fns)->
         threshold_get(temp_sensor_hdl->callback_hdl,threshold_type,val);
     if(rc != STD_ERR_OK)
@@ -106,6 +110,8 @@ t_std_error sdi_temperature_threshold_set(sdi_resource_hdl_t sensor_hdl,
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(sensor_hdl);
+
     rc = ((temperature_sensor_t *)temp_sensor_hdl->callback_fns)->
         threshold_set(temp_sensor_hdl->callback_hdl,threshold_type,val);
     if(rc != STD_ERR_OK)
@@ -135,6 +141,8 @@ t_std_error sdi_temperature_status_get(sdi_resource_hdl_t sensor_hdl, bool *aler
         return(SDI_ERRCODE(EPERM));
     }
 
+    sdi_resource_init_ensure(sensor_hdl);
+
     rc = ((temperature_sensor_t *)temp_sensor_hdl->callback_fns)->
         status_get(temp_sensor_hdl->callback_hdl,alert_on);
     if(rc != STD_ERR_OK)
@@ -23,6 +23,15 @@
 #include "sdi_entity.h"
 #include "sdi_media.h"
 #include "sdi_db.h"
+#include "sdi_sys_common.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
 
 /*
  * Get the media presence status
@@ -402,6 +411,41 @@ t_std_error sdi_media_channel_monitor_get(sdi_resource_hdl_t resource_hdl, uint_
                                                    monitor_field, value);
 }
 
+/*
+ * Read all module and channel monitors of the specified media
+ */
+t_std_error sdi_media_dom_snapshot_get(sdi_resource_hdl_t resource_hdl, uint_t channel_count,
+                                       sdi_media_dom_snapshot_t *snapshot)
+{
+    uint_t channel = 0;
+
+    STD_ASSERT(snapshot != NULL);
+
+    if (channel_count > SDI_MEDIA_DOM_MAX_CHANNELS) {
+        channel_count = SDI_MEDIA_DOM_MAX_CHANNELS;
+    }
+    memset(snapshot, 0, sizeof(*snapshot));
+    snapshot->channel_count = channel_count;
+
+    snapshot->module_monitor_valid =
+        ((sdi_media_module_monitor_get(resource_hdl, SDI_MEDIA_TEMP,
+                                       &snapshot->temperature) == STD_ERR_OK)
+         && (sdi_media_module_monitor_get(resource_hdl, SDI_MEDIA_VOLT,
+                                          &snapshot->voltage) == STD_ERR_OK));
+    snapshot->rx_power_valid = (channel_count != 0);
+    snapshot->tx_bias_valid = (channel_count != 0);
+    snapshot->tx_power_valid = (channel_count != 0);
+    for (channel = 0; channel < channel_count; channel++) {
+        snapshot->rx_power_valid &= (sdi_media_channel_monitor_get(resource_hdl, channel,
+                SDI_MEDIA_INTERNAL_RX_POWER_MONITOR, &snapshot->rx_power[channel]) == STD_ERR_OK);
+        snapshot->tx_bias_valid &= (sdi_media_channel_monitor_get(resource_hdl, channel,
+                SDI_MEDIA_INTERNAL_TX_BIAS_CURRENT, &snapshot->tx_bias[channel]) == STD_ERR_OK);
+        snapshot->tx_power_valid &= (sdi_media_channel_monitor_get(resource_hdl, channel,
+                SDI_MEDIA_INTERNAL_TX_OUTPUT_POWER, &snapshot->tx_power[channel]) == STD_ERR_OK);
+    }
+    return STD_ERR_OK;
+}
+
 /* The read and write API are not implemented for the VM but are simply stub
  * functions to prevent failure at link time. These APIs are used by
  * serviceability, but only on the real hardware.
@@ -526,3 +570,361 @@ t_std_error sdi_media_qsa_adapter_type_get (sdi_resource_hdl_t resource_hdl, sdi
     return STD_ERR_OK;
 }
 
+
+/*
+ * Collect presence and DOM data of a set of media in one sweep
+ */
+t_std_error sdi_media_poll (sdi_media_poll_t *media, uint_t count)
+{
+    uint_t index = 0;
+    uint_t channel = 0;
+
+    STD_ASSERT(media != NULL);
+
+    for (index = 0; index < count; index++) {
+        media[index].temperature = 0;
+        media[index].voltage = 0;
+        for (channel = 0; channel < SDI_MEDIA_POLL_MAX_CHANNELS; channel++) {
+            media[index].rx_power[channel] = 0;
+            media[index].tx_bias[channel] = 0;
+            media[index].tx_power[channel] = 0;
+        }
+        media[index].rc = sdi_media_presence_get(media[index].resource_hdl,
+                                                 &media[index].present);
+        if ((media[index].rc != STD_ERR_OK) || (!media[index].present)) {
+            continue;
+        }
+        sdi_media_module_monitor_get(media[index].resource_hdl, SDI_MEDIA_TEMP,
+                                     &media[index].temperature);
+        sdi_media_module_monitor_get(media[index].resource_hdl, SDI_MEDIA_VOLT,
+                                     &media[index].voltage);
+        for (channel = 0; (channel < media[index].channel_count)
+                 && (channel < SDI_MEDIA_POLL_MAX_CHANNELS); channel++) {
+            sdi_media_channel_monitor_get(media[index].resource_hdl, channel,
+                    SDI_MEDIA_INTERNAL_RX_POWER_MONITOR, &media[index].rx_power[channel]);
+            sdi_media_channel_monitor_get(media[index].resource_hdl, channel,
+                    SDI_MEDIA_INTERNAL_TX_BIAS_CURRENT, &media[index].tx_bias[channel]);
+            sdi_media_channel_monitor_get(media[index].resource_hdl, channel,
+                    SDI_MEDIA_INTERNAL_TX_OUTPUT_POWER, &media[index].tx_power[channel]);
+        }
+    }
+    return STD_ERR_OK;
+}
+
+/*
+ * Asynchronous media request. Simulated media never block, so requests
+ * complete before the submitting call returns.
+ */
+struct sdi_media_async_req {
+    t_std_error rc;
+};
+
+static pthread_once_t sdi_vm_media_async_once = PTHREAD_ONCE_INIT;
+static int sdi_vm_media_async_fd = -1;
+
+static void sdi_vm_media_async_fd_init(void)
+{
+    sdi_vm_media_async_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+/*
+ * Get the eventfd signalled on completion of requests without callback
+ */
+t_std_error sdi_media_async_fd_get (int *fd)
+{
+    STD_ASSERT(fd != NULL);
+
+    pthread_once(&sdi_vm_media_async_once, sdi_vm_media_async_fd_init);
+    if (sdi_vm_media_async_fd < 0) {
+        return SDI_ERRCODE(errno);
+    }
+    *fd = sdi_vm_media_async_fd;
+    return STD_ERR_OK;
+}
+
+/*
+ * Complete a request through its callback or the eventfd
+ */
+static t_std_error sdi_vm_media_async_done (t_std_error result, sdi_media_async_cb_t cb,
+                                            void *cookie, sdi_media_async_hdl_t *req)
+{
+    struct sdi_media_async_req *async_req = NULL;
+    int fd = -1;
+    t_std_error rc = STD_ERR_OK;
+
+    if ((cb == NULL) && (req == NULL)) {
+        return SDI_ERRCODE(EINVAL);
+    }
+    if (cb == NULL) {
+        rc = sdi_media_async_fd_get(&fd);
+        if (rc != STD_ERR_OK) {
+            return rc;
+        }
+    }
+    async_req = calloc(1, sizeof(*async_req));
+    if (async_req == NULL) {
+        return SDI_ERRCODE(ENOMEM);
+    }
+    async_req->rc = result;
+    if (req != NULL) {
+        *req = async_req;
+    }
+    if (cb != NULL) {
+        cb(async_req, result, cookie);
+        free(async_req);
+    } else {
+        eventfd_write(fd, 1);
+    }
+    return STD_ERR_OK;
+}
+
+/*
+ * Collect the result of a request without callback and release it
+ */
+t_std_error sdi_media_async_complete (sdi_media_async_hdl_t req, t_std_error *rc)
+{
+    STD_ASSERT(req != NULL);
+    STD_ASSERT(rc != NULL);
+
+    *rc = req->rc;
+    free(req);
+    return STD_ERR_OK;
+}
+
+/*
+ * Asynchronous version of sdi_media_presence_get
+ */
+t_std_error sdi_media_presence_get_async (sdi_resource_hdl_t resource_hdl,
+                                          bool *presence, sdi_media_async_cb_t cb,
+                                          void *cookie, sdi_media_async_hdl_t *req)
+{
+    return sdi_vm_media_async_done(sdi_media_presence_get(resource_hdl, presence),
+                                   cb, cookie, req);
+}
+
+/*
+ * Asynchronous version of sdi_media_module_monitor_get
+ */
+t_std_error sdi_media_module_monitor_get_async (sdi_resource_hdl_t resource_hdl,
+                                                sdi_media_module_monitor_t monitor,
+                                                float *value, sdi_media_async_cb_t cb,
+                                                void *cookie, sdi_media_async_hdl_t *req)
+{
+    return sdi_vm_media_async_done(sdi_media_module_monitor_get(resource_hdl, monitor, value),
+                                   cb, cookie, req);
+}
+
+/*
+ * Asynchronous version of sdi_media_channel_monitor_get
+ */
+t_std_error sdi_media_channel_monitor_get_async (sdi_resource_hdl_t resource_hdl,
+                                                 uint_t channel,
+                                                 sdi_media_channel_monitor_t monitor,
+                                                 float *value, sdi_media_async_cb_t cb,
+                                                 void *cookie, sdi_media_async_hdl_t *req)
+{
+    return sdi_vm_media_async_done(sdi_media_channel_monitor_get(resource_hdl, channel,
+                                                                 monitor, value),
+                                   cb, cookie, req);
+}
+
+/*
+ * Asynchronous version of sdi_media_vendor_info_get
+ */
+t_std_error sdi_media_vendor_info_get_async (sdi_resource_hdl_t resource_hdl,
+                                             sdi_media_vendor_info_type_t vendor_info_type,
+                                             char *vendor_info, size_t buf_size,
+                                             sdi_media_async_cb_t cb, void *cookie,
+                                             sdi_media_async_hdl_t *req)
+{
+    return sdi_vm_media_async_done(sdi_media_vendor_info_get(resource_hdl, vendor_info_type,
+                                                             vendor_info, buf_size),
+                                   cb, cookie, req);
+}
+
+/*
+ * Asynchronous version of sdi_media_read_generic
+ */
+t_std_error sdi_media_read_generic_async (sdi_resource_hdl_t resource_hdl,
+                                          sdi_media_eeprom_addr_t *addr,
+                                          uint8_t *data, size_t data_len,
+                                          sdi_media_async_cb_t cb, void *cookie,
+                                          sdi_media_async_hdl_t *req)
+{
+    return sdi_vm_media_async_done(sdi_media_read_generic(resource_hdl, addr, data, data_len),
+                                   cb, cookie, req);
+}
+
+/*
+ * Media registered for presence change notification. Simulated presence
+ * lives in the database and has no change signal, so the notification fd is
+ * a timer and changes are found when they are collected.
+ */
+typedef struct {
+    sdi_resource_hdl_t resource_hdl;
+    bool presence;
+} sdi_vm_media_presence_entry_t;
+
+static pthread_mutex_t sdi_vm_media_presence_lock = PTHREAD_MUTEX_INITIALIZER;
+static sdi_vm_media_presence_entry_t *sdi_vm_media_presence_entries = NULL;
+static uint_t sdi_vm_media_presence_entry_count = 0;
+static int sdi_vm_media_presence_fd = -1;
+
+/*
+ * Register a media for presence change notification
+ */
+t_std_error sdi_media_presence_event_register (sdi_resource_hdl_t resource_hdl, int *fd)
+{
+    struct itimerspec interval = {
+        .it_interval = { .tv_sec = SDI_MEDIA_PRESENCE_EVENT_POLL_INTERVAL_MS / 1000,
+                         .tv_nsec = (SDI_MEDIA_PRESENCE_EVENT_POLL_INTERVAL_MS % 1000) * 1000000 },
+    };
+    sdi_vm_media_presence_entry_t *entries = NULL;
+    t_std_error rc = STD_ERR_OK;
+    uint_t index = 0;
+
+    STD_ASSERT(fd != NULL);
+
+    pthread_mutex_lock(&sdi_vm_media_presence_lock);
+    do {
+        if (sdi_vm_media_presence_fd < 0) {
+            sdi_vm_media_presence_fd = timerfd_create(CLOCK_MONOTONIC,
+                                                      TFD_NONBLOCK | TFD_CLOEXEC);
+            if (sdi_vm_media_presence_fd < 0) {
+                rc = SDI_ERRCODE(errno);
+                break;
+            }
+            interval.it_value = interval.it_interval;
+            timerfd_settime(sdi_vm_media_presence_fd, 0, &interval, NULL);
+        }
+        *fd = sdi_vm_media_presence_fd;
+
+        for (index = 0; index < sdi_vm_media_presence_entry_count; index++) {
+            if (sdi_vm_media_presence_entries[index].resource_hdl == resource_hdl) {
+                break;
+            }
+        }
+        if (index < sdi_vm_media_presence_entry_count) {
+            break;
+        }
+        entries = realloc(sdi_vm_media_presence_entries,
+                          (sdi_vm_media_presence_entry_count + 1) * sizeof(*entries));
+        if (entries == NULL) {
+            rc = SDI_ERRCODE(ENOMEM);
+            break;
+        }
+        sdi_vm_media_presence_entries = entries;
+        entries[index].resource_hdl = resource_hdl;
+        if (sdi_media_presence_get(resource_hdl, &entries[index].presence) != STD_ERR_OK) {
+            entries[index].presence = false;
+        }
+        sdi_vm_media_presence_entry_count++;
+    } while (0);
+    pthread_mutex_unlock(&sdi_vm_media_presence_lock);
+
+    return rc;
+}
+
+/*
+ * Collect pending presence changes
+ */
+t_std_error sdi_media_presence_event_get (sdi_media_presence_event_t *events,
+                                          uint_t max_count, uint_t *count)
+{
+    uint64_t expirations = 0;
+    uint_t index = 0;
+    bool presence = false;
+
+    STD_ASSERT(count != NULL);
+
+    *count = 0;
+
+    pthread_mutex_lock(&sdi_vm_media_presence_lock);
+    if (sdi_vm_media_presence_fd >= 0) {
+        if (read(sdi_vm_media_presence_fd, &expirations, sizeof(expirations)) < 0) {
+            /* Timer not expired yet, changes are still collected */
+        }
+    }
+    for (index = 0; (index < sdi_vm_media_presence_entry_count) && (*count < max_count);
+         index++) {
+        if ((sdi_media_presence_get(sdi_vm_media_presence_entries[index].resource_hdl,
+                                    &presence) != STD_ERR_OK)
+                || (presence == sdi_vm_media_presence_entries[index].presence)) {
+            continue;
+        }
+        sdi_vm_media_presence_entries[index].presence = presence;
+        events[*count].resource_hdl = sdi_vm_media_presence_entries[index].resource_hdl;
+        events[*count].presence = presence;
+        (*count)++;
+    }
+    pthread_mutex_unlock(&sdi_vm_media_presence_lock);
+
+    return STD_ERR_OK;
+}
+
+/* Set bit index of a bitmap, when the bitmap is requested */
+static void sdi_vm_media_bitmap_set(uint8_t *bitmap, uint_t index)
+{
+    if (bitmap != NULL) {
+        bitmap[index / 8] |= (uint8_t) (1 << (index % 8));
+    }
+}
+
+/* Get presence, reset and low power mode state of a set of media */
+t_std_error sdi_media_presence_bitmap_get (sdi_resource_hdl_t *resource_hdl, uint_t count,
+                                           sdi_media_state_bitmap_t *bitmap)
+{
+    size_t size = SDI_MEDIA_BITMAP_BYTES(count);
+    t_std_error rc = STD_ERR_OK;
+    t_std_error media_rc = STD_ERR_OK;
+    uint_t index = 0;
+    bool presence = false;
+    bool reset = false;
+    bool lpmode = false;
+
+    STD_ASSERT(resource_hdl != NULL);
+    STD_ASSERT(bitmap != NULL);
+    STD_ASSERT(bitmap->presence != NULL);
+
+    memset(bitmap->presence, 0, size);
+    if (bitmap->reset != NULL) {
+        memset(bitmap->reset, 0, size);
+    }
+    if (bitmap->lpmode != NULL) {
+        memset(bitmap->lpmode, 0, size);
+    }
+    if (bitmap->failed != NULL) {
+        memset(bitmap->failed, 0, size);
+    }
+
+    for (index = 0; index < count; index++) {
+        reset = false;
+        lpmode = false;
+        media_rc = sdi_media_presence_get(resource_hdl[index], &presence);
+        if ((media_rc == STD_ERR_OK) && (bitmap->reset != NULL)) {
+            media_rc = sdi_media_module_control_status_get(resource_hdl[index],
+                                                           SDI_MEDIA_RESET, &reset);
+        }
+        if ((media_rc == STD_ERR_OK) && (bitmap->lpmode != NULL)) {
+            media_rc = sdi_media_module_control_status_get(resource_hdl[index],
+                                                           SDI_MEDIA_LP_MODE, &lpmode);
+        }
+        if (media_rc != STD_ERR_OK) {
+            /* Other bits of a failed media stay cleared */
+            sdi_vm_media_bitmap_set(bitmap->failed, index);
+            rc = media_rc;
+            continue;
+        }
+        if (presence) {
+            sdi_vm_media_bitmap_set(bitmap->presence, index);
+        }
+        if (reset) {
+            sdi_vm_media_bitmap_set(bitmap->reset, index);
+        }
+        if (lpmode) {
+            sdi_vm_media_bitmap_set(bitmap->lpmode, index);
+        }
+    }
+
+    return rc;
+}
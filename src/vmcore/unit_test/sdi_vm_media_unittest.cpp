@@ -16,6 +16,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <poll.h>
 #include "gtest/gtest.h"
 
 extern "C" {
@@ -431,6 +432,154 @@ TEST(sdi_vm_media_unittest, mediaMonitorGet)
     ASSERT_EQ(STD_ERR_OK, sdi_sys_close());
 }
 
+/* Set presence, reset and low power mode of a media in the DB */
+static void media_state_set(sdi_resource_hdl_t hdl, int presence, int reset, int lpmode)
+{
+    ASSERT_EQ(STD_ERR_OK, sdi_db_int_field_set(sdi_get_db_handle(), hdl,
+                                TABLE_MEDIA, MEDIA_PRESENCE, &presence));
+    ASSERT_EQ(STD_ERR_OK, sdi_db_int_field_set(sdi_get_db_handle(), hdl,
+                                TABLE_MEDIA, MEDIA_RESET, &reset));
+    ASSERT_EQ(STD_ERR_OK, sdi_db_int_field_set(sdi_get_db_handle(), hdl,
+                                TABLE_MEDIA, MEDIA_LP_MODE, &lpmode));
+}
+
+TEST(sdi_vm_media_unittest, presenceBitmapGet)
+{
+    sdi_entity_hdl_t e_hdl;
+    sdi_resource_hdl_t hdl[4];
+    uint8_t presence[SDI_MEDIA_BITMAP_BYTES(4)];
+    uint8_t reset[SDI_MEDIA_BITMAP_BYTES(4)];
+    uint8_t lpmode[SDI_MEDIA_BITMAP_BYTES(4)];
+    uint8_t failed[SDI_MEDIA_BITMAP_BYTES(4)];
+    sdi_media_state_bitmap_t bitmap = { presence, reset, lpmode, failed };
+
+    ASSERT_EQ(STD_ERR_OK, sdi_sys_init());
+
+    e_hdl = sdi_entity_lookup(SDI_ENTITY_SYSTEM_BOARD, 1);
+    hdl[0] = sdi_entity_resource_lookup(e_hdl, SDI_RESOURCE_MEDIA, "QSFP 1");
+    hdl[1] = sdi_entity_resource_lookup(e_hdl, SDI_RESOURCE_MEDIA, "QSFP 2");
+    hdl[2] = sdi_entity_resource_lookup(e_hdl, SDI_RESOURCE_MEDIA, "QSFP 3");
+    hdl[3] = sdi_entity_resource_lookup(e_hdl, SDI_RESOURCE_MEDIA, "QSFP 4");
+
+    /* Mix of present and absent media, in reset and low power mode */
+    media_state_set(hdl[0], 1, 0, 0);
+    media_state_set(hdl[1], 0, 0, 0);
+    media_state_set(hdl[2], 1, 1, 0);
+    media_state_set(hdl[3], 1, 0, 1);
+
+    ASSERT_EQ(STD_ERR_OK, sdi_media_presence_bitmap_get(hdl, 4, &bitmap));
+    ASSERT_EQ(0x0D, presence[0]);
+    ASSERT_EQ(0x04, reset[0]);
+    ASSERT_EQ(0x08, lpmode[0]);
+    ASSERT_EQ(0x00, failed[0]);
+
+    /* Optional bitmaps left NULL are not filled */
+    bitmap.reset = NULL;
+    bitmap.lpmode = NULL;
+    bitmap.failed = NULL;
+    ASSERT_EQ(STD_ERR_OK, sdi_media_presence_bitmap_get(hdl, 4, &bitmap));
+    ASSERT_EQ(0x0D, presence[0]);
+
+    /* A resource without media state fails, others are still read */
+    hdl[1] = sdi_entity_resource_lookup(e_hdl, SDI_RESOURCE_TEMPERATURE,
+                                        "NIC Thermal Sensor");
+    bitmap.reset = reset;
+    bitmap.lpmode = lpmode;
+    bitmap.failed = failed;
+    ASSERT_NE(STD_ERR_OK, sdi_media_presence_bitmap_get(hdl, 4, &bitmap));
+    ASSERT_EQ(0x02, failed[0]);
+    ASSERT_EQ(0x0D, presence[0]);
+    ASSERT_EQ(0x04, reset[0]);
+    ASSERT_EQ(0x08, lpmode[0]);
+
+    media_state_set(hdl[0], 1, 0, 0);
+    media_state_set(hdl[2], 1, 0, 0);
+    media_state_set(hdl[3], 1, 0, 0);
+
+    ASSERT_EQ(STD_ERR_OK, sdi_sys_close());
+}
+
+TEST(sdi_vm_media_unittest, domSnapshotGet)
+{
+    sdi_media_dom_snapshot_t snapshot;
+    float value;
+    uint_t channel;
+
+    ASSERT_EQ(STD_ERR_OK, sdi_sys_init());
+    ASSERT_EQ(STD_ERR_OK, sdi_media_dom_snapshot_get(media_hdl, 4, &snapshot));
+    ASSERT_EQ(4, snapshot.channel_count);
+
+    /* Module monitors match the per monitor API */
+    ASSERT_TRUE(snapshot.module_monitor_valid);
+    ASSERT_EQ(STD_ERR_OK, sdi_media_module_monitor_get(media_hdl, SDI_MEDIA_TEMP, &value));
+    ASSERT_FLOAT_EQ(value, snapshot.temperature);
+    ASSERT_EQ(STD_ERR_OK, sdi_media_module_monitor_get(media_hdl, SDI_MEDIA_VOLT, &value));
+    ASSERT_FLOAT_EQ(value, snapshot.voltage);
+
+    /* Channel monitors match the per channel API */
+    ASSERT_TRUE(snapshot.rx_power_valid);
+    ASSERT_TRUE(snapshot.tx_bias_valid);
+    ASSERT_TRUE(snapshot.tx_power_valid);
+    for (channel = 0; channel < snapshot.channel_count; channel++) {
+        ASSERT_EQ(STD_ERR_OK, sdi_media_channel_monitor_get(media_hdl, channel,
+                                  SDI_MEDIA_INTERNAL_RX_POWER_MONITOR, &value));
+        ASSERT_FLOAT_EQ(value, snapshot.rx_power[channel]);
+        ASSERT_EQ(STD_ERR_OK, sdi_media_channel_monitor_get(media_hdl, channel,
+                                  SDI_MEDIA_INTERNAL_TX_BIAS_CURRENT, &value));
+        ASSERT_FLOAT_EQ(value, snapshot.tx_bias[channel]);
+        ASSERT_EQ(STD_ERR_OK, sdi_media_channel_monitor_get(media_hdl, channel,
+                                  SDI_MEDIA_INTERNAL_TX_OUTPUT_POWER, &value));
+        ASSERT_FLOAT_EQ(value, snapshot.tx_power[channel]);
+    }
+
+    ASSERT_EQ(STD_ERR_OK, sdi_sys_close());
+}
+
+TEST(sdi_vm_media_unittest, presenceEvent)
+{
+    sdi_entity_hdl_t e_hdl;
+    sdi_resource_hdl_t hdl;
+    sdi_media_presence_event_t events[2];
+    struct pollfd pfd;
+    uint_t count;
+    int presence;
+    int fd = -1;
+
+    ASSERT_EQ(STD_ERR_OK, sdi_sys_init());
+
+    e_hdl = sdi_entity_lookup(SDI_ENTITY_SYSTEM_BOARD, 1);
+    hdl = sdi_entity_resource_lookup(e_hdl, SDI_RESOURCE_MEDIA, "QSFP 5");
+
+    presence = 0;
+    ASSERT_EQ(STD_ERR_OK, sdi_db_int_field_set(sdi_get_db_handle(), hdl,
+                                TABLE_MEDIA, MEDIA_PRESENCE, &presence));
+    ASSERT_EQ(STD_ERR_OK, sdi_media_presence_event_register(hdl, &fd));
+    ASSERT_GE(fd, 0);
+
+    /* Nothing pending right after registration */
+    ASSERT_EQ(STD_ERR_OK, sdi_media_presence_event_get(events, 2, &count));
+    ASSERT_EQ(0, count);
+
+    /* Insert the media, the fd is signalled and one event is delivered */
+    presence = 1;
+    ASSERT_EQ(STD_ERR_OK, sdi_db_int_field_set(sdi_get_db_handle(), hdl,
+                                TABLE_MEDIA, MEDIA_PRESENCE, &presence));
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    ASSERT_EQ(1, poll(&pfd, 1, 2 * SDI_MEDIA_PRESENCE_EVENT_POLL_INTERVAL_MS));
+    ASSERT_EQ(STD_ERR_OK, sdi_media_presence_event_get(events, 2, &count));
+    ASSERT_EQ(1, count);
+    ASSERT_EQ(hdl, events[0].resource_hdl);
+    ASSERT_TRUE(events[0].presence);
+
+    /* The event is cleared once collected */
+    ASSERT_EQ(STD_ERR_OK, sdi_media_presence_event_get(events, 2, &count));
+    ASSERT_EQ(0, count);
+
+    ASSERT_EQ(STD_ERR_OK, sdi_sys_close());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
 